@@ -551,6 +551,8 @@ public:
     friend class EnterpriseConfigProviderUnittest;
     friend class PollingPreservedDirDepthUnittest;
     friend class InputStaticFileUnittest;
+    friend class CheckpointManagerUnittest;
+    friend class CheckPointDumpBenchmark;
 #endif
 };
 
@@ -26,6 +26,7 @@
 #include "collection_pipeline/queue/ExactlyOnceQueueManager.h"
 #include "collection_pipeline/queue/SenderQueueManager.h"
 #include "common/CrashBackTraceUtil.h"
+#include "common/DNSCache.h"
 #include "common/EnvUtil.h"
 #include "common/Flags.h"
 #include "common/MachineInfoUtil.h"
@@ -394,6 +395,7 @@ void Application::Exit() {
 
     FlusherRunner::GetInstance()->Stop();
     HttpSink::GetInstance()->Stop();
+    DnsCache::GetInstance()->Stop();
 
     // TODO: make it common
     FlusherSLS::RecycleResourceIfNotUsed();
@@ -18,6 +18,7 @@
 
 #include <cstdint>
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <utility>
@@ -32,6 +33,7 @@
 #include "collection_pipeline/queue/SenderQueueManager.h"
 #include "common/Flags.h"
 #include "common/ParamExtractor.h"
+#include "common/TimeUtil.h"
 #include "config/OnetimeConfigInfoManager.h"
 #include "go_pipeline/LogtailPlugin.h"
 #include "logger/Logger.h"
@@ -41,6 +43,7 @@
 #include "plugin/processor/inner/ProcessorTagNative.h"
 
 DECLARE_FLAG_INT32(default_plugin_log_queue_size);
+DEFINE_FLAG_BOOL(enable_processor_fusion, "run adjacent native processors in a single pass over the events", true);
 
 using namespace std;
 
@@ -250,6 +253,10 @@ bool CollectionPipeline::Init(CollectionConfig&& config) {
         }
     }
 
+    if (BOOL_FLAG(enable_processor_fusion)) {
+        InitFusedProcessorChain();
+    }
+
     // mandatory override global.DefaultLogQueueSize in Go pipeline when input_file and Go processing coexist.
     if ((inputFile != nullptr || inputContainerStdio != nullptr) && IsFlushingThroughGoPipeline()) {
         mGoPipelineWithoutInput["global"]["DefaultLogQueueSize"]
@@ -361,10 +368,13 @@ bool CollectionPipeline::Init(CollectionConfig&& config) {
     mProcessorsInSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_PROCESSORS_IN_SIZE_BYTES);
     mProcessorsTotalProcessTimeMs
         = mMetricsRecordRef.CreateTimeCounter(METRIC_PIPELINE_PROCESSORS_TOTAL_PROCESS_TIME_MS);
+    mProcessorsTotalCpuTimeMs = mMetricsRecordRef.CreateTimeCounter(METRIC_PIPELINE_PROCESSORS_TOTAL_CPU_TIME_MS);
+    mProcessorsLatencyMs = mMetricsRecordRef.CreateLatencyHistogram(METRIC_PIPELINE_PROCESSORS_LATENCY_MS);
     mFlushersInGroupsTotal = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_FLUSHERS_IN_EVENT_GROUPS_TOTAL);
     mFlushersInEventsTotal = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_FLUSHERS_IN_EVENTS_TOTAL);
     mFlushersInSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_FLUSHERS_IN_SIZE_BYTES);
     mFlushersTotalPackageTimeMs = mMetricsRecordRef.CreateTimeCounter(METRIC_PIPELINE_FLUSHERS_TOTAL_PACKAGE_TIME_MS);
+    mFlushersTotalCpuTimeMs = mMetricsRecordRef.CreateTimeCounter(METRIC_PIPELINE_FLUSHERS_TOTAL_CPU_TIME_MS);
     WriteMetrics::GetInstance()->CommitMetricsRecordRef(mMetricsRecordRef);
 
     return true;
@@ -404,9 +414,13 @@ void CollectionPipeline::Process(vector<PipelineEventGroup>& logGroupList, size_
     ADD_COUNTER(mProcessorsInGroupsTotal, logGroupList.size())
 
     auto before = chrono::system_clock::now();
+    auto cpuTimeNs = GetThreadCpuTimeNs();
+    bool isSplitterFused = mFusedProcessorChain && mFusedProcessorChain->HasSplitter();
     if (inputIndex < mInputs.size()) {
-        for (auto& p : mInputs[inputIndex]->GetInnerProcessors()) {
-            p->Process(logGroupList);
+        if (!isSplitterFused) {
+            for (auto& p : mInputs[inputIndex]->GetInnerProcessors()) {
+                p->Process(logGroupList);
+            }
         }
     } else {
         LOG_WARNING(sLogger,
@@ -421,13 +435,23 @@ void CollectionPipeline::Process(vector<PipelineEventGroup>& logGroupList, size_
             GetContext().GetConfigName(),
             GetContext().GetLogstoreName());
     }
+    // inner processors of the pipeline only deal with the group, so they can run before the split in a fused chain
     for (auto& p : mPipelineInnerProcessorLine) {
         p->Process(logGroupList);
     }
-    for (auto& p : mProcessorLine) {
-        p->Process(logGroupList);
+    size_t processorIdx = 0;
+    chrono::nanoseconds otherThreadsCpuTime(0);
+    if (mFusedProcessorChain && (!isSplitterFused || inputIndex < mInputs.size())) {
+        otherThreadsCpuTime = mFusedProcessorChain->Process(logGroupList);
+        processorIdx = mFusedProcessorChain->GetProcessorCnt();
+    }
+    for (; processorIdx < mProcessorLine.size(); ++processorIdx) {
+        mProcessorLine[processorIdx]->Process(logGroupList);
     }
-    ADD_COUNTER(mProcessorsTotalProcessTimeMs, chrono::system_clock::now() - before);
+    auto processTime = chrono::system_clock::now() - before;
+    ADD_COUNTER(mProcessorsTotalProcessTimeMs, processTime);
+    ADD_COUNTER(mProcessorsTotalCpuTimeMs, chrono::nanoseconds(GetThreadCpuTimeNs() - cpuTimeNs) + otherThreadsCpuTime);
+    OBSERVE_HISTOGRAM(mProcessorsLatencyMs, processTime);
 }
 
 bool CollectionPipeline::Send(vector<PipelineEventGroup>&& groupList) {
@@ -438,6 +462,7 @@ bool CollectionPipeline::Send(vector<PipelineEventGroup>&& groupList) {
     ADD_COUNTER(mFlushersInGroupsTotal, groupList.size());
 
     auto before = chrono::system_clock::now();
+    auto cpuTimeNs = GetThreadCpuTimeNs();
     bool allSucceeded = true;
     for (auto& group : groupList) {
         if (group.GetEvents().empty()) {
@@ -445,6 +470,11 @@ bool CollectionPipeline::Send(vector<PipelineEventGroup>&& groupList) {
             continue;
         }
         auto res = mRouter.Route(group);
+        // read-only flushers go first, so that the group is copied as few times as possible before the last holder
+        // takes it over
+        stable_partition(res.begin(), res.end(), [this](const auto& item) {
+            return item.first < mFlushers.size() && mFlushers[item.first]->GetPlugin()->IsSharedGroupReadOnly();
+        });
         for (auto& item : res) {
             if (item.first >= mFlushers.size()) {
                 LOG_ERROR(sLogger,
@@ -456,9 +486,32 @@ bool CollectionPipeline::Send(vector<PipelineEventGroup>&& groupList) {
         }
     }
     ADD_COUNTER(mFlushersTotalPackageTimeMs, chrono::system_clock::now() - before);
+    ADD_COUNTER(mFlushersTotalCpuTimeMs, chrono::nanoseconds(GetThreadCpuTimeNs() - cpuTimeNs));
     return allSucceeded;
 }
 
+void CollectionPipeline::InitFusedProcessorChain() {
+    ProcessorInstance* splitter = nullptr;
+    if (mInputs.size() == 1 && mInputs[0]->GetInnerProcessors().size() == 1
+        && mInputs[0]->GetInnerProcessors()[0]->GetPlugin()->IsFusableSplitter()) {
+        splitter = mInputs[0]->GetInnerProcessors()[0].get();
+    }
+    vector<ProcessorInstance*> processors;
+    for (const auto& p : mProcessorLine) {
+        if (!p->GetPlugin()->IsFusable()) {
+            break;
+        }
+        processors.push_back(p.get());
+    }
+    // nothing to save with a single stage
+    if (processors.empty() || (!splitter && processors.size() == 1)) {
+        return;
+    }
+    LOG_INFO(sLogger,
+             ("processors fused", processors.size())("with splitter", splitter != nullptr)("config", mName));
+    mFusedProcessorChain = make_unique<FusedProcessorChain>(splitter, std::move(processors));
+}
+
 bool CollectionPipeline::FlushBatch() {
     bool allSucceeded = true;
     for (auto& flusher : mFlushers) {
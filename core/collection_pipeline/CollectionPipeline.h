@@ -26,6 +26,7 @@
 
 #include "collection_pipeline/CollectionPipelineContext.h"
 #include "collection_pipeline/plugin/instance/FlusherInstance.h"
+#include "collection_pipeline/plugin/instance/FusedProcessorChain.h"
 #include "collection_pipeline/plugin/instance/InputInstance.h"
 #include "collection_pipeline/plugin/instance/ProcessorInstance.h"
 #include "collection_pipeline/route/Router.h"
@@ -91,12 +92,15 @@ private:
     void CopyTagParamToGoPipeline(Json::Value& root, const Json::Value* config);
     bool ShouldAddPluginToGoPipelineWithInput() const { return mInputs.empty() && mProcessorLine.empty(); }
     void WaitAllItemsInProcessFinished();
+    void InitFusedProcessorChain();
 
     std::string mName;
     bool mIsOnetime = false;
     std::vector<std::unique_ptr<InputInstance>> mInputs;
     std::vector<std::unique_ptr<ProcessorInstance>> mPipelineInnerProcessorLine;
     std::vector<std::unique_ptr<ProcessorInstance>> mProcessorLine;
+    // takes over the inner processors of the input and the leading processors of the line when fusable
+    std::unique_ptr<FusedProcessorChain> mFusedProcessorChain;
     std::vector<std::unique_ptr<FlusherInstance>> mFlushers;
     Router mRouter;
     Json::Value mGoPipelineWithInput;
@@ -113,10 +117,13 @@ private:
     CounterPtr mProcessorsInGroupsTotal;
     CounterPtr mProcessorsInSizeBytes;
     TimeCounterPtr mProcessorsTotalProcessTimeMs;
+    TimeCounterPtr mProcessorsTotalCpuTimeMs;
+    LatencyHistogramPtr mProcessorsLatencyMs;
     CounterPtr mFlushersInGroupsTotal;
     CounterPtr mFlushersInEventsTotal;
     CounterPtr mFlushersInSizeBytes;
     TimeCounterPtr mFlushersTotalPackageTimeMs;
+    TimeCounterPtr mFlushersTotalCpuTimeMs;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class PipelineMock;
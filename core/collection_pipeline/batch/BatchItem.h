@@ -58,6 +58,7 @@ public:
     }
 
     GroupBatchStatus& GetStatus() { return mStatus; }
+    const GroupBatchStatus& GetStatus() const { return mStatus; }
     size_t GroupSize() const { return mGroups.size(); }
     size_t EventSize() const { return mEventsCnt; }
     size_t DataSize() const { return mStatus.GetSize(); }
@@ -157,6 +158,7 @@ public:
     }
 
     T& GetStatus() { return mStatus; }
+    const T& GetStatus() const { return mStatus; }
 
     bool IsEmpty() { return mBatch.mEvents.empty(); }
 
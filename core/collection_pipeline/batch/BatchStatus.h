@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <ctime>
 
@@ -37,6 +38,7 @@ public:
     virtual void Update(const PipelineEventPtr& e) {
         if (mCreateTime == 0) {
             mCreateTime = time(nullptr);
+            mCreateSteadyTime = std::chrono::steady_clock::now();
         }
         mSizeBytes += e->DataSize();
         ++mCnt;
@@ -45,11 +47,14 @@ public:
     uint32_t GetCnt() const { return mCnt; }
     uint32_t GetSize() const { return mSizeBytes; }
     time_t GetCreateTime() const { return mCreateTime; }
+    // for the latency of the batch, which is mostly less than a second
+    std::chrono::steady_clock::time_point GetCreateSteadyTime() const { return mCreateSteadyTime; }
 
 protected:
     uint32_t mCnt = 0;
     uint32_t mSizeBytes = 0;
     time_t mCreateTime = 0;
+    std::chrono::steady_clock::time_point mCreateSteadyTime;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class EventFlushStrategyUnittest;
@@ -66,16 +71,20 @@ public:
     void Update(const BatchedEvents& g) {
         if (mCreateTime == 0) {
             mCreateTime = time(nullptr);
+            mCreateSteadyTime = std::chrono::steady_clock::now();
         }
         mSizeBytes += g.mSizeBytes;
     }
 
     uint32_t GetSize() const { return mSizeBytes; }
     time_t GetCreateTime() const { return mCreateTime; }
+    // for the latency of the batch, which is mostly less than a second
+    std::chrono::steady_clock::time_point GetCreateSteadyTime() const { return mCreateSteadyTime; }
 
 private:
     uint32_t mSizeBytes = 0;
     time_t mCreateTime = 0;
+    std::chrono::steady_clock::time_point mCreateSteadyTime;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class GroupFlushStrategyUnittest;
@@ -92,6 +101,7 @@ public:
     void Update(const PipelineEventPtr& e) override {
         if (mCreateTime == 0) {
             mCreateTime = time(nullptr);
+            mCreateSteadyTime = std::chrono::steady_clock::now();
             mCreateTimeMinute = e->GetTimestamp() / 60;
         }
         mSizeBytes += e->DataSize();
@@ -32,6 +32,7 @@
 #include "collection_pipeline/batch/TimeoutFlushManager.h"
 #include "common/Flags.h"
 #include "common/ParamExtractor.h"
+#include "common/memory/MemoryAccountant.h"
 #include "models/PipelineEventGroup.h"
 #include "monitor/MetricManager.h"
 #include "monitor/metric_constants/MetricConstants.h"
@@ -41,6 +42,8 @@ namespace logtail {
 template <typename T = EventBatchStatus>
 class Batcher {
 public:
+    ~Batcher() { MemoryAccountant::GetInstance()->Sub(MemoryCategory::BATCHER, mAccountedDataSize); }
+
     bool Init(const Json::Value& config,
               Flusher* flusher,
               const DefaultFlushStrategyOptions& strategy,
@@ -122,6 +125,7 @@ public:
         mBufferedEventsTotal = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BATCHER_BUFFERED_EVENTS_TOTAL);
         mBufferedDataSizeByte = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BATCHER_BUFFERED_SIZE_BYTES);
         mTotalAddTimeMs = mMetricsRecordRef.CreateTimeCounter(METRIC_COMPONENT_BATCHER_TOTAL_ADD_TIME_MS);
+        mLatencyMs = mMetricsRecordRef.CreateLatencyHistogram(METRIC_COMPONENT_LATENCY_MS);
         WriteMetrics::GetInstance()->CommitMetricsRecordRef(mMetricsRecordRef);
 
         return true;
@@ -207,7 +211,7 @@ public:
                                                                      mEventFlushStrategy.GetTimeoutSecs(),
                                                                      mFlusher);
                     ADD_GAUGE(mBufferedGroupsTotal, 1);
-                    ADD_GAUGE(mBufferedDataSizeByte, item.DataSize());
+                    AddBufferedDataSize(item.DataSize());
                 } else if (i == 0) {
                     item.AddSourceBuffer(g.GetSourceBuffer());
                     for (const auto& extraSourceBuffer : g.GetExtraSourceBuffers()) {
@@ -215,7 +219,7 @@ public:
                     }
                 }
                 ADD_GAUGE(mBufferedEventsTotal, 1);
-                ADD_GAUGE(mBufferedDataSizeByte, e->DataSize());
+                AddBufferedDataSize(e->DataSize());
                 item.Add(std::move(e));
                 if (mEventFlushStrategy.NeedFlushBySize(item.GetStatus())
                     || mEventFlushStrategy.NeedFlushByCnt(item.GetStatus())) {
@@ -314,7 +318,10 @@ private:
         //                 - item.TotalEnqueTimeMs());
         SUB_GAUGE(mBufferedGroupsTotal, 1);
         SUB_GAUGE(mBufferedEventsTotal, item.EventSize());
-        SUB_GAUGE(mBufferedDataSizeByte, item.DataSize());
+        SubBufferedDataSize(item.DataSize());
+        if (item.EventSize() > 0) {
+            OBSERVE_HISTOGRAM(mLatencyMs, std::chrono::steady_clock::now() - item.GetStatus().GetCreateSteadyTime());
+        }
     }
 
     void UpdateMetricsOnFlushingGroupQueue() {
@@ -327,7 +334,24 @@ private:
         //                 - mGroupQueue->TotalEnqueTimeMs());
         SUB_GAUGE(mBufferedGroupsTotal, mGroupQueue->GroupSize());
         SUB_GAUGE(mBufferedEventsTotal, mGroupQueue->EventSize());
-        SUB_GAUGE(mBufferedDataSizeByte, mGroupQueue->DataSize());
+        SubBufferedDataSize(mGroupQueue->DataSize());
+        if (mGroupQueue->GroupSize() > 0) {
+            OBSERVE_HISTOGRAM(mLatencyMs,
+                              std::chrono::steady_clock::now() - mGroupQueue->GetStatus().GetCreateSteadyTime());
+        }
+    }
+
+    // data held by the batcher is reported to the memory accountant as well
+    void AddBufferedDataSize(size_t size) {
+        ADD_GAUGE(mBufferedDataSizeByte, size);
+        mAccountedDataSize += size;
+        MemoryAccountant::GetInstance()->Add(MemoryCategory::BATCHER, size);
+    }
+
+    void SubBufferedDataSize(size_t size) {
+        SUB_GAUGE(mBufferedDataSizeByte, size);
+        mAccountedDataSize -= size;
+        MemoryAccountant::GetInstance()->Sub(MemoryCategory::BATCHER, size);
     }
 
     std::mutex mMux;
@@ -349,6 +373,8 @@ private:
     IntGaugePtr mBufferedEventsTotal;
     IntGaugePtr mBufferedDataSizeByte;
     TimeCounterPtr mTotalAddTimeMs;
+    LatencyHistogramPtr mLatencyMs;
+    size_t mAccountedDataSize = 0;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class BatcherUnittest;
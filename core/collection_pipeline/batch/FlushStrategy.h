@@ -19,15 +19,27 @@
 #include <cstdint>
 #include <ctime>
 
+#include <algorithm>
 #include <limits>
 
 #include "json/json.h"
 
 #include "collection_pipeline/batch/BatchStatus.h"
+#include "common/memory/MemoryAccountant.h"
 #include "models/PipelineEventPtr.h"
 
 namespace logtail {
 
+inline constexpr uint32_t kMemoryPressureBatchShrinkRatio = 4;
+
+// under memory pressure, batches are flushed at a fraction of their min size or count, so that batchers hold less data
+inline uint32_t GetEffectiveFlushThreshold(uint32_t threshold) {
+    if (threshold > 0 && MemoryAccountant::GetInstance()->IsUnderPressure(MemoryPressureLevel::SHRINK_BATCH)) {
+        return std::max(threshold / kMemoryPressureBatchShrinkRatio, 1U);
+    }
+    return threshold;
+}
+
 struct DefaultFlushStrategyOptions {
     uint32_t mMaxSizeBytes = std::numeric_limits<uint32_t>::max();
     uint32_t mMinSizeBytes = 0;
@@ -48,8 +60,11 @@ public:
     uint32_t GetTimeoutSecs() const { return mTimeoutSecs; }
 
     // should be called after event is added
-    bool NeedFlushBySize(const T& status) { return status.GetSize() >= mMinSizeBytes; }
-    bool NeedFlushByCnt(const T& status) { return status.GetCnt() == mMinCnt; }
+    bool NeedFlushBySize(const T& status) { return status.GetSize() >= GetEffectiveFlushThreshold(mMinSizeBytes); }
+    // the batch may have grown beyond the threshold before it is shrunk
+    bool NeedFlushByCnt(const T& status) {
+        return mMinCnt > 0 && status.GetCnt() >= GetEffectiveFlushThreshold(mMinCnt);
+    }
     // should be called before event is added
     bool NeedFlushByTime(const T& status, const PipelineEventPtr& e) {
         return time(nullptr) - status.GetCreateTime() >= mTimeoutSecs;
@@ -73,7 +88,9 @@ public:
     uint32_t GetTimeoutSecs() const { return mTimeoutSecs; }
 
     // should be called after event is added
-    bool NeedFlushBySize(const GroupBatchStatus& status) { return status.GetSize() >= mMinSizeBytes; }
+    bool NeedFlushBySize(const GroupBatchStatus& status) {
+        return status.GetSize() >= GetEffectiveFlushThreshold(mMinSizeBytes);
+    }
     // should be called before event is added
     bool NeedFlushByTime(const GroupBatchStatus& status) {
         return time(nullptr) - status.GetCreateTime() >= mTimeoutSecs;
@@ -0,0 +1,157 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "collection_pipeline/limiter/InputFlowController.h"
+
+#include <algorithm>
+
+#include "app_config/AppConfig.h"
+#include "common/Flags.h"
+#include "logger/Logger.h"
+
+DEFINE_FLAG_INT64(input_flow_control_max_bytes_per_sec,
+                  "max bytes read per second by the inputs of a pipeline",
+                  200 * 1024 * 1024);
+DEFINE_FLAG_INT64(input_flow_control_max_events_per_sec,
+                  "max events processed per second for a pipeline",
+                  2 * 1000 * 1000);
+
+using namespace std;
+
+namespace logtail {
+
+static constexpr double kProportionalGain = 0.5;
+static constexpr double kIntegralGain = 0.3;
+static constexpr double kMinAdjustFactor = 0.5;
+static constexpr double kMaxAdjustFactor = 2.0;
+// small bursts keep reads paced instead of bursting at the start of each second
+static constexpr double kBurstSeconds = 0.1;
+static constexpr double kMinBytesPerSec = 64 * 1024;
+static constexpr double kMinEventsPerSec = 100;
+static constexpr chrono::seconds kIdleTimeout(300);
+
+InputFlowController::PipelineBuckets::PipelineBuckets(double bytesRate,
+                                                      double eventsRate,
+                                                      chrono::steady_clock::time_point now)
+    : mBytes(bytesRate, bytesRate * kBurstSeconds, now),
+      mEvents(eventsRate, eventsRate * kBurstSeconds, now),
+      mLastActiveTime(now) {
+}
+
+InputFlowController::InputFlowController() {
+}
+
+chrono::microseconds InputFlowController::GetWaitTime(const string& configName) {
+    auto now = chrono::steady_clock::now();
+    lock_guard<mutex> lock(mMux);
+    auto& buckets = getBuckets(configName, now);
+    return max(buckets.mBytes.GetWaitTime(now), buckets.mEvents.GetWaitTime(now));
+}
+
+void InputFlowController::ConsumeBytes(const string& configName, size_t bytes) {
+    auto now = chrono::steady_clock::now();
+    lock_guard<mutex> lock(mMux);
+    auto& buckets = getBuckets(configName, now);
+    buckets.mBytes.Consume(bytes, now);
+    buckets.mConsumedBytes += bytes;
+}
+
+void InputFlowController::ConsumeEvents(const string& configName, size_t cnt) {
+    auto now = chrono::steady_clock::now();
+    lock_guard<mutex> lock(mMux);
+    auto& buckets = getBuckets(configName, now);
+    buckets.mEvents.Consume(cnt, now);
+    buckets.mConsumedEvents += cnt;
+}
+
+void InputFlowController::UpdateRate() {
+    updateRate(mProcessorCpuTimeNs.load(memory_order_relaxed),
+               AppConfig::GetInstance()->GetScaledCpuUsageUpLimit(),
+               chrono::steady_clock::now());
+}
+
+void InputFlowController::updateRate(int64_t cpuTimeNs, double cpuBudget, chrono::steady_clock::time_point now) {
+    lock_guard<mutex> lock(mMux);
+    if (mLastUpdateTime == chrono::steady_clock::time_point()) {
+        mLastUpdateTime = now;
+        mLastProcessorCpuTimeNs = cpuTimeNs;
+        return;
+    }
+    double elapsed = chrono::duration<double>(now - mLastUpdateTime).count();
+    if (elapsed <= 0.0 || cpuBudget <= 0.0) {
+        return;
+    }
+    double cpuUsage = (cpuTimeNs - mLastProcessorCpuTimeNs) / 1e9 / elapsed;
+    mLastProcessorCpuTimeNs = cpuTimeNs;
+    mLastUpdateTime = now;
+
+    // PI controller in velocity form on the log of the rates, so that the clamped rates never wind up
+    double error = (cpuBudget - cpuUsage) / cpuBudget;
+    double factor = 1.0 + kProportionalGain * (error - mLastError) + kIntegralGain * error * min(elapsed, 1.0);
+    factor = clamp(factor, kMinAdjustFactor, kMaxAdjustFactor);
+    mLastError = error;
+
+    double maxBytesPerSec
+        = max(static_cast<double>(INT64_FLAG(input_flow_control_max_bytes_per_sec)), kMinBytesPerSec);
+    double maxEventsPerSec
+        = max(static_cast<double>(INT64_FLAG(input_flow_control_max_events_per_sec)), kMinEventsPerSec);
+    auto adjust = [&](TokenBucket& bucket, double& consumed, double minRate, double maxRate) {
+        double base = bucket.GetRate();
+        if (factor < 1.0) {
+            // shrink from what is actually read, a rate far above the throughput would take long to take effect
+            base = min(base, consumed / elapsed);
+        }
+        double rate = clamp(base * factor, minRate, maxRate);
+        bucket.SetRate(rate, rate * kBurstSeconds, now);
+        consumed = 0.0;
+    };
+    for (auto it = mBuckets.begin(); it != mBuckets.end();) {
+        if (now - it->second.mLastActiveTime > kIdleTimeout) {
+            it = mBuckets.erase(it);
+            continue;
+        }
+        adjust(it->second.mBytes, it->second.mConsumedBytes, kMinBytesPerSec, maxBytesPerSec);
+        adjust(it->second.mEvents, it->second.mConsumedEvents, kMinEventsPerSec, maxEventsPerSec);
+        ++it;
+    }
+    LOG_DEBUG(sLogger, ("input flow control cpu usage", cpuUsage)("cpu budget", cpuBudget)("adjust factor", factor));
+}
+
+InputFlowController::PipelineBuckets& InputFlowController::getBuckets(const string& configName,
+                                                                      chrono::steady_clock::time_point now) {
+    auto it = mBuckets.find(configName);
+    if (it == mBuckets.end()) {
+        it = mBuckets
+                 .try_emplace(configName,
+                              static_cast<double>(INT64_FLAG(input_flow_control_max_bytes_per_sec)),
+                              static_cast<double>(INT64_FLAG(input_flow_control_max_events_per_sec)),
+                              now)
+                 .first;
+    }
+    it->second.mLastActiveTime = now;
+    return it->second;
+}
+
+#ifdef APSARA_UNIT_TEST_MAIN
+void InputFlowController::Clear() {
+    lock_guard<mutex> lock(mMux);
+    mBuckets.clear();
+    mLastError = 0.0;
+    mLastUpdateTime = chrono::steady_clock::time_point();
+    mProcessorCpuTimeNs = 0;
+    mLastProcessorCpuTimeNs = 0;
+}
+#endif
+
+} // namespace logtail
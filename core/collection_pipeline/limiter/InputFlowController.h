@@ -0,0 +1,89 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "collection_pipeline/limiter/TokenBucket.h"
+
+namespace logtail {
+
+// InputFlowController paces inputs with a bytes/s and an events/s token bucket per pipeline.
+// Bytes are charged by inputs after each read and events by processor threads after each group, while processor
+// threads also report the cpu time they spend. Every second, the rates of all buckets are adjusted by a PI controller
+// toward the cpu budget of the agent: they shrink toward the observed throughput when processing takes more cpu than
+// the budget, and grow back to the configured max when there is headroom.
+class InputFlowController {
+public:
+    InputFlowController(const InputFlowController&) = delete;
+    InputFlowController& operator=(const InputFlowController&) = delete;
+
+    static InputFlowController* GetInstance() {
+        static InputFlowController instance;
+        return &instance;
+    }
+
+    // time the inputs of the pipeline should wait before reading more
+    std::chrono::microseconds GetWaitTime(const std::string& configName);
+    void ConsumeBytes(const std::string& configName, size_t bytes);
+    void ConsumeEvents(const std::string& configName, size_t cnt);
+
+    void AddProcessorCpuTime(std::chrono::nanoseconds cpuTime) {
+        mProcessorCpuTimeNs.fetch_add(cpuTime.count(), std::memory_order_relaxed);
+    }
+    // should be called periodically
+    void UpdateRate();
+
+private:
+    struct PipelineBuckets {
+        PipelineBuckets(double bytesRate, double eventsRate, std::chrono::steady_clock::time_point now);
+
+        TokenBucket mBytes;
+        TokenBucket mEvents;
+        // consumed since last rate update
+        double mConsumedBytes = 0.0;
+        double mConsumedEvents = 0.0;
+        std::chrono::steady_clock::time_point mLastActiveTime;
+    };
+
+    InputFlowController();
+    ~InputFlowController() = default;
+
+    void updateRate(int64_t cpuTimeNs, double cpuBudget, std::chrono::steady_clock::time_point now);
+    PipelineBuckets& getBuckets(const std::string& configName, std::chrono::steady_clock::time_point now);
+
+    std::mutex mMux;
+    std::unordered_map<std::string, PipelineBuckets> mBuckets;
+    double mLastError = 0.0;
+    std::chrono::steady_clock::time_point mLastUpdateTime;
+
+    std::atomic_int64_t mProcessorCpuTimeNs = 0;
+    int64_t mLastProcessorCpuTimeNs = 0;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    void Clear();
+
+    friend class InputFlowControllerUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -0,0 +1,59 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "collection_pipeline/limiter/TokenBucket.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace logtail {
+
+TokenBucket::TokenBucket(double rate, double burst, chrono::steady_clock::time_point now)
+    : mRate(rate), mBurst(burst), mTokens(burst), mLastRefillTime(now) {
+}
+
+void TokenBucket::SetRate(double rate, double burst, chrono::steady_clock::time_point now) {
+    refill(now);
+    mRate = rate;
+    mBurst = burst;
+    mTokens = min(mTokens, mBurst);
+}
+
+void TokenBucket::Consume(double tokens, chrono::steady_clock::time_point now) {
+    refill(now);
+    mTokens -= tokens;
+}
+
+chrono::microseconds TokenBucket::GetWaitTime(chrono::steady_clock::time_point now) {
+    refill(now);
+    if (mTokens >= 0.0) {
+        return chrono::microseconds(0);
+    }
+    if (mRate <= 0.0) {
+        return chrono::microseconds::max();
+    }
+    return chrono::microseconds(static_cast<int64_t>(-mTokens / mRate * 1000000) + 1);
+}
+
+void TokenBucket::refill(chrono::steady_clock::time_point now) {
+    if (now <= mLastRefillTime) {
+        return;
+    }
+    double elapsed = chrono::duration<double>(now - mLastRefillTime).count();
+    mTokens = min(mBurst, mTokens + elapsed * mRate);
+    mLastRefillTime = now;
+}
+
+} // namespace logtail
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+
+namespace logtail {
+
+// TokenBucket refills continuously at mRate tokens per second up to mBurst tokens.
+// Consume never blocks and may leave the bucket in debt, since the size of a read is only known after it is done. The
+// debt is then paid back by waiting before the next read, which spreads reads evenly over time.
+// not thread-safe
+class TokenBucket {
+public:
+    TokenBucket(double rate, double burst, std::chrono::steady_clock::time_point now);
+
+    void SetRate(double rate, double burst, std::chrono::steady_clock::time_point now);
+    void Consume(double tokens, std::chrono::steady_clock::time_point now);
+    // time to wait until the bucket is out of debt
+    std::chrono::microseconds GetWaitTime(std::chrono::steady_clock::time_point now);
+
+    double GetRate() const { return mRate; }
+
+private:
+    void refill(std::chrono::steady_clock::time_point now);
+
+    double mRate = 0.0;
+    double mBurst = 0.0;
+    double mTokens = 0.0;
+    std::chrono::steady_clock::time_point mLastRefillTime;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class InputFlowControllerUnittest;
+#endif
+};
+
+} // namespace logtail
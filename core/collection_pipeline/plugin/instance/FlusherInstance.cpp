@@ -51,4 +51,15 @@ bool FlusherInstance::Send(PipelineEventGroup&& g) {
     return res;
 }
 
+bool FlusherInstance::Send(shared_ptr<PipelineEventGroup> g) {
+    ADD_COUNTER(mInGroupsTotal, 1);
+    ADD_COUNTER(mInEventsTotal, g->GetEvents().size());
+    ADD_COUNTER(mInSizeBytes, g->DataSize());
+
+    auto before = chrono::system_clock::now();
+    auto res = mPlugin->SendShared(std::move(g));
+    ADD_COUNTER(mTotalPackageTimeMs, chrono::system_clock::now() - before);
+    return res;
+}
+
 } // namespace logtail
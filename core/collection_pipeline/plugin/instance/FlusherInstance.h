@@ -44,6 +44,7 @@ public:
     bool Start() { return mPlugin->Start(); }
     bool Stop(bool isPipelineRemoving) { return mPlugin->Stop(isPipelineRemoving); }
     bool Send(PipelineEventGroup&& g);
+    bool Send(std::shared_ptr<PipelineEventGroup> g);
     bool FlushAll() { return mPlugin->FlushAll(); }
     QueueKey GetQueueKey() const { return mPlugin->GetQueueKey(); }
 
@@ -0,0 +1,226 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "collection_pipeline/plugin/instance/FusedProcessorChain.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+#include "common/Flags.h"
+#include "common/TimeUtil.h"
+#include "runner/ProcessorRunner.h"
+
+DEFINE_FLAG_BOOL(enable_filter_pushdown,
+                 "check the predicates of a fused filter on the raw contents before the processors preceding it",
+                 true);
+DEFINE_FLAG_BOOL(enable_parallel_group_processing,
+                 "process the slices of a large event group on the idle processor threads",
+                 true);
+DEFINE_FLAG_INT32(process_slice_min_size_bytes,
+                  "min size of each slice of an event group processed in parallel",
+                  128 * 1024);
+
+using namespace std;
+
+namespace logtail {
+
+FusedProcessorChain::FusedProcessorChain(ProcessorInstance* splitter, vector<ProcessorInstance*>&& processors)
+    : mSplitter(splitter), mProcessors(std::move(processors)) {
+    if (!BOOL_FLAG(enable_filter_pushdown)) {
+        return;
+    }
+    // only the processors before the filter are skipped, so it is of no use if the filter comes first
+    string unescapedChars;
+    for (size_t i = 0; i < mProcessors.size(); ++i) {
+        if (i > 0 && mProcessors[i]->GetPlugin()->InitPushdownFilter(unescapedChars)) {
+            mPushdownFilterIdx = i;
+            break;
+        }
+        if (!mProcessors[i]->GetPlugin()->KeepsContentSubstrings(unescapedChars)) {
+            break;
+        }
+    }
+}
+
+chrono::nanoseconds FusedProcessorChain::Process(vector<PipelineEventGroup>& logGroupList) {
+    int64_t otherThreadsCpuTimeNs = 0;
+    for (auto& logGroup : logGroupList) {
+        otherThreadsCpuTimeNs += Process(logGroup);
+    }
+    return chrono::nanoseconds(otherThreadsCpuTimeNs);
+}
+
+int64_t FusedProcessorChain::Process(PipelineEventGroup& logGroup) {
+    if (logGroup.GetEvents().empty()) {
+        return 0;
+    }
+    auto before = chrono::system_clock::now();
+    auto cpuTimeNs = GetThreadCpuTimeNs();
+
+    size_t sliceCnt = GetSliceCnt(logGroup);
+    vector<FusedEventCache> caches(mProcessors.size() + 1);
+    StringView logPath = logGroup.GetMetadata(EventGroupMetaKey::LOG_FILE_PATH_RESOLVED);
+    for (auto& cache : caches) {
+        cache.mLogPath = logPath;
+    }
+    StageMetrics chainMetrics;
+    vector<StageMetrics> metrics(mProcessors.size());
+    int64_t otherThreadsCpuTimeNs = 0;
+
+    if (mSplitter) {
+        uint64_t inEvents = logGroup.GetEvents().size();
+        uint64_t inSize = logGroup.DataSize();
+        EventsContainer newEvents;
+        for (PipelineEventPtr& e : logGroup.MutableEvents()) {
+            size_t begin = newEvents.size();
+            mSplitter->GetPlugin()->SplitFusedEvent(logGroup, std::move(e), newEvents, caches.back());
+            if (sliceCnt <= 1) {
+                newEvents.resize(ProcessEvents(logGroup, newEvents, begin, caches, chainMetrics, metrics));
+            }
+        }
+        logGroup.SwapEvents(newEvents);
+        if (sliceCnt > 1) {
+            otherThreadsCpuTimeNs = ProcessSlices(logGroup, sliceCnt, chainMetrics, metrics);
+        }
+        mSplitter->AddFusedMetrics(inEvents, inSize, chainMetrics.mInEvents, chainMetrics.mInSize);
+    } else if (sliceCnt > 1) {
+        otherThreadsCpuTimeNs = ProcessSlices(logGroup, sliceCnt, chainMetrics, metrics);
+    } else {
+        EventsContainer& events = logGroup.MutableEvents();
+        events.resize(ProcessEvents(logGroup, events, 0, caches, chainMetrics, metrics));
+    }
+
+    for (size_t i = 0; i < mProcessors.size(); ++i) {
+        mProcessors[i]->AddFusedMetrics(
+            metrics[i].mInEvents, metrics[i].mInSize, metrics[i].mOutEvents, metrics[i].mOutSize);
+    }
+    // stages are interleaved per event, so the time of the whole chain is reported on the leading one
+    auto* leading = mSplitter ? mSplitter : mProcessors[0];
+    leading->AddFusedTime(chrono::system_clock::now() - before,
+                          chrono::nanoseconds(GetThreadCpuTimeNs() - cpuTimeNs + otherThreadsCpuTimeNs));
+    return otherThreadsCpuTimeNs;
+}
+
+size_t FusedProcessorChain::GetSliceCnt(const PipelineEventGroup& logGroup) const {
+    if (!BOOL_FLAG(enable_parallel_group_processing)) {
+        return 1;
+    }
+    size_t threadCnt = ProcessorRunner::GetInstance()->GetThreadCount();
+    if (threadCnt <= 1) {
+        return 1;
+    }
+    return min(threadCnt, logGroup.DataSize() / max(INT32_FLAG(process_slice_min_size_bytes), 1));
+}
+
+int64_t FusedProcessorChain::ProcessSlices(PipelineEventGroup& logGroup,
+                                           size_t sliceCnt,
+                                           StageMetrics& chainMetrics,
+                                           vector<StageMetrics>& metrics) {
+    EventsContainer& events = logGroup.MutableEvents();
+    sliceCnt = min(sliceCnt, events.size());
+    vector<PipelineEventGroup> slices;
+    slices.reserve(sliceCnt);
+    for (size_t i = 0, begin = 0; i < sliceCnt; ++i) {
+        size_t end = events.size() * (i + 1) / sliceCnt;
+        slices.emplace_back(logGroup.CreateSlice(begin, end));
+        begin = end;
+    }
+    events.clear();
+
+    vector<StageMetrics> sliceChainMetrics(sliceCnt);
+    vector<vector<StageMetrics>> sliceMetrics(sliceCnt, vector<StageMetrics>(mProcessors.size()));
+    vector<int64_t> sliceCpuTimeNs(sliceCnt, 0);
+    auto callerId = this_thread::get_id();
+    vector<function<void()>> tasks;
+    tasks.reserve(sliceCnt);
+    for (size_t i = 0; i < sliceCnt; ++i) {
+        tasks.emplace_back([&, i]() {
+            auto cpuTimeNs = GetThreadCpuTimeNs();
+            auto& slice = slices[i];
+            vector<FusedEventCache> caches(mProcessors.size());
+            StringView logPath = slice.GetMetadata(EventGroupMetaKey::LOG_FILE_PATH_RESOLVED);
+            for (auto& cache : caches) {
+                cache.mLogPath = logPath;
+            }
+            auto& sliceEvents = slice.MutableEvents();
+            sliceEvents.resize(ProcessEvents(slice, sliceEvents, 0, caches, sliceChainMetrics[i], sliceMetrics[i]));
+            if (this_thread::get_id() != callerId) {
+                sliceCpuTimeNs[i] = GetThreadCpuTimeNs() - cpuTimeNs;
+            }
+        });
+    }
+    ProcessorRunner::GetInstance()->RunTasks(std::move(tasks));
+
+    // slices are merged back in order, so that the group leaves the chain as a whole with its checkpoint
+    int64_t otherThreadsCpuTimeNs = 0;
+    for (size_t i = 0; i < sliceCnt; ++i) {
+        logGroup.MergeSlice(std::move(slices[i]));
+        chainMetrics.mInEvents += sliceChainMetrics[i].mInEvents;
+        chainMetrics.mInSize += sliceChainMetrics[i].mInSize;
+        for (size_t j = 0; j < mProcessors.size(); ++j) {
+            metrics[j].mInEvents += sliceMetrics[i][j].mInEvents;
+            metrics[j].mInSize += sliceMetrics[i][j].mInSize;
+            metrics[j].mOutEvents += sliceMetrics[i][j].mOutEvents;
+            metrics[j].mOutSize += sliceMetrics[i][j].mOutSize;
+        }
+        otherThreadsCpuTimeNs += sliceCpuTimeNs[i];
+    }
+    return otherThreadsCpuTimeNs;
+}
+
+size_t FusedProcessorChain::ProcessEvents(PipelineEventGroup& logGroup,
+                                          EventsContainer& events,
+                                          size_t begin,
+                                          vector<FusedEventCache>& caches,
+                                          StageMetrics& chainMetrics,
+                                          vector<StageMetrics>& metrics) {
+    size_t wIdx = begin;
+    for (size_t rIdx = begin; rIdx < events.size(); ++rIdx) {
+        PipelineEventPtr& e = events[rIdx];
+        size_t size = e->DataSize();
+        ++chainMetrics.mInEvents;
+        chainMetrics.mInSize += size;
+        bool kept = true;
+        if (mPushdownFilterIdx != 0 && !mProcessors[mPushdownFilterIdx]->GetPlugin()->PushdownFilterEvent(e)) {
+            // the event is accounted as discarded by the filter, skipping the processors in between
+            ++metrics[mPushdownFilterIdx].mInEvents;
+            metrics[mPushdownFilterIdx].mInSize += size;
+            continue;
+        }
+        for (size_t i = 0; i < mProcessors.size(); ++i) {
+            ++metrics[i].mInEvents;
+            metrics[i].mInSize += size;
+            if (!mProcessors[i]->GetPlugin()->ProcessFusedEvent(logGroup, e, caches[i])) {
+                kept = false;
+                break;
+            }
+            size = e->DataSize();
+            ++metrics[i].mOutEvents;
+            metrics[i].mOutSize += size;
+        }
+        if (kept) {
+            if (wIdx != rIdx) {
+                events[wIdx] = std::move(e);
+            }
+            ++wIdx;
+        }
+    }
+    return wIdx;
+}
+
+} // namespace logtail
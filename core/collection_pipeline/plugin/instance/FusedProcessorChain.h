@@ -0,0 +1,85 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <chrono>
+#include <vector>
+
+#include "collection_pipeline/plugin/instance/ProcessorInstance.h"
+#include "models/PipelineEventGroup.h"
+
+namespace logtail {
+
+// FusedProcessorChain runs an optional splitter and the fusable processors following it in a single pass: each event
+// goes through all the processors before the next one is handled, instead of each processor making a full pass over
+// the events of the group. The events split from one source event are appended to the final container directly, and
+// an event discarded by a processor never reaches the following ones.
+//
+// The predicates of a filter in the chain are pushed down in front of the processors preceding it when possible, see
+// Processor::InitPushdownFilter, so that the events it would discard are not parsed at all.
+//
+// A large group is split first and then processed in slices, which the idle processor threads can take over, see
+// ProcessorRunner::RunTasks.
+class FusedProcessorChain {
+public:
+    // @param splitter can be null, otherwise it is the only inner processor of the input
+    FusedProcessorChain(ProcessorInstance* splitter, std::vector<ProcessorInstance*>&& processors);
+
+    /// @return the cpu time spent by the other threads processing the slices of the groups
+    std::chrono::nanoseconds Process(std::vector<PipelineEventGroup>& logGroupList);
+
+    bool HasSplitter() const { return mSplitter != nullptr; }
+    // number of processors at the beginning of the processor line taken over by the chain
+    size_t GetProcessorCnt() const { return mProcessors.size(); }
+    bool HasPushdownFilter() const { return mPushdownFilterIdx != 0; }
+
+private:
+    struct StageMetrics {
+        uint64_t mInEvents = 0;
+        uint64_t mInSize = 0;
+        uint64_t mOutEvents = 0;
+        uint64_t mOutSize = 0;
+    };
+
+    int64_t Process(PipelineEventGroup& logGroup);
+    size_t GetSliceCnt(const PipelineEventGroup& logGroup) const;
+    /// @return the cpu time spent by the other threads
+    int64_t ProcessSlices(PipelineEventGroup& logGroup,
+                          size_t sliceCnt,
+                          StageMetrics& chainMetrics,
+                          std::vector<StageMetrics>& metrics);
+    // @return the end of the events kept in [begin, events.size())
+    size_t ProcessEvents(PipelineEventGroup& logGroup,
+                         EventsContainer& events,
+                         size_t begin,
+                         std::vector<FusedEventCache>& caches,
+                         StageMetrics& chainMetrics,
+                         std::vector<StageMetrics>& metrics);
+
+    ProcessorInstance* mSplitter = nullptr;
+    std::vector<ProcessorInstance*> mProcessors;
+    // index of the processor whose predicates are checked before the chain, 0 if none
+    size_t mPushdownFilterIdx = 0;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class FusedProcessorChainUnittest;
+#endif
+};
+
+} // namespace logtail
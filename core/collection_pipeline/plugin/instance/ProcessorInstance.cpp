@@ -39,6 +39,7 @@ bool ProcessorInstance::Init(const Json::Value& config, CollectionPipelineContex
     mInSizeBytes = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_IN_SIZE_BYTES);
     mOutSizeBytes = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_SIZE_BYTES);
     mTotalProcessTimeMs = mPlugin->GetMetricsRecordRef().CreateTimeCounter(METRIC_PLUGIN_TOTAL_PROCESS_TIME_MS);
+    mTotalCpuTimeMs = mPlugin->GetMetricsRecordRef().CreateTimeCounter(METRIC_PLUGIN_TOTAL_CPU_TIME_MS);
     mPlugin->CommitMetricsRecordRef();
     return true;
 }
@@ -53,7 +54,9 @@ void ProcessorInstance::Process(vector<PipelineEventGroup>& eventGroupList) {
     }
 
     auto before = chrono::system_clock::now();
+    auto cpuTimeNs = GetThreadCpuTimeNs();
     mPlugin->Process(eventGroupList);
+    ADD_COUNTER(mTotalCpuTimeMs, chrono::nanoseconds(GetThreadCpuTimeNs() - cpuTimeNs));
     ADD_COUNTER(mTotalProcessTimeMs, chrono::system_clock::now() - before);
 
     for (const auto& eventGroup : eventGroupList) {
@@ -62,4 +65,16 @@ void ProcessorInstance::Process(vector<PipelineEventGroup>& eventGroupList) {
     }
 }
 
+void ProcessorInstance::AddFusedMetrics(uint64_t inEvents, uint64_t inSize, uint64_t outEvents, uint64_t outSize) {
+    ADD_COUNTER(mInEventsTotal, inEvents);
+    ADD_COUNTER(mInSizeBytes, inSize);
+    ADD_COUNTER(mOutEventsTotal, outEvents);
+    ADD_COUNTER(mOutSizeBytes, outSize);
+}
+
+void ProcessorInstance::AddFusedTime(chrono::nanoseconds processTime, chrono::nanoseconds cpuTime) {
+    ADD_COUNTER(mTotalProcessTimeMs, processTime);
+    ADD_COUNTER(mTotalCpuTimeMs, cpuTime);
+}
+
 } // namespace logtail
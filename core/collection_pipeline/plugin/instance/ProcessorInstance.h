@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
 
 #include "json/json.h"
@@ -34,9 +35,15 @@ public:
 
     const std::string& Name() const override { return mPlugin->Name(); };
 
+    Processor* GetPlugin() const { return mPlugin.get(); }
+
     bool Init(const Json::Value& config, CollectionPipelineContext& context);
     void Process(std::vector<PipelineEventGroup>& logGroupList);
 
+    // metrics of processors in a fused chain are accounted by the chain
+    void AddFusedMetrics(uint64_t inEvents, uint64_t inSize, uint64_t outEvents, uint64_t outSize);
+    void AddFusedTime(std::chrono::nanoseconds processTime, std::chrono::nanoseconds cpuTime);
+
 private:
     std::unique_ptr<Processor> mPlugin;
 
@@ -45,9 +52,11 @@ private:
     CounterPtr mInSizeBytes;
     CounterPtr mOutSizeBytes;
     TimeCounterPtr mTotalProcessTimeMs;
+    TimeCounterPtr mTotalCpuTimeMs;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ProcessorInstanceUnittest;
+    friend class FusedProcessorChainUnittest;
     friend class ProcessorParseRegexNativeUnittest;
     friend class ProcessorParseTimestampNativeUnittest;
     friend class ProcessorParseJsonNativeUnittest;
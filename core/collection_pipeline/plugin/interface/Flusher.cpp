@@ -25,6 +25,7 @@ namespace logtail {
 
 bool Flusher::Start() {
     SenderQueueManager::GetInstance()->ReuseQueue(mQueueKey);
+    SenderQueueManager::GetInstance()->StartSpillReplay(mQueueKey, this);
     return true;
 }
 
@@ -35,6 +36,13 @@ bool Flusher::Stop(bool isPipelineRemoving) {
     return true;
 }
 
+bool Flusher::SendShared(shared_ptr<PipelineEventGroup> g) {
+    if (g.use_count() == 1) {
+        return Send(std::move(*g));
+    }
+    return Send(g->Copy());
+}
+
 void Flusher::SetPipelineForItemsWhenStop() {
     if (HasContext()) {
         const auto& pipeline = CollectionPipelineManager::GetInstance()->FindConfigByName(mContext->GetConfigName());
@@ -38,6 +38,12 @@ public:
     virtual bool Start();
     virtual bool Stop(bool isPipelineRemoving);
     virtual bool Send(PipelineEventGroup&& g) = 0;
+    // g may also be routed to other flushers of the pipeline. By default, the group is copied only if someone else
+    // still holds it when the flusher needs to own it, so the last holder takes it over without copying. Flushers that
+    // only read the group, e.g., flusher_file, override it to never copy.
+    virtual bool SendShared(std::shared_ptr<PipelineEventGroup> g);
+    // flushers that never modify nor take over a shared group are served before the others
+    virtual bool IsSharedGroupReadOnly() const { return false; }
     virtual bool Flush(size_t key) = 0;
     virtual bool FlushAll() = 0;
 
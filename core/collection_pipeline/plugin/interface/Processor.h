@@ -19,11 +19,19 @@
 #include "json/json.h"
 
 #include "collection_pipeline/plugin/interface/Plugin.h"
+#include "common/TimeUtil.h"
 #include "models/PipelineEventGroup.h"
 #include "models/PipelineEventPtr.h"
 
 namespace logtail {
 
+// state kept by a processor across the events of a group during a fused pass
+struct FusedEventCache {
+    StringView mLogPath;
+    LogtailTime mLogTime = {0, 0};
+    StringView mTimeStr;
+};
+
 class Processor : public Plugin {
 public:
     virtual ~Processor() {}
@@ -31,6 +39,32 @@ public:
     virtual bool Init(const Json::Value& config) = 0;
     virtual void Process(std::vector<PipelineEventGroup>& logGroupList);
 
+    // Processors handling each event on its own can be fused with the adjacent ones into a single pass over the
+    // events of a group, see FusedProcessorChain. A fused chain may be led by a splitter.
+    virtual bool IsFusable() const { return false; }
+    virtual bool IsFusableSplitter() const { return false; }
+    /// @return false if the event should be discarded
+    virtual bool ProcessFusedEvent(PipelineEventGroup& logGroup, PipelineEventPtr& e, FusedEventCache& cache) {
+        return true;
+    }
+    // appends the events split from e to newEvents
+    virtual void SplitFusedEvent(PipelineEventGroup& logGroup,
+                                 PipelineEventPtr&& e,
+                                 EventsContainer& newEvents,
+                                 FusedEventCache& cache) {
+        newEvents.emplace_back(std::move(e));
+    }
+
+    // Predicate pushdown in a fused chain: the predicates of a filter placed after processors which only add contents
+    // that are substrings of the existing ones, e.g. parsers extracting fields from a line, can be checked on the raw
+    // contents first, so that the events to be discarded skip these processors.
+    /// @param unescapedChars appended with the chars whose escaping may be removed in the added contents, e.g. quotes
+    virtual bool KeepsContentSubstrings(std::string& unescapedChars) const { return false; }
+    /// @return true if the processor has predicates that can be checked before the preceding processors
+    virtual bool InitPushdownFilter(const std::string& unescapedChars) { return false; }
+    /// @return false if the event would be discarded by the processor whatever the preceding processors do with it
+    virtual bool PushdownFilterEvent(const PipelineEventPtr& e) { return true; }
+
 protected:
     virtual bool IsSupportedEvent(const PipelineEventPtr& e) const = 0;
     virtual void Process(PipelineEventGroup& logGroup) = 0;
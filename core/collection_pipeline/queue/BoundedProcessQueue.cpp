@@ -44,6 +44,7 @@ bool BoundedProcessQueue::Push(unique_ptr<ProcessQueueItem>&& item) {
     ADD_COUNTER(mInItemDataSizeBytes, size);
     SET_GAUGE(mQueueSizeTotal, Size());
     ADD_COUNTER(mQueueDataSizeByte, size);
+    AddAccountedDataSize(size);
     SET_GAUGE(mValidToPushFlag, IsValidToPush());
     return true;
 }
@@ -65,9 +66,12 @@ bool BoundedProcessQueue::Pop(unique_ptr<ProcessQueueItem>& item) {
     }
 
     ADD_COUNTER(mOutItemsTotal, 1);
-    ADD_COUNTER(mTotalDelayMs, chrono::system_clock::now() - item->mEnqueTime);
+    auto delay = chrono::system_clock::now() - item->mEnqueTime;
+    ADD_COUNTER(mTotalDelayMs, delay);
+    OBSERVE_HISTOGRAM(mLatencyMs, delay);
     SET_GAUGE(mQueueSizeTotal, Size());
     SUB_GAUGE(mQueueDataSizeByte, item->mEventGroup.DataSize());
+    SubAccountedDataSize(item->mEventGroup.DataSize());
     SET_GAUGE(mValidToPushFlag, IsValidToPush());
     return true;
 }
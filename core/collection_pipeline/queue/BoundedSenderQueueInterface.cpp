@@ -14,6 +14,8 @@
 
 #include "collection_pipeline/queue/BoundedSenderQueueInterface.h"
 
+#include "common/memory/MemoryAccountant.h"
+
 
 using namespace std;
 
@@ -32,6 +34,10 @@ BoundedSenderQueueInterface::BoundedSenderQueueInterface(
     mExtraBufferDataSizeBytes = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_QUEUE_EXTRA_BUFFER_SIZE_BYTES);
 }
 
+BoundedSenderQueueInterface::~BoundedSenderQueueInterface() {
+    MemoryAccountant::GetInstance()->Sub(MemoryCategory::SENDER_QUEUE, mAccountedDataSize);
+}
+
 void BoundedSenderQueueInterface::SetFeedback(FeedbackInterface* feedback) {
     if (feedback == nullptr) {
         // should not happen
@@ -81,4 +87,14 @@ void BoundedSenderQueueInterface::Reset(size_t cap, size_t low, size_t high) {
     QueueInterface::Reset(cap);
 }
 
+void BoundedSenderQueueInterface::AddAccountedDataSize(size_t size) {
+    mAccountedDataSize += size;
+    MemoryAccountant::GetInstance()->Add(MemoryCategory::SENDER_QUEUE, size);
+}
+
+void BoundedSenderQueueInterface::SubAccountedDataSize(size_t size) {
+    mAccountedDataSize -= size;
+    MemoryAccountant::GetInstance()->Sub(MemoryCategory::SENDER_QUEUE, size);
+}
+
 } // namespace logtail
@@ -44,6 +44,7 @@ public:
                                 QueueKey key,
                                 const std::string& flusherId,
                                 const CollectionPipelineContext& ctx);
+    ~BoundedSenderQueueInterface() override;
 
     bool Pop(std::unique_ptr<SenderQueueItem>& item) override { return false; }
 
@@ -69,6 +70,10 @@ protected:
 
     void GiveFeedback() const override;
     void Reset(size_t cap, size_t low, size_t high);
+    // data held in memory by the queue is reported to the memory accountant, and whatever remains is given back on
+    // destruction
+    void AddAccountedDataSize(size_t size);
+    void SubAccountedDataSize(size_t size);
 
     std::optional<RateLimiter> mRateLimiter;
     std::vector<std::pair<std::shared_ptr<ConcurrencyLimiter>, CounterPtr>> mConcurrencyLimiters;
@@ -82,6 +87,8 @@ protected:
 private:
     virtual void PushFromExtraBuffer(std::unique_ptr<SenderQueueItem>&& item) = 0;
 
+    size_t mAccountedDataSize = 0;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class FlusherUnittest;
 #endif
@@ -41,6 +41,7 @@ bool CircularProcessQueue::Push(unique_ptr<ProcessQueueItem>&& item) {
         mQueue.pop_front();
         SET_GAUGE(mQueueSizeTotal, Size());
         SUB_GAUGE(mQueueDataSizeByte, size);
+        SubAccountedDataSize(size);
         ADD_COUNTER(mDiscardedEventsTotal, cnt);
     }
     if (mEventCnt + newCnt > mCapacity) {
@@ -55,6 +56,7 @@ bool CircularProcessQueue::Push(unique_ptr<ProcessQueueItem>&& item) {
     ADD_COUNTER(mInItemDataSizeBytes, size);
     SET_GAUGE(mQueueSizeTotal, Size());
     ADD_GAUGE(mQueueDataSizeByte, size);
+    AddAccountedDataSize(size);
     return true;
 }
 
@@ -73,9 +75,12 @@ bool CircularProcessQueue::Pop(unique_ptr<ProcessQueueItem>& item) {
     mEventCnt -= item->mEventGroup.GetEvents().size();
 
     ADD_COUNTER(mOutItemsTotal, 1);
-    ADD_COUNTER(mTotalDelayMs, std::chrono::system_clock::now() - item->mEnqueTime);
+    auto delay = std::chrono::system_clock::now() - item->mEnqueTime;
+    ADD_COUNTER(mTotalDelayMs, delay);
+    OBSERVE_HISTOGRAM(mLatencyMs, delay);
     SET_GAUGE(mQueueSizeTotal, Size());
     SUB_GAUGE(mQueueDataSizeByte, item->mEventGroup.DataSize());
+    SubAccountedDataSize(item->mEventGroup.DataSize());
     return true;
 }
 
@@ -85,6 +90,7 @@ void CircularProcessQueue::Reset(size_t cap) {
     uint32_t cnt = 0;
     while (!mQueue.empty() && mEventCnt > cap) {
         mEventCnt -= mQueue.front()->mEventGroup.GetEvents().size();
+        SubAccountedDataSize(mQueue.front()->mEventGroup.DataSize());
         mQueue.pop_front();
         ++cnt;
     }
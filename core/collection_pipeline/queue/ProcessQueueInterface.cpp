@@ -15,6 +15,7 @@
 #include "collection_pipeline/queue/ProcessQueueInterface.h"
 
 #include "collection_pipeline/queue/BoundedSenderQueueInterface.h"
+#include "common/memory/MemoryAccountant.h"
 
 using namespace std;
 
@@ -30,6 +31,10 @@ ProcessQueueInterface::ProcessQueueInterface(int64_t key,
     mValidFetchTimesCnt = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_QUEUE_VALID_FETCH_TIMES_TOTAL);
 }
 
+ProcessQueueInterface::~ProcessQueueInterface() {
+    MemoryAccountant::GetInstance()->Sub(MemoryCategory::PROCESS_QUEUE, mAccountedDataSize);
+}
+
 void ProcessQueueInterface::SetDownStreamQueues(vector<BoundedSenderQueueInterface*>&& ques) {
     mDownStreamQueues.clear();
     for (auto& item : ques) {
@@ -45,6 +50,16 @@ bool ProcessQueueInterface::IsValidToPop() const {
     return mValidToPop && IsDownStreamQueuesValidToPush();
 }
 
+void ProcessQueueInterface::AddAccountedDataSize(size_t size) {
+    mAccountedDataSize += size;
+    MemoryAccountant::GetInstance()->Add(MemoryCategory::PROCESS_QUEUE, size);
+}
+
+void ProcessQueueInterface::SubAccountedDataSize(size_t size) {
+    mAccountedDataSize -= size;
+    MemoryAccountant::GetInstance()->Sub(MemoryCategory::PROCESS_QUEUE, size);
+}
+
 bool ProcessQueueInterface::IsDownStreamQueuesValidToPush() const {
     // TODO: support other strategy
     for (const auto& q : mDownStreamQueues) {
@@ -33,7 +33,7 @@ class BoundedSenderQueueInterface;
 class ProcessQueueInterface : virtual public QueueInterface<std::unique_ptr<ProcessQueueItem>> {
 public:
     ProcessQueueInterface(int64_t key, size_t cap, uint32_t priority, const CollectionPipelineContext& ctx);
-    virtual ~ProcessQueueInterface() = default;
+    virtual ~ProcessQueueInterface();
 
     void SetPriority(uint32_t priority) { mPriority = priority; }
     uint32_t GetPriority() const { return mPriority; }
@@ -50,6 +50,9 @@ public:
 
 protected:
     bool IsValidToPop() const;
+    // data held by the queue is reported to the memory accountant, and whatever remains is given back on destruction
+    void AddAccountedDataSize(size_t size);
+    void SubAccountedDataSize(size_t size);
 
     CounterPtr mFetchTimesCnt;
     CounterPtr mValidFetchTimesCnt;
@@ -62,6 +65,7 @@ private:
 
     std::vector<BoundedSenderQueueInterface*> mDownStreamQueues;
     bool mValidToPop = false;
+    size_t mAccountedDataSize = 0;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class BoundedProcessQueueUnittest;
@@ -19,6 +19,7 @@
 #include "collection_pipeline/queue/ExactlyOnceQueueManager.h"
 #include "collection_pipeline/queue/QueueKeyManager.h"
 #include "common/Flags.h"
+#include "common/memory/MemoryAccountant.h"
 
 DEFINE_FLAG_INT32(bounded_process_queue_capacity, "", 5);
 
@@ -102,6 +103,11 @@ bool ProcessQueueManager::IsValidToPush(QueueKey key) const {
     lock_guard<mutex> lock(mQueueMux);
     auto iter = mQueues.find(key);
     if (iter != mQueues.end()) {
+        if (MemoryAccountant::GetInstance()->IsUnderPressure(MemoryPressureLevel::PAUSE_INPUT)
+            && IsLowestPriorityInUse((*iter->second.first)->GetPriority())) {
+            // memory is short, inputs of the least important pipelines wait until it is released
+            return false;
+        }
         if (iter->second.second == QueueType::BOUNDED) {
             return static_cast<BoundedProcessQueue*>(iter->second.first->get())->IsValidToPush();
         } else {
@@ -111,6 +117,21 @@ bool ProcessQueueManager::IsValidToPush(QueueKey key) const {
     return ExactlyOnceQueueManager::GetInstance()->IsValidToPushProcessQueue(key);
 }
 
+bool ProcessQueueManager::IsLowestPriorityInUse(uint32_t priority) const {
+    for (uint32_t i = sMaxPriority; i > priority; --i) {
+        if (!mPriorityQueue[i].empty()) {
+            return false;
+        }
+    }
+    // pausing the only priority in use would pause all inputs, including the most important ones
+    for (uint32_t i = 0; i < priority; ++i) {
+        if (!mPriorityQueue[i].empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 QueueStatus ProcessQueueManager::PushQueue(QueueKey key, unique_ptr<ProcessQueueItem>&& item) {
     {
         lock_guard<mutex> lock(mQueueMux);
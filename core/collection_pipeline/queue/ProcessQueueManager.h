@@ -81,6 +81,8 @@ private:
     void AdjustQueuePriority(const ProcessQueueIterator& iter, uint32_t priority);
     void DeleteQueueEntity(const ProcessQueueIterator& iter);
     void ResetCurrentQueueIndex();
+    // true if priority is the lowest of at least two priorities in use
+    bool IsLowestPriorityInUse(uint32_t priority) const;
 
     BoundedQueueParam mBoundedQueueParam;
 
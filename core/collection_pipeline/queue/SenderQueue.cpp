@@ -14,8 +14,18 @@
 
 #include "collection_pipeline/queue/SenderQueue.h"
 
+#include "common/Flags.h"
+#include "common/memory/MemoryAccountant.h"
 #include "logger/Logger.h"
 
+DEFINE_FLAG_INT64(sender_queue_spill_threshold_bytes,
+                  "extra buffer size of a sender queue beyond which items are spilled to disk",
+                  16 * 1024 * 1024);
+DEFINE_FLAG_INT64(sender_queue_spill_commit_bytes, "spilled data size that triggers a group commit", 1024 * 1024);
+DEFINE_FLAG_INT64(sender_queue_spill_segment_size_bytes,
+                  "max size of a sender queue spill segment file",
+                  64 * 1024 * 1024);
+
 using namespace std;
 
 namespace logtail {
@@ -27,6 +37,8 @@ SenderQueue::SenderQueue(
     mFetchTimesCnt = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_QUEUE_FETCH_TIMES_TOTAL);
     mValidFetchTimesCnt = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_QUEUE_VALID_FETCH_TIMES_TOTAL);
     mFetchedItemsCnt = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_QUEUE_FETCHED_ITEMS_TOTAL);
+    mSpillBufferSize = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_QUEUE_SPILL_BUFFER_SIZE);
+    mSpillBufferDataSizeBytes = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_QUEUE_SPILL_BUFFER_SIZE_BYTES);
     WriteMetrics::GetInstance()->CommitMetricsRecordRef(mMetricsRecordRef);
 }
 
@@ -37,8 +49,33 @@ bool SenderQueue::Push(unique_ptr<SenderQueueItem>&& item) {
     ADD_COUNTER(mInItemsTotal, 1);
     ADD_COUNTER(mInItemDataSizeBytes, size);
 
+    if (mSpillStore) {
+        if (!mSpillReplayStopped) {
+            // queues created on demand are never started explicitly
+            mSpillFlusher = item->mFlusher;
+        }
+        // spilled items are older, so they take the free slots first
+        while (!Full() && PushFromSpillStore()) {
+        }
+        bool overflowed = Full()
+            && (mExtraBufferDataSize + size > static_cast<size_t>(INT64_FLAG(sender_queue_spill_threshold_bytes))
+                || MemoryAccountant::GetInstance()->IsUnderPressure(MemoryPressureLevel::SPILL_SENDER_QUEUE));
+        if (SenderQueueSpillStore::CanSpill(*item) && (overflowed || !mSpillStore->Empty())) {
+            // once spilling starts, later items go to disk too until all spilled ones are taken back, so that the
+            // order is kept
+            mSpillStore->Append(*item);
+            if (mSpillStore->PendingSizeBytes() >= static_cast<size_t>(INT64_FLAG(sender_queue_spill_commit_bytes))) {
+                mSpillStore->Commit();
+            }
+            UpdateSpillMetrics();
+            return true;
+        }
+    }
+
     if (Full()) {
         mExtraBuffer.push_back(std::move(item));
+        mExtraBufferDataSize += size;
+        AddAccountedDataSize(size);
 
         SET_GAUGE(mExtraBufferSize, mExtraBuffer.size());
         ADD_GAUGE(mExtraBufferDataSizeBytes, size);
@@ -60,6 +97,7 @@ bool SenderQueue::Push(unique_ptr<SenderQueueItem>&& item) {
 
     SET_GAUGE(mQueueSizeTotal, Size());
     ADD_GAUGE(mQueueDataSizeByte, size);
+    AddAccountedDataSize(size);
     SET_GAUGE(mValidToPushFlag, IsValidToPush());
     return true;
 }
@@ -89,18 +127,25 @@ bool SenderQueue::Remove(SenderQueueItem* item) {
     --mSize;
 
     ADD_COUNTER(mOutItemsTotal, 1);
-    ADD_COUNTER(mTotalDelayMs, chrono::system_clock::now() - enQueuTime);
+    auto delay = chrono::system_clock::now() - enQueuTime;
+    ADD_COUNTER(mTotalDelayMs, delay);
+    OBSERVE_HISTOGRAM(mLatencyMs, delay);
     SUB_GAUGE(mQueueDataSizeByte, size);
+    SubAccountedDataSize(size);
 
     if (!mExtraBuffer.empty()) {
         auto newSize = mExtraBuffer.front()->mData.size();
         PushFromExtraBuffer(std::move(mExtraBuffer.front()));
         mExtraBuffer.pop_front();
+        mExtraBufferDataSize -= newSize;
 
         SET_GAUGE(mExtraBufferSize, mExtraBuffer.size());
         SUB_GAUGE(mExtraBufferDataSizeBytes, newSize);
         return true;
     }
+    if (PushFromSpillStore()) {
+        return true;
+    }
     if (ChangeStateIfNeededAfterPop()) {
         GiveFeedback();
     }
@@ -112,6 +157,12 @@ bool SenderQueue::Remove(SenderQueueItem* item) {
 
 void SenderQueue::GetAvailableItems(vector<SenderQueueItem*>& items, int32_t limit) {
     ADD_COUNTER(mFetchTimesCnt, 1);
+    if (mExtraBuffer.empty()) {
+        // slots left by failed replays or a late flusher are filled here, replayed items then go through the limiters
+        // like any other item
+        while (!Full() && PushFromSpillStore()) {
+        }
+    }
     if (Empty()) {
         return;
     }
@@ -197,6 +248,55 @@ void SenderQueue::SetPipelineForItems(const std::shared_ptr<CollectionPipeline>&
     }
 }
 
+bool SenderQueue::EnableSpill(const filesystem::path& dir) {
+    auto store = make_unique<SenderQueueSpillStore>(dir, INT64_FLAG(sender_queue_spill_segment_size_bytes));
+    if (!store->Open()) {
+        mSpillUnavailable = true;
+        LOG_WARNING(sLogger,
+                    ("failed to enable sender queue spill", "keep overflowed items in memory")("dir", dir.string()));
+        return false;
+    }
+    mSpillStore = std::move(store);
+    UpdateSpillMetrics();
+    return true;
+}
+
+void SenderQueue::CommitSpill() {
+    if (mSpillStore) {
+        mSpillStore->Commit();
+    }
+}
+
+void SenderQueue::StartSpillReplay(Flusher* flusher) {
+    mSpillFlusher = flusher;
+    mSpillReplayStopped = false;
+}
+
+void SenderQueue::StopSpillReplay() {
+    mSpillFlusher = nullptr;
+    mSpillReplayStopped = true;
+}
+
+bool SenderQueue::PushFromSpillStore() {
+    if (!mSpillStore || mSpillStore->Empty() || mSpillFlusher == nullptr) {
+        return false;
+    }
+    auto item = mSpillStore->Pop(mSpillFlusher, mKey);
+    UpdateSpillMetrics();
+    if (!item) {
+        return false;
+    }
+    item->mFirstEnqueTime = chrono::system_clock::now();
+    AddAccountedDataSize(item->mData.size());
+    PushFromExtraBuffer(std::move(item));
+    return true;
+}
+
+void SenderQueue::UpdateSpillMetrics() {
+    SET_GAUGE(mSpillBufferSize, mSpillStore->Size());
+    SET_GAUGE(mSpillBufferDataSizeBytes, mSpillStore->DataSizeBytes());
+}
+
 void SenderQueue::PushFromExtraBuffer(std::unique_ptr<SenderQueueItem>&& item) {
     auto size = item->mData.size();
 
@@ -16,12 +16,14 @@
 
 #pragma once
 
+#include <filesystem>
 #include <memory>
 #include <vector>
 
 #include "collection_pipeline/queue/BoundedSenderQueueInterface.h"
 #include "collection_pipeline/queue/QueueKey.h"
 #include "collection_pipeline/queue/SenderQueueItem.h"
+#include "collection_pipeline/queue/SenderQueueSpillStore.h"
 
 namespace logtail {
 
@@ -42,23 +44,44 @@ public:
     void GetAvailableItems(std::vector<SenderQueueItem*>& items, int32_t limit) override;
     void SetPipelineForItems(const std::shared_ptr<CollectionPipeline>& p) const override;
 
+    // once enabled, items overflowing the extra buffer are kept on disk under dir instead of in memory
+    bool EnableSpill(const std::filesystem::path& dir);
+    // whether items overflowing right now would be kept in memory, while spill could still be enabled
+    bool CanEnableSpill() const { return Full() && !mSpillStore && !mSpillUnavailable; }
+    void CommitSpill();
+    // spilled items, including those left by the previous run, are taken back for the flusher
+    void StartSpillReplay(Flusher* flusher);
+    // spilled items are not replayed until the next flusher starts
+    void StopSpillReplay();
+
 private:
     size_t Size() const override { return mSize; }
     void PushFromExtraBuffer(std::unique_ptr<SenderQueueItem>&& item) override;
+    bool PushFromSpillStore();
+    void UpdateSpillMetrics();
 
     std::vector<std::unique_ptr<SenderQueueItem>> mQueue;
     size_t mWrite = 0;
     size_t mRead = 0;
     size_t mSize = 0;
 
+    std::unique_ptr<SenderQueueSpillStore> mSpillStore;
+    Flusher* mSpillFlusher = nullptr;
+    bool mSpillReplayStopped = false;
+    bool mSpillUnavailable = false;
+    size_t mExtraBufferDataSize = 0;
+
     CounterPtr mFetchTimesCnt;
     CounterPtr mValidFetchTimesCnt;
     CounterPtr mFetchedItemsCnt;
+    IntGaugePtr mSpillBufferSize;
+    IntGaugePtr mSpillBufferDataSizeBytes;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class SenderQueueUnittest;
     friend class SenderQueueManagerUnittest;
     friend class FlusherUnittest;
+    friend class SenderQueueSpillStoreUnittest;
 #endif
 };
 
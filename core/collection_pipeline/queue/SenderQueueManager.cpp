@@ -14,12 +14,17 @@
 
 #include "collection_pipeline/queue/SenderQueueManager.h"
 
+#include "app_config/AppConfig.h"
 #include "collection_pipeline/queue/ExactlyOnceQueueManager.h"
 #include "collection_pipeline/queue/QueueKeyManager.h"
 #include "common/Flags.h"
+#include "common/memory/MemoryAccountant.h"
 
 DEFINE_FLAG_INT32(sender_queue_gc_threshold_sec, "30s", 30);
 DEFINE_FLAG_INT32(sender_queue_capacity, "", 15);
+DEFINE_FLAG_BOOL(enable_sender_queue_spill,
+                 "keep items overflowing sender queues on disk instead of in memory, and replay them after restart",
+                 false);
 
 using namespace std;
 
@@ -45,12 +50,26 @@ bool SenderQueueManager::CreateQueue(
                             flusherId,
                             ctx);
         iter = mQueues.find(key);
+        if (BOOL_FLAG(enable_sender_queue_spill)) {
+            iter->second.EnableSpill(GetSpillDir(key));
+        }
     }
     iter->second.SetConcurrencyLimiters(std::move(concurrencyLimitersMap));
     iter->second.SetRateLimiter(maxRate);
     return true;
 }
 
+filesystem::path SenderQueueManager::GetSpillDir(QueueKey key) const {
+    // queue keys are not stable across restarts, while queue names are
+    auto name = QueueKeyManager::GetInstance()->GetName(key);
+    for (auto& c : name) {
+        if (!isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_') {
+            c = '_';
+        }
+    }
+    return filesystem::path(GetAgentDataDir()) / "sender_queue_spill" / name;
+}
+
 SenderQueue* SenderQueueManager::GetQueue(QueueKey key) {
     lock_guard<mutex> lock(mQueueMux);
     auto iter = mQueues.find(key);
@@ -93,6 +112,11 @@ int SenderQueueManager::PushQueue(QueueKey key, unique_ptr<SenderQueueItem>&& it
         lock_guard<mutex> lock(mQueueMux);
         auto iter = mQueues.find(key);
         if (iter != mQueues.end()) {
+            if (iter->second.CanEnableSpill()
+                && MemoryAccountant::GetInstance()->IsUnderPressure(MemoryPressureLevel::SPILL_SENDER_QUEUE)) {
+                // memory is short, overflowed items go to disk even if spill is not enabled
+                iter->second.EnableSpill(GetSpillDir(key));
+            }
             if (!iter->second.Push(std::move(item))) {
                 return 1;
             }
@@ -113,6 +137,10 @@ void SenderQueueManager::GetAvailableItems(vector<SenderQueueItem*>& items, int3
         if (mQueues.empty()) {
             return;
         }
+        // items spilled since last round are persisted in one batch
+        for (auto& q : mQueues) {
+            q.second.CommitSpill();
+        }
         if (itemsCntLimit == -1) {
             for (auto iter = mQueues.begin(); iter != mQueues.end(); ++iter) {
                 iter->second.GetAvailableItems(items, -1);
@@ -230,11 +258,21 @@ void SenderQueueManager::SetPipelineForItems(QueueKey key, const std::shared_ptr
     auto iter = mQueues.find(key);
     if (iter != mQueues.end()) {
         iter->second.SetPipelineForItems(p);
+        // the flusher is being stopped, spilled items wait for the next one
+        iter->second.StopSpillReplay();
     } else {
         ExactlyOnceQueueManager::GetInstance()->SetPipelineForSenderItems(key, p);
     }
 }
 
+void SenderQueueManager::StartSpillReplay(QueueKey key, Flusher* flusher) {
+    lock_guard<mutex> lock(mQueueMux);
+    auto iter = mQueues.find(key);
+    if (iter != mQueues.end()) {
+        iter->second.StartSpillReplay(flusher);
+    }
+}
+
 #ifdef APSARA_UNIT_TEST_MAIN
 void SenderQueueManager::Clear() {
     lock_guard<mutex> lock(mQueueMux);
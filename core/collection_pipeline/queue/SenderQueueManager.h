@@ -17,6 +17,7 @@
 #pragma once
 
 #include <condition_variable>
+#include <filesystem>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -64,6 +65,7 @@ public:
     void ClearUnusedQueues();
     void NotifyPipelineStop(QueueKey key, const std::string& configName);
     void SetPipelineForItems(QueueKey key, const std::shared_ptr<CollectionPipeline>& p);
+    void StartSpillReplay(QueueKey key, Flusher* flusher);
 
     bool Wait(uint64_t ms);
     void Trigger();
@@ -80,6 +82,8 @@ private:
     SenderQueueManager();
     ~SenderQueueManager() = default;
 
+    std::filesystem::path GetSpillDir(QueueKey key) const;
+
     BoundedQueueParam mDefaultQueueParam;
 
     mutable std::mutex mQueueMux;
@@ -0,0 +1,519 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "collection_pipeline/queue/SenderQueueSpillStore.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#include "xxhash/xxhash.h"
+
+#include "collection_pipeline/queue/SLSSenderQueueItem.h"
+#include "logger/Logger.h"
+
+using namespace std;
+
+namespace logtail {
+
+bool SenderQueueSpillStore::CanSpill(const SenderQueueItem& item) {
+    if (!item.mBufferOrNot || item.mPipeline) {
+        return false;
+    }
+    const auto* slsItem = dynamic_cast<const SLSSenderQueueItem*>(&item);
+    return slsItem == nullptr || !slsItem->mExactlyOnceCheckpoint;
+}
+
+#if defined(__linux__)
+
+static constexpr uint32_t kRecordMagic = 0x53515354; // "SQST"
+static constexpr uint64_t kIndexMagic = 0x5351535449445831; // "SQSTIDX1"
+static constexpr size_t kRecordHeaderSize = 3 * sizeof(uint32_t);
+static constexpr uint32_t kMaxRecordSize = 1U << 30;
+static const string kSegmentPrefix = "segment_";
+static const string kSegmentSuffix = ".log";
+
+enum class SpilledItemKind : uint8_t { BASE, SLS };
+
+// payload: kind(1) type(1) bufferOrNot(1) reserved(1) rawSize(8) dataLen(4) data [logstoreLen(4) logstore
+// shardHashKeyLen(4) shardHashKey], in host byte order since spill files never leave the host
+static constexpr size_t kDataLenOffset = 12;
+
+static void AppendUint32(string& buffer, uint32_t value) {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static void AppendString(string& buffer, const string& value) {
+    AppendUint32(buffer, static_cast<uint32_t>(value.size()));
+    buffer.append(value);
+}
+
+static bool ReadUint32(const string& buffer, size_t& pos, uint32_t& value) {
+    if (pos + sizeof(value) > buffer.size()) {
+        return false;
+    }
+    memcpy(&value, buffer.data() + pos, sizeof(value));
+    pos += sizeof(value);
+    return true;
+}
+
+static bool ReadString(const string& buffer, size_t& pos, string& value) {
+    uint32_t size = 0;
+    if (!ReadUint32(buffer, pos, size) || pos + size > buffer.size()) {
+        return false;
+    }
+    value.assign(buffer.data() + pos, size);
+    pos += size;
+    return true;
+}
+
+static size_t DataSizeOf(const string& payload) {
+    size_t pos = kDataLenOffset;
+    uint32_t size = 0;
+    ReadUint32(payload, pos, size);
+    return size;
+}
+
+static bool PreadAll(int fd, char* buf, size_t size, uint64_t offset) {
+    while (size > 0) {
+        ssize_t n = pread(fd, buf, size, offset);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        buf += n;
+        size -= n;
+        offset += n;
+    }
+    return true;
+}
+
+static bool WriteAll(int fd, const char* buf, size_t size) {
+    while (size > 0) {
+        ssize_t n = write(fd, buf, size);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        buf += n;
+        size -= n;
+    }
+    return true;
+}
+
+static bool ReadRecord(int fd, uint64_t offset, string& payload, uint64_t& next) {
+    uint32_t header[3];
+    if (!PreadAll(fd, reinterpret_cast<char*>(header), kRecordHeaderSize, offset)) {
+        return false;
+    }
+    if (header[0] != kRecordMagic || header[1] > kMaxRecordSize) {
+        return false;
+    }
+    payload.resize(header[1]);
+    if (!PreadAll(fd, payload.data(), payload.size(), offset + kRecordHeaderSize)) {
+        return false;
+    }
+    if (XXH32(payload.data(), payload.size(), 0) != header[2]) {
+        return false;
+    }
+    next = offset + kRecordHeaderSize + payload.size();
+    return true;
+}
+
+SenderQueueSpillStore::SenderQueueSpillStore(const filesystem::path& dir, size_t maxSegmentSize)
+    : mDir(dir), mMaxSegmentSize(maxSegmentSize) {
+}
+
+SenderQueueSpillStore::~SenderQueueSpillStore() {
+    if (mWriteFd >= 0) {
+        Commit();
+        close(mWriteFd);
+    }
+    if (mReadFd >= 0) {
+        close(mReadFd);
+    }
+    if (mIndex != nullptr) {
+        munmap(mIndex, sizeof(Index));
+    }
+    if (mIndexFd >= 0) {
+        close(mIndexFd);
+    }
+}
+
+bool SenderQueueSpillStore::Open() {
+    error_code ec;
+    filesystem::create_directories(mDir, ec);
+    if (ec) {
+        LOG_ERROR(sLogger,
+                  ("failed to create spill dir", mDir.string())("error code", ec.value())("error msg", ec.message()));
+        return false;
+    }
+    if (!openIndex()) {
+        return false;
+    }
+
+    vector<uint64_t> seqs;
+    for (const auto& entry : filesystem::directory_iterator(mDir, ec)) {
+        auto name = entry.path().filename().string();
+        if (name.size() <= kSegmentPrefix.size() + kSegmentSuffix.size() || name.rfind(kSegmentPrefix, 0) != 0
+            || name.compare(name.size() - kSegmentSuffix.size(), kSegmentSuffix.size(), kSegmentSuffix) != 0) {
+            continue;
+        }
+        try {
+            seqs.push_back(stoull(name.substr(kSegmentPrefix.size())));
+        } catch (...) {
+            continue;
+        }
+    }
+    sort(seqs.begin(), seqs.end());
+
+    for (auto seq : seqs) {
+        if (seq < mIndex->mReadSeq) {
+            // fully replayed before the last exit
+            filesystem::remove(segmentPath(seq), ec);
+            continue;
+        }
+        Segment segment;
+        segment.mSeq = seq;
+        scanSegment(segment, seq == mIndex->mReadSeq ? mIndex->mReadOffset : 0);
+        mItemCnt += segment.mItemCnt;
+        mDataSize += segment.mDataSize;
+        mSegments.push_back(segment);
+    }
+    if (mSegments.empty()) {
+        Segment segment;
+        segment.mSeq = mIndex->mReadSeq;
+        mSegments.push_back(segment);
+    }
+    mReadOffset = mSegments.front().mSeq == mIndex->mReadSeq ? mIndex->mReadOffset : 0;
+    mReadOffset = min(mReadOffset, mSegments.front().mSize);
+    updateIndex();
+
+    if (!openWriteSegment()) {
+        return false;
+    }
+    if (mItemCnt > 0) {
+        LOG_INFO(sLogger,
+                 ("recover spilled sender queue items, dir", mDir.string())("item cnt", mItemCnt)("data size",
+                                                                                                  mDataSize));
+    }
+    return true;
+}
+
+void SenderQueueSpillStore::Append(const SenderQueueItem& item) {
+    size_t headerPos = mPending.size();
+    mPending.append(kRecordHeaderSize, '\0');
+    encode(item, mPending);
+    uint32_t header[3];
+    header[0] = kRecordMagic;
+    header[1] = static_cast<uint32_t>(mPending.size() - headerPos - kRecordHeaderSize);
+    header[2] = XXH32(mPending.data() + headerPos + kRecordHeaderSize, header[1], 0);
+    memcpy(mPending.data() + headerPos, header, kRecordHeaderSize);
+
+    ++mPendingItemCnt;
+    mPendingDataSize += item.mData.size();
+    ++mItemCnt;
+    mDataSize += item.mData.size();
+}
+
+bool SenderQueueSpillStore::Commit() {
+    if (mPending.empty()) {
+        return true;
+    }
+    if (mSegments.back().mSize > 0 && mSegments.back().mSize + mPending.size() > mMaxSegmentSize && !rotate()) {
+        return false;
+    }
+    auto& segment = mSegments.back();
+    if (!WriteAll(mWriteFd, mPending.data(), mPending.size()) || fdatasync(mWriteFd) != 0) {
+        LOG_ERROR(sLogger,
+                  ("failed to write spill segment", segmentPath(segment.mSeq).string())("error", strerror(errno)));
+        // drop the partial write, items stay pending for the next commit
+        if (ftruncate(mWriteFd, segment.mSize) != 0) {
+            LOG_ERROR(sLogger, ("failed to truncate spill segment", segmentPath(segment.mSeq).string()));
+        }
+        return false;
+    }
+    segment.mSize += mPending.size();
+    segment.mItemCnt += mPendingItemCnt;
+    segment.mDataSize += mPendingDataSize;
+    mPending.clear();
+    mPendingItemCnt = 0;
+    mPendingDataSize = 0;
+    return true;
+}
+
+unique_ptr<SenderQueueItem> SenderQueueSpillStore::Pop(Flusher* flusher, QueueKey key) {
+    while (mItemCnt > 0) {
+        auto& segment = mSegments.front();
+        if (mReadOffset >= segment.mSize) {
+            if (mSegments.size() > 1) {
+                advanceReadSegment();
+                continue;
+            }
+            // all left are pending
+            if (!Commit()) {
+                return nullptr;
+            }
+            continue;
+        }
+        if (mReadFd < 0 || mReadFdSeq != segment.mSeq) {
+            if (mReadFd >= 0) {
+                close(mReadFd);
+            }
+            mReadFd = open(segmentPath(segment.mSeq).c_str(), O_RDONLY | O_CLOEXEC);
+            mReadFdSeq = segment.mSeq;
+            if (mReadFd < 0) {
+                LOG_ERROR(sLogger,
+                          ("failed to open spill segment", "discard items in it")(
+                              "segment", segmentPath(segment.mSeq).string())("error", strerror(errno)));
+                dropReadSegment();
+                continue;
+            }
+        }
+
+        string payload;
+        uint64_t next = 0;
+        if (!ReadRecord(mReadFd, mReadOffset, payload, next)) {
+            LOG_ERROR(sLogger,
+                      ("failed to read spill segment", "discard items left in it")(
+                          "segment", segmentPath(segment.mSeq).string())("offset", mReadOffset));
+            dropReadSegment();
+            continue;
+        }
+        mReadOffset = next;
+        auto dataSize = DataSizeOf(payload);
+        --segment.mItemCnt;
+        segment.mDataSize -= dataSize;
+        --mItemCnt;
+        mDataSize -= dataSize;
+        if (mItemCnt == 0 && mPending.empty()) {
+            // start over with an empty segment, so that the replayed one can be removed
+            if (rotate()) {
+                advanceReadSegment();
+            }
+        }
+        updateIndex();
+
+        auto item = decode(payload, flusher, key);
+        if (!item) {
+            LOG_ERROR(sLogger, ("failed to decode spilled item", "discard")("dir", mDir.string()));
+            continue;
+        }
+        return item;
+    }
+    return nullptr;
+}
+
+bool SenderQueueSpillStore::openIndex() {
+    auto path = mDir / "index";
+    mIndexFd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (mIndexFd < 0) {
+        LOG_ERROR(sLogger, ("failed to open spill index", path.string())("error", strerror(errno)));
+        return false;
+    }
+    if (ftruncate(mIndexFd, sizeof(Index)) != 0) {
+        LOG_ERROR(sLogger, ("failed to resize spill index", path.string())("error", strerror(errno)));
+        return false;
+    }
+    void* addr = mmap(nullptr, sizeof(Index), PROT_READ | PROT_WRITE, MAP_SHARED, mIndexFd, 0);
+    if (addr == MAP_FAILED) {
+        LOG_ERROR(sLogger, ("failed to mmap spill index", path.string())("error", strerror(errno)));
+        return false;
+    }
+    mIndex = static_cast<Index*>(addr);
+    if (mIndex->mMagic != kIndexMagic) {
+        mIndex->mMagic = kIndexMagic;
+        mIndex->mReadSeq = 0;
+        mIndex->mReadOffset = 0;
+    }
+    return true;
+}
+
+void SenderQueueSpillStore::scanSegment(Segment& segment, uint64_t offset) {
+    auto path = segmentPath(segment.mSeq);
+    int fd = open(path.c_str(), O_RDWR | O_CLOEXEC);
+    if (fd < 0) {
+        LOG_ERROR(sLogger, ("failed to open spill segment", path.string())("error", strerror(errno)));
+        return;
+    }
+    auto fileSize = static_cast<uint64_t>(lseek(fd, 0, SEEK_END));
+    uint64_t pos = offset;
+    string payload;
+    uint64_t next = 0;
+    while (pos < fileSize && ReadRecord(fd, pos, payload, next)) {
+        ++segment.mItemCnt;
+        segment.mDataSize += DataSizeOf(payload);
+        pos = next;
+    }
+    if (pos < fileSize) {
+        // torn by a crash during write, there is nothing valid after it
+        LOG_WARNING(sLogger,
+                    ("drop torn records in spill segment", path.string())("valid size", pos)("file size", fileSize));
+        if (ftruncate(fd, pos) != 0) {
+            LOG_ERROR(sLogger, ("failed to truncate spill segment", path.string())("error", strerror(errno)));
+        }
+        fileSize = pos;
+    }
+    segment.mSize = fileSize;
+    close(fd);
+}
+
+bool SenderQueueSpillStore::openWriteSegment() {
+    auto path = segmentPath(mSegments.back().mSeq);
+    mWriteFd = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (mWriteFd < 0) {
+        LOG_ERROR(sLogger, ("failed to open spill segment", path.string())("error", strerror(errno)));
+        return false;
+    }
+    return true;
+}
+
+bool SenderQueueSpillStore::rotate() {
+    if (mWriteFd >= 0) {
+        close(mWriteFd);
+        mWriteFd = -1;
+    }
+    Segment segment;
+    segment.mSeq = mSegments.back().mSeq + 1;
+    mSegments.push_back(segment);
+    return openWriteSegment();
+}
+
+void SenderQueueSpillStore::advanceReadSegment() {
+    if (mReadFd >= 0) {
+        close(mReadFd);
+        mReadFd = -1;
+    }
+    error_code ec;
+    filesystem::remove(segmentPath(mSegments.front().mSeq), ec);
+    mSegments.pop_front();
+    mReadOffset = 0;
+    updateIndex();
+}
+
+void SenderQueueSpillStore::dropReadSegment() {
+    auto& segment = mSegments.front();
+    mItemCnt -= segment.mItemCnt;
+    mDataSize -= segment.mDataSize;
+    segment.mItemCnt = 0;
+    segment.mDataSize = 0;
+    mReadOffset = segment.mSize;
+    if (mSegments.size() > 1) {
+        advanceReadSegment();
+    } else {
+        updateIndex();
+    }
+}
+
+void SenderQueueSpillStore::updateIndex() {
+    // the page is written back by the kernel, a crash at most replays the items taken back since then
+    mIndex->mReadSeq = mSegments.front().mSeq;
+    mIndex->mReadOffset = mReadOffset;
+}
+
+filesystem::path SenderQueueSpillStore::segmentPath(uint64_t seq) const {
+    return mDir / (kSegmentPrefix + to_string(seq) + kSegmentSuffix);
+}
+
+void SenderQueueSpillStore::encode(const SenderQueueItem& item, string& buffer) {
+    const auto* slsItem = dynamic_cast<const SLSSenderQueueItem*>(&item);
+    buffer.push_back(static_cast<char>(slsItem ? SpilledItemKind::SLS : SpilledItemKind::BASE));
+    buffer.push_back(static_cast<char>(item.mType));
+    buffer.push_back(static_cast<char>(item.mBufferOrNot));
+    buffer.push_back('\0');
+    uint64_t rawSize = item.mRawSize;
+    buffer.append(reinterpret_cast<const char*>(&rawSize), sizeof(rawSize));
+    AppendString(buffer, item.mData);
+    if (slsItem) {
+        AppendString(buffer, slsItem->mLogstore);
+        AppendString(buffer, slsItem->mShardHashKey);
+    }
+}
+
+unique_ptr<SenderQueueItem> SenderQueueSpillStore::decode(const string& payload, Flusher* flusher, QueueKey key) {
+    if (payload.size() < kDataLenOffset) {
+        return nullptr;
+    }
+    auto kind = static_cast<SpilledItemKind>(payload[0]);
+    auto type = static_cast<RawDataType>(payload[1]);
+    bool bufferOrNot = payload[2] != 0;
+    uint64_t rawSize = 0;
+    memcpy(&rawSize, payload.data() + 4, sizeof(rawSize));
+    size_t pos = kDataLenOffset;
+    string data;
+    if (!ReadString(payload, pos, data)) {
+        return nullptr;
+    }
+    switch (kind) {
+        case SpilledItemKind::BASE:
+            return make_unique<SenderQueueItem>(std::move(data), rawSize, flusher, key, type, bufferOrNot);
+        case SpilledItemKind::SLS: {
+            string logstore, shardHashKey;
+            if (!ReadString(payload, pos, logstore) || !ReadString(payload, pos, shardHashKey)) {
+                return nullptr;
+            }
+            return make_unique<SLSSenderQueueItem>(std::move(data),
+                                                   rawSize,
+                                                   flusher,
+                                                   key,
+                                                   logstore,
+                                                   type,
+                                                   shardHashKey,
+                                                   RangeCheckpointPtr(),
+                                                   bufferOrNot);
+        }
+        default:
+            return nullptr;
+    }
+}
+
+#else
+
+// spill relies on pread, fdatasync and mmap, so overflowed items are always kept in memory on other platforms
+SenderQueueSpillStore::SenderQueueSpillStore(const filesystem::path& dir, size_t maxSegmentSize)
+    : mDir(dir), mMaxSegmentSize(maxSegmentSize) {
+}
+
+SenderQueueSpillStore::~SenderQueueSpillStore() = default;
+
+bool SenderQueueSpillStore::Open() {
+    LOG_WARNING(sLogger, ("sender queue spill is not supported on this platform, dir", mDir.string()));
+    return false;
+}
+
+void SenderQueueSpillStore::Append(const SenderQueueItem&) {
+}
+
+bool SenderQueueSpillStore::Commit() {
+    return false;
+}
+
+unique_ptr<SenderQueueItem> SenderQueueSpillStore::Pop(Flusher*, QueueKey) {
+    return nullptr;
+}
+
+#endif
+
+} // namespace logtail
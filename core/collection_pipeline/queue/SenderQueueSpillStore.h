@@ -0,0 +1,116 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include "collection_pipeline/queue/QueueKey.h"
+#include "collection_pipeline/queue/SenderQueueItem.h"
+
+namespace logtail {
+
+class Flusher;
+
+// SenderQueueSpillStore is an append-only log of sender queue items split into segment files, which takes the items
+// a sender queue cannot afford to keep in memory.
+// Appended items are group committed, i.e., a batch of items costs one write and one fdatasync. The replay position
+// is kept in a small mmap'd index file, so that items already taken back are not replayed again after a restart,
+// while records torn by a crash are detected by checksum and dropped on Open.
+// not thread-safe, should be protected explicitly by queue manager
+class SenderQueueSpillStore {
+public:
+    SenderQueueSpillStore(const std::filesystem::path& dir, size_t maxSegmentSize);
+    ~SenderQueueSpillStore();
+
+    SenderQueueSpillStore(const SenderQueueSpillStore&) = delete;
+    SenderQueueSpillStore& operator=(const SenderQueueSpillStore&) = delete;
+
+    // items carrying in-memory state, i.e., the pipeline kept alive during update or the exactly once checkpoint,
+    // cannot be restored from disk
+    static bool CanSpill(const SenderQueueItem& item);
+
+    // recover items left by the previous run
+    bool Open();
+    // the item is only buffered, call Commit to persist it
+    void Append(const SenderQueueItem& item);
+    bool Commit();
+    // take the oldest item back, nullptr if there is none
+    std::unique_ptr<SenderQueueItem> Pop(Flusher* flusher, QueueKey key);
+
+    bool Empty() const { return mItemCnt == 0; }
+    size_t Size() const { return mItemCnt; }
+    size_t DataSizeBytes() const { return mDataSize; }
+    size_t PendingSizeBytes() const { return mPending.size(); }
+    const std::filesystem::path& GetDir() const { return mDir; }
+
+private:
+    struct Segment {
+        uint64_t mSeq = 0;
+        uint64_t mSize = 0;
+        // items not taken back yet
+        size_t mItemCnt = 0;
+        size_t mDataSize = 0;
+    };
+
+    struct Index {
+        uint64_t mMagic;
+        uint64_t mReadSeq;
+        uint64_t mReadOffset;
+    };
+
+    bool openIndex();
+    void scanSegment(Segment& segment, uint64_t offset);
+    bool openWriteSegment();
+    bool rotate();
+    void advanceReadSegment();
+    void dropReadSegment();
+    void updateIndex();
+    std::filesystem::path segmentPath(uint64_t seq) const;
+
+    static void encode(const SenderQueueItem& item, std::string& buffer);
+    static std::unique_ptr<SenderQueueItem> decode(const std::string& payload, Flusher* flusher, QueueKey key);
+
+    std::filesystem::path mDir;
+    size_t mMaxSegmentSize = 0;
+
+    std::deque<Segment> mSegments;
+    int mWriteFd = -1;
+    int mReadFd = -1;
+    uint64_t mReadFdSeq = 0;
+    uint64_t mReadOffset = 0;
+
+    int mIndexFd = -1;
+    Index* mIndex = nullptr;
+
+    std::string mPending;
+    size_t mPendingItemCnt = 0;
+    size_t mPendingDataSize = 0;
+
+    size_t mItemCnt = 0;
+    size_t mDataSize = 0;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class SenderQueueSpillStoreUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -15,6 +15,7 @@
 #include "collection_pipeline/route/Condition.h"
 
 #include "common/ParamExtractor.h"
+#include "common/StringTools.h"
 
 using namespace std;
 
@@ -112,6 +113,126 @@ void TagCondition::DiscardTagIfRequired(PipelineEventGroup& g) const {
     }
 }
 
+bool ContentCondition::Init(const Json::Value& config, const CollectionPipelineContext& ctx) {
+    string errorMsg;
+
+    // Key
+    if (!GetMandatoryStringParam(config, "Match.Key", mKey, errorMsg)) {
+        PARAM_ERROR_RETURN(ctx.GetLogger(),
+                           ctx.GetAlarm(),
+                           errorMsg,
+                           noModule,
+                           ctx.GetConfigName(),
+                           ctx.GetProjectName(),
+                           ctx.GetLogstoreName(),
+                           ctx.GetRegion());
+    }
+
+    // Operator
+    string op = "equals";
+    if (!GetOptionalStringParam(config, "Match.Operator", op, errorMsg)) {
+        PARAM_ERROR_RETURN(ctx.GetLogger(),
+                           ctx.GetAlarm(),
+                           errorMsg,
+                           noModule,
+                           ctx.GetConfigName(),
+                           ctx.GetProjectName(),
+                           ctx.GetLogstoreName(),
+                           ctx.GetRegion());
+    }
+    if (op == "equals") {
+        mOperator = Operator::EQUALS;
+    } else if (op == "prefix") {
+        mOperator = Operator::PREFIX;
+    } else if (op == "in") {
+        mOperator = Operator::IN;
+    } else if (op == "regex") {
+        mOperator = Operator::REGEX;
+    } else {
+        PARAM_ERROR_RETURN(ctx.GetLogger(),
+                           ctx.GetAlarm(),
+                           "string param Match.Operator is not valid",
+                           noModule,
+                           ctx.GetConfigName(),
+                           ctx.GetProjectName(),
+                           ctx.GetLogstoreName(),
+                           ctx.GetRegion());
+    }
+
+    // Value
+    if (mOperator == Operator::IN) {
+        if (!GetMandatoryListParam(config, "Match.Value", mValues, errorMsg)) {
+            PARAM_ERROR_RETURN(ctx.GetLogger(),
+                               ctx.GetAlarm(),
+                               errorMsg,
+                               noModule,
+                               ctx.GetConfigName(),
+                               ctx.GetProjectName(),
+                               ctx.GetLogstoreName(),
+                               ctx.GetRegion());
+        }
+    } else {
+        string value;
+        if (!GetMandatoryStringParam(config, "Match.Value", value, errorMsg)) {
+            PARAM_ERROR_RETURN(ctx.GetLogger(),
+                               ctx.GetAlarm(),
+                               errorMsg,
+                               noModule,
+                               ctx.GetConfigName(),
+                               ctx.GetProjectName(),
+                               ctx.GetLogstoreName(),
+                               ctx.GetRegion());
+        }
+        if (mOperator == Operator::REGEX) {
+            try {
+                mRegex = boost::regex(value);
+            } catch (const boost::regex_error& e) {
+                PARAM_ERROR_RETURN(ctx.GetLogger(),
+                                   ctx.GetAlarm(),
+                                   "string param Match.Value is not a valid regex: " + string(e.what()),
+                                   noModule,
+                                   ctx.GetConfigName(),
+                                   ctx.GetProjectName(),
+                                   ctx.GetLogstoreName(),
+                                   ctx.GetRegion());
+            }
+        }
+        mValues.emplace_back(std::move(value));
+    }
+
+    return true;
+}
+
+bool ContentCondition::Check(const PipelineEventPtr& e) const {
+    if (!e.Is<LogEvent>()) {
+        return false;
+    }
+    const auto& logEvent = e.Cast<LogEvent>();
+    auto it = logEvent.FindContent(mKey);
+    if (it == logEvent.cend()) {
+        return false;
+    }
+    StringView value = it->second;
+    switch (mOperator) {
+        case Operator::EQUALS:
+        case Operator::IN:
+            for (const auto& item : mValues) {
+                if (value == item) {
+                    return true;
+                }
+            }
+            return false;
+        case Operator::PREFIX:
+            return value.starts_with(mValues[0]);
+        case Operator::REGEX: {
+            string exception;
+            return BoostRegexMatch(value.data(), value.size(), mRegex, exception);
+        }
+        default:
+            return false;
+    }
+}
+
 bool Condition::Init(const Json::Value& config, const CollectionPipelineContext& ctx) {
     string errorMsg;
 
@@ -141,6 +262,8 @@ bool Condition::Init(const Json::Value& config, const CollectionPipelineContext&
         mType = Type::EVENT_TYPE;
     } else if (type == "tag") {
         mType = Type::TAG;
+    } else if (type == "content") {
+        mType = Type::CONTENT;
     } else {
         PARAM_ERROR_RETURN(ctx.GetLogger(),
                            ctx.GetAlarm(),
@@ -163,6 +286,11 @@ bool Condition::Init(const Json::Value& config, const CollectionPipelineContext&
                 return false;
             }
             break;
+        case Type::CONTENT:
+            if (!mDetail.emplace<ContentCondition>().Init(config, ctx)) {
+                return false;
+            }
+            break;
         default:
             return false;
     }
@@ -191,4 +319,13 @@ void Condition::GetResult(PipelineEventGroup& g) const {
     }
 }
 
+bool Condition::IsModifying(const PipelineEventGroup& g) const {
+    switch (mType) {
+        case Type::TAG:
+            return get_if<TagCondition>(&mDetail)->IsDiscardingTag(g);
+        default:
+            return false;
+    }
+}
+
 } // namespace logtail
@@ -16,8 +16,11 @@
 
 #pragma once
 
+#include <string>
 #include <variant>
+#include <vector>
 
+#include "boost/regex.hpp"
 #include "json/json.h"
 
 #include "collection_pipeline/CollectionPipelineContext.h"
@@ -43,6 +46,7 @@ public:
     bool Init(const Json::Value& config, const CollectionPipelineContext& ctx);
     bool Check(const PipelineEventGroup& g) const;
     void DiscardTagIfRequired(PipelineEventGroup& g) const;
+    bool IsDiscardingTag(const PipelineEventGroup& g) const { return mDiscardingTag && g.HasTag(mKey); }
 
 private:
     std::string mKey;
@@ -55,17 +59,45 @@ private:
 #endif
 };
 
+// matches log events by the value of a content field, routed per event rather than per group
+class ContentCondition {
+public:
+    enum class Operator { EQUALS, PREFIX, IN, REGEX };
+
+    bool Init(const Json::Value& config, const CollectionPipelineContext& ctx);
+    bool Check(const PipelineEventPtr& e) const;
+
+    const std::string& GetKey() const { return mKey; }
+    Operator GetOperator() const { return mOperator; }
+    const std::vector<std::string>& GetValues() const { return mValues; }
+    const boost::regex& GetRegex() const { return mRegex; }
+
+private:
+    std::string mKey;
+    Operator mOperator = Operator::EQUALS;
+    std::vector<std::string> mValues;
+    boost::regex mRegex;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ContentConditionUnittest;
+#endif
+};
+
 class Condition {
 public:
     bool Init(const Json::Value& config, const CollectionPipelineContext& ctx);
     bool Check(const PipelineEventGroup& g) const;
     void GetResult(PipelineEventGroup& g) const;
+    // whether GetResult would modify g, i.e., g cannot be shared with other destinations
+    bool IsModifying(const PipelineEventGroup& g) const;
+    // event level conditions are not checked against groups, see EventRouteIndex
+    const ContentCondition* GetContentCondition() const { return std::get_if<ContentCondition>(&mDetail); }
 
 private:
-    enum class Type { EVENT_TYPE, TAG };
+    enum class Type { EVENT_TYPE, TAG, CONTENT };
 
     Type mType;
-    std::variant<EventTypeCondition, TagCondition> mDetail;
+    std::variant<EventTypeCondition, TagCondition, ContentCondition> mDetail;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ConditionUnittest;
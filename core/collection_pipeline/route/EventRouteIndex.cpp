@@ -0,0 +1,142 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "collection_pipeline/route/EventRouteIndex.h"
+
+#include <algorithm>
+
+#include "common/StringTools.h"
+
+using namespace std;
+
+namespace logtail {
+
+void EventRouteIndex::Add(size_t flusherIdx, const ContentCondition& condition) {
+    auto it = find_if(mKeys.begin(), mKeys.end(), [&](const auto& item) { return item->mKey == condition.GetKey(); });
+    if (it == mKeys.end()) {
+        mKeys.emplace_back(make_unique<KeyIndex>());
+        mKeys.back()->mKey = condition.GetKey();
+        it = prev(mKeys.end());
+    }
+    auto& index = **it;
+    size_t slot = mFlusherIdx.size();
+    mFlusherIdx.push_back(flusherIdx);
+
+    switch (condition.GetOperator()) {
+        case ContentCondition::Operator::EQUALS:
+        case ContentCondition::Operator::IN:
+            for (const auto& value : condition.GetValues()) {
+                auto valueIt = index.mExactMatches.find(value);
+                if (valueIt == index.mExactMatches.end()) {
+                    index.mValues.emplace_back(value);
+                    valueIt = index.mExactMatches.emplace(index.mValues.back(), vector<size_t>()).first;
+                }
+                if (valueIt->second.empty() || valueIt->second.back() != slot) {
+                    valueIt->second.push_back(slot);
+                }
+            }
+            break;
+        case ContentCondition::Operator::PREFIX:
+            index.mPrefixes.emplace_back(condition.GetValues()[0], slot);
+            break;
+        case ContentCondition::Operator::REGEX:
+            index.mRegexes.emplace_back(condition.GetRegex(), slot);
+            break;
+        default:
+            break;
+    }
+}
+
+void EventRouteIndex::Route(PipelineEventGroup& g,
+                            bool keepEvents,
+                            vector<pair<size_t, shared_ptr<PipelineEventGroup>>>& res) const {
+    vector<shared_ptr<PipelineEventGroup>> groups(mFlusherIdx.size());
+    vector<uint8_t> seen(mFlusherIdx.size(), 0);
+    vector<size_t> matched;
+    bool moved = false;
+    for (auto& e : g.MutableEvents()) {
+        if (!e.Is<LogEvent>()) {
+            continue;
+        }
+        matched.clear();
+        match(e.Cast<LogEvent>(), seen, matched);
+        for (size_t i = 0; i < matched.size(); ++i) {
+            auto slot = matched[i];
+            seen[slot] = 0;
+            auto& group = groups[slot];
+            if (!group) {
+                group = make_shared<PipelineEventGroup>(g.CopyWithoutEvents());
+            }
+            auto& events = group->MutableEvents();
+            if (!keepEvents && i + 1 == matched.size()) {
+                events.emplace_back(std::move(e));
+                moved = true;
+            } else {
+                events.emplace_back(e.Copy());
+            }
+            events.back()->ResetPipelineEventGroup(group.get());
+        }
+    }
+    if (moved) {
+        // unmatched events stay in g, so that they are released to the event pool as usual
+        auto& events = g.MutableEvents();
+        events.erase(remove_if(events.begin(), events.end(), [](const PipelineEventPtr& e) { return !e; }),
+                     events.end());
+    }
+
+    for (size_t slot = 0; slot < groups.size(); ++slot) {
+        if (groups[slot]) {
+            res.emplace_back(mFlusherIdx[slot], std::move(groups[slot]));
+        }
+    }
+}
+
+void EventRouteIndex::match(const LogEvent& e, vector<uint8_t>& seen, vector<size_t>& matched) const {
+    auto add = [&](size_t slot) {
+        if (!seen[slot]) {
+            seen[slot] = 1;
+            matched.push_back(slot);
+        }
+    };
+    for (const auto& index : mKeys) {
+        auto it = e.FindContent(index->mKey);
+        if (it == e.cend()) {
+            continue;
+        }
+        StringView value = it->second;
+        if (!index->mExactMatches.empty()) {
+            auto valueIt = index->mExactMatches.find(value);
+            if (valueIt != index->mExactMatches.end()) {
+                for (auto slot : valueIt->second) {
+                    add(slot);
+                }
+            }
+        }
+        for (const auto& prefix : index->mPrefixes) {
+            if (!seen[prefix.second] && value.starts_with(prefix.first)) {
+                add(prefix.second);
+            }
+        }
+        for (const auto& regex : index->mRegexes) {
+            string exception;
+            if (!seen[regex.second] && BoostRegexMatch(value.data(), value.size(), regex.first, exception)) {
+                add(regex.second);
+            }
+        }
+    }
+}
+
+} // namespace logtail
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "boost/regex.hpp"
+
+#include "collection_pipeline/route/Condition.h"
+#include "common/StringView.h"
+#include "models/PipelineEventGroup.h"
+
+namespace logtail {
+
+// EventRouteIndex compiles the content conditions of all flushers into one index per content key, so that the
+// destinations of an event are found with a single hash lookup for equals and in conditions, leaving only prefix and
+// regex conditions to be checked one by one.
+class EventRouteIndex {
+public:
+    void Add(size_t flusherIdx, const ContentCondition& condition);
+    bool Empty() const { return mFlusherIdx.empty(); }
+
+    // partition events of g into one group per matched flusher in a single pass, and append them to res
+    // groups share the source buffers of g, events are copied only if they are also needed elsewhere, i.e., when
+    // keepEvents is true or the event matches more than one flusher
+    void Route(PipelineEventGroup& g,
+               bool keepEvents,
+               std::vector<std::pair<size_t, std::shared_ptr<PipelineEventGroup>>>& res) const;
+
+private:
+    struct KeyIndex {
+        std::string mKey;
+        // keys point to mValues, whose elements never move
+        std::unordered_map<StringView, std::vector<size_t>, StringViewHash, StringViewEqual> mExactMatches;
+        std::deque<std::string> mValues;
+        std::vector<std::pair<std::string, size_t>> mPrefixes;
+        std::vector<std::pair<boost::regex, size_t>> mRegexes;
+    };
+
+    void match(const LogEvent& e, std::vector<uint8_t>& seen, std::vector<size_t>& matched) const;
+
+    std::vector<std::unique_ptr<KeyIndex>> mKeys;
+    // slot -> flusher index, one slot per content condition
+    std::vector<size_t> mFlusherIdx;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class RouterUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -26,10 +26,15 @@ namespace logtail {
 bool Router::Init(std::vector<pair<size_t, const Json::Value*>> configs, const CollectionPipelineContext& ctx) {
     for (auto& item : configs) {
         if (item.second != nullptr) {
-            mConditions.emplace_back(item.first, Condition());
-            if (!mConditions.back().second.Init(*item.second, ctx)) {
+            Condition condition;
+            if (!condition.Init(*item.second, ctx)) {
                 return false;
             }
+            if (const auto* content = condition.GetContentCondition()) {
+                mEventIndex.Add(item.first, *content);
+            } else {
+                mConditions.emplace_back(item.first, std::move(condition));
+            }
         } else {
             mAlwaysMatchedFlusherIdx.push_back(item.first);
         }
@@ -47,37 +52,58 @@ bool Router::Init(std::vector<pair<size_t, const Json::Value*>> configs, const C
     return true;
 }
 
-vector<pair<size_t, PipelineEventGroup>> Router::Route(PipelineEventGroup& g) const {
+vector<pair<size_t, shared_ptr<PipelineEventGroup>>> Router::Route(PipelineEventGroup& g) const {
     ADD_COUNTER(mInEventsTotal, g.GetEvents().size());
     ADD_COUNTER(mInGroupDataSizeBytes, g.DataSize());
 
     vector<size_t> dest;
+    vector<bool> modifying;
+    size_t modifyingCnt = 0;
     for (size_t i = 0; i < mConditions.size(); ++i) {
         if (mConditions[i].second.Check(g)) {
             dest.push_back(i);
+            modifying.push_back(mConditions[i].second.IsModifying(g));
+            modifyingCnt += modifying.back();
         }
     }
-    auto resSz = dest.size() + mAlwaysMatchedFlusherIdx.size();
 
-    vector<pair<size_t, PipelineEventGroup>> res;
-    res.reserve(resSz);
-    for (size_t i = 0; i < mAlwaysMatchedFlusherIdx.size(); ++i, --resSz) {
-        if (resSz == 1) {
-            res.emplace_back(mAlwaysMatchedFlusherIdx[i], std::move(g));
-        } else {
-            res.emplace_back(mAlwaysMatchedFlusherIdx[i], g.Copy());
-        }
+    // destinations whose condition modifies the group get a copy of their own, while all the others share the
+    // original one, which is only copied later if the flusher needs to own it while it is still shared
+    bool shared = !mAlwaysMatchedFlusherIdx.empty() || dest.size() > modifyingCnt;
+    vector<pair<size_t, shared_ptr<PipelineEventGroup>>> eventRes;
+    if (!mEventIndex.Empty()) {
+        mEventIndex.Route(g, !dest.empty() || shared, eventRes);
     }
-    for (size_t i = 0; i < dest.size(); ++i, --resSz) {
-        if (resSz == 1) {
+    vector<shared_ptr<PipelineEventGroup>> modified(dest.size());
+    for (size_t i = 0; i < dest.size(); ++i) {
+        if (!modifying[i]) {
+            continue;
+        }
+        if (!shared && --modifyingCnt == 0) {
+            // the last one takes the original group over
             mConditions[dest[i]].second.GetResult(g);
-            res.emplace_back(dest[i], std::move(g));
+            modified[i] = make_shared<PipelineEventGroup>(std::move(g));
         } else {
-            auto copy = g.Copy();
-            mConditions[dest[i]].second.GetResult(copy);
-            res.emplace_back(dest[i], std::move(copy));
+            modified[i] = make_shared<PipelineEventGroup>(g.Copy());
+            mConditions[dest[i]].second.GetResult(*modified[i]);
         }
     }
+
+    shared_ptr<PipelineEventGroup> sharedGroup;
+    if (shared) {
+        sharedGroup = make_shared<PipelineEventGroup>(std::move(g));
+    }
+    vector<pair<size_t, shared_ptr<PipelineEventGroup>>> res;
+    res.reserve(dest.size() + mAlwaysMatchedFlusherIdx.size() + eventRes.size());
+    for (auto idx : mAlwaysMatchedFlusherIdx) {
+        res.emplace_back(idx, sharedGroup);
+    }
+    for (size_t i = 0; i < dest.size(); ++i) {
+        res.emplace_back(dest[i], modified[i] ? std::move(modified[i]) : sharedGroup);
+    }
+    for (auto& item : eventRes) {
+        res.emplace_back(std::move(item));
+    }
     return res;
 }
 
@@ -16,12 +16,14 @@
 
 #pragma once
 
+#include <memory>
 #include <optional>
 #include <vector>
 
 #include "json/json.h"
 
 #include "collection_pipeline/route/Condition.h"
+#include "collection_pipeline/route/EventRouteIndex.h"
 #include "models/PipelineEventGroup.h"
 #include "monitor/MetricManager.h"
 
@@ -32,11 +34,14 @@ class Flusher;
 class Router {
 public:
     bool Init(std::vector<std::pair<size_t, const Json::Value*>> config, const CollectionPipelineContext& ctx);
-    std::vector<std::pair<size_t, PipelineEventGroup>> Route(PipelineEventGroup& g) const;
+    // g is taken over, flushers not modifying the group share the same instance
+    std::vector<std::pair<size_t, std::shared_ptr<PipelineEventGroup>>> Route(PipelineEventGroup& g) const;
 
 private:
     std::vector<std::pair<size_t, Condition>> mConditions;
     std::vector<size_t> mAlwaysMatchedFlusherIdx;
+    // content conditions, routed per event
+    EventRouteIndex mEventIndex;
 
     mutable MetricsRecordRef mMetricsRecordRef;
     CounterPtr mInEventsTotal;
@@ -27,9 +27,9 @@ namespace logtail {
 
 // Helper function to serialize common fields (tags and time)
 template <typename WriterType>
-void SerializeCommonFields(const SizedMap& tags, uint64_t timestamp, WriterType& writer) {
+void SerializeCommonFields(const GroupTags& tags, uint64_t timestamp, WriterType& writer) {
     // Serialize tags
-    for (const auto& tag : tags.mInner) {
+    for (const auto& tag : tags) {
         writer.Key(tag.first.to_string().c_str());
         writer.String(tag.second.to_string().c_str());
     }
@@ -38,13 +38,25 @@ void SerializeCommonFields(const SizedMap& tags, uint64_t timestamp, WriterType&
     writer.Uint64(timestamp);
 }
 
+bool JsonEventGroupSerializer::DoSerialize(const PipelineEventGroup& g, string& output, string& errorMsg) {
+    return RecordSerialize(
+        g.DataSize(), output, [&]() { return SerializeEvents(g.GetEvents(), g.GetTags(), output, errorMsg); });
+}
+
 bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, string& errorMsg) {
-    if (group.mEvents.empty()) {
+    return SerializeEvents(group.mEvents, group.mTags.mInner, res, errorMsg);
+}
+
+bool JsonEventGroupSerializer::SerializeEvents(const EventsContainer& events,
+                                               const GroupTags& tags,
+                                               string& res,
+                                               string& errorMsg) {
+    if (events.empty()) {
         errorMsg = "empty event group";
         return false;
     }
 
-    PipelineEvent::Type eventType = group.mEvents[0]->GetType();
+    PipelineEvent::Type eventType = events[0]->GetType();
     if (eventType == PipelineEvent::Type::NONE) {
         // should not happen
         errorMsg = "unsupported event type in event group";
@@ -62,7 +74,7 @@ bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, str
     // TODO: should support nano second
     switch (eventType) {
         case PipelineEvent::Type::LOG:
-            for (const auto& item : group.mEvents) {
+            for (const auto& item : events) {
                 const auto& e = item.Cast<LogEvent>();
                 if (e.Empty()) {
                     continue;
@@ -70,7 +82,7 @@ bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, str
                 resetBuffer();
 
                 writer.StartObject();
-                SerializeCommonFields(group.mTags, e.GetTimestamp(), writer);
+                SerializeCommonFields(tags, e.GetTimestamp(), writer);
                 // contents
                 for (const auto& kv : e) {
                     writer.Key(kv.first.to_string().c_str());
@@ -83,7 +95,7 @@ bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, str
             break;
         case PipelineEvent::Type::METRIC:
             // TODO: key should support custom key
-            for (const auto& item : group.mEvents) {
+            for (const auto& item : events) {
                 const auto& e = item.Cast<MetricEvent>();
                 if (e.Is<std::monostate>()) {
                     continue;
@@ -91,7 +103,7 @@ bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, str
                 resetBuffer();
 
                 writer.StartObject();
-                SerializeCommonFields(group.mTags, e.GetTimestamp(), writer);
+                SerializeCommonFields(tags, e.GetTimestamp(), writer);
                 // __labels__
                 writer.Key(METRIC_RESERVED_KEY_LABELS.c_str());
                 writer.StartObject();
@@ -123,7 +135,7 @@ bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, str
             }
             break;
         case PipelineEvent::Type::RAW:
-            for (const auto& item : group.mEvents) {
+            for (const auto& item : events) {
                 const auto& e = item.Cast<RawEvent>();
                 if (e.GetContent().empty()) {
                     continue;
@@ -131,7 +143,7 @@ bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, str
                 resetBuffer();
 
                 writer.StartObject();
-                SerializeCommonFields(group.mTags, e.GetTimestamp(), writer);
+                SerializeCommonFields(tags, e.GetTimestamp(), writer);
                 // content
                 writer.Key(DEFAULT_CONTENT_KEY.c_str());
                 writer.String(e.GetContent().to_string().c_str());
@@ -141,13 +153,13 @@ bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, str
             }
             break;
         case PipelineEvent::Type::SPAN:
-            for (const auto& item : group.mEvents) {
+            for (const auto& item : events) {
                 const auto& e = item.Cast<SpanEvent>();
 
                 resetBuffer();
 
                 writer.StartObject();
-                SerializeCommonFields(group.mTags, e.GetTimestamp(), writer);
+                SerializeCommonFields(tags, e.GetTimestamp(), writer);
 
                 writer.Key(DEFAULT_TRACE_TAG_TRACE_ID.data(), DEFAULT_TRACE_TAG_TRACE_ID.size());
                 writer.String(e.GetTraceId().data(), e.GetTraceId().size());
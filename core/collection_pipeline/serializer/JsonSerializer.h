@@ -27,8 +27,13 @@ class JsonEventGroupSerializer : public Serializer<BatchedEvents> {
 public:
     JsonEventGroupSerializer(Flusher* f) : Serializer<BatchedEvents>(f) {}
 
+    using Serializer<BatchedEvents>::DoSerialize;
+    // the group is only read, so it can still be shared with other flushers
+    bool DoSerialize(const PipelineEventGroup& g, std::string& output, std::string& errorMsg);
+
 private:
     bool Serialize(BatchedEvents&& p, std::string& res, std::string& errorMsg) override;
+    bool SerializeEvents(const EventsContainer& events, const GroupTags& tags, std::string& res, std::string& errorMsg);
 };
 
 } // namespace logtail
@@ -59,6 +59,7 @@ public:
         mOutItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_OUT_ITEMS_TOTAL);
         mOutItemSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_OUT_SIZE_BYTES);
         mTotalProcessMs = mMetricsRecordRef.CreateTimeCounter(METRIC_COMPONENT_TOTAL_PROCESS_TIME_MS);
+        mLatencyMs = mMetricsRecordRef.CreateLatencyHistogram(METRIC_COMPONENT_LATENCY_MS);
         mDiscardedItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_DISCARDED_ITEMS_TOTAL);
         mDiscardedItemSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_DISCARDED_SIZE_BYTES);
         WriteMetrics::GetInstance()->CommitMetricsRecordRef(mMetricsRecordRef);
@@ -66,13 +67,20 @@ public:
     virtual ~Serializer() = default;
 
     bool DoSerialize(T&& p, std::string& output, std::string& errorMsg) {
-        auto inputSize = GetInputSize(p);
+        return RecordSerialize(GetInputSize(p), output, [&]() { return Serialize(std::move(p), output, errorMsg); });
+    }
+
+protected:
+    template <typename F>
+    bool RecordSerialize(size_t inputSize, const std::string& output, F&& serialize) {
         ADD_COUNTER(mInItemsTotal, 1);
         ADD_COUNTER(mInItemSizeBytes, inputSize);
 
         auto before = std::chrono::system_clock::now();
-        auto res = Serialize(std::move(p), output, errorMsg);
-        ADD_COUNTER(mTotalProcessMs, std::chrono::system_clock::now() - before);
+        auto res = serialize();
+        auto processTime = std::chrono::system_clock::now() - before;
+        ADD_COUNTER(mTotalProcessMs, processTime);
+        OBSERVE_HISTOGRAM(mLatencyMs, processTime);
 
         if (res) {
             ADD_COUNTER(mOutItemsTotal, 1);
@@ -84,7 +92,6 @@ public:
         return res;
     }
 
-protected:
     // if serialized output contains output related info, it can be obtained via this member
     const Flusher* mFlusher = nullptr;
 
@@ -96,6 +103,7 @@ protected:
     CounterPtr mDiscardedItemsTotal;
     CounterPtr mDiscardedItemSizeBytes;
     TimeCounterPtr mTotalProcessMs;
+    LatencyHistogramPtr mLatencyMs;
 
 private:
     virtual bool Serialize(T&& p, std::string& res, std::string& errorMsg) = 0;
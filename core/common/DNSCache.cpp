@@ -23,10 +23,154 @@
 #include <ws2tcpip.h>
 #endif
 
-DEFINE_FLAG_INT32(dns_cache_ttl_sec, "", 600);
+#include <algorithm>
+#include <chrono>
+
+DEFINE_FLAG_INT32(dns_cache_ttl_sec, "ttl of a resolved host when the ttl of the record is unknown", 600);
+DEFINE_FLAG_INT32(dns_cache_negative_ttl_sec, "interval to retry resolving a host after a failure", 3);
+
+using namespace std;
 
 namespace logtail {
-DnsCache::DnsCache(const int32_t ttlSeconds) : mUpdateTime(time(NULL)), mDnsTTL(ttlSeconds) {
+
+DnsCache::DnsCache()
+    : mSnapshot(make_shared<const Snapshot>()), mResolver([](const string& host, string& ip, int32_t& ttlSec) {
+          return ParseHost(host.c_str(), ip);
+      }),
+      mClock([]() { return static_cast<int32_t>(time(NULL)); }) {
+}
+
+bool DnsCache::GetIPFromDnsCache(const string& host, string& address) {
+    if (!host.empty() && IsRawIp(host.c_str())) {
+        address = host;
+        return true;
+    }
+    int32_t now = mClock();
+    auto snapshot = atomic_load(&mSnapshot);
+    auto it = snapshot->find(host);
+    if (it == snapshot->end()) {
+        RequestResolve(host);
+        return false;
+    }
+    Entry& entry = *it->second;
+    if (entry.mLastAccessTime.load(memory_order_relaxed) != now) {
+        entry.mLastAccessTime.store(now, memory_order_relaxed);
+    }
+    // normally refreshed before, unless the resolving thread is late
+    if (now >= entry.mExpireTime && !entry.mRefreshRequested.exchange(true)) {
+        RequestResolve(host);
+    }
+    if (entry.mAddress.empty()) {
+        return false;
+    }
+    address = entry.mAddress;
+    return true;
+}
+
+void DnsCache::Stop() {
+    {
+        lock_guard<mutex> lock(mMux);
+        mIsStopped = true;
+        if (!mIsRunning) {
+            return;
+        }
+        mIsRunning = false;
+    }
+    mCond.notify_all();
+    if (mThreadRes.valid()) {
+        mThreadRes.wait_for(chrono::seconds(1));
+    }
+}
+
+void DnsCache::RequestResolve(const string& host) {
+    lock_guard<mutex> lock(mMux);
+    // restarting would replace the future of the old thread, whose destructor waits for the thread to exit, which in
+    // turn may wait for mMux
+    if (mIsStopped) {
+        return;
+    }
+    if (!mPendingHosts.insert(host).second) {
+        return;
+    }
+    mQueue.push_back(host);
+    if (!mIsRunning) {
+        mIsRunning = true;
+        mThreadRes = async(launch::async, &DnsCache::Run, this);
+    }
+    mCond.notify_one();
+}
+
+void DnsCache::Run() {
+    unique_lock<mutex> lock(mMux);
+    while (mIsRunning) {
+        mCond.wait_for(lock, chrono::seconds(1), [this]() { return !mQueue.empty() || !mIsRunning; });
+        if (!mIsRunning) {
+            break;
+        }
+        vector<string> hosts;
+        hosts.swap(mQueue);
+        lock.unlock();
+        ResolveHosts(hosts);
+        lock.lock();
+        for (const auto& host : hosts) {
+            mPendingHosts.erase(host);
+        }
+    }
+}
+
+vector<string> DnsCache::CollectRefreshHosts(Snapshot& snapshot, int32_t now) const {
+    vector<string> hosts;
+    for (auto it = snapshot.begin(); it != snapshot.end();) {
+        Entry& entry = *it->second;
+        if (entry.mLastAccessTime.load(memory_order_relaxed) < entry.mUpdateTime) {
+            if (now >= entry.mExpireTime) {
+                it = snapshot.erase(it);
+            } else {
+                ++it;
+            }
+            continue;
+        }
+        // refreshed during the last tenth of the ttl
+        int32_t ttl = entry.mExpireTime - entry.mUpdateTime;
+        if (now >= entry.mExpireTime - ttl / 10 && !entry.mRefreshRequested.exchange(true)) {
+            hosts.push_back(it->first);
+        }
+        ++it;
+    }
+    return hosts;
+}
+
+void DnsCache::ResolveHosts(const vector<string>& requestedHosts) {
+    auto snapshot = make_shared<Snapshot>(*atomic_load(&mSnapshot));
+    size_t size = snapshot->size();
+    auto hosts = CollectRefreshHosts(*snapshot, mClock());
+    for (const auto& host : requestedHosts) {
+        if (find(hosts.begin(), hosts.end(), host) == hosts.end()) {
+            hosts.push_back(host);
+        }
+    }
+    if (hosts.empty()) {
+        if (snapshot->size() != size) {
+            atomic_store(&mSnapshot, shared_ptr<const Snapshot>(snapshot));
+        }
+        return;
+    }
+    // each result is published at once, so that a slow host does not delay the others
+    for (const auto& host : hosts) {
+        string ip;
+        int32_t ttl = INT32_FLAG(dns_cache_ttl_sec);
+        bool success = mResolver(host, ip, ttl);
+        int32_t now = mClock();
+        auto& entry = (*snapshot)[host];
+        if (success) {
+            entry = make_shared<Entry>(ip, now, now + max(ttl, 1));
+        } else {
+            entry = make_shared<Entry>(entry ? entry->mAddress : string(),
+                                       now,
+                                       now + max(INT32_FLAG(dns_cache_negative_ttl_sec), 1));
+        }
+        atomic_store(&mSnapshot, make_shared<const Snapshot>(*snapshot));
+    }
 }
 
 // ParseHost only supports IPv4 now.
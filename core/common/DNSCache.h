@@ -19,72 +19,69 @@
 #include <cstdint>
 #include <ctime>
 
-#include <map>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "common/Flags.h"
 
 DECLARE_FLAG_INT32(dns_cache_ttl_sec);
+DECLARE_FLAG_INT32(dns_cache_negative_ttl_sec);
 
 namespace logtail {
 
+// DnsCache never resolves a host on the caller's thread. Hosts are resolved by a dedicated thread, started on the first
+// miss, which publishes the results as immutable snapshots, so that a lookup is a snapshot load plus a hash lookup.
+// Note that the snapshot load is not lock-free: atomic_load on a shared_ptr takes a lock from a small internal pool in
+// libstdc++, which is only held to copy the pointer and is never held while a host is being resolved.
+// - A miss returns false at once, and the caller should use the host as it is until the host is resolved.
+// - A failed resolution is cached for dns_cache_negative_ttl_sec, keeping the last known address if any.
+// - An entry used since its last resolution is refreshed before it expires, and an expired entry is still served
+//   until the refreshed one is published. Entries not used during their ttl are evicted.
 class DnsCache {
-    int32_t mUpdateTime;
-    int32_t mDnsTTL;
-    std::mutex mDnsCacheLock;
-    std::map<std::string, std::pair<std::string, int32_t>> mDnsCacheData;
-
 public:
+    // @param ttlSec set to the ttl of the record if known, dns_cache_ttl_sec is used otherwise
+    using Resolver = std::function<bool(const std::string& host, std::string& ip, int32_t& ttlSec)>;
+    // @return the current time in seconds
+    using Clock = std::function<int32_t()>;
+
+    DnsCache(const DnsCache&) = delete;
+    DnsCache& operator=(const DnsCache&) = delete;
+
     static DnsCache* GetInstance() {
         static DnsCache singleton;
         return &singleton;
     }
 
-    bool UpdateHostInDnsCache(const std::string& host, std::string& address) {
-        int32_t currentTime = time(NULL);
-        bool status = false;
-        std::lock_guard<std::mutex> lock(mDnsCacheLock);
-
-        auto itr = mDnsCacheData.find(host);
-        if (itr == mDnsCacheData.end() || currentTime - (itr->second).second >= 3) {
-            if (ParseHost(host.c_str(), address)) {
-                status = true;
-                mDnsCacheData[host] = std::make_pair(address, currentTime);
-            } else {
-                if (itr == mDnsCacheData.end()) {
-                    mDnsCacheData[host] = std::make_pair(host, currentTime);
-                } else {
-                    mDnsCacheData[host] = std::make_pair((itr->second).first, currentTime);
-                }
-            }
-        }
-
-        return status;
-    }
-
-    bool GetIPFromDnsCache(const std::string& host, std::string& address) {
-        bool found = false;
-        {
-            std::lock_guard<std::mutex> lock(mDnsCacheLock);
-            if (!RemoveTimeOutDnsCache()) // not time out
-            {
-                auto itr = mDnsCacheData.find(host);
-                if (itr != mDnsCacheData.end()) {
-                    address = (itr->second).first;
-                    found = true;
-                }
-            }
-        }
-        if (!found) // time out or not found
-            return UpdateHostInDnsCache(host, address);
-        return found;
-    }
+    bool GetIPFromDnsCache(const std::string& host, std::string& address);
+    // no host is resolved any more once stopped, and only the entries resolved before are served
+    void Stop();
 
 private:
-    DnsCache(const int32_t ttlSeconds = INT32_FLAG(dns_cache_ttl_sec));
-    ~DnsCache() = default;
-
-    bool IsRawIp(const char* host) {
+    struct Entry {
+        Entry(const std::string& address, int32_t updateTime, int32_t expireTime)
+            : mAddress(address), mUpdateTime(updateTime), mExpireTime(expireTime) {}
+
+        // empty if the host has never been resolved
+        std::string mAddress;
+        int32_t mUpdateTime = 0;
+        int32_t mExpireTime = 0;
+        std::atomic_int32_t mLastAccessTime = 0;
+        std::atomic_bool mRefreshRequested = false;
+    };
+    using Snapshot = std::unordered_map<std::string, std::shared_ptr<Entry>>;
+
+    DnsCache();
+    ~DnsCache() { Stop(); }
+
+    static bool IsRawIp(const char* host) {
         unsigned char c, *p;
         p = (unsigned char*)host;
         while ((c = (*p++)) != '\0') {
@@ -94,18 +91,29 @@ private:
         return true;
     }
 
-    bool ParseHost(const char* host, std::string& ip);
-
-    bool RemoveTimeOutDnsCache() {
-        int32_t currentTime = time(NULL);
-        bool isTimeOut = false;
-        if (currentTime - mUpdateTime >= mDnsTTL) {
-            isTimeOut = true;
-            mDnsCacheData.clear();
-            mUpdateTime = currentTime;
-        }
-        return isTimeOut;
-    }
+    static bool ParseHost(const char* host, std::string& ip);
+
+    void RequestResolve(const std::string& host);
+    void Run();
+    // @return the hosts to be refreshed before they expire, and removes the entries not used during their ttl
+    std::vector<std::string> CollectRefreshHosts(Snapshot& snapshot, int32_t now) const;
+    void ResolveHosts(const std::vector<std::string>& hosts);
+
+    std::shared_ptr<const Snapshot> mSnapshot;
+    Resolver mResolver;
+    Clock mClock;
+
+    std::mutex mMux;
+    std::condition_variable mCond;
+    std::vector<std::string> mQueue;
+    std::unordered_set<std::string> mPendingHosts;
+    bool mIsRunning = false;
+    bool mIsStopped = false;
+    std::future<void> mThreadRes;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class DnsCacheUnittest;
+#endif
 };
 
 } // namespace logtail
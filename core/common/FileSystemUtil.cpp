@@ -48,6 +48,22 @@ std::string ParentPath(const std::string& path) {
     return p.parent_path().string();
 }
 
+std::vector<std::string> SplitPath(const std::string& path) {
+    std::vector<std::string> components;
+    size_t begin = 0;
+    while (begin < path.size()) {
+        size_t end = path.find(PATH_SEPARATOR[0], begin);
+        if (end == std::string::npos) {
+            end = path.size();
+        }
+        if (end > begin) {
+            components.emplace_back(path, begin, end - begin);
+        }
+        begin = end + 1;
+    }
+    return components;
+}
+
 bool CheckExistance(const std::string& path) {
     boost::system::error_code ec;
     boost::filesystem::path p(path);
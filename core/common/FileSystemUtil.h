@@ -50,6 +50,9 @@ inline std::string PathJoin(const std::string& base, const std::string& sub) {
 
 std::string ParentPath(const std::string& path);
 
+// SplitPath returns the non-empty components of @path, /a//b/ -> [a, b].
+std::vector<std::string> SplitPath(const std::string& path);
+
 // CheckExistance checks whether the dir or file specified by @path is exist or not.
 bool CheckExistance(const std::string& path);
 
@@ -514,7 +514,7 @@ bool ProcParser::ReadProcessStat(pid_t pid, ProcessStat& ps) const {
 // 1 (cat) R 0 1 1 34816 1 4194560 1110 0 0 0 1 1 0 0 20 0 1 0 18938584 4505600 171 18446744073709551615 4194304 4238788
 // 140727020025920 0 0 0 0 0 0 0 0 0 17 3 0 0 0 0 0 6336016 6337300 21442560 140727020027760 140727020027777
 // 140727020027777 140727020027887 0
-bool ProcParser::ParseProcessStat(pid_t pid, const std::string& line, ProcessStat& ps) const {
+bool ProcParser::ParseProcessStat(pid_t pid, StringView line, ProcessStat& ps) const {
     ps.pid = pid;
     auto nameStartPos = line.find_first_of('(');
     auto nameEndPos = line.find_last_of(')');
@@ -523,8 +523,8 @@ bool ProcParser::ParseProcessStat(pid_t pid, const std::string& line, ProcessSta
         return false;
     }
     nameStartPos++; // 跳过左括号
-    ps.name = line.substr(nameStartPos, nameEndPos - nameStartPos);
-    StringView lineview = StringView(line).substr(nameEndPos + 2); // 跳过右括号及空格
+    ps.name.assign(line.data() + nameStartPos, nameEndPos - nameStartPos);
+    StringView lineview = line.substr(nameEndPos + 2); // 跳过右括号及空格
 
     std::array<StringView, size_t(EnumProcessStat::_count)> words{};
     StringViewSplitter splitter(lineview, " ");
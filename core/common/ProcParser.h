@@ -203,7 +203,7 @@ public:
     std::string GetPIDEnviron(uint32_t pid) const;
     uint32_t GetPIDCWD(uint32_t pid, std::string& cwd) const;
     bool ReadProcessStat(pid_t pid, ProcessStat& ps) const;
-    bool ParseProcessStat(pid_t pid, const std::string& line, ProcessStat& ps) const;
+    bool ParseProcessStat(pid_t pid, StringView line, ProcessStat& ps) const;
     bool ReadProcessStatus(pid_t pid, ProcessStatus& ps) const;
     bool ParseProcessStatus(pid_t pid, const std::string& content, ProcessStatus& ps) const;
     int64_t GetStatsKtime(ProcessStat& procStat) const;
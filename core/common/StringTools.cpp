@@ -298,6 +298,246 @@ bool BoostRegexSearch(const char* buffer, const boost::regex& reg, string& excep
     }
 }
 
+// The literal chars found outside of any group, class or alternation of a regex must appear in order in every string
+// matched by it.
+void GetRegexRequiredLiterals(const string& exp, vector<string>& literals) {
+    static const char* sSpecialChars = "\\^$.|?*+()[]{}";
+    vector<string> res;
+    string run;
+    auto endRun = [&]() {
+        if (!run.empty()) {
+            res.emplace_back(move(run));
+            run.clear();
+        }
+    };
+    // @return the index after the class starting at i, or npos
+    auto skipClass = [&](size_t i) -> size_t {
+        ++i;
+        if (i < exp.size() && exp[i] == '^') {
+            ++i;
+        }
+        if (i < exp.size() && exp[i] == ']') {
+            ++i;
+        }
+        for (; i < exp.size(); ++i) {
+            if (exp[i] == '\\') {
+                ++i;
+            } else if (exp[i] == '[' && i + 1 < exp.size() && exp[i + 1] == ':') {
+                i = exp.find(":]", i + 2);
+                if (i == string::npos) {
+                    return i;
+                }
+                ++i;
+            } else if (exp[i] == ']') {
+                return i + 1;
+            }
+        }
+        return string::npos;
+    };
+
+    size_t i = 0;
+    while (i < exp.size()) {
+        char c = exp[i];
+        if (c == '|' || c == ')') {
+            return;
+        }
+        if (c == '(') {
+            // inline modifiers and comments
+            if (i + 2 < exp.size() && exp[i + 1] == '?' && strchr(":=!<", exp[i + 2]) == nullptr) {
+                return;
+            }
+            endRun();
+            size_t depth = 0;
+            for (; i < exp.size(); ++i) {
+                if (exp[i] == '\\') {
+                    // a quoted ) does not close the group
+                    if (i + 1 < exp.size() && exp[i + 1] == 'Q') {
+                        return;
+                    }
+                    ++i;
+                } else if (exp[i] == '[') {
+                    i = skipClass(i);
+                    if (i == string::npos) {
+                        return;
+                    }
+                    --i;
+                } else if (exp[i] == '(') {
+                    ++depth;
+                } else if (exp[i] == ')' && --depth == 0) {
+                    break;
+                }
+            }
+            if (i >= exp.size()) {
+                return;
+            }
+            ++i;
+            continue;
+        }
+        if (c == '[') {
+            endRun();
+            i = skipClass(i);
+            if (i == string::npos) {
+                return;
+            }
+            continue;
+        }
+        if (c == '{') {
+            endRun();
+            i = exp.find('}', i);
+            if (i == string::npos) {
+                return;
+            }
+            ++i;
+            continue;
+        }
+        char lit = c;
+        if (c == '\\') {
+            // quoting, and escapes followed by a code, a name or a property of variable length
+            if (i + 1 == exp.size() || strchr("QxucNpPgko", exp[i + 1]) != nullptr
+                || isdigit(static_cast<unsigned char>(exp[i + 1]))) {
+                return;
+            }
+            lit = exp[i + 1];
+            // char classes, anchors and back references
+            if (isalnum(static_cast<unsigned char>(lit))) {
+                endRun();
+                i += 2;
+                continue;
+            }
+            ++i;
+        } else if (strchr(sSpecialChars, c) != nullptr) {
+            endRun();
+            ++i;
+            continue;
+        }
+        ++i;
+        char next = i < exp.size() ? exp[i] : '\0';
+        if (next == '?' || next == '*' || next == '{') {
+            endRun();
+        } else {
+            run.push_back(lit);
+            if (next == '+') {
+                endRun();
+            }
+        }
+    }
+    endRun();
+    for (auto& literal : res) {
+        literals.emplace_back(move(literal));
+    }
+}
+
+bool GetRegexFirstChars(const string& exp, bitset<256>& chars) {
+    chars.reset();
+    // an alternation may skip the first atom
+    if (exp.find('|') != string::npos) {
+        return false;
+    }
+    size_t i = 0;
+    while (i < exp.size() && exp[i] == '^') {
+        ++i;
+    }
+    if (i == exp.size()) {
+        return false;
+    }
+    // @return false if the escaped char at i is not understood, otherwise i is moved past it
+    auto addEscaped = [&](size_t& i, char& lit) -> bool {
+        if (i + 1 >= exp.size()) {
+            return false;
+        }
+        char c = exp[i + 1];
+        i += 2;
+        lit = '\0';
+        if (c == 'd') {
+            for (char d = '0'; d <= '9'; ++d) {
+                chars.set(static_cast<unsigned char>(d));
+            }
+        } else if (c == 'w') {
+            // word chars beyond ascii depend on the locale
+            for (size_t j = 0; j < 256; ++j) {
+                if (j >= 0x80 || isalnum(static_cast<int>(j)) || j == '_') {
+                    chars.set(j);
+                }
+            }
+        } else if (isalnum(static_cast<unsigned char>(c))) {
+            return false;
+        } else {
+            lit = c;
+            chars.set(static_cast<unsigned char>(c));
+        }
+        return true;
+    };
+
+    char c = exp[i];
+    if (c == '[') {
+        ++i;
+        if (i < exp.size() && exp[i] == '^') {
+            return false;
+        }
+        bool first = true;
+        while (true) {
+            if (i >= exp.size() || exp[i] == '[') {
+                return false;
+            }
+            if (exp[i] == ']' && !first) {
+                ++i;
+                break;
+            }
+            first = false;
+            char lo = exp[i];
+            if (lo == '\\') {
+                if (!addEscaped(i, lo)) {
+                    return false;
+                }
+                if (lo == '\0') {
+                    continue;
+                }
+            } else {
+                chars.set(static_cast<unsigned char>(lo));
+                ++i;
+            }
+            if (i + 1 < exp.size() && exp[i] == '-' && exp[i + 1] != ']') {
+                char hi = exp[i + 1];
+                if (hi == '\\' || hi == '[' || static_cast<unsigned char>(hi) < static_cast<unsigned char>(lo)) {
+                    return false;
+                }
+                for (size_t j = static_cast<unsigned char>(lo); j <= static_cast<unsigned char>(hi); ++j) {
+                    chars.set(j);
+                }
+                i += 2;
+            }
+        }
+    } else if (c == '\\') {
+        char lit;
+        if (!addEscaped(i, lit)) {
+            return false;
+        }
+    } else if (strchr("$.|?*+()[]{}", c) != nullptr) {
+        return false;
+    } else {
+        chars.set(static_cast<unsigned char>(c));
+        ++i;
+    }
+
+    // the first atom must not be optional
+    if (i < exp.size()) {
+        if (exp[i] == '?' || exp[i] == '*') {
+            return false;
+        }
+        if (exp[i] == '{') {
+            // the min count must be positive
+            bool positive = false;
+            for (size_t j = i + 1; j < exp.size() && isdigit(static_cast<unsigned char>(exp[j])); ++j) {
+                positive |= exp[j] != '0';
+            }
+            if (!positive) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 uint32_t GetLittelEndianValue32(const uint8_t* buffer) {
     return buffer[3] << 24 | buffer[2] << 16 | buffer[1] << 8 | buffer[0];
 }
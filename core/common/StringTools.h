@@ -19,6 +19,7 @@
 #include <charconv>
 
 #include <algorithm>
+#include <bitset>
 #include <filesystem>
 #include <string>
 #include <vector>
@@ -141,6 +142,13 @@ bool BoostRegexMatch(const char* buffer, const boost::regex& reg, std::string& e
 bool BoostRegexSearch(const char* buffer, size_t size, const boost::regex& reg, std::string& exception);
 bool BoostRegexSearch(const char* buffer, const boost::regex& reg, std::string& exception);
 
+// Regex analysis for prefiltering, constructs not understood give up the analysis.
+// Collects the runs of literal chars that any string matched by the regex must contain.
+void GetRegexRequiredLiterals(const std::string& exp, std::vector<std::string>& literals);
+// Collects the chars that a match of the regex from the beginning of a string can start with.
+/// @return false if the chars cannot be told, e.g. the regex may match an empty string
+bool GetRegexFirstChars(const std::string& exp, std::bitset<256>& chars);
+
 // GetLittelEndianValue32 converts @buffer in little endian to uint32_t.
 uint32_t GetLittelEndianValue32(const uint8_t* buffer);
 
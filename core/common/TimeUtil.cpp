@@ -17,6 +17,7 @@
 #include <cmath>
 #include <memory.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <limits>
@@ -24,6 +25,8 @@
 #include <ctime>
 #include <sys/sysinfo.h>
 #include <utmp.h>
+#elif defined(_MSC_VER)
+#include <Windows.h>
 #endif
 #include "common/LogtailCommonFlags.h"
 #include "common/ParamExtractor.h"
@@ -102,6 +105,211 @@ int DeduceYear(const struct tm* tm, const struct tm* currentTm) {
     return currentTm->tm_year;
 }
 
+static const int64_t kSecondsPerDay = 86400;
+
+// days since 1970-01-01 of the proleptic gregorian date, month in [1, 12]
+static int64_t DaysFromCivil(int64_t year, int64_t month, int64_t day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t yoe = year - era * 400;
+    int64_t doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+static void CivilFromDays(int64_t days, int64_t& year, int64_t& month, int64_t& day) {
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t doe = days - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    day = doy - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = yoe + era * 400 + (month <= 2);
+}
+
+LocalTimeZone* LocalTimeZone::GetInstance() {
+    static LocalTimeZone sInstance;
+    return &sInstance;
+}
+
+LocalTimeZone::LocalTimeZone() {
+#if defined(__linux__)
+    auto probe = [](int64_t t, Period& period) {
+        time_t tt = t;
+        struct tm timeInfo;
+        if (NULL == localtime_r(&tt, &timeInfo)) {
+            return false;
+        }
+        period.mOffset = timeInfo.tm_gmtoff;
+        period.mIsDst = timeInfo.tm_isdst > 0;
+        return true;
+    };
+    // the timezone is probed once a day, a transition found is then located to the second
+    int64_t begin = time(NULL) / kSecondsPerDay * kSecondsPerDay - 20 * 365 * kSecondsPerDay;
+    int64_t end = begin + 30 * 365 * kSecondsPerDay;
+    Period cur;
+    cur.mBegin = begin;
+    if (!probe(begin, cur)) {
+        return;
+    }
+    mPeriods.push_back(cur);
+    for (int64_t t = begin + kSecondsPerDay; t <= end; t += kSecondsPerDay) {
+        Period next;
+        if (!probe(t, next)) {
+            mPeriods.clear();
+            return;
+        }
+        if (next.mOffset == cur.mOffset && next.mIsDst == cur.mIsDst) {
+            continue;
+        }
+        int64_t lo = t - kSecondsPerDay, hi = t;
+        while (hi - lo > 1) {
+            int64_t mid = lo + (hi - lo) / 2;
+            Period period;
+            if (!probe(mid, period)) {
+                mPeriods.clear();
+                return;
+            }
+            if (period.mOffset == cur.mOffset && period.mIsDst == cur.mIsDst) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        next.mBegin = hi;
+        mPeriods.push_back(next);
+        cur = next;
+    }
+    mEnd = end;
+#endif
+}
+
+time_t LocalTimeZone::ToEpoch(const struct tm& tm) const {
+    int64_t year = static_cast<int64_t>(tm.tm_year) + 1900 + tm.tm_mon / 12;
+    int64_t month = tm.tm_mon % 12;
+    if (month < 0) {
+        month += 12;
+        --year;
+    }
+    int64_t local = (DaysFromCivil(year, month + 1, 1) + tm.tm_mday - 1) * kSecondsPerDay + tm.tm_hour * 3600LL
+        + tm.tm_min * 60LL + tm.tm_sec;
+    int64_t idx = FindPeriod(local);
+    if (idx >= 0) {
+        // the offset at the local time taken as utc is a guess, which is right unless a transition lies in between
+        int64_t t = local - mPeriods[idx].mOffset;
+        idx = FindPeriod(t);
+        if (idx >= 0 && local - mPeriods[idx].mOffset != t) {
+            t = local - mPeriods[idx].mOffset;
+            int64_t newIdx = FindPeriod(t);
+            idx = newIdx >= 0 && mPeriods[newIdx].mOffset == mPeriods[idx].mOffset ? newIdx : idx;
+        }
+        if (idx >= 0 && tm.tm_isdst >= 0 && (tm.tm_isdst > 0) != mPeriods[idx].mIsDst) {
+            int32_t offset = 0;
+            if (FindDstOffset(t, idx, tm.tm_isdst > 0, offset)) {
+                t = local - offset;
+                idx = FindPeriod(t);
+            } else {
+                idx = -1;
+            }
+        }
+        if (idx >= 0) {
+            return t;
+        }
+    }
+    struct tm copy = tm;
+    return mktime(&copy);
+}
+
+void LocalTimeZone::ToLocalTime(time_t t, struct tm& tm) const {
+    int64_t idx = FindPeriod(t);
+    if (idx < 0) {
+#if defined(__linux__)
+        localtime_r(&t, &tm);
+#elif defined(_MSC_VER)
+        localtime_s(&tm, &t);
+#endif
+        return;
+    }
+    int64_t local = t + mPeriods[idx].mOffset;
+    int64_t days = local / kSecondsPerDay;
+    int64_t seconds = local % kSecondsPerDay;
+    if (seconds < 0) {
+        seconds += kSecondsPerDay;
+        --days;
+    }
+    int64_t year = 0, month = 0, day = 0;
+    CivilFromDays(days, year, month, day);
+    memset(&tm, 0, sizeof(tm));
+    tm.tm_year = year - 1900;
+    tm.tm_mon = month - 1;
+    tm.tm_mday = day;
+    tm.tm_hour = seconds / 3600;
+    tm.tm_min = seconds % 3600 / 60;
+    tm.tm_sec = seconds % 60;
+    // 1970-01-01 is a thursday
+    tm.tm_wday = ((days + 4) % 7 + 7) % 7;
+    tm.tm_yday = days - DaysFromCivil(year, 1, 1);
+    tm.tm_isdst = mPeriods[idx].mIsDst ? 1 : 0;
+#if defined(__linux__)
+    tm.tm_gmtoff = mPeriods[idx].mOffset;
+#endif
+}
+
+int64_t LocalTimeZone::FindPeriod(int64_t t) const {
+    if (mPeriods.empty() || t < mPeriods[0].mBegin || t >= mEnd) {
+        return -1;
+    }
+    auto it = std::upper_bound(
+        mPeriods.begin(), mPeriods.end(), t, [](int64_t t, const Period& period) { return t < period.mBegin; });
+    return it - mPeriods.begin() - 1;
+}
+
+bool LocalTimeZone::FindDstOffset(int64_t t, int64_t idx, bool isDst, int32_t& offset) const {
+    // the same probes as mktime, which takes the offset of the first neighboring time found with the dst flag
+    const int64_t stride = 601200;
+    const int64_t deltaBound = 536454000 / 2 + stride;
+    for (int64_t delta = stride; delta < deltaBound; delta += stride) {
+        for (int64_t direction = -1; direction <= 1; direction += 2) {
+            int64_t probeIdx = FindPeriod(t + delta * direction);
+            if (probeIdx < 0) {
+                return false;
+            }
+            if (mPeriods[probeIdx].mIsDst == isDst) {
+                offset = mPeriods[probeIdx].mOffset;
+                return true;
+            }
+        }
+    }
+    // otherwise dst is taken as one hour ahead
+    offset = mPeriods[idx].mOffset + 3600 * (static_cast<int>(isDst) - static_cast<int>(mPeriods[idx].mIsDst));
+    return true;
+}
+
+// fills the year missing in tm as requested by specifiedYear, see Strptime, and converts tm to epoch
+static time_t LocalTimeWithYearToEpoch(struct tm* tm, int32_t specifiedYear) {
+    const int32_t MIN_YEAR = std::numeric_limits<decltype(tm->tm_year)>::min();
+    if (specifiedYear < 0 || tm->tm_year != MIN_YEAR) {
+        return LocalTimeZone::GetInstance()->ToEpoch(*tm);
+    }
+
+    // Mode 1.
+    if (specifiedYear > 0) {
+        tm->tm_year = specifiedYear - 1900;
+        return LocalTimeZone::GetInstance()->ToEpoch(*tm);
+    }
+
+    // Mode 2: deduce year according to current time.
+    tm->tm_year = 0;
+    struct tm currentTm = {0};
+    LocalTimeZone::GetInstance()->ToLocalTime(time(0), currentTm);
+    auto deduction = DeduceYear(tm, &currentTm);
+    if (deduction != -1)
+        tm->tm_year = deduction;
+    return LocalTimeZone::GetInstance()->ToEpoch(*tm);
+}
+
 /*
     Parse time (local timezone) from log
     return the position of the parsing ends. If parsing fails, return NULL.
@@ -110,51 +318,184 @@ const char*
 Strptime(const char* buf, const char* fmt, LogtailTime* ts, int& nanosecondLength, int32_t specifiedYear /* = -1 */) {
     struct tm tm_ = {0};
     struct tm* tm = &tm_;
-    const int32_t MIN_YEAR = std::numeric_limits<decltype(tm->tm_year)>::min();
-    auto bakYear = tm->tm_year;
-    tm->tm_year = MIN_YEAR;
+    tm->tm_year = std::numeric_limits<decltype(tm->tm_year)>::min();
 
     auto ret = strptime_ns(buf, fmt, tm, &ts->tv_nsec, &nanosecondLength);
     if (0 == strcmp("%f", fmt)) {
         return ret;
     }
+    ts->tv_sec = LocalTimeWithYearToEpoch(tm, specifiedYear);
+    return ret;
+}
 
-    if (specifiedYear < 0) {
-        ts->tv_sec = mktime(tm);
-        return ret;
+TimeFormat::TimeFormat(const std::string& format) : mFormat(format) {
+    // the nanosecond alone is parsed without the epoch by Strptime
+    if (format == "%f") {
+        return;
     }
-
-    // Do not specify: already got year information.
-    if (tm->tm_year != MIN_YEAR) {
-        ts->tv_sec = mktime(tm);
-        return ret;
+    std::vector<Field> fields;
+    bool hasShortYear = false;
+    for (size_t i = 0; i < format.size(); ++i) {
+        char c = format[i];
+        if (isspace(static_cast<unsigned char>(c))) {
+            fields.push_back({FieldType::SPACE, c});
+            continue;
+        }
+        if (c != '%') {
+            fields.push_back({FieldType::LITERAL, c});
+            continue;
+        }
+        if (++i == format.size()) {
+            return;
+        }
+        switch (format[i]) {
+            case '%':
+                fields.push_back({FieldType::LITERAL, '%'});
+                break;
+            case 'Y':
+                fields.push_back({FieldType::YEAR, '\0'});
+                break;
+            case 'y':
+                // a second one keeps the century of the first one
+                if (hasShortYear) {
+                    return;
+                }
+                hasShortYear = true;
+                fields.push_back({FieldType::SHORT_YEAR, '\0'});
+                break;
+            case 'm':
+                fields.push_back({FieldType::MONTH, '\0'});
+                break;
+            case 'd':
+                fields.push_back({FieldType::DAY, '\0'});
+                break;
+            case 'H':
+                fields.push_back({FieldType::HOUR, '\0'});
+                break;
+            case 'M':
+                fields.push_back({FieldType::MINUTE, '\0'});
+                break;
+            case 'S':
+                fields.push_back({FieldType::SECOND, '\0'});
+                break;
+            case 'f':
+                fields.push_back({FieldType::NANOSECOND, '\0'});
+                break;
+            case 'F':
+                fields.insert(fields.end(),
+                              {{FieldType::YEAR, '\0'},
+                               {FieldType::LITERAL, '-'},
+                               {FieldType::MONTH, '\0'},
+                               {FieldType::LITERAL, '-'},
+                               {FieldType::DAY, '\0'}});
+                break;
+            case 'T':
+                fields.insert(fields.end(),
+                              {{FieldType::HOUR, '\0'},
+                               {FieldType::LITERAL, ':'},
+                               {FieldType::MINUTE, '\0'},
+                               {FieldType::LITERAL, ':'},
+                               {FieldType::SECOND, '\0'}});
+                break;
+            default:
+                // names, timezones and the like are left to Strptime
+                return;
+        }
     }
+    mFields = std::move(fields);
+}
 
-    // Mode 1.
-    if (specifiedYear > 0) {
-        tm->tm_year = specifiedYear - 1900;
-        ts->tv_sec = mktime(tm);
-        return ret;
+// reads a field of exactly width digits, which strptime reads the same way when the value is in [lo, hi]
+static bool ReadFixedDigits(const char* buf, size_t size, size_t& pos, size_t width, int lo, int hi, int& value) {
+    if (pos + width > size) {
+        return false;
+    }
+    value = 0;
+    for (size_t i = 0; i < width; ++i) {
+        char c = buf[pos + i];
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + (c - '0');
+    }
+    if (value < lo || value > hi) {
+        return false;
     }
+    pos += width;
+    return true;
+}
 
-    // Mode 2: deduce year according to current time.
-    tm->tm_year = bakYear;
-    struct tm currentTm = {0};
-    time_t currentTime = time(0);
-#if defined(_MSC_VER)
-    if (localtime_s(&currentTm, &currentTime) != 0)
-#elif defined(__linux__)
-    if (NULL == localtime_r(&currentTime, &currentTm))
-#endif
-    {
-        LOG_WARNING(sLogger, ("Call localtime failed, errno", errno));
-        return ret;
+const char* TimeFormat::Parse(
+    const char* buf, size_t size, LogtailTime* ts, int& nanosecondLength, int32_t specifiedYear) const {
+    if (mFields.empty()) {
+        return Strptime(buf, mFormat.c_str(), ts, nanosecondLength, specifiedYear);
     }
-    auto deduction = DeduceYear(tm, &currentTm);
-    if (deduction != -1)
-        tm->tm_year = deduction;
-    ts->tv_sec = mktime(tm);
-    return ret;
+    struct tm tm = {0};
+    tm.tm_year = std::numeric_limits<decltype(tm.tm_year)>::min();
+    long nanosecond = 0;
+    int nanoLength = -1;
+    size_t pos = 0;
+    int value = 0;
+    bool matched = true;
+    for (auto it = mFields.begin(); matched && it != mFields.end(); ++it) {
+        switch (it->mType) {
+            case FieldType::LITERAL:
+                matched = pos < size && buf[pos] == it->mLiteral;
+                ++pos;
+                break;
+            case FieldType::SPACE:
+                while (pos < size && isspace(static_cast<unsigned char>(buf[pos]))) {
+                    ++pos;
+                }
+                break;
+            case FieldType::YEAR:
+                matched = ReadFixedDigits(buf, size, pos, 4, 0, 9999, value);
+                tm.tm_year = value - 1900;
+                break;
+            case FieldType::SHORT_YEAR:
+                matched = ReadFixedDigits(buf, size, pos, 2, 0, 99, value);
+                tm.tm_year = value <= 68 ? value + 100 : value;
+                break;
+            case FieldType::MONTH:
+                matched = ReadFixedDigits(buf, size, pos, 2, 1, 12, value);
+                tm.tm_mon = value - 1;
+                break;
+            case FieldType::DAY:
+                matched = ReadFixedDigits(buf, size, pos, 2, 1, 31, tm.tm_mday);
+                break;
+            case FieldType::HOUR:
+                matched = ReadFixedDigits(buf, size, pos, 2, 0, 23, tm.tm_hour);
+                break;
+            case FieldType::MINUTE:
+                matched = ReadFixedDigits(buf, size, pos, 2, 0, 59, tm.tm_min);
+                break;
+            case FieldType::SECOND:
+                matched = ReadFixedDigits(buf, size, pos, 2, 0, 61, tm.tm_sec);
+                break;
+            case FieldType::NANOSECOND: {
+                size_t begin = pos;
+                while (pos < size && pos - begin < 10 && buf[pos] >= '0' && buf[pos] <= '9') {
+                    nanosecond = nanosecond * 10 + (buf[pos++] - '0');
+                }
+                nanoLength = pos - begin;
+                // more than 9 digits overflow in strptime
+                matched = nanoLength > 0 && nanoLength < 10;
+                for (int i = nanoLength; i < 9; ++i) {
+                    nanosecond *= 10;
+                }
+                break;
+            }
+        }
+    }
+    if (!matched) {
+        return Strptime(buf, mFormat.c_str(), ts, nanosecondLength, specifiedYear);
+    }
+    ts->tv_nsec = nanosecond;
+    if (nanoLength >= 0) {
+        nanosecondLength = nanoLength;
+    }
+    ts->tv_sec = LocalTimeWithYearToEpoch(&tm, specifiedYear);
+    return buf + pos;
 }
 
 #if defined(__linux__)
@@ -367,6 +708,27 @@ uint64_t GetCurrentTimeInNanoSeconds() {
         .count();
 }
 
+int64_t GetThreadCpuTimeNs() {
+#if defined(__linux__)
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0;
+    }
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+#elif defined(_MSC_VER)
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+        return 0;
+    }
+    auto toNs = [](const FILETIME& t) {
+        return ((static_cast<int64_t>(t.dwHighDateTime) << 32) | t.dwLowDateTime) * 100;
+    };
+    return toNs(kernelTime) + toNs(userTime);
+#else
+    return 0;
+#endif
+}
+
 bool ParseTimeZoneOffsetSecond(const std::string& logTZ, int& logTZSecond) {
     if (logTZ.size() != strlen("GMT+08:00") || logTZ[6] != ':' || (logTZ[3] != '+' && logTZ[3] != '-')) {
         return false;
@@ -20,6 +20,7 @@
 #include <optional>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "common/Strptime.h"
 #include "protobuf/sls/sls_logs.pb.h"
@@ -50,6 +51,9 @@ uint64_t GetCurrentTimeInMicroSeconds();
 uint64_t GetCurrentTimeInMilliSeconds();
 uint64_t GetCurrentTimeInNanoSeconds();
 
+// Get cpu time consumed by the calling thread in ns.
+int64_t GetThreadCpuTimeNs();
+
 // Get offset between current time zone and UTC in seconds.
 // For example, for UTC+8, returns 8*60*60.
 int GetLocalTimeZoneOffsetSecond();
@@ -76,6 +80,69 @@ inline void sleep(uint64_t s) {
 const char*
 Strptime(const char* buf, const char* fmt, LogtailTime* ts, int& nanosecondLength, int32_t specifiedYear = -1);
 
+// LocalTimeZone keeps the UTC offsets of the local timezone over the years around its creation, probed once with
+// localtime_r, so that local time is converted without taking the libc timezone lock like mktime does.
+class LocalTimeZone {
+public:
+    // built on the first call, the timezone changed later is not taken into account
+    static LocalTimeZone* GetInstance();
+
+    LocalTimeZone();
+
+    // works like mktime, with tm.tm_isdst taken into account the same way. Times in a DST gap or overlap may be
+    // resolved differently, for which mktime depends on its previous calls.
+    time_t ToEpoch(const struct tm& tm) const;
+    // works like localtime_r, tm_gmtoff and tm_zone excluded
+    void ToLocalTime(time_t t, struct tm& tm) const;
+
+private:
+    struct Period {
+        int64_t mBegin = 0;
+        int32_t mOffset = 0;
+        bool mIsDst = false;
+    };
+
+    // @return the index of the period containing t, or -1 if t is out of the table
+    int64_t FindPeriod(int64_t t) const;
+    // finds the offset of a neighboring period of t with the dst flag, as mktime searches for it
+    /// @return false if the search goes out of the table
+    bool FindDstOffset(int64_t t, int64_t idx, bool isDst, int32_t& offset) const;
+
+    std::vector<Period> mPeriods;
+    int64_t mEnd = 0;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class TimeUtilUnittest;
+#endif
+};
+
+// TimeFormat is a strptime format compiled once, so that the common formats made of numeric fields, e.g.
+// %Y-%m-%d %H:%M:%S.%f, are parsed with fixed-width digit reads instead of interpreting the format for each string.
+// Formats and strings out of the compiled subset are handed to Strptime.
+class TimeFormat {
+public:
+    TimeFormat() = default;
+    explicit TimeFormat(const std::string& format);
+
+    // works like Strptime with the format, buf needs to be null-terminated only if it is handed to Strptime
+    const char* Parse(const char* buf,
+                      size_t size,
+                      LogtailTime* ts,
+                      int& nanosecondLength,
+                      int32_t specifiedYear = -1) const;
+    bool IsCompiled() const { return !mFields.empty(); }
+
+private:
+    enum class FieldType : uint8_t { LITERAL, SPACE, YEAR, SHORT_YEAR, MONTH, DAY, HOUR, MINUTE, SECOND, NANOSECOND };
+    struct Field {
+        FieldType mType;
+        char mLiteral;
+    };
+
+    std::string mFormat;
+    std::vector<Field> mFields;
+};
+
 int32_t GetSystemBootTime();
 
 // For feature enable_log_time_auto_adjust.
@@ -0,0 +1,11 @@
+#include "version.h"
+
+const char* const ILOGTAIL_VERSION = "0.0.1";
+const char* const ILOGTAIL_GIT_HASH = "c0081389b5557ec34ae3e7dfa7dd4adee3ad5382";
+const char* const ILOGTAIL_BUILD_DATE = "20261019";
+
+#if defined(__linux__)
+const char* const ILOGTAIL_UPDATE_SUFFIX = "";
+#elif defined(_MSC_VER)
+const char* const ILOGTAIL_UPDATE_SUFFIX = ".update";
+#endif
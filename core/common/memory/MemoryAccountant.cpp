@@ -0,0 +1,47 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/memory/MemoryAccountant.h"
+
+#include "common/Flags.h"
+
+DEFINE_FLAG_DOUBLE(memory_pressure_high_watermark,
+                   "ratio of the memory limit above which load shedding is escalated",
+                   0.8);
+DEFINE_FLAG_DOUBLE(memory_pressure_low_watermark,
+                   "ratio of the memory limit below which load shedding is relaxed",
+                   0.6);
+
+using namespace std;
+
+namespace logtail {
+
+MemoryPressureLevel MemoryAccountant::UpdatePressureLevel(uint64_t usedMb, uint64_t limitMb) {
+    auto level = static_cast<uint8_t>(GetPressureLevel());
+    if (limitMb == 0) {
+        level = static_cast<uint8_t>(MemoryPressureLevel::NORMAL);
+    } else if (usedMb > limitMb * DOUBLE_FLAG(memory_pressure_high_watermark)) {
+        if (level < static_cast<uint8_t>(MemoryPressureLevel::TRIM_POOL)) {
+            ++level;
+        }
+    } else if (usedMb < limitMb * DOUBLE_FLAG(memory_pressure_low_watermark)) {
+        if (level > static_cast<uint8_t>(MemoryPressureLevel::NORMAL)) {
+            --level;
+        }
+    }
+    mLevel.store(static_cast<MemoryPressureLevel>(level), memory_order_relaxed);
+    return static_cast<MemoryPressureLevel>(level);
+}
+
+} // namespace logtail
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace logtail {
+
+// SOURCE_BUFFER is the memory allocated by source buffers, where event data physically lives, while the other
+// categories are the size of the data held at each stage of the pipelines, so they overlap with SOURCE_BUFFER.
+enum class MemoryCategory : uint8_t { SOURCE_BUFFER, PROCESS_QUEUE, SENDER_QUEUE, BATCHER, COUNT };
+
+// each level keeps the measures of the lower ones
+enum class MemoryPressureLevel : uint8_t {
+    NORMAL,
+    // batchers flush earlier
+    SHRINK_BATCH,
+    // sender queues spill to disk instead of buffering in memory
+    SPILL_SENDER_QUEUE,
+    // lowest priority process queues stop accepting data
+    PAUSE_INPUT,
+    // caches and free memory held by the allocator are released
+    TRIM_POOL,
+};
+
+// MemoryAccountant tracks the bytes held by the main data holders of the agent, and turns the memory usage of the
+// process into a pressure level, which the holders check to shed load before the memory limit forces a restart.
+class MemoryAccountant {
+public:
+    MemoryAccountant(const MemoryAccountant&) = delete;
+    MemoryAccountant& operator=(const MemoryAccountant&) = delete;
+
+    static MemoryAccountant* GetInstance() {
+        static MemoryAccountant instance;
+        return &instance;
+    }
+
+    void Add(MemoryCategory category, int64_t bytes) {
+        mBytes[static_cast<size_t>(category)].mValue.fetch_add(bytes, std::memory_order_relaxed);
+    }
+    void Sub(MemoryCategory category, int64_t bytes) {
+        mBytes[static_cast<size_t>(category)].mValue.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+    int64_t GetBytes(MemoryCategory category) const {
+        return mBytes[static_cast<size_t>(category)].mValue.load(std::memory_order_relaxed);
+    }
+
+    MemoryPressureLevel GetPressureLevel() const { return mLevel.load(std::memory_order_relaxed); }
+    bool IsUnderPressure(MemoryPressureLevel level) const { return GetPressureLevel() >= level; }
+
+    // should be called periodically with the rss of the process.
+    // the level goes up by one while the usage is above the high watermark of the limit, and down by one while it is
+    // below the low watermark, so that each measure gets a chance to take effect before the next one is taken.
+    MemoryPressureLevel UpdatePressureLevel(uint64_t usedMb, uint64_t limitMb);
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    void SetPressureLevel(MemoryPressureLevel level) { mLevel.store(level, std::memory_order_relaxed); }
+#endif
+
+private:
+    // counters are updated from different threads, keep them on different cache lines
+    struct alignas(64) PaddedCounter {
+        std::atomic_int64_t mValue = 0;
+    };
+
+    MemoryAccountant() = default;
+    ~MemoryAccountant() = default;
+
+    std::array<PaddedCounter, static_cast<size_t>(MemoryCategory::COUNT)> mBytes;
+    std::atomic<MemoryPressureLevel> mLevel = MemoryPressureLevel::NORMAL;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class MemoryAccountantUnittest;
+#endif
+};
+
+} // namespace logtail
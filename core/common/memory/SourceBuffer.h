@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "common/StringView.h"
+#include "common/memory/MemoryAccountant.h"
 
 namespace logtail {
 
@@ -54,20 +55,42 @@ public:
         mAllocatedChunks.push_back(mAllocPtr);
         mFreeBytesInChunk = mChunkSize;
         mAllocated = mChunkSize;
+        MemoryAccountant::GetInstance()->Add(MemoryCategory::SOURCE_BUFFER, mAllocated);
     }
 
     BufferAllocator(const BufferAllocator&) = delete;
     BufferAllocator& operator=(const BufferAllocator&) = delete;
 
-    BufferAllocator(BufferAllocator&&) = default;
-    BufferAllocator& operator=(BufferAllocator&&) = default;
-
-    ~BufferAllocator() {
-        for (size_t i = 0; i < mAllocatedChunks.size(); i++) {
-            delete[] mAllocatedChunks[i];
+    // the moved-from allocator must own nothing, otherwise its chunks would be accounted twice
+    BufferAllocator(BufferAllocator&& rhs) noexcept
+        : mFirstChunkSize(rhs.mFirstChunkSize),
+          mChunkSizeLimit(rhs.mChunkSizeLimit),
+          mAllocatedChunks(std::move(rhs.mAllocatedChunks)),
+          mAllocated(rhs.mAllocated),
+          mUsed(rhs.mUsed),
+          mAllocPtr(rhs.mAllocPtr),
+          mFreeBytesInChunk(rhs.mFreeBytesInChunk),
+          mChunkSize(rhs.mChunkSize) {
+        rhs.release();
+    }
+    BufferAllocator& operator=(BufferAllocator&& rhs) noexcept {
+        if (this != &rhs) {
+            destroy();
+            mFirstChunkSize = rhs.mFirstChunkSize;
+            mChunkSizeLimit = rhs.mChunkSizeLimit;
+            mAllocatedChunks = std::move(rhs.mAllocatedChunks);
+            mAllocated = rhs.mAllocated;
+            mUsed = rhs.mUsed;
+            mAllocPtr = rhs.mAllocPtr;
+            mFreeBytesInChunk = rhs.mFreeBytesInChunk;
+            mChunkSize = rhs.mChunkSize;
+            rhs.release();
         }
+        return *this;
     }
 
+    ~BufferAllocator() { destroy(); }
+
     void Reset(void) {
         for (size_t i = 1; i < mAllocatedChunks.size(); i++) {
             delete[] mAllocatedChunks[i];
@@ -76,6 +99,7 @@ public:
         mAllocPtr = mAllocatedChunks[0];
         mChunkSize = mFirstChunkSize;
         mFreeBytesInChunk = mChunkSize;
+        MemoryAccountant::GetInstance()->Sub(MemoryCategory::SOURCE_BUFFER, mAllocated - mChunkSize);
         mAllocated = mChunkSize;
         mUsed = 0;
     }
@@ -112,6 +136,7 @@ private:
             mem = new uint8_t[bytes];
             mAllocatedChunks.push_back(mem);
             mAllocated += bytes;
+            MemoryAccountant::GetInstance()->Add(MemoryCategory::SOURCE_BUFFER, bytes);
         } else {
             /*
              * Here we intentionally waste some space in the current chunk.
@@ -124,12 +149,30 @@ private:
             mAllocPtr = mem + bytes;
             mFreeBytesInChunk = mChunkSize - bytes;
             mAllocated += mChunkSize;
+            MemoryAccountant::GetInstance()->Add(MemoryCategory::SOURCE_BUFFER, mChunkSize);
         }
 
         mUsed += bytes;
         return mem;
     }
 
+    void destroy() {
+        for (size_t i = 0; i < mAllocatedChunks.size(); i++) {
+            delete[] mAllocatedChunks[i];
+        }
+        mAllocatedChunks.clear();
+        MemoryAccountant::GetInstance()->Sub(MemoryCategory::SOURCE_BUFFER, mAllocated);
+        mAllocated = 0;
+    }
+
+    void release() {
+        mAllocatedChunks.clear();
+        mAllocated = 0;
+        mUsed = 0;
+        mAllocPtr = nullptr;
+        mFreeBytesInChunk = 0;
+    }
+
 private:
     uint32_t mFirstChunkSize = 4096;
     uint32_t mChunkSizeLimit = 1024 * 128;
@@ -181,6 +181,9 @@ EBPFServer::EBPFServer()
     mLossKernelEventsTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_EBPF_LOST_KERNEL_EVENTS_TOTAL);
     mConnectionCacheSize = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_EBPF_CONNECTION_CACHE_SIZE);
     mPushLogFailedTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_EBPF_LOST_LOG_EVENTS_TOTAL);
+    mProtocolParseQueueSize = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_EBPF_PROTOCOL_PARSE_QUEUE_SIZE);
+    mProtocolParseBackpressureTotal
+        = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_EBPF_PROTOCOL_PARSE_BACKPRESSURE_TOTAL);
 
     mProcessCacheManager = std::make_shared<ProcessCacheManager>(mEBPFAdapter,
                                                                  mHostName,
@@ -322,6 +325,7 @@ bool EBPFServer::startPluginInternal(const std::string& pipelineName,
                         mProcessCacheManager, mEBPFAdapter, mCommonEventQueue, &mEventPool);
                     mgr->SetMetrics(
                         mRecvKernelEventsTotal, mLossKernelEventsTotal, mConnectionCacheSize, mPushLogFailedTotal);
+                    mgr->SetParseWorkerMetrics(mProtocolParseQueueSize, mProtocolParseBackpressureTotal);
                     pluginMgr = mgr;
                 }
                 break;
@@ -175,6 +175,8 @@ private:
     CounterPtr mLossKernelEventsTotal;
     IntGaugePtr mConnectionCacheSize;
     CounterPtr mPushLogFailedTotal;
+    IntGaugePtr mProtocolParseQueueSize;
+    CounterPtr mProtocolParseBackpressureTotal;
 
     int mUnifiedEpollFd = -1;
     std::vector<struct epoll_event> mEpollEvents;
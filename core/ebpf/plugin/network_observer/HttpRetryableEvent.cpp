@@ -45,7 +45,9 @@ bool HttpRetryableEvent::HandleMessage() {
 }
 
 bool HttpRetryableEvent::flushEvent() {
-    if (!mCommonEventQueue.try_enqueue(mRecord)) {
+    bool enqueued = mProducerToken ? mCommonEventQueue.try_enqueue(*mProducerToken, mRecord)
+                                   : mCommonEventQueue.try_enqueue(mRecord);
+    if (!enqueued) {
         // don't use move as it will set mProcessEvent to nullptr even
         // if enqueue failed, this is unexpected but don't know why
         LOG_WARNING(sLogger, ("event", "Failed to enqueue http record")("pid", mRecord->GetSpanName()));
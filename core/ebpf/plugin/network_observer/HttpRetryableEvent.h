@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <memory>
+#include <utility>
 
 #include "common/queue/blockingconcurrentqueue.h"
 #include "ebpf/plugin/RetryableEvent.h"
@@ -26,10 +27,15 @@ namespace logtail::ebpf {
 
 class HttpRetryableEvent : public RetryableEvent {
 public:
+    // producerToken, if given, must only be used by the thread that handles this event (the poller thread)
     explicit HttpRetryableEvent(int retryLimit,
-                                const std::shared_ptr<L7Record>& record,
-                                moodycamel::BlockingConcurrentQueue<std::shared_ptr<CommonEvent>>& queue)
-        : RetryableEvent(retryLimit), mRecord(record), mCommonEventQueue(queue) {}
+                                std::shared_ptr<L7Record> record,
+                                moodycamel::BlockingConcurrentQueue<std::shared_ptr<CommonEvent>>& queue,
+                                moodycamel::ProducerToken* producerToken = nullptr)
+        : RetryableEvent(retryLimit),
+          mRecord(std::move(record)),
+          mCommonEventQueue(queue),
+          mProducerToken(producerToken) {}
 
     virtual ~HttpRetryableEvent() = default;
 
@@ -50,6 +56,7 @@ private:
     // record ...
     std::shared_ptr<L7Record> mRecord;
     moodycamel::BlockingConcurrentQueue<std::shared_ptr<CommonEvent>>& mCommonEventQueue;
+    moodycamel::ProducerToken* mProducerToken = nullptr;
 };
 
 } // namespace logtail::ebpf
@@ -14,7 +14,9 @@
 
 #include "ebpf/plugin/network_observer/NetworkObserverManager.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <thread>
 
 #include "rapidjson/document.h"
 #include "rapidjson/stringbuffer.h"
@@ -51,6 +53,8 @@ extern "C" {
 DEFINE_FLAG_INT32(ebpf_networkobserver_max_connections, "maximum connections", 5000);
 DEFINE_FLAG_STRING(ebpf_networkobserver_enable_protocols, "enable application protocols, split by comma", "HTTP");
 DEFINE_FLAG_DOUBLE(ebpf_networkobserver_default_sample_rate, "ebpf network observer default sample rate", 1.0);
+DEFINE_FLAG_INT32(ebpf_networkobserver_parse_worker_num, "protocol parse workers, 0 means parsing in poller thread", 0);
+DEFINE_FLAG_INT32(ebpf_networkobserver_parse_worker_queue_size, "max pending data events per parse worker", 4096);
 
 namespace logtail::ebpf {
 
@@ -162,6 +166,7 @@ NetworkObserverManager::NetworkObserverManager(const std::shared_ptr<ProcessCach
                                                moodycamel::BlockingConcurrentQueue<std::shared_ptr<CommonEvent>>& queue,
                                                EventPool* pool)
     : AbstractManager(processCacheManager, eBPFAdapter, queue, pool),
+      mRecordProducerToken(queue),
       mAppAggregator(
           10240,
           [](std::unique_ptr<AppMetricData>& base, L7Record* other) {
@@ -1149,6 +1154,15 @@ int NetworkObserverManager::Init() {
     mCidOffset = GuessContainerIdOffset();
     mConvergerManager = std::make_shared<AppConvergerManager>();
 
+    if (INT32_FLAG(ebpf_networkobserver_parse_worker_num) > 0) {
+        mParserWorkerPool = std::make_unique<ProtocolParserWorkerPool>(
+            INT32_FLAG(ebpf_networkobserver_parse_worker_num),
+            std::max(INT32_FLAG(ebpf_networkobserver_parse_worker_queue_size), 1));
+        mParserWorkerPool->Start();
+    } else {
+        mParserWorkerPool.reset();
+    }
+
     const char* value = getenv("_cluster_id_");
     if (value != nullptr) {
         mClusterId = value;
@@ -1557,6 +1571,9 @@ int NetworkObserverManager::PollPerfBuffer(int timeout) {
             " total ctrl events:", mRecvCtrlEventsTotal.load())(" lost data events:", mLostDataEventsTotal.load())(
             " lost stats events:", mLostConnStatEventsTotal.load())(" lost ctrl events:", mLostCtrlEventsTotal.load()));
     // 4. consume mRetryableEventCache, used for handling metadata attach failed scenario ...
+    if (mParserWorkerPool) {
+        drainParsedRecords();
+    }
     mRetryableEventCache.HandleEvents();
     return ret;
 }
@@ -1600,24 +1617,55 @@ void NetworkObserverManager::AcceptDataEvent(struct conn_data_event_t* event) {
         return;
     }
 
-    std::vector<std::shared_ptr<L7Record>> records
-        = ProtocolParserManager::GetInstance().Parse(protocol, conn, event, appDetail, mConvergerManager);
+    if (mParserWorkerPool) {
+        // records are collected in drainParsedRecords, a full shard blocks the poller until its worker catches up
+        while (!mParserWorkerPool->Submit(protocol, conn, appDetail, event)) {
+            if (!mParserWorkerPool->IsRunning()) {
+                return;
+            }
+            ADD_COUNTER(mParseBackpressureTotal, 1);
+            drainParsedRecords();
+            std::this_thread::yield();
+        }
+        return;
+    }
 
-    if (records.empty()) {
+    mParsedRecords.clear();
+    if (ProtocolParserManager::GetInstance().Parse(
+            protocol, conn, event, appDetail, mConvergerManager, mParsedRecords)
+        == 0) {
         return;
     }
 
     // add records to span/event generate queue
-    for (const auto& record : records) {
-        std::shared_ptr<RetryableEvent> retryableEvent
-            = std::make_shared<HttpRetryableEvent>(5, record, mCommonEventQueue);
-        if (!retryableEvent->HandleMessage()) {
-            // LOG_DEBUG(sLogger, ("failed once", "enqueue retry cache")("meta flag", conn->GetMetaFlags()));
-            mRetryableEventCache.AddEvent(retryableEvent);
-        }
+    for (auto& record : mParsedRecords) {
+        handleParsedRecord(std::move(record));
+    }
+    mParsedRecords.clear();
+}
+
+void NetworkObserverManager::handleParsedRecord(std::shared_ptr<L7Record>&& record) {
+    // most records are ready to be flushed at once, so the retryable wrapper lives on the stack and is only
+    // copied to the heap when it has to wait in the retry cache
+    HttpRetryableEvent retryableEvent(5, std::move(record), mCommonEventQueue, &mRecordProducerToken);
+    if (!retryableEvent.HandleMessage()) {
+        // LOG_DEBUG(sLogger, ("failed once", "enqueue retry cache")("meta flag", conn->GetMetaFlags()));
+        mRetryableEventCache.AddEvent(std::make_shared<HttpRetryableEvent>(retryableEvent));
     }
 }
 
+void NetworkObserverManager::drainParsedRecords() {
+    mDrainedRecords.clear();
+    mParserWorkerPool->Drain(mDrainedRecords);
+    for (auto& parsed : mDrainedRecords) {
+        // AppConvergerManager is not thread safe, so workers leave converging to the poller thread
+        ProtocolParserManager::GetInstance().Converge(parsed.mProtocol, parsed.mRecord.get(), mConvergerManager);
+        handleParsedRecord(std::move(parsed.mRecord));
+    }
+    mDrainedRecords.clear();
+    SET_GAUGE(mParseQueueSize, mParserWorkerPool->PendingCount());
+}
+
 void NetworkObserverManager::AcceptNetStatsEvent(struct conn_stats_event_t* event) {
     ADD_COUNTER(mRecvKernelEventsTotal, 1);
     LOG_DEBUG(
@@ -1904,6 +1952,10 @@ int NetworkObserverManager::Destroy() {
     LOG_INFO(sLogger, ("prepare to destroy", ""));
     mEBPFAdapter->StopPlugin(PluginType::NETWORK_OBSERVE);
     LOG_INFO(sLogger, ("destroy stage", "shutdown ebpf prog"));
+    if (mParserWorkerPool) {
+        LOG_INFO(sLogger, ("destroy stage", "stop protocol parser workers"));
+        mParserWorkerPool->Stop();
+    }
     this->mInited = false;
 
 #ifdef APSARA_UNIT_TEST_MAIN
@@ -23,6 +23,7 @@
 #include "ebpf/plugin/ProcessCacheManager.h"
 #include "ebpf/plugin/RetryableEventCache.h"
 #include "ebpf/plugin/network_observer/ConnectionManager.h"
+#include "ebpf/protocol/ProtocolParserWorkerPool.h"
 #include "ebpf/type/CommonDataEvent.h"
 #include "ebpf/type/NetworkObserverEvent.h"
 #include "ebpf/util/AggregateTree.h"
@@ -132,6 +133,11 @@ public:
         mPushLogFailedTotal = std::move(lossLogsTotal);
     }
 
+    void SetParseWorkerMetrics(IntGaugePtr parseQueueSize, CounterPtr parseBackpressureTotal) {
+        mParseQueueSize = std::move(parseQueueSize);
+        mParseBackpressureTotal = std::move(parseBackpressureTotal);
+    }
+
     // periodically tasks ...
     bool ConsumeLogAggregateTree();
     bool ConsumeMetricAggregateTree();
@@ -167,6 +173,11 @@ private:
                              const std::shared_ptr<logtail::ebpf::AppDetail>&);
     void processRecordAsMetric(L7Record* record, const std::shared_ptr<logtail::ebpf::AppDetail>&);
 
+    // hand a parsed record to the event queue, or to the retry cache if it cannot be flushed yet
+    void handleParsedRecord(std::shared_ptr<L7Record>&& record);
+    // only used in poller thread, collect records parsed by mParserWorkerPool
+    void drainParsedRecords();
+
     bool updateParsers(const std::vector<std::string>& protocols, const std::vector<std::string>& prevProtocols);
 
     enum class EventDataType {
@@ -199,6 +210,15 @@ private:
 
     int mCidOffset = -1;
 
+    // only used in poller thread ...
+    // records parsed from a data event, reused across events to avoid a vector allocation per event
+    std::vector<std::shared_ptr<L7Record>> mParsedRecords;
+    // explicit producer for records handed to mCommonEventQueue, avoids the implicit producer lookup per enqueue
+    moodycamel::ProducerToken mRecordProducerToken;
+    // null means protocols are parsed inline in poller thread
+    std::unique_ptr<ProtocolParserWorkerPool> mParserWorkerPool;
+    std::vector<ParsedRecord> mDrainedRecords;
+
     // handler thread ...
     SIZETAggTreeWithSourceBuffer<AppMetricData, L7Record*> mAppAggregator;
     SIZETAggTreeWithSourceBuffer<NetMetricData, ConnStatsRecord*> mNetAggregator;
@@ -265,6 +285,8 @@ private:
     CounterPtr mLossKernelEventsTotal;
     IntGaugePtr mConnectionNum;
     CounterPtr mPushLogFailedTotal;
+    IntGaugePtr mParseQueueSize;
+    CounterPtr mParseBackpressureTotal;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class NetworkObserverManagerUnittest;
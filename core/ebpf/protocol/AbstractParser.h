@@ -27,11 +27,17 @@ class AbstractProtocolParser {
 public:
     virtual ~AbstractProtocolParser() = default;
     virtual std::shared_ptr<AbstractProtocolParser> Create() = 0;
-    virtual std::vector<std::shared_ptr<L7Record>> Parse(struct conn_data_event_t* dataEvent,
-                                                         const std::shared_ptr<Connection>& conn,
-                                                         const std::shared_ptr<AppDetail>& appDetail,
-                                                         const std::shared_ptr<AppConvergerManager>& converger)
+    // parsed records are appended to records, which the caller may reuse across data events
+    // return the number of records appended
+    virtual size_t Parse(struct conn_data_event_t* dataEvent,
+                         const std::shared_ptr<Connection>& conn,
+                         const std::shared_ptr<AppDetail>& appDetail,
+                         const std::shared_ptr<AppConvergerManager>& converger,
+                         std::vector<std::shared_ptr<L7Record>>& records)
         = 0;
+    // apply converger to a record produced by Parse with a null converger, used when parsing runs off the poller
+    // thread since AppConvergerManager is not thread safe
+    virtual void Converge(L7Record*, const std::shared_ptr<AppConvergerManager>&) {}
 };
 
 } // namespace logtail::ebpf
@@ -89,19 +89,30 @@ bool ProtocolParserManager::RemoveParser(support_proto_e type) {
 }
 
 
-std::vector<std::shared_ptr<L7Record>>
-ProtocolParserManager::Parse(support_proto_e type,
-                             const std::shared_ptr<Connection>& conn,
-                             struct conn_data_event_t* data,
-                             const std::shared_ptr<AppDetail>& appDetail,
-                             const std::shared_ptr<AppConvergerManager>& converger) {
+size_t ProtocolParserManager::Parse(support_proto_e type,
+                                    const std::shared_ptr<Connection>& conn,
+                                    struct conn_data_event_t* data,
+                                    const std::shared_ptr<AppDetail>& appDetail,
+                                    const std::shared_ptr<AppConvergerManager>& converger,
+                                    std::vector<std::shared_ptr<L7Record>>& records) {
     ReadLock lock(mLock);
-    if (mParsers.find(type) != mParsers.end()) {
-        return mParsers[type]->Parse(data, conn, appDetail, converger);
+    auto it = mParsers.find(type);
+    if (it != mParsers.end()) {
+        return it->second->Parse(data, conn, appDetail, converger, records);
     }
 
     LOG_ERROR(sLogger, ("No parser found for given protocol type", std::string(magic_enum::enum_name(type))));
-    return std::vector<std::shared_ptr<L7Record>>();
+    return 0;
+}
+
+void ProtocolParserManager::Converge(support_proto_e type,
+                                     L7Record* record,
+                                     const std::shared_ptr<AppConvergerManager>& converger) {
+    ReadLock lock(mLock);
+    auto it = mParsers.find(type);
+    if (it != mParsers.end()) {
+        it->second->Converge(record, converger);
+    }
 }
 
 } // namespace logtail::ebpf
@@ -50,11 +50,15 @@ public:
     bool RemoveParser(support_proto_e type);
     std::set<support_proto_e> AvaliableProtocolTypes() const;
 
-    std::vector<std::shared_ptr<L7Record>> Parse(support_proto_e type,
-                                                 const std::shared_ptr<Connection>& conn,
-                                                 struct conn_data_event_t* data,
-                                                 const std::shared_ptr<AppDetail>& appDetail,
-                                                 const std::shared_ptr<AppConvergerManager>& converger);
+    // append parsed records to records, return the number of records appended
+    size_t Parse(support_proto_e type,
+                 const std::shared_ptr<Connection>& conn,
+                 struct conn_data_event_t* data,
+                 const std::shared_ptr<AppDetail>& appDetail,
+                 const std::shared_ptr<AppConvergerManager>& converger,
+                 std::vector<std::shared_ptr<L7Record>>& records);
+
+    void Converge(support_proto_e type, L7Record* record, const std::shared_ptr<AppConvergerManager>& converger);
 
 private:
     ProtocolParserManager() {}
@@ -0,0 +1,142 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ebpf/protocol/ProtocolParserWorkerPool.h"
+
+#include <cstddef>
+#include <cstring>
+
+#include "ebpf/plugin/network_observer/Connection.h"
+#include "ebpf/protocol/ProtocolParser.h"
+#include "logger/Logger.h"
+
+namespace logtail::ebpf {
+
+inline constexpr int64_t kParseWorkerWaitTimeUs = 100000;
+
+ProtocolParserWorkerPool::ProtocolParserWorkerPool(size_t workerNum, size_t queueCapacity)
+    : mQueueCapacity(queueCapacity == 0 ? 1 : queueCapacity) {
+    workerNum = workerNum == 0 ? 1 : workerNum;
+    mShards.reserve(workerNum);
+    for (size_t i = 0; i < workerNum; ++i) {
+        mShards.emplace_back(std::make_unique<Shard>());
+    }
+}
+
+ProtocolParserWorkerPool::~ProtocolParserWorkerPool() {
+    Stop();
+}
+
+void ProtocolParserWorkerPool::Start() {
+    bool expected = false;
+    if (!mRunning.compare_exchange_strong(expected, true)) {
+        return;
+    }
+    for (auto& shard : mShards) {
+        shard->mWorker = std::thread([this, s = shard.get()]() { runWorker(*s); });
+    }
+    LOG_INFO(sLogger, ("protocol parser worker pool started, worker num", mShards.size())("capacity", mQueueCapacity));
+}
+
+void ProtocolParserWorkerPool::Stop() {
+    bool expected = true;
+    if (!mRunning.compare_exchange_strong(expected, false)) {
+        return;
+    }
+    for (auto& shard : mShards) {
+        if (shard->mWorker.joinable()) {
+            shard->mWorker.join();
+        }
+    }
+    for (auto& shard : mShards) {
+        std::unique_ptr<ParseTask> task;
+        while (shard->mTasks.try_dequeue(task)) {
+        }
+        ParsedRecord record;
+        while (shard->mResults.try_dequeue(record)) {
+        }
+        shard->mPending = 0;
+    }
+    LOG_INFO(sLogger, ("protocol parser worker pool", "stopped"));
+}
+
+bool ProtocolParserWorkerPool::Submit(support_proto_e protocol,
+                                      const std::shared_ptr<Connection>& conn,
+                                      const std::shared_ptr<AppDetail>& appDetail,
+                                      const struct conn_data_event_t* event) {
+    auto& shard = *mShards[ConnIdHash{}(conn->GetConnId()) % mShards.size()];
+    if (shard.mPending.load(std::memory_order_relaxed) >= mQueueCapacity) {
+        return false;
+    }
+
+    std::unique_ptr<ParseTask> task;
+    if (!shard.mFreeTasks.try_dequeue(task)) {
+        task = std::make_unique<ParseTask>();
+    }
+    task->mProtocol = protocol;
+    task->mConn = conn;
+    task->mAppDetail = appDetail;
+    size_t size = offsetof(conn_data_event_t, msg) + event->request_len + event->response_len;
+    task->mEvent.resize(size);
+    std::memcpy(task->mEvent.data(), event, size);
+
+    shard.mPending.fetch_add(1, std::memory_order_relaxed);
+    shard.mTasks.enqueue(std::move(task));
+    return true;
+}
+
+size_t ProtocolParserWorkerPool::Drain(std::vector<ParsedRecord>& records) {
+    size_t count = 0;
+    for (auto& shard : mShards) {
+        ParsedRecord record;
+        while (shard->mResults.try_dequeue(record)) {
+            records.emplace_back(std::move(record));
+            ++count;
+        }
+    }
+    return count;
+}
+
+size_t ProtocolParserWorkerPool::PendingCount() const {
+    size_t count = 0;
+    for (const auto& shard : mShards) {
+        count += shard->mPending.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+void ProtocolParserWorkerPool::runWorker(Shard& shard) {
+    std::vector<std::shared_ptr<L7Record>> records;
+    std::unique_ptr<ParseTask> task;
+    while (mRunning.load(std::memory_order_acquire)) {
+        if (!shard.mTasks.wait_dequeue_timed(task, kParseWorkerWaitTimeUs)) {
+            continue;
+        }
+        auto* event = reinterpret_cast<struct conn_data_event_t*>(task->mEvent.data());
+        // converging is left to the poller thread, see ProtocolParserManager::Converge
+        ProtocolParserManager::GetInstance().Parse(
+            task->mProtocol, task->mConn, event, task->mAppDetail, nullptr, records);
+        for (auto& record : records) {
+            shard.mResults.enqueue(ParsedRecord{task->mProtocol, std::move(record)});
+        }
+        records.clear();
+        shard.mPending.fetch_sub(1, std::memory_order_relaxed);
+
+        task->mConn.reset();
+        task->mAppDetail.reset();
+        shard.mFreeTasks.enqueue(std::move(task));
+    }
+}
+
+} // namespace logtail::ebpf
@@ -0,0 +1,97 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/queue/blockingconcurrentqueue.h"
+#include "ebpf/type/NetworkObserverEvent.h"
+
+extern "C" {
+#include <coolbpf/net.h>
+}
+
+namespace logtail::ebpf {
+
+class Connection;
+
+struct ParsedRecord {
+    support_proto_e mProtocol = support_proto_e::ProtoUnknown;
+    std::shared_ptr<L7Record> mRecord;
+};
+
+// ProtocolParserWorkerPool moves protocol parsing off the poller thread.
+// Data events are sharded by connection id, every shard is served by one worker thread and its output is drained in
+// FIFO order, so records of the same connection keep the order in which the poller received them.
+// Submit and Drain must be called from the poller thread only.
+class ProtocolParserWorkerPool {
+public:
+    ProtocolParserWorkerPool(size_t workerNum, size_t queueCapacity);
+    ~ProtocolParserWorkerPool();
+
+    ProtocolParserWorkerPool(const ProtocolParserWorkerPool&) = delete;
+    ProtocolParserWorkerPool& operator=(const ProtocolParserWorkerPool&) = delete;
+
+    void Start();
+    // pending tasks are dropped
+    void Stop();
+
+    // the event is copied since perf buffer memory is reused once the callback returns
+    // return false if the shard of the connection is full, caller should drain and retry
+    bool Submit(support_proto_e protocol,
+                const std::shared_ptr<Connection>& conn,
+                const std::shared_ptr<AppDetail>& appDetail,
+                const struct conn_data_event_t* event);
+
+    // append all parsed records to records, return the number of records appended
+    size_t Drain(std::vector<ParsedRecord>& records);
+
+    [[nodiscard]] bool IsRunning() const { return mRunning.load(std::memory_order_acquire); }
+    [[nodiscard]] size_t WorkerNum() const { return mShards.size(); }
+    // number of submitted events not yet parsed
+    [[nodiscard]] size_t PendingCount() const;
+
+private:
+    struct ParseTask {
+        support_proto_e mProtocol = support_proto_e::ProtoUnknown;
+        std::shared_ptr<Connection> mConn;
+        std::shared_ptr<AppDetail> mAppDetail;
+        std::vector<char> mEvent;
+    };
+
+    struct Shard {
+        moodycamel::BlockingConcurrentQueue<std::unique_ptr<ParseTask>> mTasks;
+        // parsed tasks are handed back to the poller for reuse, so the event buffers are allocated only once
+        moodycamel::ConcurrentQueue<std::unique_ptr<ParseTask>> mFreeTasks;
+        moodycamel::ConcurrentQueue<ParsedRecord> mResults;
+        std::atomic_size_t mPending = 0;
+        std::thread mWorker;
+    };
+
+    void runWorker(Shard& shard);
+
+    size_t mQueueCapacity = 0;
+    std::atomic_bool mRunning = false;
+    std::vector<std::unique_ptr<Shard>> mShards;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ProtocolParserWorkerPoolUnittest;
+#endif
+};
+
+} // namespace logtail::ebpf
@@ -27,11 +27,11 @@ inline constexpr char kContentLength[] = "Content-Length";
 inline constexpr char kTransferEncoding[] = "Transfer-Encoding";
 inline constexpr char kUpgrade[] = "Upgrade";
 
-std::vector<std::shared_ptr<L7Record>>
-HTTPProtocolParser::Parse(struct conn_data_event_t* dataEvent,
-                          const std::shared_ptr<Connection>& conn,
-                          const std::shared_ptr<AppDetail>& appDetail,
-                          const std::shared_ptr<AppConvergerManager>& converger) {
+size_t HTTPProtocolParser::Parse(struct conn_data_event_t* dataEvent,
+                                const std::shared_ptr<Connection>& conn,
+                                const std::shared_ptr<AppDetail>& appDetail,
+                                const std::shared_ptr<AppConvergerManager>& converger,
+                                std::vector<std::shared_ptr<L7Record>>& records) {
     auto record = std::make_shared<HttpRecord>(conn, appDetail);
     record->SetEndTsNs(dataEvent->end_ts);
     record->SetStartTsNs(dataEvent->start_ts);
@@ -47,7 +47,7 @@ HTTPProtocolParser::Parse(struct conn_data_event_t* dataEvent,
         ParseState state = http::ParseResponse(buf, record, true, false);
         if (state != ParseState::kSuccess) {
             LOG_DEBUG(sLogger, ("[HTTPProtocolParser]: Parse HTTP response failed", int(state)));
-            return {};
+            return 0;
         }
     }
 
@@ -56,7 +56,7 @@ HTTPProtocolParser::Parse(struct conn_data_event_t* dataEvent,
         ParseState state = http::ParseRequest(buf, record, false);
         if (state != ParseState::kSuccess) {
             LOG_DEBUG(sLogger, ("[HTTPProtocolParser]: Parse HTTP request failed", int(state)));
-            return {};
+            return 0;
         }
         if (converger) {
             converger->DoConverge(appDetail, ConvType::kUrl, record->mPath);
@@ -68,7 +68,15 @@ HTTPProtocolParser::Parse(struct conn_data_event_t* dataEvent,
         record->SetTraceId(GenerateTraceID());
     }
 
-    return {record};
+    records.push_back(std::move(record));
+    return 1;
+}
+
+void HTTPProtocolParser::Converge(L7Record* record, const std::shared_ptr<AppConvergerManager>& converger) {
+    auto* httpRecord = static_cast<HttpRecord*>(record);
+    if (converger && !httpRecord->mPath.empty()) {
+        converger->DoConverge(record->GetAppDetail(), ConvType::kUrl, httpRecord->mPath);
+    }
 }
 
 namespace http {
@@ -94,10 +94,13 @@ class HTTPProtocolParser : public AbstractProtocolParser {
 public:
     std::shared_ptr<AbstractProtocolParser> Create() override { return std::make_shared<HTTPProtocolParser>(); }
 
-    std::vector<std::shared_ptr<L7Record>> Parse(struct conn_data_event_t* dataEvent,
-                                                 const std::shared_ptr<Connection>& conn,
-                                                 const std::shared_ptr<AppDetail>& appDetail,
-                                                 const std::shared_ptr<AppConvergerManager>& converger) override;
+    size_t Parse(struct conn_data_event_t* dataEvent,
+                 const std::shared_ptr<Connection>& conn,
+                 const std::shared_ptr<AppDetail>& appDetail,
+                 const std::shared_ptr<AppConvergerManager>& converger,
+                 std::vector<std::shared_ptr<L7Record>>& records) override;
+
+    void Converge(L7Record* record, const std::shared_ptr<AppConvergerManager>& converger) override;
 };
 
 REGISTER_PROTOCOL_PARSER(support_proto_e::ProtoHTTP, HTTPProtocolParser)
@@ -0,0 +1,238 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "common/memory/SourceBuffer.h"
+#include "logger/Logger.h"
+
+namespace logtail {
+
+// FlatAggTree is a flat alternative of AggTree for fixed-depth keys.
+// The full key tuple is hashed once and looked up in an open-addressing table, entries live in one contiguous
+// vector, so aggregating a record costs no node allocation and a single probe sequence instead of one hash map per
+// level. Entries sharing the first key form a group, which plays the role of the level-1 node of AggTree and owns
+// the SourceBuffer shared by all its entries.
+template <class Data, class Value, size_t N, bool NeedSourceBuffer>
+class FlatAggTree {
+public:
+    using KeyArray = std::array<size_t, N>;
+
+    struct Group {
+        size_t mKey = 0UL;
+        std::shared_ptr<SourceBuffer> mSourceBuffer;
+        uint32_t mHead = kInvalidIndex;
+        uint32_t mTail = kInvalidIndex;
+        size_t mSize = 0UL;
+    };
+
+    FlatAggTree(size_t maxNodes,
+                const std::function<void(std::unique_ptr<Data>&, const Value&)>& aggregateFunc,
+                const std::function<std::unique_ptr<Data>(const Value& n, std::shared_ptr<SourceBuffer>& sourceBuffer)>&
+                    buildFunc)
+        : mMaxNodes(maxNodes), mAggregateFunc(aggregateFunc), mBuildFunc(buildFunc) {
+        Reset();
+    }
+
+    FlatAggTree(FlatAggTree&& other) noexcept
+        : mMaxNodes(other.mMaxNodes),
+          mEventCount(other.mEventCount),
+          mSlots(std::move(other.mSlots)),
+          mEntries(std::move(other.mEntries)),
+          mGroups(std::move(other.mGroups)),
+          mGroupIndex(std::move(other.mGroupIndex)),
+          mAggregateFunc(other.mAggregateFunc),
+          mBuildFunc(other.mBuildFunc) {}
+
+    FlatAggTree& operator=(FlatAggTree&& other) noexcept {
+        mMaxNodes = other.mMaxNodes;
+        mEventCount = other.mEventCount;
+        mSlots = std::move(other.mSlots);
+        mEntries = std::move(other.mEntries);
+        mGroups = std::move(other.mGroups);
+        mGroupIndex = std::move(other.mGroupIndex);
+        mAggregateFunc = other.mAggregateFunc;
+        mBuildFunc = other.mBuildFunc;
+        return *this;
+    }
+
+    FlatAggTree GetAndReset() {
+        FlatAggTree res = std::move(*this);
+        Reset();
+        return res;
+    }
+
+    bool Aggregate(const Value& d, const KeyArray& aggKeys) {
+        uint64_t hash = HashKeys(aggKeys);
+        size_t mask = mSlots.size() - 1;
+        size_t pos = hash & mask;
+        while (mSlots[pos] != 0) {
+            auto& entry = mEntries[mSlots[pos] - 1];
+            if (entry.mHash == hash && entry.mKeys == aggKeys) {
+                mAggregateFunc(entry.mData, d);
+                mEventCount++;
+                return true;
+            }
+            pos = (pos + 1) & mask;
+        }
+
+        if (mEntries.size() >= mMaxNodes) {
+            // when we exceed the maximum limit, we will drop new metrics
+            LOG_ERROR(sLogger, ("maximum limit exceeded", mMaxNodes));
+            return false;
+        }
+        auto entryIdx = static_cast<uint32_t>(mEntries.size());
+        auto& group = FindOrCreateGroup(aggKeys[0]);
+        auto& entry = mEntries.emplace_back();
+        entry.mHash = hash;
+        entry.mKeys = aggKeys;
+        if (group.mTail == kInvalidIndex) {
+            group.mHead = entryIdx;
+        } else {
+            mEntries[group.mTail].mNext = entryIdx;
+        }
+        group.mTail = entryIdx;
+        group.mSize++;
+        entry.mData = mBuildFunc(d, group.mSourceBuffer);
+        mAggregateFunc(entry.mData, d);
+        mEventCount++;
+
+        mSlots[pos] = entryIdx + 1;
+        if (mEntries.size() * 2 > mSlots.size()) {
+            Rehash(mSlots.size() * 2);
+        }
+        return true;
+    }
+
+    // groups are returned in creation order, pointers are valid until the next Aggregate or Reset
+    std::vector<Group*> GetGroups() {
+        std::vector<Group*> res;
+        res.reserve(mGroups.size());
+        for (auto& group : mGroups) {
+            res.push_back(&group);
+        }
+        return res;
+    }
+
+    void ForEach(const std::function<void(const Data*)>& call) const {
+        for (const auto& entry : mEntries) {
+            if (entry.mData != nullptr) {
+                call(entry.mData.get());
+            }
+        }
+    }
+
+    void ForEach(const Group* group, const std::function<void(const Data*)>& call) const {
+        if (group == nullptr) {
+            return;
+        }
+        for (auto idx = group->mHead; idx != kInvalidIndex; idx = mEntries[idx].mNext) {
+            if (mEntries[idx].mData != nullptr) {
+                call(mEntries[idx].mData.get());
+            }
+        }
+    }
+
+    void Reset() {
+        mSlots.assign(kInitialSlotCount, 0);
+        mEntries.clear();
+        mGroups.clear();
+        mGroupIndex.clear();
+        mEventCount = 0;
+    }
+
+    [[nodiscard]] size_t NodeCount() const { return mEntries.size(); }
+
+    [[nodiscard]] size_t GroupCount() const { return mGroups.size(); }
+
+    [[nodiscard]] size_t EventCount() const { return mEventCount; }
+
+private:
+    static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+    static constexpr size_t kInitialSlotCount = 16;
+
+    struct Entry {
+        uint64_t mHash = 0;
+        KeyArray mKeys{};
+        uint32_t mNext = kInvalidIndex;
+        std::unique_ptr<Data> mData;
+    };
+
+    static uint64_t HashKeys(const KeyArray& keys) {
+        uint64_t seed = 0;
+        for (auto key : keys) {
+            seed ^= key + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+        }
+        // murmur3 finalizer, keys are often already hashes but low bits must be well mixed for the mask
+        seed ^= seed >> 33;
+        seed *= 0xff51afd7ed558ccdULL;
+        seed ^= seed >> 33;
+        seed *= 0xc4ceb9fe1a85ec53ULL;
+        seed ^= seed >> 33;
+        return seed;
+    }
+
+    Group& FindOrCreateGroup(size_t key) {
+        auto it = mGroupIndex.find(key);
+        if (it != mGroupIndex.end()) {
+            return mGroups[it->second];
+        }
+        mGroupIndex.emplace(key, mGroups.size());
+        auto& group = mGroups.emplace_back();
+        group.mKey = key;
+        if (NeedSourceBuffer) {
+            group.mSourceBuffer = std::make_shared<SourceBuffer>(kDefaultNodeSourceBufferSize);
+        }
+        return group;
+    }
+
+    void Rehash(size_t slotCount) {
+        mSlots.assign(slotCount, 0);
+        size_t mask = slotCount - 1;
+        for (size_t i = 0; i < mEntries.size(); ++i) {
+            size_t pos = mEntries[i].mHash & mask;
+            while (mSlots[pos] != 0) {
+                pos = (pos + 1) & mask;
+            }
+            mSlots[pos] = static_cast<uint32_t>(i + 1);
+        }
+    }
+
+    size_t mMaxNodes = 0UL;
+    size_t mEventCount = 0UL;
+
+    // entry index + 1, 0 means empty
+    std::vector<uint32_t> mSlots;
+    std::vector<Entry> mEntries;
+    std::vector<Group> mGroups;
+    std::unordered_map<size_t, size_t> mGroupIndex;
+
+    std::function<void(std::unique_ptr<Data>& base, const Value& n)> mAggregateFunc;
+    std::function<std::unique_ptr<Data>(const Value& n, std::shared_ptr<SourceBuffer>& sourceBuffer)> mBuildFunc;
+};
+
+template <typename T, typename U, size_t N>
+using SIZETFlatAggTree = FlatAggTree<T, U, N, false>;
+
+template <typename T, typename U, size_t N>
+using SIZETFlatAggTreeWithSourceBuffer = FlatAggTree<T, U, N, true>;
+
+} // namespace logtail
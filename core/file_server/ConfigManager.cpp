@@ -43,6 +43,7 @@
 #include "common/StringTools.h"
 #include "common/TimeUtil.h"
 #include "common/version.h"
+#include "file_server/ContainerInfo.h"
 #include "file_server/EventDispatcher.h"
 #include "file_server/FileServer.h"
 #include "file_server/checkpoint/CheckPointManager.h"
@@ -611,42 +612,37 @@ FileDiscoveryConfig ConfigManager::FindBestMatch(const string& path, const strin
             }
         }
     }
-    const auto& nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
-    auto itr = nameConfigMap.begin();
+    vector<FileDiscoveryConfig> candidates;
+    FileServer::GetInstance()->GetFileDiscoveryIndex().FindCandidates(path, name, candidates);
     FileDiscoveryConfig prevMatch(nullptr, nullptr);
     size_t prevLen = 0;
     size_t curLen = 0;
     uint32_t nameRepeat = 0;
     string logNameList;
     vector<FileDiscoveryConfig> multiConfigs;
-    for (; itr != nameConfigMap.end(); ++itr) {
-        const FileDiscoveryOptions* config = itr->second.first;
-        // // exclude __FUSE_CONFIG__
-        // if (itr->first == STRING_FLAG(fuse_customized_config_name)) {
-        //     continue;
-        // }
-
+    for (const auto& candidate : candidates) {
+        const FileDiscoveryOptions* config = candidate.first;
         bool match = config->IsMatch(path, name);
         if (match) {
             // if force multi config, do not send alarm
             if (!name.empty() && !config->mAllowingIncludedByMultiConfigs) {
                 nameRepeat++;
                 logNameList.append("logstore:");
-                logNameList.append(itr->second.second->GetLogstoreName());
+                logNameList.append(candidate.second->GetLogstoreName());
                 logNameList.append(",config:");
-                logNameList.append(itr->second.second->GetConfigName());
+                logNameList.append(candidate.second->GetConfigName());
                 logNameList.append(" ");
-                multiConfigs.push_back(itr->second);
+                multiConfigs.push_back(candidate);
             }
 
             // note: best config is the one which length is longest and create time is nearest
             curLen = config->GetBasePath().size();
             if (prevLen < curLen) {
-                prevMatch = itr->second;
+                prevMatch = candidate;
                 prevLen = curLen;
             } else if (prevLen == curLen && prevMatch.first) {
-                if (prevMatch.second->GetCreateTime() > itr->second.second->GetCreateTime()) {
-                    prevMatch = itr->second;
+                if (prevMatch.second->GetCreateTime() > candidate.second->GetCreateTime()) {
+                    prevMatch = candidate;
                     prevLen = curLen;
                 }
             }
@@ -701,18 +697,11 @@ int32_t ConfigManager::FindAllMatch(vector<FileDiscoveryConfig>& allConfig,
         }
     }
     bool alarmFlag = false;
-    auto nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
-    auto itr = nameConfigMap.begin();
-    for (; itr != nameConfigMap.end(); ++itr) {
-        const FileDiscoveryOptions* config = itr->second.first;
-        // // exclude __FUSE_CONFIG__
-        // if (itr->first == STRING_FLAG(fuse_customized_config_name)) {
-        //     continue;
-        // }
-
-        bool match = config->IsMatch(path, name);
-        if (match) {
-            allConfig.push_back(itr->second);
+    vector<FileDiscoveryConfig> candidates;
+    FileServer::GetInstance()->GetFileDiscoveryIndex().FindCandidates(path, name, candidates);
+    for (const auto& candidate : candidates) {
+        if (candidate.first->IsMatch(path, name)) {
+            allConfig.push_back(candidate);
         }
     }
 
@@ -749,21 +738,15 @@ int32_t ConfigManager::FindMatchWithForceFlag(std::vector<FileDiscoveryConfig>&
             }
         }
     }
-    auto nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
-    auto itr = nameConfigMap.begin();
+    vector<FileDiscoveryConfig> candidates;
+    FileServer::GetInstance()->GetFileDiscoveryIndex().FindCandidates(path, name, candidates);
     FileDiscoveryConfig prevMatch = make_pair(nullptr, nullptr);
     size_t prevLen = 0;
     size_t curLen = 0;
     uint32_t nameRepeat = 0;
     string logNameList;
     vector<FileDiscoveryConfig> multiConfigs;
-    for (; itr != nameConfigMap.end(); ++itr) {
-        FileDiscoveryConfig config = itr->second;
-        // // exclude __FUSE_CONFIG__
-        // if (itr->first == STRING_FLAG(fuse_customized_config_name)) {
-        //     continue;
-        // }
-
+    for (const auto& config : candidates) {
         bool match = config.first->IsMatch(path, name);
         if (match) {
             // if force multi config, do not send alarm
@@ -872,10 +855,11 @@ void ConfigManager::DeleteHandlers() {
 // 1. No wildcard path: the base path of Config is the prefix of @path and within depth.
 // 2. Wildcard path: @path matches and within depth.
 void ConfigManager::GetRelatedConfigs(const std::string& path, std::vector<FileDiscoveryConfig>& configs) {
-    const auto& nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
-    for (auto iter = nameConfigMap.begin(); iter != nameConfigMap.end(); ++iter) {
-        if (iter->second.first->IsMatch(path, "")) {
-            configs.push_back(iter->second);
+    vector<FileDiscoveryConfig> candidates;
+    FileServer::GetInstance()->GetFileDiscoveryIndex().FindCandidates(path, "", candidates);
+    for (const auto& candidate : candidates) {
+        if (candidate.first->IsMatch(path, "")) {
+            configs.push_back(candidate);
         }
     }
 }
@@ -893,7 +877,27 @@ bool ConfigManager::DoUpdateContainerPaths() {
     mContainerInfoCmdVec.clear();
     mContainerInfoCmdLock.unlock();
     LOG_INFO(sLogger, ("update container path", tmpPathCmdVec.size()));
+    // the commands of a config before a full update of the config are superseded by it, unless it is invalid
+    unordered_map<string, size_t> lastAllCmdIdx;
+    for (size_t i = tmpPathCmdVec.size(); i-- > 0;) {
+        const ConfigContainerInfoUpdateCmd* cmd = tmpPathCmdVec[i];
+        if (cmd->mDeleteFlag || !cmd->mJsonParams.isMember("AllCmd")
+            || lastAllCmdIdx.find(cmd->mConfigName) != lastAllCmdIdx.end()) {
+            continue;
+        }
+        unordered_map<string, ContainerInfo> allPathMap;
+        string errorMsg;
+        if (ContainerInfo::ParseAllByJSONObj(cmd->mJsonParams["AllCmd"], allPathMap, errorMsg)) {
+            lastAllCmdIdx[cmd->mConfigName] = i;
+        }
+    }
+    unordered_set<string> updatedConfigs;
     for (size_t i = 0; i < tmpPathCmdVec.size(); ++i) {
+        auto itr = lastAllCmdIdx.find(tmpPathCmdVec[i]->mConfigName);
+        if (itr != lastAllCmdIdx.end() && itr->second > i) {
+            delete tmpPathCmdVec[i];
+            continue;
+        }
         FileDiscoveryConfig config = FileServer::GetInstance()->GetFileDiscoveryConfig(tmpPathCmdVec[i]->mConfigName);
         if (!config.first) {
             LOG_ERROR(sLogger,
@@ -922,8 +926,12 @@ bool ConfigManager::DoUpdateContainerPaths() {
                            tmpPathCmdVec[i]->mConfigName)("params", tmpPathCmdVec[i]->mJsonParams.toStyledString()));
             }
         }
+        updatedConfigs.insert(tmpPathCmdVec[i]->mConfigName);
         delete tmpPathCmdVec[i];
     }
+    for (const auto& configName : updatedConfigs) {
+        FileServer::GetInstance()->RefreshFileDiscoveryConfig(configName);
+    }
     return true;
 }
 
@@ -1009,14 +1017,8 @@ void ConfigManager::GetContainerStoppedEvents(std::vector<Event*>& eventVec) {
             LOG_ERROR(sLogger, ("invalid container info update param", errorMsg)("action", "ignore current cmd"));
             continue;
         }
-        std::vector<ContainerInfo>::iterator iter = config.first->GetContainerInfo()->begin();
-        std::vector<ContainerInfo>::iterator iend = config.first->GetContainerInfo()->end();
-        for (; iter != iend; ++iter) {
-            if (iter->mID == containerInfo.mID) {
-                break;
-            }
-        }
-        if (iter == iend) {
+        ContainerInfo* iter = config.first->GetContainerInfoByID(containerInfo.mID);
+        if (iter == nullptr) {
             continue;
         }
         Event* pStoppedEvent = new Event(iter->mRealBaseDir, "", EVENT_ISDIR | EVENT_CONTAINER_STOPPED, -1, 0);
@@ -14,10 +14,12 @@
 
 #include "file_server/ContainerInfo.h"
 
+#include <algorithm>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "common/FileSystemUtil.h"
 #include "common/StringTools.h"
 #include "logger/Logger.h"
 #include "models/PipelineEventGroup.h"
@@ -138,4 +140,78 @@ void ContainerInfo::AddMetadata(const std::string& key, const std::string& value
     }
 }
 
+void ContainerInfoIndex::Build(const std::vector<ContainerInfo>& infos) {
+    Clear();
+    mInfos = &infos;
+    mSize = infos.size();
+    for (size_t i = 0; i < infos.size(); ++i) {
+        GetNode(infos[i].mRealBaseDir)->mIdxs.push_back(i);
+        mIDs[infos[i].mID] = i;
+    }
+}
+
+void ContainerInfoIndex::Clear() {
+    mInfos = nullptr;
+    mSize = 0;
+    mRoot.mChildren.clear();
+    mRoot.mIdxs.clear();
+    mIDs.clear();
+}
+
+void ContainerInfoIndex::Add(const std::vector<ContainerInfo>& infos) {
+    if (mInfos != &infos || mSize + 1 != infos.size()) {
+        Build(infos);
+        return;
+    }
+    size_t idx = mSize++;
+    GetNode(infos[idx].mRealBaseDir)->mIdxs.push_back(idx);
+    mIDs[infos[idx].mID] = idx;
+}
+
+void ContainerInfoIndex::Update(const std::vector<ContainerInfo>& infos, size_t idx, const std::string& oldBaseDir) {
+    if (!IsBuiltFrom(infos)) {
+        Build(infos);
+        return;
+    }
+    if (infos[idx].mRealBaseDir == oldBaseDir) {
+        return;
+    }
+    // empty nodes are left, which is fine since base dirs rarely change
+    auto& oldIdxs = GetNode(oldBaseDir)->mIdxs;
+    oldIdxs.erase(std::remove(oldIdxs.begin(), oldIdxs.end(), idx), oldIdxs.end());
+    auto& idxs = GetNode(infos[idx].mRealBaseDir)->mIdxs;
+    idxs.insert(std::upper_bound(idxs.begin(), idxs.end(), idx), idx);
+}
+
+void ContainerInfoIndex::FindByPath(const std::string& path, std::vector<size_t>& res) const {
+    res.insert(res.end(), mRoot.mIdxs.begin(), mRoot.mIdxs.end());
+    const Node* node = &mRoot;
+    for (const auto& component : SplitPath(path)) {
+        auto it = node->mChildren.find(component);
+        if (it == node->mChildren.end()) {
+            break;
+        }
+        node = it->second.get();
+        res.insert(res.end(), node->mIdxs.begin(), node->mIdxs.end());
+    }
+    std::sort(res.begin(), res.end());
+}
+
+size_t ContainerInfoIndex::FindByID(const std::string& id) const {
+    auto it = mIDs.find(id);
+    return it == mIDs.end() ? std::string::npos : it->second;
+}
+
+ContainerInfoIndex::Node* ContainerInfoIndex::GetNode(const std::string& path) {
+    Node* node = &mRoot;
+    for (const auto& component : SplitPath(path)) {
+        auto& child = node->mChildren[component];
+        if (!child) {
+            child = std::make_unique<Node>();
+        }
+        node = child.get();
+    }
+    return node;
+}
+
 } // namespace logtail
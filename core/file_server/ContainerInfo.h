@@ -18,6 +18,7 @@
 
 #include <cstdint>
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -108,4 +109,38 @@ struct ContainerInfo {
 private:
 };
 
+// ContainerInfoIndex looks up a list of containers by id, and by path in a trie over the components of their real base
+// dirs, so that finding the containers of a path costs O(path depth) instead of a scan of the list.
+// The index refers to the positions in the list, so it must be updated along with the list.
+class ContainerInfoIndex {
+public:
+    void Build(const std::vector<ContainerInfo>& infos);
+    void Clear();
+    // the list is appended with infos.back()
+    void Add(const std::vector<ContainerInfo>& infos);
+    // the real base dir of infos[idx] is changed from oldBaseDir
+    void Update(const std::vector<ContainerInfo>& infos, size_t idx, const std::string& oldBaseDir);
+    bool IsBuiltFrom(const std::vector<ContainerInfo>& infos) const {
+        return mInfos == &infos && mSize == infos.size();
+    }
+
+    // @param res the positions of the containers whose real base dir contains path by components, in ascending order
+    void FindByPath(const std::string& path, std::vector<size_t>& res) const;
+    // @return the position of the container, std::string::npos if not found
+    size_t FindByID(const std::string& id) const;
+
+private:
+    struct Node {
+        std::unordered_map<std::string, std::unique_ptr<Node>> mChildren;
+        std::vector<size_t> mIdxs;
+    };
+
+    Node* GetNode(const std::string& path);
+
+    const std::vector<ContainerInfo>* mInfos = nullptr;
+    size_t mSize = 0;
+    Node mRoot;
+    std::unordered_map<std::string, size_t> mIDs;
+};
+
 } // namespace logtail
@@ -226,7 +226,10 @@ bool EventDispatcher::RegisterEventHandler(const string& path,
     }
 
     wd = -1;
-    if (mInotifyWatchNum >= INT32_FLAG(default_max_inotify_watch_num)) {
+    // fanotify watches the whole filesystem, so adding a dir costs no kernel resource, while the dirs falling back to
+    // inotify are still limited
+    bool inotifyAllowed = mInotifyWatchNum < INT32_FLAG(default_max_inotify_watch_num);
+    if (!mEventListener->IsFanotifyEnabled() && !inotifyAllowed) {
         LOG_INFO(sLogger,
                  ("failed to add inotify watcher for dir", path)("max allowed inotify watchers",
                                                                  INT32_FLAG(default_max_inotify_watch_num)));
@@ -239,7 +242,7 @@ bool EventDispatcher::RegisterEventHandler(const string& path,
     } else {
         // need check mEventListener valid
         if (mEventListener->IsInit() && !AppConfig::GetInstance()->IsInInotifyBlackList(path)) {
-            wd = mEventListener->AddWatch(path.c_str());
+            wd = mEventListener->AddWatch(path.c_str(), inotifyAllowed);
             if (!EventListener::IsValidID(wd)) {
                 string str = ErrnoToString(GetErrno());
                 LOG_WARNING(sLogger, ("failed to register dir", path)("reason", str));
@@ -287,7 +290,7 @@ bool EventDispatcher::RegisterEventHandler(const string& path,
                               ("can not register inotify monitor", path)("inode", inode)("wd", wd)(
                                   "reason", "there is already a dir in inotify watch list shard the same inode"));
                     wd = -1;
-                } else
+                } else if (mEventListener->IsInotifyWatch(wd))
                     mInotifyWatchNum++;
             }
         }
@@ -853,7 +856,9 @@ void EventDispatcher::UnregisterEventHandler(const string& path) {
     mWdUpdateTimeMap.erase(wd);
     if (EventListener::IsValidID(wd) && mEventListener->IsInit()) {
         mEventListener->RemoveWatch(wd);
-        mInotifyWatchNum--;
+        if (mEventListener->IsInotifyWatch(wd)) {
+            mInotifyWatchNum--;
+        }
     }
     mWatchNum--;
     LOG_INFO(sLogger, ("remove the watcher for dir", path)("wd", wd));
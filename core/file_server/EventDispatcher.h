@@ -289,6 +289,7 @@ protected:
     friend class EventDispatcherDirUnittest;
     friend class ModifyHandlerUnittest;
     friend class PipelineUpdateUnittest;
+    friend class EventListenerUnittest;
 
     void CleanEnviroments();
     int32_t GetInotifyWatcherCount();
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "file_server/FileDiscoveryIndex.h"
+
+#include <algorithm>
+
+#include "common/FileSystemUtil.h"
+
+using namespace std;
+
+namespace logtail {
+
+void FileDiscoveryIndex::Add(const string& configName, const FileDiscoveryConfig& config) {
+    Remove(configName);
+    auto res = mEntries.emplace(configName, Entry());
+    Entry& entry = res.first->second;
+    entry.mConfigName = &res.first->first;
+    entry.mConfig = config;
+    GetRoots(*config.first, entry.mRoots);
+    CompileNameGlob(config.first->GetFilePattern(), entry);
+    for (const auto& root : entry.mRoots) {
+        Insert(root, &entry);
+    }
+}
+
+void FileDiscoveryIndex::Remove(const string& configName) {
+    auto it = mEntries.find(configName);
+    if (it == mEntries.end()) {
+        return;
+    }
+    for (const auto& root : it->second.mRoots) {
+        Erase(root, &it->second);
+    }
+    mEntries.erase(it);
+}
+
+void FileDiscoveryIndex::Clear() {
+    mEntries.clear();
+    mRoot.mChildren.clear();
+    mRoot.mEntries.clear();
+}
+
+void FileDiscoveryIndex::FindCandidates(const string& path,
+                                        const string& name,
+                                        vector<FileDiscoveryConfig>& candidates) const {
+    vector<const Entry*> entries(mRoot.mEntries.begin(), mRoot.mEntries.end());
+    const Node* node = &mRoot;
+    for (const auto& component : SplitPath(path)) {
+        auto it = node->mChildren.find(component);
+        if (it == node->mChildren.end()) {
+            break;
+        }
+        node = it->second.get();
+        entries.insert(entries.end(), node->mEntries.begin(), node->mEntries.end());
+    }
+
+    // a container config is registered once per container, and the containers may be nested
+    sort(entries.begin(), entries.end(), [](const Entry* l, const Entry* r) {
+        return *l->mConfigName < *r->mConfigName;
+    });
+    entries.erase(unique(entries.begin(), entries.end()), entries.end());
+    for (const auto* entry : entries) {
+        if (name.empty() || entry->IsNameMatched(name)) {
+            candidates.push_back(entry->mConfig);
+        }
+    }
+}
+
+void FileDiscoveryIndex::GetRoots(const FileDiscoveryOptions& options, vector<string>& roots) {
+    if (options.IsContainerDiscoveryEnabled()) {
+        // the path is matched only if it lies in the real base dir of some container, see IsMatch
+        const auto& containerInfos = options.GetContainerInfo();
+        if (containerInfos) {
+            for (const auto& info : *containerInfos) {
+                roots.push_back(info.mRealBaseDir);
+            }
+        }
+        return;
+    }
+    if (options.GetWildcardPaths().empty()) {
+        roots.push_back(options.GetBasePath());
+        return;
+    }
+#if defined(_MSC_VER)
+    // fnmatch ignores case on Windows, so the literal prefix cannot be looked up exactly
+    roots.emplace_back();
+#else
+    roots.push_back(options.GetWildcardPaths()[0]);
+#endif
+}
+
+void FileDiscoveryIndex::CompileNameGlob(const string& pattern, Entry& entry) {
+#if defined(__linux__)
+    if (pattern.find_first_of("?[\\") != string::npos) {
+        return;
+    }
+    entry.mHasNameGlob = true;
+    size_t first = pattern.find('*');
+    if (first == string::npos) {
+        entry.mIsExactName = true;
+        entry.mNamePrefix = pattern;
+        return;
+    }
+    entry.mNamePrefix = pattern.substr(0, first);
+    entry.mNameSuffix = pattern.substr(pattern.rfind('*') + 1);
+#endif
+}
+
+bool FileDiscoveryIndex::Entry::IsNameMatched(const string& name) const {
+    if (!mHasNameGlob) {
+        return true;
+    }
+    if (mIsExactName) {
+        return name == mNamePrefix;
+    }
+    // the '*'s in the middle are not checked, fnmatch is still called by IsMatch
+    return name.size() >= mNamePrefix.size() + mNameSuffix.size()
+        && name.compare(0, mNamePrefix.size(), mNamePrefix) == 0
+        && name.compare(name.size() - mNameSuffix.size(), mNameSuffix.size(), mNameSuffix) == 0;
+}
+
+void FileDiscoveryIndex::Insert(const string& root, const Entry* entry) {
+    Node* node = &mRoot;
+    for (const auto& component : SplitPath(root)) {
+        auto& child = node->mChildren[component];
+        if (!child) {
+            child = make_unique<Node>();
+        }
+        node = child.get();
+    }
+    node->mEntries.push_back(entry);
+}
+
+void FileDiscoveryIndex::Erase(const string& root, const Entry* entry) {
+    vector<pair<Node*, string>> trace;
+    Node* node = &mRoot;
+    for (const auto& component : SplitPath(root)) {
+        auto it = node->mChildren.find(component);
+        if (it == node->mChildren.end()) {
+            return;
+        }
+        trace.emplace_back(node, component);
+        node = it->second.get();
+    }
+    auto it = find(node->mEntries.begin(), node->mEntries.end(), entry);
+    if (it != node->mEntries.end()) {
+        node->mEntries.erase(it);
+    }
+    // prune the branch left empty
+    while (!trace.empty() && node->mEntries.empty() && node->mChildren.empty()) {
+        Node* parent = trace.back().first;
+        parent->mChildren.erase(trace.back().second);
+        trace.pop_back();
+        node = parent;
+    }
+}
+
+} // namespace logtail
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "file_server/FileDiscoveryOptions.h"
+
+namespace logtail {
+
+// FileDiscoveryIndex narrows down the file discovery configs to be checked by FileDiscoveryOptions::IsMatch for a path.
+// Each config is registered in a trie of path components under its roots, i.e. the literal directories any matched
+// path must lie in:
+// - the base path for a normal config;
+// - the directory before the first wildcard component for a wildcard config, which buckets all the configs sharing
+//   the same literal prefix;
+// - the real base dir of each container for a config with container discovery enabled.
+// So finding the candidates costs one walk down the trie along the components of the path, no matter how many configs
+// there are. The file pattern is compiled into a prefix and a suffix when it only contains '*' wildcards.
+//
+// The index is updated per config, see FileServer::AddFileDiscoveryConfig, and must be refreshed once the container
+// infos of a config have changed.
+class FileDiscoveryIndex {
+public:
+    void Add(const std::string& configName, const FileDiscoveryConfig& config);
+    void Remove(const std::string& configName);
+    void Clear();
+    // the candidates are returned in the order of config names, each of them must still be checked by IsMatch
+    void FindCandidates(const std::string& path,
+                        const std::string& name,
+                        std::vector<FileDiscoveryConfig>& candidates) const;
+    size_t Size() const { return mEntries.size(); }
+
+private:
+    struct Entry {
+        const std::string* mConfigName = nullptr;
+        FileDiscoveryConfig mConfig;
+        std::vector<std::string> mRoots;
+        bool mHasNameGlob = false;
+        bool mIsExactName = false;
+        std::string mNamePrefix;
+        std::string mNameSuffix;
+
+        bool IsNameMatched(const std::string& name) const;
+    };
+
+    struct Node {
+        std::unordered_map<std::string, std::unique_ptr<Node>> mChildren;
+        std::vector<const Entry*> mEntries;
+    };
+
+    static void GetRoots(const FileDiscoveryOptions& options, std::vector<std::string>& roots);
+    static void CompileNameGlob(const std::string& pattern, Entry& entry);
+
+    void Insert(const std::string& root, const Entry* entry);
+    void Erase(const std::string& root, const Entry* entry);
+
+    std::unordered_map<std::string, Entry> mEntries;
+    Node mRoot;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class FileDiscoveryIndexUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -538,8 +538,13 @@ bool FileDiscoveryOptions::IsMatch(const string& path, const string& name) const
         }
 
         // Normal base path.
-        for (size_t i = 0; i < mContainerInfos->size(); ++i) {
-            const string& containerBasePath = (*mContainerInfos)[i].mRealBaseDir;
+        vector<size_t> idxs;
+        bool indexed = mContainerInfoIndex.IsBuiltFrom(*mContainerInfos);
+        if (indexed) {
+            mContainerInfoIndex.FindByPath(path, idxs);
+        }
+        for (size_t i = 0; i < (indexed ? idxs.size() : mContainerInfos->size()); ++i) {
+            const string& containerBasePath = (*mContainerInfos)[indexed ? idxs[i] : i].mRealBaseDir;
             if (_IsPathMatched(containerBasePath, path, mMaxDirSearchDepth)) {
                 if (!mHasBlacklist) {
                     return true;
@@ -668,10 +673,29 @@ bool FileDiscoveryOptions::WithinMaxDepth(const string& path) const {
     return true;
 }
 
+void FileDiscoveryOptions::SetContainerInfo(const std::shared_ptr<std::vector<ContainerInfo>>& info) {
+    mContainerInfos = info;
+    if (mContainerInfos) {
+        mContainerInfoIndex.Build(*mContainerInfos);
+    } else {
+        mContainerInfoIndex.Clear();
+    }
+}
+
 ContainerInfo* FileDiscoveryOptions::GetContainerPathByLogPath(const string& logPath) const {
     if (!mContainerInfos) {
         return NULL;
     }
+    if (mContainerInfoIndex.IsBuiltFrom(*mContainerInfos)) {
+        vector<size_t> idxs;
+        mContainerInfoIndex.FindByPath(logPath, idxs);
+        for (auto it = idxs.rbegin(); it != idxs.rend(); ++it) {
+            if (_IsSubPath((*mContainerInfos)[*it].mRealBaseDir, logPath)) {
+                return &(*mContainerInfos)[*it];
+            }
+        }
+        return NULL;
+    }
     // reverse order to find the latest container
     for (int i = mContainerInfos->size() - 1; i >= 0; --i) {
         if (_IsSubPath((*mContainerInfos)[i].mRealBaseDir, logPath)) {
@@ -681,6 +705,22 @@ ContainerInfo* FileDiscoveryOptions::GetContainerPathByLogPath(const string& log
     return NULL;
 }
 
+ContainerInfo* FileDiscoveryOptions::GetContainerInfoByID(const string& id) const {
+    if (!mContainerInfos) {
+        return NULL;
+    }
+    if (mContainerInfoIndex.IsBuiltFrom(*mContainerInfos)) {
+        size_t idx = mContainerInfoIndex.FindByID(id);
+        return idx == string::npos ? NULL : &(*mContainerInfos)[idx];
+    }
+    for (auto& info : *mContainerInfos) {
+        if (info.mID == id) {
+            return &info;
+        }
+    }
+    return NULL;
+}
+
 bool FileDiscoveryOptions::IsSameContainerInfo(const Json::Value& paramsJSON, const CollectionPipelineContext* ctx) {
     if (!mEnableContainerDiscovery)
         return true;
@@ -695,13 +735,8 @@ bool FileDiscoveryOptions::IsSameContainerInfo(const Json::Value& paramsJSON, co
         if (!mDeduceAndSetContainerBaseDirFunc(containerInfo, ctx, this)) {
             return true;
         }
-        // try update
-        for (size_t i = 0; i < mContainerInfos->size(); ++i) {
-            if ((*mContainerInfos)[i] == containerInfo) {
-                return true;
-            }
-        }
-        return false;
+        const ContainerInfo* info = GetContainerInfoByID(containerInfo.mID);
+        return info != NULL && *info == containerInfo;
     }
 
     // check all
@@ -750,15 +785,16 @@ bool FileDiscoveryOptions::UpdateContainerInfo(const Json::Value& paramsJSON, co
             return false;
         }
         // try update
-        for (size_t i = 0; i < mContainerInfos->size(); ++i) {
-            if ((*mContainerInfos)[i].mID == containerInfo.mID) {
-                // update
-                (*mContainerInfos)[i] = containerInfo;
-                return true;
-            }
+        ContainerInfo* info = GetContainerInfoByID(containerInfo.mID);
+        if (info != NULL) {
+            string oldBaseDir = std::move(info->mRealBaseDir);
+            *info = containerInfo;
+            mContainerInfoIndex.Update(*mContainerInfos, info - mContainerInfos->data(), oldBaseDir);
+            return true;
         }
         // add
         mContainerInfos->push_back(containerInfo);
+        mContainerInfoIndex.Add(*mContainerInfos);
         return true;
     }
 
@@ -771,14 +807,37 @@ bool FileDiscoveryOptions::UpdateContainerInfo(const Json::Value& paramsJSON, co
         return false;
     }
     bool success = true;
-    // if update all, clear and reset
-    mContainerInfos->clear();
+    // if update all, diff with the current containers, the ones kept stay in place
+    vector<ContainerInfo> containerInfos;
+    containerInfos.reserve(allPathMap.size());
+    for (const auto& info : *mContainerInfos) {
+        auto iter = allPathMap.find(info.mID);
+        if (iter == allPathMap.end()) {
+            continue;
+        }
+        if (mDeduceAndSetContainerBaseDirFunc(iter->second, ctx, this)) {
+            containerInfos.push_back(std::move(iter->second));
+        } else {
+            success = false;
+        }
+        allPathMap.erase(iter);
+    }
     for (auto& iter : allPathMap) {
         if (!mDeduceAndSetContainerBaseDirFunc(iter.second, ctx, this)) {
             success = false;
             continue;
         }
-        mContainerInfos->push_back(iter.second);
+        containerInfos.push_back(std::move(iter.second));
+    }
+    // the index only refers to the ids and the real base dirs, which are often unchanged when the metadata changes
+    bool reindex = containerInfos.size() != mContainerInfos->size();
+    for (size_t i = 0; !reindex && i < containerInfos.size(); ++i) {
+        const auto& info = (*mContainerInfos)[i];
+        reindex = containerInfos[i].mID != info.mID || containerInfos[i].mRealBaseDir != info.mRealBaseDir;
+    }
+    *mContainerInfos = std::move(containerInfos);
+    if (reindex) {
+        mContainerInfoIndex.Build(*mContainerInfos);
     }
     return success;
 }
@@ -793,11 +852,10 @@ bool FileDiscoveryOptions::DeleteContainerInfo(const Json::Value& paramsJSON) {
         LOG_ERROR(sLogger, ("invalid container info update param", errorMsg)("action", "ignore current cmd"));
         return false;
     }
-    for (vector<ContainerInfo>::iterator iter = mContainerInfos->begin(); iter != mContainerInfos->end(); ++iter) {
-        if (iter->mID == containerInfo.mID) {
-            mContainerInfos->erase(iter);
-            break;
-        }
+    const ContainerInfo* info = GetContainerInfoByID(containerInfo.mID);
+    if (info != NULL) {
+        mContainerInfos->erase(mContainerInfos->begin() + (info - mContainerInfos->data()));
+        mContainerInfoIndex.Build(*mContainerInfos);
     }
     return true;
 }
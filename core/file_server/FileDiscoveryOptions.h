@@ -46,7 +46,7 @@ public:
     bool IsContainerDiscoveryEnabled() const { return mEnableContainerDiscovery; }
     void SetEnableContainerDiscoveryFlag(bool flag) { mEnableContainerDiscovery = true; }
     const std::shared_ptr<std::vector<ContainerInfo>>& GetContainerInfo() const { return mContainerInfos; }
-    void SetContainerInfo(const std::shared_ptr<std::vector<ContainerInfo>>& info) { mContainerInfos = info; }
+    void SetContainerInfo(const std::shared_ptr<std::vector<ContainerInfo>>& info);
     void SetDeduceAndSetContainerBaseDirFunc(bool (*f)(ContainerInfo&,
                                                        const CollectionPipelineContext*,
                                                        const FileDiscoveryOptions*)) {
@@ -64,6 +64,7 @@ public:
     bool UpdateContainerInfo(const Json::Value& paramsJSON, const CollectionPipelineContext*);
     bool DeleteContainerInfo(const Json::Value& paramsJSON);
     ContainerInfo* GetContainerPathByLogPath(const std::string& logPath) const;
+    ContainerInfo* GetContainerInfoByID(const std::string& id) const;
     // 过渡使用
     bool IsTailingAllMatchedFiles() const { return mTailingAllMatchedFiles; }
     void SetTailingAllMatchedFiles(bool flag) { mTailingAllMatchedFiles = flag; }
@@ -113,6 +114,9 @@ private:
 
     bool mEnableContainerDiscovery = false;
     std::shared_ptr<std::vector<ContainerInfo>> mContainerInfos; // must not be null if container discovery is enabled
+    // kept in step with mContainerInfos, so the containers must only be added, removed or moved through
+    // SetContainerInfo, UpdateContainerInfo and DeleteContainerInfo
+    ContainerInfoIndex mContainerInfoIndex;
     bool (*mDeduceAndSetContainerBaseDirFunc)(ContainerInfo& containerInfo,
                                               const CollectionPipelineContext*,
                                               const FileDiscoveryOptions*)
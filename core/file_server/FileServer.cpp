@@ -141,12 +141,23 @@ void FileServer::AddFileDiscoveryConfig(const string& name,
                                         const CollectionPipelineContext* ctx) {
     WriteLock lock(mReadWriteLock);
     mPipelineNameFileDiscoveryConfigsMap[name] = make_pair(opts, ctx);
+    mFileDiscoveryIndex.Add(name, make_pair(opts, ctx));
 }
 
 // 移除给定名称的文件发现配置
 void FileServer::RemoveFileDiscoveryConfig(const string& name) {
     WriteLock lock(mReadWriteLock);
     mPipelineNameFileDiscoveryConfigsMap.erase(name);
+    mFileDiscoveryIndex.Remove(name);
+}
+
+// 容器信息变化后，重新索引给定名称的文件发现配置
+void FileServer::RefreshFileDiscoveryConfig(const string& name) {
+    WriteLock lock(mReadWriteLock);
+    auto itr = mPipelineNameFileDiscoveryConfigsMap.find(name);
+    if (itr != mPipelineNameFileDiscoveryConfigsMap.end()) {
+        mFileDiscoveryIndex.Add(name, itr->second);
+    }
 }
 
 // 获取给定名称的文件读取器配置
@@ -22,6 +22,7 @@
 
 #include "collection_pipeline/CollectionPipelineContext.h"
 #include "common/Lock.h"
+#include "file_server/FileDiscoveryIndex.h"
 #include "file_server/FileDiscoveryOptions.h"
 #include "file_server/FileTagOptions.h"
 #include "file_server/MultilineOptions.h"
@@ -53,6 +54,9 @@ public:
     void
     AddFileDiscoveryConfig(const std::string& name, FileDiscoveryOptions* opts, const CollectionPipelineContext* ctx);
     void RemoveFileDiscoveryConfig(const std::string& name);
+    // re-registers the config in the index after its container infos have changed
+    void RefreshFileDiscoveryConfig(const std::string& name);
+    const FileDiscoveryIndex& GetFileDiscoveryIndex() const { return mFileDiscoveryIndex; }
 
     FileReaderConfig GetFileReaderConfig(const std::string& name) const;
     const std::unordered_map<std::string, FileReaderConfig>& GetAllFileReaderConfigs() const {
@@ -110,6 +114,7 @@ private:
     mutable ReadWriteLock mReadWriteLock;
 
     std::unordered_map<std::string, FileDiscoveryConfig> mPipelineNameFileDiscoveryConfigsMap;
+    FileDiscoveryIndex mFileDiscoveryIndex;
     std::unordered_map<std::string, FileReaderConfig> mPipelineNameFileReaderConfigsMap;
     std::unordered_map<std::string, MultilineConfig> mPipelineNameMultilineConfigsMap;
     std::unordered_map<std::string, FileTagConfig> mPipelineNameFileTagConfigsMap;
@@ -14,11 +14,37 @@
 
 #include "file_server/MultilineOptions.h"
 
+#include <string_view>
+
 #include "common/ParamExtractor.h"
+#include "common/StringTools.h"
 
 using namespace std;
 
 namespace logtail {
+
+MultilinePattern::MultilinePattern(const string& pattern) : mReg(pattern) {
+    mHasFirstChars = GetRegexFirstChars(pattern, mFirstChars);
+    vector<string> literals;
+    GetRegexRequiredLiterals(pattern, literals);
+    for (auto& literal : literals) {
+        if (literal.size() > mLiteral.size()) {
+            mLiteral = std::move(literal);
+        }
+    }
+}
+
+bool MultilinePattern::Match(const char* data, size_t size, string& exception) const {
+    if (mHasFirstChars && (size == 0 || !mFirstChars[static_cast<unsigned char>(data[0])])) {
+        return false;
+    }
+    // string_view::find looks for the first char with memchr, which is vectorized by the libc
+    if (!mLiteral.empty() && string_view(data, size).find(mLiteral) == string_view::npos) {
+        return false;
+    }
+    return BoostRegexSearch(data, size, mReg, exception);
+}
+
 bool MultilineOptions::Init(const Json::Value& config, const CollectionPipelineContext& ctx, const string& pluginType) {
     string errorMsg;
 
@@ -202,7 +228,7 @@ bool MultilineOptions::Init(const Json::Value& config, const CollectionPipelineC
     return true;
 }
 
-bool MultilineOptions::ParseRegex(const string& pattern, shared_ptr<boost::regex>& reg) {
+bool MultilineOptions::ParseRegex(const string& pattern, shared_ptr<MultilinePattern>& reg) {
     string regexPattern = pattern;
     if (!regexPattern.empty() && EndWith(regexPattern, "$")) {
         regexPattern = regexPattern.substr(0, regexPattern.size() - 1);
@@ -214,7 +240,7 @@ bool MultilineOptions::ParseRegex(const string& pattern, shared_ptr<boost::regex
         return true;
     }
     try {
-        reg.reset(new boost::regex(regexPattern));
+        reg.reset(new MultilinePattern(regexPattern));
     } catch (...) {
         return false;
     }
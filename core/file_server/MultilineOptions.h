@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <bitset>
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -26,15 +28,38 @@
 
 namespace logtail {
 
+// MultilinePattern matches a line against a multiline pattern from the beginning of the line. The first char and the
+// literals required by the pattern are checked before the regex, so that most of the lines not matched, e.g. the stack
+// frames of an exception against a start pattern beginning with a date, are rejected without running the regex.
+class MultilinePattern {
+public:
+    // throws like boost::regex if the pattern is invalid
+    explicit MultilinePattern(const std::string& pattern);
+
+    bool Match(const char* data, size_t size, std::string& exception) const;
+    const boost::regex& GetRegex() const { return mReg; }
+
+private:
+    boost::regex mReg;
+    bool mHasFirstChars = false;
+    std::bitset<256> mFirstChars;
+    // the longest literal required
+    std::string mLiteral;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class MultilineOptionsUnittest;
+#endif
+};
+
 class MultilineOptions {
 public:
     enum class Mode { CUSTOM, JSON };
     enum class UnmatchedContentTreatment { DISCARD, SINGLE_LINE };
 
     bool Init(const Json::Value& config, const CollectionPipelineContext& ctx, const std::string& pluginType);
-    const std::shared_ptr<boost::regex>& GetStartPatternReg() const { return mStartPatternRegPtr; }
-    const std::shared_ptr<boost::regex>& GetContinuePatternReg() const { return mContinuePatternRegPtr; }
-    const std::shared_ptr<boost::regex>& GetEndPatternReg() const { return mEndPatternRegPtr; }
+    const std::shared_ptr<MultilinePattern>& GetStartPatternReg() const { return mStartPatternRegPtr; }
+    const std::shared_ptr<MultilinePattern>& GetContinuePatternReg() const { return mContinuePatternRegPtr; }
+    const std::shared_ptr<MultilinePattern>& GetEndPatternReg() const { return mEndPatternRegPtr; }
     bool IsMultiline() const { return mIsMultiline; }
 
     Mode mMode = Mode::CUSTOM;
@@ -45,11 +70,11 @@ public:
     bool mIgnoringUnmatchWarning = false;
 
 private:
-    bool ParseRegex(const std::string& pattern, std::shared_ptr<boost::regex>& reg);
+    bool ParseRegex(const std::string& pattern, std::shared_ptr<MultilinePattern>& reg);
 
-    std::shared_ptr<boost::regex> mStartPatternRegPtr;
-    std::shared_ptr<boost::regex> mContinuePatternRegPtr;
-    std::shared_ptr<boost::regex> mEndPatternRegPtr;
+    std::shared_ptr<MultilinePattern> mStartPatternRegPtr;
+    std::shared_ptr<MultilinePattern> mContinuePatternRegPtr;
+    std::shared_ptr<MultilinePattern> mEndPatternRegPtr;
     bool mIsMultiline = false;
 };
 
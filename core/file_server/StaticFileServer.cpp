@@ -14,6 +14,8 @@
 
 #include "file_server/StaticFileServer.h"
 
+#include "app_config/AppConfig.h"
+#include "collection_pipeline/limiter/InputFlowController.h"
 #include "collection_pipeline/queue/ProcessQueueManager.h"
 #include "common/LogtailCommonFlags.h"
 #include "file_server/checkpoint/InputStaticFileCheckpointManager.h"
@@ -141,6 +143,12 @@ void StaticFileServer::ReadFiles() {
                         skip = true;
                         break;
                     }
+                    // never block here, other configs are read meanwhile and this one is retried next round
+                    if (AppConfig::GetInstance()->IsInputFlowControl()
+                        && InputFlowController::GetInstance()->GetWaitTime(configName).count() > 0) {
+                        skip = true;
+                        break;
+                    }
 
                     auto logBuffer = make_unique<LogBuffer>();
                     bool moreData = reader->ReadLog(*logBuffer, nullptr);
@@ -0,0 +1,374 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "file_server/checkpoint/CheckPointJournal.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "xxhash/xxhash.h"
+
+#include "common/Flags.h"
+#include "logger/Logger.h"
+
+DEFINE_FLAG_INT32(checkpoint_journal_compact_ratio,
+                  "checkpoint journal is compacted once it is bigger than the records alive in it by this ratio",
+                  4);
+
+using namespace std;
+
+namespace logtail {
+
+#if defined(__linux__)
+
+static constexpr uint64_t kFileMagic = 0x4c434b50544a4e31; // "LCKPTJN1"
+static constexpr uint32_t kRecordMagic = 0x434b5054; // "CKPT"
+static constexpr size_t kFileHeaderSize = sizeof(uint64_t) + 2 * sizeof(uint32_t);
+static constexpr size_t kRecordHeaderSize = 3 * sizeof(uint32_t);
+static constexpr uint32_t kMaxRecordSize = 1U << 30;
+static constexpr uint64_t kMinCompactSize = 1024 * 1024;
+
+// file: magic(8) version(4) reserved(4) record...
+// record: magic(4) payloadLen(4) xxh32(4) payload, where payload is a batch: type(1) entry...
+// entry: op(1) keyLen(4) key [valueLen(4) value], in host byte order since checkpoints never leave the host
+enum class BatchType : uint8_t { SNAPSHOT, DELTA };
+enum class EntryOp : uint8_t { PUT, DEL };
+
+static void AppendUint32(string& buffer, uint32_t value) {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static void AppendString(string& buffer, const string& value) {
+    AppendUint32(buffer, static_cast<uint32_t>(value.size()));
+    buffer.append(value);
+}
+
+static bool ReadString(const char* data, size_t size, size_t& pos, string_view& value) {
+    uint32_t len = 0;
+    if (pos + sizeof(len) > size) {
+        return false;
+    }
+    memcpy(&len, data + pos, sizeof(len));
+    pos += sizeof(len);
+    if (pos + len > size) {
+        return false;
+    }
+    value = string_view(data + pos, len);
+    pos += len;
+    return true;
+}
+
+static void SealRecord(string& buffer, size_t headerPos) {
+    uint32_t header[3];
+    header[0] = kRecordMagic;
+    header[1] = static_cast<uint32_t>(buffer.size() - headerPos - kRecordHeaderSize);
+    header[2] = XXH32(buffer.data() + headerPos + kRecordHeaderSize, header[1], 0);
+    memcpy(buffer.data() + headerPos, header, kRecordHeaderSize);
+}
+
+// the batch is applied only if it is complete and valid
+static bool ApplyRecord(const char* data, uint64_t size, uint64_t& pos, unordered_map<string, string>& records) {
+    uint32_t header[3];
+    if (pos + kRecordHeaderSize > size) {
+        return false;
+    }
+    memcpy(header, data + pos, kRecordHeaderSize);
+    if (header[0] != kRecordMagic || header[1] > kMaxRecordSize || header[1] == 0
+        || pos + kRecordHeaderSize + header[1] > size) {
+        return false;
+    }
+    const char* payload = data + pos + kRecordHeaderSize;
+    size_t payloadSize = header[1];
+    if (XXH32(payload, payloadSize, 0) != header[2]) {
+        return false;
+    }
+
+    auto type = static_cast<BatchType>(payload[0]);
+    if (type != BatchType::SNAPSHOT && type != BatchType::DELTA) {
+        return false;
+    }
+    vector<tuple<EntryOp, string_view, string_view>> entries;
+    size_t cur = 1;
+    while (cur < payloadSize) {
+        auto op = static_cast<EntryOp>(payload[cur++]);
+        string_view key;
+        string_view value;
+        if (op != EntryOp::PUT && op != EntryOp::DEL) {
+            return false;
+        }
+        if (!ReadString(payload, payloadSize, cur, key)
+            || (op == EntryOp::PUT && !ReadString(payload, payloadSize, cur, value))) {
+            return false;
+        }
+        entries.emplace_back(op, key, value);
+    }
+
+    if (type == BatchType::SNAPSHOT) {
+        records.clear();
+        records.reserve(entries.size());
+    }
+    for (const auto& [op, key, value] : entries) {
+        if (op == EntryOp::DEL) {
+            records.erase(string(key));
+        } else {
+            records[string(key)] = string(value);
+        }
+    }
+    pos += kRecordHeaderSize + payloadSize;
+    return true;
+}
+
+static bool WriteAll(int fd, const char* buf, size_t size) {
+    while (size > 0) {
+        ssize_t n = write(fd, buf, size);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        buf += n;
+        size -= n;
+    }
+    return true;
+}
+
+static void SyncDir(const string& path) {
+    auto dir = filesystem::path(path).parent_path();
+    int fd = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        return;
+    }
+    fsync(fd);
+    ::close(fd);
+}
+
+CheckPointJournal::~CheckPointJournal() {
+    close();
+}
+
+bool CheckPointJournal::Load(unordered_map<string, string>& records, uint32_t& version) {
+    close();
+    mValueHashes.clear();
+    if (!open()) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(mFd, &st) != 0 || static_cast<uint64_t>(st.st_size) < kFileHeaderSize) {
+        LOG_WARNING(sLogger, ("invalid checkpoint journal, ignore", mPath));
+        close();
+        return false;
+    }
+    auto size = static_cast<uint64_t>(st.st_size);
+    void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, mFd, 0);
+    if (addr == MAP_FAILED) {
+        LOG_ERROR(sLogger, ("failed to mmap checkpoint journal", mPath)("error", strerror(errno)));
+        close();
+        return false;
+    }
+    const auto* data = static_cast<const char*>(addr);
+    uint64_t magic = 0;
+    memcpy(&magic, data, sizeof(magic));
+    if (magic != kFileMagic) {
+        LOG_WARNING(sLogger, ("invalid checkpoint journal magic, ignore", mPath));
+        munmap(addr, size);
+        close();
+        return false;
+    }
+    memcpy(&mVersion, data + sizeof(magic), sizeof(mVersion));
+
+    records.clear();
+    uint64_t pos = kFileHeaderSize;
+    while (pos < size && ApplyRecord(data, size, pos, records)) {
+    }
+    munmap(addr, size);
+    if (pos < size) {
+        // torn by a crash during write, there is nothing valid after it
+        LOG_WARNING(sLogger,
+                    ("drop torn records in checkpoint journal", mPath)("valid size", pos)("file size", size));
+        if (ftruncate(mFd, pos) != 0) {
+            LOG_ERROR(sLogger, ("failed to truncate checkpoint journal", mPath)("error", strerror(errno)));
+            // appended records would follow the torn ones, so start over with a new file on next dump
+            close();
+        }
+    }
+    mFileSize = pos;
+    mValueHashes.reserve(records.size());
+    for (const auto& item : records) {
+        mValueHashes[item.first] = XXH64(item.second.data(), item.second.size(), 0);
+    }
+    version = mVersion;
+    return true;
+}
+
+bool CheckPointJournal::Dump(const unordered_map<string, string>& records, uint32_t version) {
+    if (mFd < 0 || version != mVersion) {
+        return compact(records, version);
+    }
+
+    string batch(kRecordHeaderSize, '\0');
+    batch.push_back(static_cast<char>(BatchType::DELTA));
+    vector<pair<const string*, uint64_t>> puts;
+    vector<string> dels;
+    uint64_t liveSize = 0;
+    size_t existedCnt = 0;
+    for (const auto& item : records) {
+        liveSize += 1 + 2 * sizeof(uint32_t) + item.first.size() + item.second.size();
+        auto hash = XXH64(item.second.data(), item.second.size(), 0);
+        auto it = mValueHashes.find(item.first);
+        if (it != mValueHashes.end()) {
+            ++existedCnt;
+            if (it->second == hash) {
+                continue;
+            }
+        }
+        batch.push_back(static_cast<char>(EntryOp::PUT));
+        AppendString(batch, item.first);
+        AppendString(batch, item.second);
+        puts.emplace_back(&item.first, hash);
+    }
+    if (existedCnt < mValueHashes.size()) {
+        for (const auto& item : mValueHashes) {
+            if (records.find(item.first) == records.end()) {
+                batch.push_back(static_cast<char>(EntryOp::DEL));
+                AppendString(batch, item.first);
+                dels.push_back(item.first);
+            }
+        }
+    }
+    if (puts.empty() && dels.empty()) {
+        return true;
+    }
+    auto ratio = static_cast<uint64_t>(max(INT32_FLAG(checkpoint_journal_compact_ratio), 1));
+    if (mFileSize + batch.size() > max(liveSize, kMinCompactSize) * ratio) {
+        return compact(records, version);
+    }
+
+    SealRecord(batch, 0);
+    if (!append(batch)) {
+        return false;
+    }
+    for (const auto& item : puts) {
+        mValueHashes[*item.first] = item.second;
+    }
+    for (const auto& key : dels) {
+        mValueHashes.erase(key);
+    }
+    return true;
+}
+
+bool CheckPointJournal::open() {
+    mFd = ::open(mPath.c_str(), O_RDWR | O_APPEND | O_CLOEXEC);
+    if (mFd < 0) {
+        if (errno != ENOENT) {
+            LOG_ERROR(sLogger, ("failed to open checkpoint journal", mPath)("error", strerror(errno)));
+        }
+        return false;
+    }
+    return true;
+}
+
+void CheckPointJournal::close() {
+    if (mFd >= 0) {
+        ::close(mFd);
+        mFd = -1;
+    }
+}
+
+bool CheckPointJournal::append(const string& batch) {
+    if (!WriteAll(mFd, batch.data(), batch.size()) || fdatasync(mFd) != 0) {
+        LOG_ERROR(sLogger, ("failed to write checkpoint journal", mPath)("error", strerror(errno)));
+        // drop the partial write, or start over with a new file on next dump if it cannot be dropped
+        if (ftruncate(mFd, mFileSize) != 0) {
+            close();
+        }
+        return false;
+    }
+    mFileSize += batch.size();
+    return true;
+}
+
+bool CheckPointJournal::compact(const unordered_map<string, string>& records, uint32_t version) {
+    string buffer(kFileHeaderSize + kRecordHeaderSize, '\0');
+    memcpy(buffer.data(), &kFileMagic, sizeof(kFileMagic));
+    memcpy(buffer.data() + sizeof(kFileMagic), &version, sizeof(version));
+    buffer.push_back(static_cast<char>(BatchType::SNAPSHOT));
+    unordered_map<string, uint64_t> valueHashes;
+    valueHashes.reserve(records.size());
+    for (const auto& item : records) {
+        buffer.push_back(static_cast<char>(EntryOp::PUT));
+        AppendString(buffer, item.first);
+        AppendString(buffer, item.second);
+        valueHashes[item.first] = XXH64(item.second.data(), item.second.size(), 0);
+    }
+    SealRecord(buffer, kFileHeaderSize);
+
+    close();
+    string tmpPath = mPath + ".tmp";
+    int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        LOG_ERROR(sLogger, ("failed to open checkpoint journal", tmpPath)("error", strerror(errno)));
+        return false;
+    }
+    if (!WriteAll(fd, buffer.data(), buffer.size()) || fdatasync(fd) != 0) {
+        LOG_ERROR(sLogger, ("failed to write checkpoint journal", tmpPath)("error", strerror(errno)));
+        ::close(fd);
+        remove(tmpPath.c_str());
+        return false;
+    }
+    ::close(fd);
+    if (rename(tmpPath.c_str(), mPath.c_str()) != 0) {
+        LOG_ERROR(sLogger, ("failed to rename checkpoint journal", tmpPath)("error", strerror(errno)));
+        remove(tmpPath.c_str());
+        return false;
+    }
+    SyncDir(mPath);
+    if (!open()) {
+        return false;
+    }
+    mFileSize = buffer.size();
+    mVersion = version;
+    mValueHashes.swap(valueHashes);
+    LOG_DEBUG(sLogger, ("compact checkpoint journal", mPath)("record cnt", records.size())("size", mFileSize));
+    return true;
+}
+
+#else
+
+CheckPointJournal::~CheckPointJournal() = default;
+
+bool CheckPointJournal::Load(unordered_map<string, string>&, uint32_t&) {
+    return false;
+}
+
+bool CheckPointJournal::Dump(const unordered_map<string, string>&, uint32_t) {
+    return false;
+}
+
+#endif
+
+} // namespace logtail
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <string>
+#include <unordered_map>
+
+namespace logtail {
+
+// CheckPointJournal persists a set of key-value records in a binary, append-only file.
+// Each Dump appends only the records changed since the last one as a single checksummed batch, which costs one write
+// and one fdatasync, and a batch torn by a crash is dropped as a whole on Load. Once the file has grown much bigger
+// than the records alive in it, it is compacted, i.e., rewritten with a snapshot of the records and renamed over.
+// Only implemented on Linux, Load and Dump always fail on other platforms.
+// not thread-safe
+class CheckPointJournal {
+public:
+    explicit CheckPointJournal(const std::string& path) : mPath(path) {}
+    ~CheckPointJournal();
+
+    CheckPointJournal(const CheckPointJournal&) = delete;
+    CheckPointJournal& operator=(const CheckPointJournal&) = delete;
+
+    // false if there is no valid journal
+    bool Load(std::unordered_map<std::string, std::string>& records, uint32_t& version);
+    // the records given replace all the ones dumped before
+    bool Dump(const std::unordered_map<std::string, std::string>& records, uint32_t version);
+
+    const std::string& GetPath() const { return mPath; }
+    uint64_t GetFileSize() const { return mFileSize; }
+
+private:
+    bool open();
+    void close();
+    bool append(const std::string& batch);
+    bool compact(const std::unordered_map<std::string, std::string>& records, uint32_t version);
+
+    std::string mPath;
+    int mFd = -1;
+    uint64_t mFileSize = 0;
+    uint32_t mVersion = 0;
+    // hash of the value last written for each key alive in the file
+    std::unordered_map<std::string, uint64_t> mValueHashes;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class CheckPointJournalUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -16,6 +16,9 @@
 
 #include <fcntl.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <string>
 #include <thread>
@@ -40,9 +43,131 @@ DEFINE_FLAG_INT32(check_point_version, "now check point version xx.xx.xx such as
 DEFINE_FLAG_INT32(check_point_dump_interval, "default 15 min", 15 * 60);
 DEFINE_FLAG_INT32(check_point_max_count, "max check point count", 100000);
 DEFINE_FLAG_INT32(checkpoint_find_max_file_count, "", 1000);
+DEFINE_FLAG_BOOL(enable_checkpoint_journal,
+                 "dump checkpoints incrementally to a binary journal instead of rewriting the json file",
+                 true);
 
 namespace logtail {
 
+static const string kCheckPointJournalSuffix = ".journal";
+static constexpr char kFileCheckPointKeyPrefix = 'f';
+static constexpr char kDirCheckPointKeyPrefix = 'd';
+
+static bool IsCheckPointJournalEnabled() {
+#if defined(__linux__)
+    return BOOL_FLAG(enable_checkpoint_journal);
+#else
+    // the journal relies on mmap and fdatasync, checkpoints are always kept in the json file
+    return false;
+#endif
+}
+
+template <typename T>
+static void AppendValue(string& buffer, T value) {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static void AppendString(string& buffer, const string& value) {
+    AppendValue(buffer, static_cast<uint32_t>(value.size()));
+    buffer.append(value);
+}
+
+template <typename T>
+static bool ReadValue(const string& buffer, size_t& pos, T& value) {
+    if (pos + sizeof(value) > buffer.size()) {
+        return false;
+    }
+    memcpy(&value, buffer.data() + pos, sizeof(value));
+    pos += sizeof(value);
+    return true;
+}
+
+static bool ReadString(const string& buffer, size_t& pos, string& value) {
+    uint32_t size = 0;
+    if (!ReadValue(buffer, pos, size) || pos + size > buffer.size()) {
+        return false;
+    }
+    value.assign(buffer.data() + pos, size);
+    pos += size;
+    return true;
+}
+
+// key: 'f' dev(8) inode(8) configName
+// value: offset(8) sigHash(8) sigSize(4) updateTime(4) idxInReaderArray(4) flags(1) fileName realFileName containerID
+static void EncodeFileCheckPoint(const CheckPoint& checkPoint, string& key, string& value) {
+    key.clear();
+    key.push_back(kFileCheckPointKeyPrefix);
+    AppendValue(key, checkPoint.mDevInode.dev);
+    AppendValue(key, checkPoint.mDevInode.inode);
+    key.append(checkPoint.mConfigName);
+
+    value.clear();
+    AppendValue(value, checkPoint.mOffset);
+    AppendValue(value, checkPoint.mSignatureHash);
+    AppendValue(value, checkPoint.mSignatureSize);
+    AppendValue(value, checkPoint.mLastUpdateTime);
+    AppendValue(value, checkPoint.mIdxInReaderArray);
+    AppendValue(value,
+                static_cast<uint8_t>((checkPoint.mFileOpenFlag ? 1 : 0) | (checkPoint.mContainerStopped ? 2 : 0)
+                                     | (checkPoint.mLastForceRead ? 4 : 0)));
+    AppendString(value, checkPoint.mFileName);
+    AppendString(value, checkPoint.mRealFileName);
+    AppendString(value, checkPoint.mContainerID);
+}
+
+static bool DecodeFileCheckPoint(const string& key, const string& value, CheckPoint& checkPoint) {
+    size_t pos = 1;
+    if (!ReadValue(key, pos, checkPoint.mDevInode.dev) || !ReadValue(key, pos, checkPoint.mDevInode.inode)) {
+        return false;
+    }
+    checkPoint.mConfigName = key.substr(pos);
+
+    pos = 0;
+    uint8_t flags = 0;
+    if (!ReadValue(value, pos, checkPoint.mOffset) || !ReadValue(value, pos, checkPoint.mSignatureHash)
+        || !ReadValue(value, pos, checkPoint.mSignatureSize) || !ReadValue(value, pos, checkPoint.mLastUpdateTime)
+        || !ReadValue(value, pos, checkPoint.mIdxInReaderArray) || !ReadValue(value, pos, flags)
+        || !ReadString(value, pos, checkPoint.mFileName) || !ReadString(value, pos, checkPoint.mRealFileName)
+        || !ReadString(value, pos, checkPoint.mContainerID)) {
+        return false;
+    }
+    checkPoint.mFileOpenFlag = (flags & 1) != 0;
+    checkPoint.mContainerStopped = (flags & 2) != 0;
+    checkPoint.mLastForceRead = (flags & 4) != 0;
+    return true;
+}
+
+// key: 'd' dirName
+// value: updateTime(4) subDirCnt(4) subDir...
+static void EncodeDirCheckPoint(const string& dirName, const DirCheckPoint& checkPoint, string& key, string& value) {
+    key.clear();
+    key.push_back(kDirCheckPointKeyPrefix);
+    key.append(dirName);
+
+    value.clear();
+    AppendValue(value, checkPoint.mUpdateTime);
+    AppendValue(value, static_cast<uint32_t>(checkPoint.mSubDir.size()));
+    for (const auto& subDir : checkPoint.mSubDir) {
+        AppendString(value, subDir);
+    }
+}
+
+static bool DecodeDirCheckPoint(const string& value, int32_t& updateTime, set<string>& subDirs) {
+    size_t pos = 0;
+    uint32_t cnt = 0;
+    if (!ReadValue(value, pos, updateTime) || !ReadValue(value, pos, cnt)) {
+        return false;
+    }
+    string subDir;
+    for (uint32_t i = 0; i < cnt; ++i) {
+        if (!ReadString(value, pos, subDir)) {
+            return false;
+        }
+        subDirs.insert(subDir);
+    }
+    return true;
+}
+
 bool CheckPointManager::CheckVersion() {
     return (mLoadVersion == NO_CHECKPOINT_VERSION) || (mLoadVersion / 10000 == INT32_FLAG(check_point_version) / 10000);
 }
@@ -128,6 +253,10 @@ void CheckPointManager::AddDirCheckPoint(const string& dirname) {
     ptr->mSubDir.insert(dirname);
 }
 void CheckPointManager::LoadCheckPoint() {
+    // the json file is still loaded if there is no journal, e.g., the one left by the previous version
+    if (IsCheckPointJournalEnabled() && LoadCheckPointFromJournal()) {
+        return;
+    }
     Json::Value root;
     ParseConfResult cptRes = ParseConfig(AppConfig::GetInstance()->GetCheckPointFilePath(), root);
     // if new checkpoint file not exist, check old checkpoint file.
@@ -159,6 +288,58 @@ void CheckPointManager::LoadCheckPoint() {
                  "dir check point", mDirNameMap.size()));
 }
 
+bool CheckPointManager::LoadCheckPointFromJournal() {
+    mJournal = make_unique<CheckPointJournal>(AppConfig::GetInstance()->GetCheckPointFilePath()
+                                              + kCheckPointJournalSuffix);
+    unordered_map<string, string> records;
+    uint32_t version = 0;
+    if (!mJournal->Load(records, version)) {
+        return false;
+    }
+    mLoadVersion = version;
+    mReaderCount = 0;
+    int32_t curTime = time(NULL);
+    for (const auto& item : records) {
+        const string& key = item.first;
+        if (key.empty()) {
+            continue;
+        }
+        if (key[0] == kDirCheckPointKeyPrefix) {
+            string dirName = key.substr(1);
+            DirCheckPointPtr dir(new DirCheckPoint(dirName));
+            int32_t updateTime = 0;
+            if (!DecodeDirCheckPoint(item.second, updateTime, dir->mSubDir)) {
+                LOG_ERROR(sLogger, ("failed to parse dir checkpoint", dirName));
+                AlarmManager::GetInstance()->SendAlarmWarning(CHECKPOINT_ALARM,
+                                                              "failed to parse dir checkpoint:" + dirName);
+                continue;
+            }
+            if (updateTime >= curTime - INT32_FLAG(file_check_point_time_out)) {
+                mDirNameMap.insert(make_pair(dirName, dir));
+            } else {
+                LOG_INFO(sLogger, ("load timeout dir check point, ignore", dirName)(ToString(updateTime), curTime));
+            }
+        } else if (key[0] == kFileCheckPointKeyPrefix) {
+            ++mReaderCount;
+            unique_ptr<CheckPoint> ptr(new CheckPoint());
+            if (!DecodeFileCheckPoint(key, item.second, *ptr)) {
+                LOG_ERROR(sLogger, ("failed to parse file checkpoint", "discard it"));
+                AlarmManager::GetInstance()->SendAlarmWarning(CHECKPOINT_ALARM, "failed to parse file checkpoint");
+                continue;
+            }
+            if (!ptr->mDevInode.IsValid()) {
+                LOG_WARNING(sLogger, ("can not find check point dev inode, discard it", ptr->mFileName));
+                continue;
+            }
+            AddCheckPoint(ptr.release());
+        }
+    }
+    LOG_INFO(sLogger,
+             ("load checkpoint from journal, version", mLoadVersion)(
+                 "file check point", mDevInodeCheckPointPtrMap.size())("dir check point", mDirNameMap.size()));
+    return true;
+}
+
 void CheckPointManager::LoadDirCheckPoint(const Json::Value& root) {
     if (root.isMember("dir_check_point") == false)
         return;
@@ -331,7 +512,6 @@ void CheckPointManager::LoadFileCheckPoint(const Json::Value& root) {
 bool CheckPointManager::DumpCheckPointToLocal() {
     mLastDumpTime = time(NULL);
     string checkPointFile = AppConfig::GetInstance()->GetCheckPointFilePath();
-    string checkPointTempFile = checkPointFile + ".bak";
 
     if (!Mkdirs(ParentPath(checkPointFile))) {
         LOG_ERROR(sLogger, ("open check point file dir error", checkPointFile));
@@ -339,70 +519,84 @@ bool CheckPointManager::DumpCheckPointToLocal() {
         return false;
     }
 
-    Json::Value root;
     mReaderCount = mDevInodeCheckPointPtrMap.size();
-    if (mDevInodeCheckPointPtrMap.size() <= (size_t)INT32_FLAG(check_point_max_count)) {
-        CheckPointManager::DevInodeCheckPointHashMap::iterator it;
-        for (it = mDevInodeCheckPointPtrMap.begin(); it != mDevInodeCheckPointPtrMap.end(); ++it) {
-            CheckPoint* checkPointPtr = it->second.get();
-            Json::Value leaf;
-            leaf["file_name"] = Json::Value(checkPointPtr->mFileName);
-            leaf["real_file_name"] = Json::Value(checkPointPtr->mRealFileName);
-            leaf["offset"] = Json::Value(ToString(checkPointPtr->mOffset));
-            leaf["sig_size"] = Json::Value(Json::UInt(checkPointPtr->mSignatureSize));
-            leaf["sig_hash"] = Json::Value(Json::UInt64(checkPointPtr->mSignatureHash));
-            leaf["update_time"] = Json::Value(checkPointPtr->mLastUpdateTime);
-            leaf["inode"] = Json::Value(Json::UInt64(checkPointPtr->mDevInode.inode));
-            leaf["dev"] = Json::Value(Json::UInt64(checkPointPtr->mDevInode.dev));
-            leaf["file_open"] = Json::Value(checkPointPtr->mFileOpenFlag ? 1 : 0);
-            leaf["container_stopped"] = Json::Value(checkPointPtr->mContainerStopped ? 1 : 0);
-            leaf["container_id"] = Json::Value(checkPointPtr->mContainerID);
-            leaf["last_force_read"] = Json::Value(checkPointPtr->mLastForceRead ? 1 : 0);
-            leaf["config_name"] = Json::Value(checkPointPtr->mConfigName);
-            // forward compatible
-            leaf["sig"] = Json::Value(string(""));
-            leaf["idx_in_reader_array"] = Json::Value(checkPointPtr->mIdxInReaderArray);
-            // use filename + dev + inode + configName to prevent same filename conflict
-            root[checkPointPtr->mFileName + "*" + ToString(checkPointPtr->mDevInode.dev) + "*"
-                 + ToString(checkPointPtr->mDevInode.inode) + "*" + checkPointPtr->mConfigName]
-                = leaf;
-        }
-    } else {
-        vector<CheckPoint*> sortedCheckPointVec;
-        CheckPointManager::DevInodeCheckPointHashMap::iterator it;
-        for (it = mDevInodeCheckPointPtrMap.begin(); it != mDevInodeCheckPointPtrMap.end(); ++it) {
-            sortedCheckPointVec.push_back(it->second.get());
-        }
-        sort(sortedCheckPointVec.begin(), sortedCheckPointVec.end(), CheckPointManager::CheckPointCmpByUpdateTime);
-        for (int32_t i = 0; i < INT32_FLAG(check_point_max_count); ++i) {
-            CheckPoint* checkPointPtr = sortedCheckPointVec[i];
-            Json::Value leaf;
-            leaf["file_name"] = Json::Value(checkPointPtr->mFileName);
-            leaf["real_file_name"] = Json::Value(checkPointPtr->mRealFileName);
-            leaf["offset"] = Json::Value(ToString(checkPointPtr->mOffset));
-            leaf["sig_size"] = Json::Value(Json::UInt(checkPointPtr->mSignatureSize));
-            leaf["sig_hash"] = Json::Value(Json::UInt64(checkPointPtr->mSignatureHash));
-            leaf["update_time"] = Json::Value(checkPointPtr->mLastUpdateTime);
-            leaf["inode"] = Json::Value(Json::UInt64(checkPointPtr->mDevInode.inode));
-            leaf["dev"] = Json::Value(Json::UInt64(checkPointPtr->mDevInode.dev));
-            leaf["file_open"] = Json::Value(checkPointPtr->mFileOpenFlag ? 1 : 0);
-            leaf["container_stopped"] = Json::Value(checkPointPtr->mContainerStopped ? 1 : 0);
-            leaf["container_id"] = Json::Value(checkPointPtr->mContainerID);
-            leaf["last_force_read"] = Json::Value(checkPointPtr->mLastForceRead ? 1 : 0);
-            leaf["config_name"] = Json::Value(checkPointPtr->mConfigName);
-            // forward compatible
-            leaf["sig"] = Json::Value(string(""));
-            leaf["idx_in_reader_array"] = Json::Value(checkPointPtr->mIdxInReaderArray);
-            // use filename + dev + inode + configName to prevent same filename conflict
-            root[checkPointPtr->mFileName + "*" + ToString(checkPointPtr->mDevInode.dev) + "*"
-                 + ToString(checkPointPtr->mDevInode.inode) + "*" + checkPointPtr->mConfigName]
-                = leaf;
-        }
+    vector<CheckPoint*> checkPoints;
+    checkPoints.reserve(mDevInodeCheckPointPtrMap.size());
+    for (const auto& item : mDevInodeCheckPointPtrMap) {
+        checkPoints.push_back(item.second.get());
+    }
+    if (checkPoints.size() > (size_t)INT32_FLAG(check_point_max_count)) {
+        sort(checkPoints.begin(), checkPoints.end(), CheckPointManager::CheckPointCmpByUpdateTime);
+        checkPoints.resize(INT32_FLAG(check_point_max_count));
         LOG_WARNING(sLogger, ("Too many check point", mDevInodeCheckPointPtrMap.size()));
         AlarmManager::GetInstance()->SendAlarmWarning(
             CHECKPOINT_ALARM, "Too many check point:" + ToString(mDevInodeCheckPointPtrMap.size()));
     }
 
+    bool res = IsCheckPointJournalEnabled() ? DumpCheckPointToJournal(checkPointFile, checkPoints)
+                                            : DumpCheckPointToJson(checkPointFile, checkPoints);
+    if (res) {
+        LOG_DEBUG(sLogger,
+                  ("dump checkpoint, version", INT32_FLAG(check_point_version))("file check point", checkPoints.size())(
+                      "dir check point", mDirNameMap.size()));
+    }
+    return res;
+}
+
+bool CheckPointManager::DumpCheckPointToJournal(const string& checkPointFile, const vector<CheckPoint*>& checkPoints) {
+    unordered_map<string, string> records;
+    records.reserve(checkPoints.size() + mDirNameMap.size());
+    string key;
+    string value;
+    for (const auto* checkPointPtr : checkPoints) {
+        EncodeFileCheckPoint(*checkPointPtr, key, value);
+        records[key] = value;
+    }
+    for (const auto& item : mDirNameMap) {
+        EncodeDirCheckPoint(item.first, *item.second, key, value);
+        records[key] = value;
+    }
+
+    string journalFile = checkPointFile + kCheckPointJournalSuffix;
+    if (!mJournal || mJournal->GetPath() != journalFile) {
+        mJournal = make_unique<CheckPointJournal>(journalFile);
+    }
+    if (!mJournal->Dump(records, INT32_FLAG(check_point_version))) {
+        LOG_ERROR(sLogger, ("dump check point to journal failed", journalFile));
+        AlarmManager::GetInstance()->SendAlarmWarning(CHECKPOINT_ALARM, "dump check point to journal failed");
+        return false;
+    }
+    // the json file is stale from now on
+    remove(checkPointFile.c_str());
+    return true;
+}
+
+bool CheckPointManager::DumpCheckPointToJson(const string& checkPointFile, const vector<CheckPoint*>& checkPoints) {
+    string checkPointTempFile = checkPointFile + ".bak";
+    Json::Value root;
+    for (const auto* checkPointPtr : checkPoints) {
+        Json::Value leaf;
+        leaf["file_name"] = Json::Value(checkPointPtr->mFileName);
+        leaf["real_file_name"] = Json::Value(checkPointPtr->mRealFileName);
+        leaf["offset"] = Json::Value(ToString(checkPointPtr->mOffset));
+        leaf["sig_size"] = Json::Value(Json::UInt(checkPointPtr->mSignatureSize));
+        leaf["sig_hash"] = Json::Value(Json::UInt64(checkPointPtr->mSignatureHash));
+        leaf["update_time"] = Json::Value(checkPointPtr->mLastUpdateTime);
+        leaf["inode"] = Json::Value(Json::UInt64(checkPointPtr->mDevInode.inode));
+        leaf["dev"] = Json::Value(Json::UInt64(checkPointPtr->mDevInode.dev));
+        leaf["file_open"] = Json::Value(checkPointPtr->mFileOpenFlag ? 1 : 0);
+        leaf["container_stopped"] = Json::Value(checkPointPtr->mContainerStopped ? 1 : 0);
+        leaf["container_id"] = Json::Value(checkPointPtr->mContainerID);
+        leaf["last_force_read"] = Json::Value(checkPointPtr->mLastForceRead ? 1 : 0);
+        leaf["config_name"] = Json::Value(checkPointPtr->mConfigName);
+        // forward compatible
+        leaf["sig"] = Json::Value(string(""));
+        leaf["idx_in_reader_array"] = Json::Value(checkPointPtr->mIdxInReaderArray);
+        // use filename + dev + inode + configName to prevent same filename conflict
+        root[checkPointPtr->mFileName + "*" + ToString(checkPointPtr->mDevInode.dev) + "*"
+             + ToString(checkPointPtr->mDevInode.inode) + "*" + checkPointPtr->mConfigName]
+            = leaf;
+    }
 
     Json::Value dirJson;
     for (unordered_map<string, DirCheckPointPtr>::iterator it = mDirNameMap.begin(); it != mDirNameMap.end(); ++it) {
@@ -446,10 +640,9 @@ bool CheckPointManager::DumpCheckPointToLocal() {
             CHECKPOINT_ALARM, std::string("rename check point file fail, errno ") + ToString(errno));
         return false;
     }
-    LOG_DEBUG(sLogger,
-              ("dump checkpoint, version", INT32_FLAG(check_point_version))(
-                  "file check point", mDevInodeCheckPointPtrMap.size())("dir check point", mDirNameMap.size()));
-
+    // the journal is stale from now on, and would be loaded in preference to the json file once enabled again
+    mJournal.reset();
+    remove((checkPointFile + kCheckPointJournalSuffix).c_str());
     return true;
 }
 
@@ -566,6 +759,8 @@ void CheckPointManager::RemoveLocalCheckPoint() {
     std::string checkPointFile = AppConfig::GetInstance()->GetCheckPointFilePath();
     if (remove(checkPointFile.c_str()) == -1) {
     }
+    mJournal.reset();
+    remove((checkPointFile + kCheckPointJournalSuffix).c_str());
 }
 
 void CheckPointManager::PrintStatus() {
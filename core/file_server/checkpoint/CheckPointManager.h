@@ -21,6 +21,7 @@
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "boost/optional.hpp"
 #include "json/json.h"
@@ -28,6 +29,7 @@
 #include "common/DevInode.h"
 #include "common/EncodingConverter.h"
 #include "common/SplitedFilePath.h"
+#include "file_server/checkpoint/CheckPointJournal.h"
 #include "file_server/reader/LogFileReader.h"
 
 #ifdef APSARA_UNIT_TEST_MAIN
@@ -122,9 +124,14 @@ private:
     int32_t mLastDumpTime;
     int32_t mLoadVersion;
     int32_t mReaderCount;
+    std::unique_ptr<CheckPointJournal> mJournal;
     CheckPointManager()
         : mLastCheckTime(time(NULL)), mLastDumpTime(time(NULL)), mLoadVersion(NO_CHECKPOINT_VERSION), mReaderCount(0) {}
 
+    bool LoadCheckPointFromJournal();
+    bool DumpCheckPointToJournal(const std::string& checkPointFile, const std::vector<CheckPoint*>& checkPoints);
+    bool DumpCheckPointToJson(const std::string& checkPointFile, const std::vector<CheckPoint*>& checkPoints);
+
 public:
     bool CheckVersion();
     void AddCheckPoint(CheckPoint* checkPointPtr);
@@ -155,6 +162,7 @@ public:
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ConfigUpdatorUnittest;
+    friend class CheckpointManagerUnittest;
     void RemoveLocalCheckPoint();
     void PrintStatus();
 #endif
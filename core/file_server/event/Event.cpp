@@ -0,0 +1,89 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "file_server/event/Event.h"
+
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "common/Flags.h"
+
+DEFINE_FLAG_INT32(event_pool_max_size, "max number of freed events kept for reuse", 4096);
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+class EventPool {
+public:
+    static EventPool* GetInstance() {
+        // never destructed, since events may still be freed by the destructors of other singletons
+        static auto* sPool = new EventPool();
+        return sPool;
+    }
+
+    void* Allocate() {
+        {
+            lock_guard<mutex> lock(mMux);
+            if (!mFreeList.empty()) {
+                void* ptr = mFreeList.back();
+                mFreeList.pop_back();
+                return ptr;
+            }
+        }
+        return ::operator new(sizeof(Event));
+    }
+
+    void Free(void* ptr) {
+        {
+            lock_guard<mutex> lock(mMux);
+            if (mFreeList.size() < static_cast<size_t>(INT32_FLAG(event_pool_max_size))) {
+                mFreeList.push_back(ptr);
+                return;
+            }
+        }
+        ::operator delete(ptr);
+    }
+
+private:
+    EventPool() = default;
+
+    mutex mMux;
+    vector<void*> mFreeList;
+};
+
+} // namespace
+
+void* Event::operator new(size_t size) {
+    if (size != sizeof(Event)) {
+        return ::operator new(size);
+    }
+    return EventPool::GetInstance()->Allocate();
+}
+
+void Event::operator delete(void* ptr, size_t size) {
+    if (ptr == nullptr) {
+        return;
+    }
+    if (size != sizeof(Event)) {
+        ::operator delete(ptr);
+        return;
+    }
+    EventPool::GetInstance()->Free(ptr);
+}
+
+} // namespace logtail
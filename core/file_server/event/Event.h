@@ -15,6 +15,7 @@
  */
 
 #pragma once
+#include <stddef.h>
 #include <stdint.h>
 
 #include <string>
@@ -36,32 +37,35 @@ typedef uint32_t EventType;
 #define EVENT_CONTAINER_STOPPED (256)
 #define EVENT_READER_FLUSH_TIMEOUT (512)
 
+// Events are created and destroyed at a high rate by the inotify listener and the polling threads, so they are
+// allocated from a free list shared by all threads, see operator new below.
 class Event {
 private:
     std::string mSource; // path of file or dir
     std::string mObject; // the object who has changed
-    EventType mType;
-    int mWd;
-    uint32_t mCookie;
-    uint64_t mDev;
-    uint64_t mInode;
-    int64_t mHashKey;
     std::string mConfigName;
     std::string mContainerID;
+    uint64_t mDev;
+    uint64_t mInode;
+    int64_t mHashKey = 0;
 
     // for read timeout
-    int64_t mLastReadPos;
-    int64_t mLastFilePos;
+    int64_t mLastReadPos = 0;
+    int64_t mLastFilePos = 0;
+
+    EventType mType;
+    int mWd;
+    uint32_t mCookie;
 
 public:
     Event(const std::string& source, const std::string& object, EventType type, int wd, uint32_t cookie = 0)
         : mSource(source),
           mObject(object),
+          mDev(NO_BLOCK_DEV),
+          mInode(NO_BLOCK_INODE),
           mType(type),
           mWd(wd),
-          mCookie(cookie),
-          mDev(NO_BLOCK_DEV),
-          mInode(NO_BLOCK_INODE) {}
+          mCookie(cookie) {}
     Event(const std::string& source,
           const std::string& object,
           EventType type,
@@ -69,7 +73,10 @@ public:
           uint32_t cookie,
           uint64_t dev,
           uint64_t inode)
-        : mSource(source), mObject(object), mType(type), mWd(wd), mCookie(cookie), mDev(dev), mInode(inode) {}
+        : mSource(source), mObject(object), mDev(dev), mInode(inode), mType(type), mWd(wd), mCookie(cookie) {}
+
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr, size_t size);
 
     static bool CompareByFullPath(const Event* lhs, const Event* rhs) {
         std::string lhsPath(lhs->mSource);
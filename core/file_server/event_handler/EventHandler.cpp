@@ -816,6 +816,9 @@ void ModifyHandler::Handle(const Event& event) {
                     reader->GetQueueKey(), mConfigName, event, reader->GetDevInode(), curTime);
                 return;
             }
+            if (AppConfig::GetInstance()->IsInputFlowControl()) {
+                LogInput::GetInstance()->FlowControl(mConfigName);
+            }
             auto logBuffer = make_unique<LogBuffer>();
             hasMoreData = reader->ReadLog(*logBuffer, &event);
             int32_t pushRetry = PushLogToProcessor(reader, logBuffer.get());
@@ -14,7 +14,10 @@
 
 #include "HistoryFileImporter.h"
 
+#include <thread>
+
 #include "app_config/AppConfig.h"
+#include "collection_pipeline/limiter/InputFlowController.h"
 #include "collection_pipeline/queue/ProcessQueueManager.h"
 #include "common/FileSystemUtil.h"
 #include "common/RuntimeUtil.h"
@@ -108,6 +111,13 @@ void HistoryFileImporter::ProcessEvent(const HistoryFileEvent& event, const std:
             while (!ProcessQueueManager::GetInstance()->IsValidToPush(readerSharePtr->GetQueueKey())) {
                 usleep(1000 * 10);
             }
+            if (AppConfig::GetInstance()->IsInputFlowControl()) {
+                // history files share the budget of the config with the files being collected
+                auto waitTime = InputFlowController::GetInstance()->GetWaitTime(readerSharePtr->GetConfigName());
+                if (waitTime.count() > 0) {
+                    std::this_thread::sleep_for(waitTime);
+                }
+            }
             std::unique_ptr<LogBuffer> logBuffer(new LogBuffer);
             readerSharePtr->ReadLog(*logBuffer, nullptr);
             if (!logBuffer->rawBuffer.empty()) {
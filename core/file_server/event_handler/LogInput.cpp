@@ -18,6 +18,7 @@
 
 #include "app_config/AppConfig.h"
 #include "application/Application.h"
+#include "collection_pipeline/limiter/InputFlowController.h"
 #include "common/FileSystemUtil.h"
 #include "common/HashUtil.h"
 #include "common/LogtailCommonFlags.h"
@@ -153,52 +154,21 @@ void LogInput::TryReadEvents(bool forceRead) {
     mLastReadEventTime = ((int32_t)time(NULL));
 }
 
-void LogInput::FlowControl() {
-    const static int32_t FLOW_CONTROL_SLEEP_MICROSECONDS = 20 * 1000; // 20ms
-    const static int32_t MAX_SLEEP_COUNT = 50; // 1s
-    static int32_t sleepCount = 10;
-    static int32_t lastCheckTime = 0;
-    int32_t i = 0;
-    while (i < sleepCount) {
-        if (mInteruptFlag)
+void LogInput::FlowControl(const std::string& configName) {
+    const static auto FLOW_CONTROL_MAX_SLEEP_TIME = chrono::milliseconds(20);
+    const static auto READ_EVENTS_INTERVAL = chrono::milliseconds(100);
+    auto lastReadEventsTime = chrono::steady_clock::now();
+    while (!mInteruptFlag) {
+        auto waitTime = InputFlowController::GetInstance()->GetWaitTime(configName);
+        if (waitTime.count() <= 0) {
             return;
-        usleep(FLOW_CONTROL_SLEEP_MICROSECONDS);
-        ++i;
-        if (i % 5 == 0)
+        }
+        // sleep in short slices so that interruption and new events are not held up by a long wait
+        this_thread::sleep_for(min<chrono::microseconds>(waitTime, FLOW_CONTROL_MAX_SLEEP_TIME));
+        if (chrono::steady_clock::now() - lastReadEventsTime >= READ_EVENTS_INTERVAL) {
             TryReadEvents(true);
-    }
-
-    if (mInteruptFlag)
-        return;
-    int32_t curTime = time(NULL);
-    if (curTime - lastCheckTime >= 1) {
-        lastCheckTime = curTime;
-        double cpuUsageLevel = LogtailMonitor::GetInstance()->GetRealtimeCpuLevel();
-        if (cpuUsageLevel >= 1.5) {
-            sleepCount += 5;
-            if (sleepCount > MAX_SLEEP_COUNT)
-                sleepCount = MAX_SLEEP_COUNT;
-        } else if (cpuUsageLevel >= 1.2) {
-            sleepCount += 2;
-            if (sleepCount > MAX_SLEEP_COUNT)
-                sleepCount = MAX_SLEEP_COUNT;
-        } else if (cpuUsageLevel >= 1.0) {
-            if (sleepCount < MAX_SLEEP_COUNT)
-                ++sleepCount;
-        } else if (cpuUsageLevel >= 0.9) {
-        } else if (cpuUsageLevel >= 0.6) {
-            if (sleepCount > 0)
-                --sleepCount;
-        } else if (cpuUsageLevel >= 0.3) {
-            sleepCount -= 2;
-            if (sleepCount < 0)
-                sleepCount = 0;
-        } else {
-            sleepCount -= 5;
-            if (sleepCount < 0)
-                sleepCount = 0;
+            lastReadEventsTime = chrono::steady_clock::now();
         }
-        LOG_DEBUG(sLogger, ("cpuUsageLevel", cpuUsageLevel)("sleepCount", sleepCount));
     }
 }
 
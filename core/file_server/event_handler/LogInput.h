@@ -45,7 +45,8 @@ public:
     void PushEventQueue(std::vector<Event*>& eventVec);
     void PushEventQueue(Event* ev);
     void TryReadEvents(bool forceRead);
-    void FlowControl();
+    // wait until the inputs of the config are allowed to read more
+    void FlowControl(const std::string& configName);
     bool IsInterupt() { return mInteruptFlag; }
 
     /**
@@ -14,8 +14,13 @@
 
 #include "EventListener_Linux.h"
 
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/fanotify.h>
 #include <sys/inotify.h>
 #include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <sys/statfs.h>
 #include <unistd.h>
 
 #include "common/ErrorUtil.h"
@@ -25,112 +30,396 @@
 #include "logger/Logger.h"
 #include "monitor/AlarmManager.h"
 
+#if defined(FAN_REPORT_DFID_NAME) && defined(FAN_MARK_FILESYSTEM)
+#define LOGTAIL_FANOTIFY_SUPPORTED
+#endif
+
 DEFINE_FLAG_BOOL(fs_events_inotify_enable, "", true);
+DEFINE_FLAG_BOOL(fs_events_fanotify_enable,
+                 "watch the filesystems of the registered dirs with fanotify instead of one inotify watch per dir, "
+                 "requires CAP_SYS_ADMIN and linux 5.9+, falls back to inotify if not permitted",
+                 false);
 
 namespace logtail {
 
+static const size_t kMaxKeptBufferSize = 1024 * 1024;
+
 const uint32_t EventListener::mWatchEventMask
     = IN_CREATE | IN_MODIFY | IN_MASK_ADD | IN_DELETE_SELF | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE;
 
+#ifdef LOGTAIL_FANOTIFY_SUPPORTED
+static const uint64_t kFanotifyEventMask
+    = FAN_CREATE | FAN_MODIFY | FAN_DELETE | FAN_DELETE_SELF | FAN_MOVED_FROM | FAN_MOVED_TO | FAN_ONDIR;
+static const int kMaxFanotifyEventLen = FAN_EVENT_METADATA_LEN + sizeof(struct fanotify_event_info_fid)
+    + sizeof(struct file_handle) + MAX_HANDLE_SZ + NAME_MAX + 1;
+
+static void AppendHandleKey(const void* fsid, const struct file_handle* handle, std::string& key) {
+    key.assign(static_cast<const char*>(fsid), sizeof(__kernel_fsid_t));
+    key.append(reinterpret_cast<const char*>(&handle->handle_type), sizeof(handle->handle_type));
+    key.append(reinterpret_cast<const char*>(handle->f_handle), handle->handle_bytes);
+}
+#endif
+
 logtail::EventListener::~EventListener() {
     Destroy();
 }
 
 bool logtail::EventListener::Init() {
+    if (BOOL_FLAG(fs_events_fanotify_enable) && InitFanotify()) {
+        return true;
+    }
     mInotifyFd = inotify_init();
     return mInotifyFd != -1;
 }
 
-int logtail::EventListener::AddWatch(const char* dir) {
+bool logtail::EventListener::InitFanotify() {
+#ifdef LOGTAIL_FANOTIFY_SUPPORTED
+    mFanotifyFd = fanotify_init(FAN_CLASS_NOTIF | FAN_CLOEXEC | FAN_NONBLOCK | FAN_REPORT_DFID_NAME,
+                                O_RDONLY | O_CLOEXEC | O_LARGEFILE);
+    if (mFanotifyFd == -1) {
+        LOG_WARNING(sLogger,
+                    ("failed to init fanotify fd, fall back to inotify", ErrnoToString(GetErrno()))("errno", errno));
+        return false;
+    }
+    // since linux 5.13, the fd can be inited without CAP_SYS_ADMIN, which is still required to mark a filesystem
+    if (fanotify_mark(mFanotifyFd, FAN_MARK_ADD | FAN_MARK_FILESYSTEM, kFanotifyEventMask, AT_FDCWD, "/") != 0) {
+        if (errno == EPERM) {
+            LOG_WARNING(sLogger, ("not permitted to mark filesystems with fanotify", "fall back to inotify"));
+            close(mFanotifyFd);
+            mFanotifyFd = -1;
+            return false;
+        }
+        // e.g. the root filesystem is not supported, the others may be
+    } else {
+        fanotify_mark(mFanotifyFd, FAN_MARK_REMOVE | FAN_MARK_FILESYSTEM, kFanotifyEventMask, AT_FDCWD, "/");
+    }
+    LOG_INFO(sLogger, ("watch file events with", "fanotify"));
+    return true;
+#else
+    LOG_WARNING(sLogger, ("fanotify with FAN_REPORT_DFID_NAME is not supported by this build", "fall back to inotify"));
+#endif
+    return false;
+}
+
+int logtail::EventListener::AddWatch(const char* dir, bool inotifyAllowed) {
+    if (mFanotifyFd != -1) {
+        int wd = AddFanotifyWatch(dir);
+        if (wd != -1) {
+            return wd;
+        }
+        if (!inotifyAllowed) {
+            errno = ENOSPC;
+            return -1;
+        }
+        LOG_INFO(sLogger,
+                 ("failed to watch dir with fanotify, watch it with inotify", dir)("reason",
+                                                                                  ErrnoToString(GetErrno())));
+        return AddInotifyWatch(dir);
+    }
+    return inotify_add_watch(mInotifyFd, dir, mWatchEventMask);
+}
+
+int logtail::EventListener::AddInotifyWatch(const char* dir) {
+    if (mInotifyFd == -1) {
+        mInotifyFd = inotify_init();
+        if (mInotifyFd == -1) {
+            return -1;
+        }
+    }
     return inotify_add_watch(mInotifyFd, dir, mWatchEventMask);
 }
 
+int logtail::EventListener::AddFanotifyWatch(const char* dir) {
+#ifdef LOGTAIL_FANOTIFY_SUPPORTED
+    struct statfs fsBuf;
+    alignas(struct file_handle) char handleBuf[sizeof(struct file_handle) + MAX_HANDLE_SZ];
+    auto* handle = reinterpret_cast<struct file_handle*>(handleBuf);
+    handle->handle_bytes = MAX_HANDLE_SZ;
+    int mountId = 0;
+    if (statfs(dir, &fsBuf) != 0 || name_to_handle_at(AT_FDCWD, dir, handle, &mountId, AT_SYMLINK_FOLLOW) != 0) {
+        return -1;
+    }
+    std::string key;
+    AppendHandleKey(&fsBuf.f_fsid, handle, key);
+    // like inotify, the dirs sharing the same inode share the same wd
+    auto it = mHandleWdMap.find(key);
+    if (it != mHandleWdMap.end()) {
+        return it->second;
+    }
+    std::string fsid(key, 0, sizeof(__kernel_fsid_t));
+    if (mMarkedFsids.find(fsid) == mMarkedFsids.end()) {
+        if (fanotify_mark(mFanotifyFd, FAN_MARK_ADD | FAN_MARK_FILESYSTEM, kFanotifyEventMask, AT_FDCWD, dir) != 0) {
+            // EINVAL and EBADF of inotify_add_watch are fatal to EventDispatcher, while here they only mean the
+            // filesystem cannot be watched by fanotify, e.g. a btrfs subvolume, so the dir is treated as unwatchable
+            if (errno == EINVAL || errno == EBADF) {
+                errno = EOPNOTSUPP;
+            }
+            return -1;
+        }
+        LOG_INFO(sLogger, ("add fanotify mark for the filesystem of dir", dir));
+        mMarkedFsids.insert(fsid);
+    }
+    int wd = mNextWd;
+    mNextWd = mNextWd == INT32_MAX ? kMinFanotifyWd : mNextWd + 1;
+    mHandleWdMap.emplace(key, wd);
+    mWdHandleMap.emplace(wd, std::move(key));
+    return wd;
+#else
+    errno = EOPNOTSUPP;
+    return -1;
+#endif
+}
+
 bool logtail::EventListener::RemoveWatch(int wd) {
+    if (mFanotifyFd != -1 && wd >= kMinFanotifyWd) {
+        // the filesystem mark is kept, the events of the dir are dropped once it is unregistered
+        auto it = mWdHandleMap.find(wd);
+        if (it == mWdHandleMap.end()) {
+            return false;
+        }
+        mHandleWdMap.erase(it->second);
+        mWdHandleMap.erase(it);
+        return true;
+    }
     return inotify_rm_watch(mInotifyFd, wd) != -1;
 }
 
 int32_t logtail::EventListener::ReadEvents(std::vector<logtail::Event*>& eventVec) {
     eventVec.clear();
-    if (mInotifyFd < 0) {
-        return 0;
+    // the dirs watched by the two are disjoint, so the order between their events does not matter
+    if (mFanotifyFd >= 0) {
+        ReadEvents(mFanotifyFd, mFanotifyBuffer, mFanotifyHalfEventSize, eventVec);
     }
+    if (mInotifyFd >= 0) {
+        ReadEvents(mInotifyFd, mBuffer, mHalfEventSize, eventVec);
+    }
+    return (int32_t)eventVec.size();
+}
+
+void logtail::EventListener::ReadEvents(int32_t fd,
+                                        std::vector<char>& buffer,
+                                        int32_t& halfEventSize,
+                                        std::vector<Event*>& eventVec) {
     int len = 0;
-    ioctl(mInotifyFd, FIONREAD, &len);
+    ioctl(fd, FIONREAD, &len);
     if (len < 1)
-        return 0;
-    static char* s_lastHalfEventBuf = new char[65536];
-    static int32_t s_lastHalfEventSize = 0;
-
-    char* buffer = new char[len + s_lastHalfEventSize];
-    if (s_lastHalfEventSize > 0) {
-        memcpy(buffer, s_lastHalfEventBuf, s_lastHalfEventSize);
+        return;
+#ifdef LOGTAIL_FANOTIFY_SUPPORTED
+    if (fd == mFanotifyFd) {
+        // FIONREAD of fanotify only counts the metadata of the events, not the info records following them
+        len = (len + FAN_EVENT_METADATA_LEN - 1) / FAN_EVENT_METADATA_LEN * kMaxFanotifyEventLen;
     }
-    size_t readLen = read(mInotifyFd, buffer + s_lastHalfEventSize, len);
-    if (readLen == 0) {
+#endif
+    if (buffer.size() < static_cast<size_t>(halfEventSize + len)) {
+        buffer.resize(halfEventSize + len);
+    }
+    ssize_t readLen = read(fd, buffer.data() + halfEventSize, len);
+    if (readLen <= 0) {
         LOG_ERROR(sLogger, ("read inotify fd error", ErrnoToString(GetErrno()))("read len", len));
-        delete[] buffer;
-        return 0;
+        return;
     }
-    // update len
-    len = readLen + s_lastHalfEventSize;
-    // when read success, set lastHalfSize 0
-    s_lastHalfEventSize = 0;
+    len = readLen + halfEventSize;
+    halfEventSize = 0;
     if (BOOL_FLAG(fs_events_inotify_enable)) {
-        static EventDispatcher* dispatcher = EventDispatcher::GetInstance();
-        int n = 0;
-        struct inotify_event* event;
-        while (n < len) {
-            // maybe invalid, must check if this packet is a whole packet
-            event = (struct inotify_event*)&buffer[n];
-
-            int tailSize = len - n;
-            if ((size_t)tailSize < sizeof(struct inotify_event)
-                || (size_t)tailSize < event->len + sizeof(struct inotify_event)) {
-                s_lastHalfEventSize = tailSize;
-                LOG_WARNING(sLogger,
-                            ("read notify event abnormal, half packet is readed, proccess size", n)("read len", len));
-                memcpy(s_lastHalfEventBuf, buffer + n, tailSize);
-                break;
-            }
+        int32_t n = fd == mFanotifyFd ? ParseFanotifyEvents(buffer.data(), len, eventVec)
+                                      : ParseEvents(buffer.data(), len, eventVec);
+        if (n < len) {
+            halfEventSize = len - n;
+            LOG_WARNING(sLogger,
+                        ("read notify event abnormal, half packet is readed, proccess size", n)("read len", len));
+            memmove(buffer.data(), buffer.data() + n, halfEventSize);
+        }
+    }
+    // do not hold the memory of a burst forever
+    if (buffer.size() > kMaxKeptBufferSize && halfEventSize == 0) {
+        std::vector<char>().swap(buffer);
+    }
+}
+
+int32_t logtail::EventListener::ParseEvents(const char* buffer, int32_t len, std::vector<Event*>& eventVec) {
+    ParseContext ctx;
+    int32_t n = 0;
+    while (n < len) {
+        // maybe invalid, must check if this packet is a whole packet
+        const auto* event = reinterpret_cast<const struct inotify_event*>(buffer + n);
+        int32_t tailSize = len - n;
+        if ((size_t)tailSize < sizeof(struct inotify_event)
+            || (size_t)tailSize < event->len + sizeof(struct inotify_event)) {
+            break;
+        }
+        n += sizeof(struct inotify_event) + event->len;
 
+        // when interrupt (config update), must check event buf tail, if not a whole packet, next read will crash
+        if (LogInput::GetInstance()->IsInterupt()) {
+            continue;
+        }
+        if (event->mask & IN_Q_OVERFLOW) {
+            LOG_INFO(sLogger, ("inotify event queue overflow", "miss inotify events"));
+            AlarmManager::GetInstance()->SendAlarmWarning(INOTIFY_EVENT_OVERFLOW_ALARM, "inotify event queue overflow");
+            continue;
+        }
+        EventType etype = 0;
+        etype |= event->mask & IN_DELETE_SELF ? EVENT_TIMEOUT : 0;
+        etype |= event->mask & IN_CREATE ? EVENT_CREATE : 0;
+        etype |= event->mask & IN_MODIFY ? EVENT_MODIFY : 0;
+        etype |= event->mask & IN_ISDIR ? EVENT_ISDIR : 0;
+        etype |= event->mask & IN_MOVED_FROM ? EVENT_MOVE_FROM : 0;
+        etype |= event->mask & IN_MOVED_TO ? EVENT_MOVE_TO : 0;
+        etype |= event->mask & IN_DELETE ? EVENT_DELETE : 0;
+        if (etype == 0) {
+            continue;
+        }
+        // name is padded with '\0' to the alignment
+        PushEvent(ctx, event->wd, StringView(event->len > 0 ? event->name : ""), etype, event->cookie, eventVec);
+    }
+    return n;
+}
 
-            // when interrupt (config update), must check event buf tail, if not a whole packet, next read will crash
-            if (LogInput::GetInstance()->IsInterupt()) {
-                n += sizeof(struct inotify_event) + event->len;
-                continue;
+int32_t logtail::EventListener::ParseFanotifyEvents(const char* buffer, int32_t len, std::vector<Event*>& eventVec) {
+#ifdef LOGTAIL_FANOTIFY_SUPPORTED
+    static EventDispatcher* dispatcher = EventDispatcher::GetInstance();
+    ParseContext ctx;
+    std::string key;
+    int32_t n = 0;
+    while (n < len) {
+        const auto* meta = reinterpret_cast<const struct fanotify_event_metadata*>(buffer + n);
+        int32_t tailSize = len - n;
+        if ((size_t)tailSize < FAN_EVENT_METADATA_LEN || (size_t)tailSize < meta->event_len
+            || meta->event_len < FAN_EVENT_METADATA_LEN) {
+            break;
+        }
+        const char* infoBegin = buffer + n + meta->metadata_len;
+        const char* infoEnd = buffer + n + meta->event_len;
+        n += meta->event_len;
+
+        if (LogInput::GetInstance()->IsInterupt()) {
+            continue;
+        }
+        if (meta->mask & FAN_Q_OVERFLOW) {
+            LOG_INFO(sLogger, ("fanotify event queue overflow", "miss fanotify events"));
+            AlarmManager::GetInstance()->SendAlarmWarning(INOTIFY_EVENT_OVERFLOW_ALARM,
+                                                          "fanotify event queue overflow");
+            continue;
+        }
+
+        // the dir and the name of the object, or the dir itself with name "." for an event on a dir
+        const struct fanotify_event_info_fid* fid = nullptr;
+        for (const char* info = infoBegin; info + sizeof(struct fanotify_event_info_header) <= infoEnd;) {
+            const auto* header = reinterpret_cast<const struct fanotify_event_info_header*>(info);
+            if (header->len == 0 || info + header->len > infoEnd) {
+                break;
+            }
+            if (header->info_type == FAN_EVENT_INFO_TYPE_DFID_NAME) {
+                fid = reinterpret_cast<const struct fanotify_event_info_fid*>(info);
+                break;
             }
-            EventType etype = 0;
-            if (event->mask & IN_Q_OVERFLOW) {
-                LOG_INFO(sLogger, ("inotify event queue overflow", "miss inotify events"));
-                AlarmManager::GetInstance()->SendAlarmWarning(INOTIFY_EVENT_OVERFLOW_ALARM,
-                                                              "inotify event queue overflow");
+            info += header->len;
+        }
+        if (fid == nullptr) {
+            continue;
+        }
+        const auto* handle = reinterpret_cast<const struct file_handle*>(fid->handle);
+        AppendHandleKey(&fid->fsid, handle, key);
+        auto it = mHandleWdMap.find(key);
+        if (it == mHandleWdMap.end()) {
+            // most of the events on the filesystem are not in the registered dirs
+            continue;
+        }
+        int wd = it->second;
+        StringView name(reinterpret_cast<const char*>(handle->f_handle) + handle->handle_bytes);
+        if (name == ".") {
+            if ((meta->mask & FAN_DELETE_SELF) && (meta->mask & FAN_ONDIR)) {
+                PushEvent(ctx, wd, kEmptyStringView, EVENT_TIMEOUT, 0, eventVec);
+            }
+            continue;
+        }
+
+        // unlike inotify, fanotify merges the events on the same object, so they are split again, and the removal
+        // is put first if the object exists now, e.g. the file is deleted and created again
+        EventType dirFlag = meta->mask & FAN_ONDIR ? EVENT_ISDIR : 0;
+        bool removed = meta->mask & (FAN_DELETE | FAN_MOVED_FROM);
+        bool added = meta->mask & (FAN_CREATE | FAN_MOVED_TO | FAN_MODIFY);
+        bool removedFirst = false;
+        if (removed && added) {
+            std::string path;
+            struct stat buf;
+            removedFirst = dispatcher->IsRegistered(wd, path)
+                && lstat(path.append("/").append(name.data(), name.size()).c_str(), &buf) == 0;
+        }
+        for (int round = 0; round < 2; ++round) {
+            if ((round == 0) == removedFirst) {
+                if (meta->mask & FAN_MOVED_FROM) {
+                    PushEvent(ctx, wd, name, EVENT_MOVE_FROM | dirFlag, 0, eventVec);
+                }
+                if (meta->mask & FAN_DELETE) {
+                    PushEvent(ctx, wd, name, EVENT_DELETE | dirFlag, 0, eventVec);
+                }
             } else {
-                etype |= event->mask & IN_DELETE_SELF ? EVENT_TIMEOUT : 0;
-                etype |= event->mask & IN_CREATE ? EVENT_CREATE : 0;
-                etype |= event->mask & IN_MODIFY ? EVENT_MODIFY : 0;
-                etype |= event->mask & IN_ISDIR ? EVENT_ISDIR : 0;
-                etype |= event->mask & IN_MOVED_FROM ? EVENT_MOVE_FROM : 0;
-                etype |= event->mask & IN_MOVED_TO ? EVENT_MOVE_TO : 0;
-                etype |= event->mask & IN_DELETE ? EVENT_DELETE : 0;
-                std::string path;
-                if (etype != 0 && dispatcher->IsRegistered(event->wd, path))
-                    eventVec.push_back(
-                        new Event(path, event->len > 0 ? event->name : "", etype, event->wd, event->cookie));
+                if (meta->mask & FAN_CREATE) {
+                    PushEvent(ctx, wd, name, EVENT_CREATE | dirFlag, 0, eventVec);
+                }
+                if (meta->mask & FAN_MOVED_TO) {
+                    PushEvent(ctx, wd, name, EVENT_MOVE_TO | dirFlag, 0, eventVec);
+                }
+                if (meta->mask & FAN_MODIFY) {
+                    PushEvent(ctx, wd, name, EVENT_MODIFY | dirFlag, 0, eventVec);
+                }
             }
-            n += sizeof(struct inotify_event) + event->len;
         }
     }
-    delete[] buffer;
-    return (int32_t)eventVec.size();
+    return n;
+#else
+    return len;
+#endif
+}
+
+void logtail::EventListener::PushEvent(
+    ParseContext& ctx, int wd, StringView name, EventType type, uint32_t cookie, std::vector<Event*>& eventVec) {
+    static EventDispatcher* dispatcher = EventDispatcher::GetInstance();
+    auto key = std::make_pair(wd, name);
+    if (type == EVENT_MODIFY) {
+        if (ctx.mModifyEvents.find(key) != ctx.mModifyEvents.end()) {
+            return;
+        }
+    } else {
+        // the following MODIFY events must not be moved before this one
+        ctx.mModifyEvents.erase(key);
+    }
+
+    if (wd != ctx.mLastWd) {
+        ctx.mLastWd = wd;
+        ctx.mLastRegistered = dispatcher->IsRegistered(wd, ctx.mLastPath);
+    }
+    if (!ctx.mLastRegistered) {
+        return;
+    }
+    if (type == EVENT_MODIFY) {
+        ctx.mModifyEvents.insert(key);
+    }
+    eventVec.push_back(new Event(ctx.mLastPath, std::string(name.data(), name.size()), type, wd, cookie));
 }
 
 bool logtail::EventListener::IsInit() {
-    return mInotifyFd != -1;
+    return mInotifyFd != -1 || mFanotifyFd != -1;
 }
 
 void logtail::EventListener::Destroy() {
-    if (mInotifyFd >= 0)
+    if (mInotifyFd >= 0) {
         close(mInotifyFd);
+        mInotifyFd = -1;
+    }
+    if (mFanotifyFd >= 0) {
+        close(mFanotifyFd);
+        mFanotifyFd = -1;
+    }
+    mHandleWdMap.clear();
+    mWdHandleMap.clear();
+    mMarkedFsids.clear();
+    mNextWd = kMinFanotifyWd;
+    mBuffer.clear();
+    mHalfEventSize = 0;
+    mFanotifyBuffer.clear();
+    mFanotifyHalfEventSize = 0;
 }
 
 bool EventListener::IsValidID(int id) {
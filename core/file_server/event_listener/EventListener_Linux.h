@@ -17,14 +17,24 @@
 #ifndef LOGTAIL_EVENTLISTENER_H
 #define LOGTAIL_EVENTLISTENER_H
 
+#include <set>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
+#include "common/StringView.h"
 #include "file_server/event/Event.h"
 
 namespace logtail {
 
-
+// EventListener watches the registered dirs with either of the two backends:
+// - inotify, one watch per dir, which is limited by max_user_watches;
+// - fanotify with FAN_REPORT_DFID_NAME, enabled by fs_events_fanotify_enable, which marks the whole filesystem of the
+//   dirs once. Each event carries the file handle of its dir, which is mapped to the wd allocated by AddWatch, so the
+//   events in the dirs not registered are dropped just as inotify does. It falls back to inotify if not permitted, and
+//   the dirs whose filesystem cannot be marked, e.g. overlayfs on old kernels, are watched by inotify alongside.
 class EventListener {
 public:
     ~EventListener();
@@ -37,18 +47,64 @@ public:
     bool Init();
     bool IsInit();
     void Destroy();
+    bool IsFanotifyEnabled() const { return mFanotifyFd != -1; }
+    // whether wd is an inotify watch, which is limited by max_user_watches
+    bool IsInotifyWatch(int wd) const { return mFanotifyFd == -1 || wd < kMinFanotifyWd; }
 
     static bool IsValidID(int id);
     static const uint32_t mWatchEventMask;
 
-    int AddWatch(const char* dir);
+    // @param inotifyAllowed whether the dir may be watched by inotify if fanotify is not available for it, fails with
+    // ENOSPC otherwise
+    int AddWatch(const char* dir, bool inotifyAllowed = true);
     bool RemoveWatch(int wd);
 
     int32_t ReadEvents(std::vector<Event*>& eventVec);
 
 private:
+    struct ParseContext {
+        // wd and name of the files with a MODIFY event pending in eventVec
+        std::set<std::pair<int, StringView>> mModifyEvents;
+        int mLastWd = -1;
+        bool mLastRegistered = false;
+        std::string mLastPath;
+    };
+
+    // the wds of inotify are allocated from 1 and never come close
+    static constexpr int kMinFanotifyWd = 1 << 30;
+
     EventListener() = default;
+
+    bool InitFanotify();
+    int AddFanotifyWatch(const char* dir);
+    int AddInotifyWatch(const char* dir);
+    // reads the events of fd, the half event left at the tail of buffer is kept for the next read
+    void ReadEvents(int32_t fd, std::vector<char>& buffer, int32_t& halfEventSize, std::vector<Event*>& eventVec);
+
+    // parses the complete events at the head of buffer and returns the number of bytes consumed, MODIFY events on the
+    // same file are coalesced unless some other event on the file comes in between
+    int32_t ParseEvents(const char* buffer, int32_t len, std::vector<Event*>& eventVec);
+    int32_t ParseFanotifyEvents(const char* buffer, int32_t len, std::vector<Event*>& eventVec);
+    void PushEvent(
+        ParseContext& ctx, int wd, StringView name, EventType type, uint32_t cookie, std::vector<Event*>& eventVec);
+
     int32_t mInotifyFd = -1;
+    // reused between reads and sized by FIONREAD, the half event left at the tail is moved to the head
+    std::vector<char> mBuffer;
+    int32_t mHalfEventSize = 0;
+
+    int32_t mFanotifyFd = -1;
+    std::vector<char> mFanotifyBuffer;
+    int32_t mFanotifyHalfEventSize = 0;
+    // fsid and file handle of the dir -> wd, and vice versa, the wds allocated are above the ones of inotify
+    std::unordered_map<std::string, int> mHandleWdMap;
+    std::unordered_map<int, std::string> mWdHandleMap;
+    std::unordered_set<std::string> mMarkedFsids;
+    int mNextWd = kMinFanotifyWd;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class EventListenerUnittest;
+#endif
 };
 
 } // namespace logtail
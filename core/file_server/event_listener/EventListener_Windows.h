@@ -34,10 +34,12 @@ public:
     bool Init();
     bool IsInit();
     void Destroy();
+    bool IsFanotifyEnabled() const { return false; }
+    bool IsInotifyWatch(int wd) const { return true; }
 
     static bool IsValidID(int id);
 
-    int AddWatch(const char* dir);
+    int AddWatch(const char* dir, bool inotifyAllowed = true);
     bool RemoveWatch(int wd);
 
     int32_t ReadEvents(std::vector<Event*>& eventVec);
@@ -21,6 +21,7 @@
 #include <map>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "common/SplitedFilePath.h"
@@ -51,19 +52,78 @@ struct DirFileCache {
     int32_t GetLastEventTime() const { return mLastEventTime; }
 
 private:
-    // It indicates if the related file/dir has generated event.
-    bool mEventFlag = false;
+    // Members are ordered by size to keep the item compact, there might be millions of them.
+    // Last modified time on filesystem in nanoseconds.
+    int64_t mLastModifyTime = 0;
+    uint64_t mLastCheckRound = 0;
     // The event time of related file/dir.
     int32_t mLastEventTime = 0;
-
+    // It indicates if the related file/dir has generated event.
+    bool mEventFlag = false;
     bool mConfigMatched = false;
     bool mExceedPreservedDirDepth = false;
-    uint64_t mLastCheckRound = 0;
-    // Last modified time on filesystem in nanoseconds.
-    int64_t mLastModifyTime = 0;
 };
 
-typedef std::unordered_map<std::string, DirFileCache> DirCheckCacheMap;
+// DirEntryList is a snapshot of the entries in a directory which polling is interested in,
+// i.e. sub directories, symbolic links and regular files matched by at least one config.
+// Entries are packed into a single buffer, each one is a type byte followed by the name and '\0'.
+class DirEntryList {
+public:
+    enum class Type : char { UNKNOWN, DIR, REG_FILE, SYMBOLIC };
+
+    DirEntryList() {}
+    DirEntryList(int64_t modifyTime, int32_t listTime) : mModifyTime(modifyTime), mListTime(listTime) {}
+
+    void Add(Type type, const std::string& name) {
+        mData.push_back(static_cast<char>(type));
+        mData.append(name);
+        mData.push_back('\0');
+    }
+
+    // Next reads the entry at @pos and moves @pos to the next one.
+    // @return false if there are no more entries.
+    bool Next(size_t& pos, Type& type, std::string& name) const {
+        if (pos >= mData.size()) {
+            return false;
+        }
+        type = static_cast<Type>(mData[pos]);
+        size_t end = mData.find('\0', pos + 1);
+        name.assign(mData, pos + 1, end - pos - 1);
+        pos = end + 1;
+        return true;
+    }
+
+    // IsReusable returns true if the directory has not been changed since the entries were listed.
+    // Directory modify time changes when an entry is added, removed or renamed, however, changes
+    // within the same timestamp granularity are invisible, so the entries listed too soon after
+    // the last modification are not trusted.
+    bool IsReusable(int64_t modifyTime, int64_t modifySec, int32_t curTime, int32_t timeout) const {
+        return mListTime > 0 && modifyTime == mModifyTime && mListTime > modifySec + 1
+            && curTime - mListTime < timeout;
+    }
+
+    int64_t GetModifyTime() const { return mModifyTime; }
+    int32_t GetListTime() const { return mListTime; }
+    size_t GetDataSize() const { return mData.size(); }
+
+private:
+    std::string mData;
+    // Modify time of the directory in nanoseconds when the entries were listed.
+    int64_t mModifyTime = 0;
+    int32_t mListTime = 0;
+};
+
+struct DirCache : public DirFileCache {
+    DirCache() {}
+
+    void SetEntries(DirEntryList&& entries) { mEntries = std::move(entries); }
+    const DirEntryList& GetEntries() const { return mEntries; }
+
+private:
+    DirEntryList mEntries;
+};
+
+typedef std::unordered_map<std::string, DirCache> DirCheckCacheMap;
 typedef std::unordered_map<std::string, DirFileCache> FileCheckCacheMap;
 
 struct ModifyCheckCache {
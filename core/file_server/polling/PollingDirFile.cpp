@@ -21,6 +21,9 @@
 #endif
 #include <sys/stat.h>
 
+#include <algorithm>
+#include <thread>
+
 #include "app_config/AppConfig.h"
 #include "common/ErrorUtil.h"
 #include "common/FileSystemUtil.h"
@@ -46,7 +49,7 @@ DEFINE_FLAG_INT32(dirfile_check_interval_ms, "dir file check interval, ms", 5000
 // Windows only supports polling, check more frequently.
 DEFINE_FLAG_INT32(dirfile_check_interval_ms, "dir file check interval, ms", 1000);
 #endif
-DEFINE_FLAG_INT32(dirfile_stat_count, "sleep when dir file stat count up to", 100);
+DEFINE_FLAG_INT32(dirfile_stat_count, "sleep when dir file stat count of all polling workers up to", 100);
 DEFINE_FLAG_INT32(dirfile_stat_sleep, "sleep time when dir file stat up to 1000, ms", 30);
 DEFINE_FLAG_INT32(polling_dir_upperlimit, "try to remove unchanged dir if dir count is up to", 500000);
 DEFINE_FLAG_INT32(polling_file_upperlimit, "try to remove unchanged file if file count is up to", 500000);
@@ -59,6 +62,10 @@ DEFINE_FLAG_INT32(polling_max_stat_count, "max stat count in each round", 100000
 DEFINE_FLAG_INT32(polling_max_stat_count_per_dir, "max stat count per dir in each round", 100000);
 DEFINE_FLAG_INT32(polling_max_stat_count_per_config, "max stat count per config in each round", 100000);
 DEFINE_FLAG_INT32(polling_modify_repush_interval, "polling modify event repush interval, seconds", 10);
+DEFINE_FLAG_INT32(polling_dir_file_thread_num, "number of workers to poll config paths in parallel", 4);
+DEFINE_FLAG_INT32(polling_dir_entries_cache_timeout,
+                  "re-read the directory if its cached entries are older than, seconds",
+                  60);
 DECLARE_FLAG_INT32(wildcard_max_sub_dir_count);
 
 using namespace std;
@@ -73,6 +80,10 @@ void PollingDirFile::Start() {
         = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(METRIC_RUNNER_FILE_POLLING_DIR_CACHE_SIZE);
     mPollingFileCacheSize
         = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(METRIC_RUNNER_FILE_POLLING_FILE_CACHE_SIZE);
+    mPollingScanTimeMs
+        = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(METRIC_RUNNER_FILE_POLLING_SCAN_TIME_MS);
+    mPollingStatCount
+        = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(METRIC_RUNNER_FILE_POLLING_STAT_COUNT);
     mRuningFlag = true;
     mThreadPtr = CreateThread([this]() { Polling(); });
 }
@@ -103,24 +114,24 @@ void PollingDirFile::Resume() {
     LOG_INFO(sLogger, ("polling discovery resume", "succeeded"));
 }
 
-void PollingDirFile::CheckConfigPollingStatCount(const int32_t lastStatCount,
-                                                 const FileDiscoveryConfig& config,
-                                                 bool isDockerConfig) {
-    auto diffCount = mStatCount - lastStatCount;
+void PollingDirFile::CheckConfigPollingStatCount(const PollingTask& task) {
+    auto diffCount = task.mStatCount;
     if (diffCount <= INT32_FLAG(polling_max_stat_count_per_config))
         return;
 
+    const FileDiscoveryConfig& config = task.mConfig;
+    int32_t statCount = mStatCount;
     std::string msgBase = "The polling stat count of this ";
-    if (isDockerConfig)
+    if (task.mIsContainer)
         msgBase += "docker ";
     msgBase += "config has exceeded limit";
 
     LOG_WARNING(sLogger,
-                (msgBase, diffCount)(config.first->GetBasePath(), mStatCount)(config.second->GetProjectName(),
-                                                                              config.second->GetLogstoreName()));
+                (msgBase, diffCount)(config.first->GetBasePath(), statCount)(config.second->GetProjectName(),
+                                                                             config.second->GetLogstoreName()));
     AlarmManager::GetInstance()->SendAlarmError(STAT_LIMIT_ALARM,
                                                 msgBase + ", current count: " + ToString(diffCount) + " total count:"
-                                                    + ToString(mStatCount) + " path: " + config.first->GetBasePath(),
+                                                    + ToString(statCount) + " path: " + config.first->GetBasePath(),
                                                 config.second->GetRegion(),
                                                 config.second->GetProjectName(),
                                                 config.second->GetConfigName(),
@@ -141,6 +152,60 @@ void PollingDirFile::Polling() {
     LOG_DEBUG(sLogger, ("dir file polling thread done", ""));
 }
 
+void PollingDirFile::RunPollingTasks(vector<PollingTask>& tasks) {
+    atomic_size_t nextTask(0);
+    auto worker = [&]() {
+        for (size_t i = nextTask++; i < tasks.size(); i = nextTask++) {
+            // Make sure stat count will not exceed limit.
+            if (!mRuningFlag || mHoldOnFlag || mStatCount > INT32_FLAG(polling_max_stat_count))
+                break;
+            RunPollingTask(tasks[i]);
+        }
+    };
+
+    // Workers are created for each round rather than kept in a pool, the cost is negligible
+    // compared with the polling interval, and nothing is left running while polling is held on.
+    size_t workerNum = min(tasks.size(), static_cast<size_t>(max(1, INT32_FLAG(polling_dir_file_thread_num))));
+    // each worker sleeps proportionally more often, so that the total stat rate does not grow with the workers
+    mThrottleStatCount = max(1, INT32_FLAG(dirfile_stat_count) / static_cast<int32_t>(workerNum));
+    vector<thread> workers;
+    for (size_t i = 1; i < workerNum; ++i) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : workers) {
+        t.join();
+    }
+}
+
+void PollingDirFile::RunPollingTask(PollingTask& task) {
+    const FileDiscoveryOptions* config = task.mConfig.first;
+    const CollectionPipelineContext* ctx = task.mConfig.second;
+    if (!config->GetWildcardPaths().empty()) {
+        if (!PollingWildcardConfigPath(task, task.mConfig, task.mBasePath, 0)) {
+            LOG_DEBUG(sLogger,
+                      ("can not find matched path in config, Wildcard begin logPath",
+                       task.mBasePath)(ctx->GetProjectName(), ctx->GetLogstoreName()));
+        }
+        CheckConfigPollingStatCount(task);
+        return;
+    }
+
+    fsutil::PathStat baseDirStat;
+    if (!fsutil::PathStat::stat(task.mBasePath, baseDirStat)) {
+        LOG_DEBUG(sLogger,
+                  (task.mIsContainer ? "get docker base dir info error: " : "get base dir info error: ",
+                   task.mBasePath)(ctx->GetProjectName(), ctx->GetLogstoreName()));
+        return;
+    }
+    if (!PollingNormalConfigPath(task, task.mConfig, task.mBasePath, string(), baseDirStat, 0)) {
+        LOG_DEBUG(sLogger,
+                  (task.mIsContainer ? "docker logPath in config not exist" : "logPath in config not exist",
+                   task.mBasePath)(ctx->GetProjectName(), ctx->GetLogstoreName()));
+    }
+    CheckConfigPollingStatCount(task);
+}
+
 void PollingDirFile::PollingIteration() {
     LOG_DEBUG(sLogger, ("start dir file polling, mCurrentRound", mCurrentRound));
     PTScopedLock threadLock(mPollingThreadLock);
@@ -168,83 +233,33 @@ void PollingDirFile::PollingIteration() {
         SET_GAUGE(mPollingFileCacheSize, mFileCacheMap.size());
     }
 
-    // Iterate all normal configs, make sure stat count will not exceed limit.
-    for (auto itr = sortedConfigs.begin();
-         itr != sortedConfigs.end() && mStatCount <= INT32_FLAG(polling_max_stat_count);
-         ++itr) {
-        if (!mRuningFlag || mHoldOnFlag)
-            break;
-
-        const FileDiscoveryOptions* config = itr->first;
-        const CollectionPipelineContext* ctx = itr->second;
-        if (!config->IsContainerDiscoveryEnabled()) {
-            fsutil::PathStat baseDirStat;
-            if (!fsutil::PathStat::stat(config->GetBasePath(), baseDirStat)) {
-                LOG_DEBUG(sLogger,
-                          ("get base dir info error: ", config->GetBasePath())(ctx->GetProjectName(),
-                                                                               ctx->GetLogstoreName()));
-                continue;
-            }
-
-            int32_t lastConfigStatCount = mStatCount;
-            if (!PollingNormalConfigPath(*itr, config->GetBasePath(), string(), baseDirStat, 0)) {
-                LOG_DEBUG(sLogger,
-                          ("logPath in config not exist", config->GetBasePath())(ctx->GetProjectName(),
-                                                                                 ctx->GetLogstoreName()));
-            }
-            CheckConfigPollingStatCount(lastConfigStatCount, *itr, false);
-        } else {
-            for (size_t i = 0; i < config->GetContainerInfo()->size(); ++i) {
-                const string& basePath = (*config->GetContainerInfo())[i].mRealBaseDir;
-                fsutil::PathStat baseDirStat;
-                if (!fsutil::PathStat::stat(basePath, baseDirStat)) {
-                    LOG_DEBUG(
-                        sLogger,
-                        ("get docker base dir info error: ", basePath)(ctx->GetProjectName(), ctx->GetLogstoreName()));
-                    continue;
-                }
-                int32_t lastConfigStatCount = mStatCount;
-                if (!PollingNormalConfigPath(*itr, basePath, string(), baseDirStat, 0)) {
-                    LOG_DEBUG(sLogger,
-                              ("docker logPath in config not exist", basePath)(ctx->GetProjectName(),
-                                                                               ctx->GetLogstoreName()));
+    // Normal configs are polled before wildcard configs, and each path of a config is a task.
+    vector<PollingTask> tasks;
+    for (const auto* configs : {&sortedConfigs, &wildcardConfigs}) {
+        for (const auto& config : *configs) {
+            if (!config.first->IsContainerDiscoveryEnabled()) {
+                const auto& wildcardPaths = config.first->GetWildcardPaths();
+                tasks.emplace_back(
+                    config, wildcardPaths.empty() ? config.first->GetBasePath() : wildcardPaths[0], false);
+            } else {
+                for (const auto& info : *config.first->GetContainerInfo()) {
+                    tasks.emplace_back(config, info.mRealBaseDir, true);
                 }
-                CheckConfigPollingStatCount(lastConfigStatCount, *itr, true);
             }
         }
     }
 
-    // Iterate all wildcard configs, make sure stat count will not exceed limit.
-    for (auto itr = wildcardConfigs.begin();
-         itr != wildcardConfigs.end() && mStatCount <= INT32_FLAG(polling_max_stat_count);
-         ++itr) {
-        if (!mRuningFlag || mHoldOnFlag)
-            break;
-
-        const FileDiscoveryOptions* config = itr->first;
-        const CollectionPipelineContext* ctx = itr->second;
-        if (!config->IsContainerDiscoveryEnabled()) {
-            int32_t lastConfigStatCount = mStatCount;
-            if (!PollingWildcardConfigPath(*itr, config->GetWildcardPaths()[0], 0)) {
-                LOG_DEBUG(sLogger,
-                          ("can not find matched path in config, Wildcard begin logPath",
-                           config->GetBasePath())(ctx->GetProjectName(), ctx->GetLogstoreName()));
-            }
-            CheckConfigPollingStatCount(lastConfigStatCount, *itr, false);
-        } else {
-            for (size_t i = 0; i < config->GetContainerInfo()->size(); ++i) {
-                const string& baseWildcardPath = (*config->GetContainerInfo())[i].mRealBaseDir;
-                int32_t lastConfigStatCount = mStatCount;
-                if (!PollingWildcardConfigPath(*itr, baseWildcardPath, 0)) {
-                    LOG_DEBUG(sLogger,
-                              ("can not find matched path in config, "
-                               "Wildcard begin logPath ",
-                               baseWildcardPath)(ctx->GetProjectName(), ctx->GetLogstoreName()));
-                }
-                CheckConfigPollingStatCount(lastConfigStatCount, *itr, true);
-            }
-        }
+    auto startTime = GetCurrentTimeInMilliSeconds();
+    RunPollingTasks(tasks);
+    auto scanTimeMs = GetCurrentTimeInMilliSeconds() - startTime;
+    for (auto& task : tasks) {
+        mNewFileVec.insert(mNewFileVec.end(), task.mNewFileVec.begin(), task.mNewFileVec.end());
     }
+    SET_GAUGE(mPollingScanTimeMs, scanTimeMs);
+    SET_GAUGE(mPollingStatCount, mStatCount.load());
+    LOG_DEBUG(sLogger,
+              ("dir file polling done, round", mCurrentRound)("tasks", tasks.size())("stat count", mStatCount.load())(
+                  "scan time ms", scanTimeMs));
 
     // Add collected new files to PollingModify.
     PollingModify::GetInstance()->AddNewFile(mNewFileVec);
@@ -263,23 +278,27 @@ void PollingDirFile::PollingIteration() {
 bool PollingDirFile::CheckAndUpdateDirMatchCache(const string& dirPath,
                                                  const fsutil::PathStat& statBuf,
                                                  bool exceedPreservedDirDepth,
-                                                 bool& newFlag) {
+                                                 bool& newFlag,
+                                                 DirEntryList& entries,
+                                                 bool& reusable) {
     int64_t sec, nsec;
     statBuf.GetLastWriteTime(sec, nsec);
     int64_t modifyTime = NANO_CONVERTING * sec + nsec;
+    auto curTime = static_cast<int32_t>(time(NULL));
+    reusable = false;
+    entries = DirEntryList(modifyTime, curTime);
 
     ScopedSpinLock lock(mCacheLock);
     auto iter = mDirCacheMap.find(dirPath);
 
     // New directory, add a new cache item for it.
     if (iter == mDirCacheMap.end()) {
-        DirFileCache& dirCache = mDirCacheMap[dirPath];
+        DirCache& dirCache = mDirCacheMap[dirPath];
         dirCache.SetConfigMatched(true);
         dirCache.SetExceedPreservedDirDepth(exceedPreservedDirDepth);
         dirCache.SetCheckRound(mCurrentRound);
         dirCache.SetLastModifyTime(modifyTime);
         // Directories found at round 1 or too old are considered as old data.
-        auto curTime = static_cast<int32_t>(time(NULL));
         if (mCurrentRound == 1 || curTime - sec > INT32_FLAG(polling_dir_first_watch_timeout)) {
             newFlag = false;
         } else {
@@ -294,9 +313,23 @@ bool PollingDirFile::CheckAndUpdateDirMatchCache(const string& dirPath,
     newFlag = false;
     iter->second.SetCheckRound(mCurrentRound);
     iter->second.SetLastModifyTime(modifyTime);
+    if (iter->second.GetEntries().IsReusable(
+            modifyTime, sec, curTime, INT32_FLAG(polling_dir_entries_cache_timeout))) {
+        entries = iter->second.GetEntries();
+        reusable = true;
+    }
     return true; // iter->second.HasMatchedConfig().
 }
 
+void PollingDirFile::UpdateDirEntriesCache(const string& dirPath, DirEntryList&& entries) {
+    ScopedSpinLock lock(mCacheLock);
+    auto iter = mDirCacheMap.find(dirPath);
+    // The entries listed by another worker later might have been saved.
+    if (iter != mDirCacheMap.end() && iter->second.GetEntries().GetListTime() <= entries.GetListTime()) {
+        iter->second.SetEntries(std::move(entries));
+    }
+}
+
 bool PollingDirFile::CheckAndUpdateFileMatchCache(const string& fileDir,
                                                   const string& fileName,
                                                   const fsutil::PathStat& statBuf,
@@ -308,13 +341,22 @@ bool PollingDirFile::CheckAndUpdateFileMatchCache(const string& fileDir,
 
     bool newFlag = false;
     string filePath = PathJoin(fileDir, fileName);
-    FileCheckCacheMap::iterator iter = mFileCacheMap.find(filePath);
     int32_t curTime = time(NULL);
-    if (iter == mFileCacheMap.end()) {
-        bool matchFlag = needFindBestMatch
-            ? ConfigManager::GetInstance()->FindBestMatch(fileDir, fileName).first != nullptr
-            : true;
+    bool matchFlag = true;
+    if (needFindBestMatch) {
+        {
+            ScopedSpinLock lock(mCacheLock);
+            needFindBestMatch = mFileCacheMap.find(filePath) == mFileCacheMap.end();
+        }
+        // Match out of the lock, which is shared by all polling workers.
+        if (needFindBestMatch) {
+            matchFlag = ConfigManager::GetInstance()->FindBestMatch(fileDir, fileName).first != nullptr;
+        }
+    }
 
+    ScopedSpinLock lock(mCacheLock);
+    FileCheckCacheMap::iterator iter = mFileCacheMap.find(filePath);
+    if (iter == mFileCacheMap.end()) {
         DirFileCache& fileCache = mFileCacheMap[filePath];
         fileCache.SetConfigMatched(matchFlag);
         fileCache.SetExceedPreservedDirDepth(exceedPreservedDirDepth);
@@ -353,7 +395,8 @@ bool PollingDirFile::CheckAndUpdateFileMatchCache(const string& fileDir,
     return iter->second.HasMatchedConfig() && newFlag;
 }
 
-bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
+bool PollingDirFile::PollingNormalConfigPath(PollingTask& task,
+                                             const FileDiscoveryConfig& pConfig,
                                              const string& srcPath,
                                              const string& obj,
                                              const fsutil::PathStat& statBuf,
@@ -381,15 +424,18 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
         return false;
     }
     bool isNewDirectory = false;
-    if (!CheckAndUpdateDirMatchCache(dirPath, statBuf, exceedPreservedDirDepth, isNewDirectory))
+    DirEntryList entries;
+    bool reuseEntries = false;
+    if (!CheckAndUpdateDirMatchCache(
+            dirPath, statBuf, exceedPreservedDirDepth, isNewDirectory, entries, reuseEntries))
         return true;
     if (isNewDirectory) {
         PollingEventQueue::GetInstance()->PushEvent(new Event(srcPath, obj, EVENT_CREATE | EVENT_ISDIR, -1, 0));
     }
 
-    // Iterate directories and files in dirPath.
+    // Iterate directories and files in dirPath, or the entries cached if the directory is unchanged.
     fsutil::Dir dir(dirPath);
-    if (!dir.Open()) {
+    if (!reuseEntries && !dir.Open()) {
         auto err = GetErrno();
         if (fsutil::Dir::IsENOENT(err)) {
             LOG_DEBUG(sLogger, ("Open dir error, ENOENT, dir", dirPath.c_str()));
@@ -407,75 +453,110 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
         return true;
     }
     int32_t nowStatCount = 0;
+    size_t entryPos = 0;
+    bool allListed = true;
     fsutil::Entry ent;
-    while ((ent = dir.ReadNext(false))) {
-        if (!mRuningFlag || mHoldOnFlag)
+    DirEntryList::Type entType;
+    string entName;
+    while (true) {
+        if (reuseEntries) {
+            if (!entries.Next(entryPos, entType, entName))
+                break;
+        } else {
+            if (!(ent = dir.ReadNext(false)))
+                break;
+            entName = ent.Name();
+            if (ent.IsDir()) {
+                entType = DirEntryList::Type::DIR;
+            } else if (ent.IsRegFile()) {
+                entType = DirEntryList::Type::REG_FILE;
+            } else if (ent.IsSymbolic()) {
+                entType = DirEntryList::Type::SYMBOLIC;
+            } else {
+                entType = DirEntryList::Type::UNKNOWN;
+            }
+        }
+
+        if (!mRuningFlag || mHoldOnFlag) {
+            allListed = false;
             break;
+        }
 
-        if (++mStatCount % INT32_FLAG(dirfile_stat_count) == 0) {
+        if (++task.mStatCount % mThrottleStatCount == 0) {
             usleep(INT32_FLAG(dirfile_stat_sleep) * 1000);
         }
 
-        if (mStatCount > INT32_FLAG(polling_max_stat_count)) {
+        int32_t statCount = ++mStatCount;
+        if (statCount > INT32_FLAG(polling_max_stat_count)) {
             LOG_WARNING(sLogger,
-                        ("total dir's polling stat count is exceeded", nowStatCount)(dirPath, mStatCount)(
+                        ("total dir's polling stat count is exceeded", nowStatCount)(dirPath, statCount)(
                             pConfig.second->GetProjectName(), pConfig.second->GetLogstoreName()));
             AlarmManager::GetInstance()->SendAlarmError(
                 STAT_LIMIT_ALARM,
                 string("total dir's polling stat count is exceeded, now count:") + ToString(nowStatCount)
-                    + " total count:" + ToString(mStatCount) + " path: " + dirPath
+                    + " total count:" + ToString(statCount) + " path: " + dirPath
                     + " project:" + pConfig.second->GetProjectName() + " logstore:" + pConfig.second->GetLogstoreName(),
                 pConfig.second->GetRegion(),
                 pConfig.second->GetProjectName(),
                 pConfig.second->GetConfigName(),
                 pConfig.second->GetLogstoreName());
+            allListed = false;
             break;
         }
 
         if (++nowStatCount > INT32_FLAG(polling_max_stat_count_per_dir)) {
             LOG_WARNING(sLogger,
-                        ("this dir's polling stat count is exceeded", nowStatCount)(dirPath, mStatCount)(
+                        ("this dir's polling stat count is exceeded", nowStatCount)(dirPath, statCount)(
                             pConfig.second->GetProjectName(), pConfig.second->GetLogstoreName()));
             AlarmManager::GetInstance()->SendAlarmError(
                 STAT_LIMIT_ALARM,
                 string("this dir's polling stat count is exceeded, now count:") + ToString(nowStatCount)
-                    + " total count:" + ToString(mStatCount) + " path: " + dirPath
+                    + " total count:" + ToString(statCount) + " path: " + dirPath
                     + " project:" + pConfig.second->GetProjectName() + " logstore:" + pConfig.second->GetLogstoreName(),
                 pConfig.second->GetRegion(),
                 pConfig.second->GetProjectName(),
                 pConfig.second->GetConfigName(),
                 pConfig.second->GetLogstoreName());
+            allListed = false;
             break;
         }
 
         // If the type of item is raw directory or file, use MatchDirPattern or FindBestMatch
         // to check if there are configs that match it.
-        auto entName = ent.Name();
+        // Only the entries that do not depend on current config are cached, the directory
+        // blacklist is checked for each config.
         string item = PathJoin(dirPath, entName);
         bool needCheckDirMatch = true;
         bool needFindBestMatch = true;
-        if (ent.IsDir()) {
+        if (entType == DirEntryList::Type::DIR) {
             // Have to call MatchDirPattern, because we have no idea which config matches
             // the directory according to cache.
             // TODO: Refactor directory cache, maintain all configs that match the directory.
             needCheckDirMatch = false;
+            if (!reuseEntries) {
+                entries.Add(entType, entName);
+            }
             if (pConfig.first->IsDirectoryInBlacklist(item)) {
                 continue;
             }
-        } else if (ent.IsRegFile()) {
-            // TODO: Add file cache looking up here: we can skip the file if it is in cache
-            // and the match flag is false (no config matches it).
-            // There is a cache in FindBestMatch, so the overhead is acceptable now.
+        } else if (entType == DirEntryList::Type::REG_FILE) {
+            // Files matched by no config are not cached, so the cached ones need not to be matched again.
+            // There is a cache in FindBestMatch, so the overhead is acceptable for new entries.
             needFindBestMatch = false;
-            if (!ConfigManager::GetInstance()->FindBestMatch(dirPath, entName).first) {
-                continue;
+            if (!reuseEntries) {
+                if (!ConfigManager::GetInstance()->FindBestMatch(dirPath, entName).first) {
+                    continue;
+                }
+                entries.Add(entType, entName);
             }
-        } else {
+        } else if (entType == DirEntryList::Type::SYMBOLIC) {
             // Symbolic link should be passed, while other types file should ignore.
-            if (!ent.IsSymbolic()) {
-                LOG_DEBUG(sLogger, ("should ignore, other type file", item.c_str()));
-                continue;
+            if (!reuseEntries) {
+                entries.Add(entType, entName);
             }
+        } else {
+            LOG_DEBUG(sLogger, ("should ignore, other type file", item.c_str()));
+            continue;
         }
 
         // Mainly for symbolic (Linux), we need to use stat to dig out the real type.
@@ -485,17 +566,17 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
             continue;
         }
 
-        // For directory, poll recursively; for file, update cache and add to mNewFileVec so that
-        // it can be pushed to PollingModify at the end of polling.
+        // For directory, poll recursively; for file, update cache and add to mNewFileVec of the task
+        // so that it can be pushed to PollingModify at the end of polling.
         // If needCheckDirMatch or needFindBestMatch is true, that means the item is a symbolic link.
         // We should check file type again to make sure that the original file which linked by
         // a symbolic file is DIR or REG.
         if (buf.IsDir() && (!needCheckDirMatch || !pConfig.first->IsDirectoryInBlacklist(item))) {
-            PollingNormalConfigPath(pConfig, dirPath, entName, buf, depth + 1);
+            PollingNormalConfigPath(task, pConfig, dirPath, entName, buf, depth + 1);
         } else if (buf.IsRegFile()) {
             if (CheckAndUpdateFileMatchCache(dirPath, entName, buf, needFindBestMatch, exceedPreservedDirDepth)) {
                 LOG_DEBUG(sLogger, ("add to modify event", entName)("round", mCurrentRound));
-                mNewFileVec.push_back(SplitedFilePath(dirPath, entName));
+                task.mNewFileVec.push_back(SplitedFilePath(dirPath, entName));
             }
         } else {
             // Ignore other file type.
@@ -504,13 +585,19 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
         }
     }
 
+    if (!reuseEntries && allListed) {
+        UpdateDirEntriesCache(dirPath, std::move(entries));
+    }
     return true;
 }
 
 // PollingWildcardConfigPath will iterate mWildcardPaths one by one, and according to
 // corresponding value in mConstWildcardPaths, call PollingNormalConfigPath or call
 // PollingWildcardConfigPath recursively.
-bool PollingDirFile::PollingWildcardConfigPath(const FileDiscoveryConfig& pConfig, const string& dirPath, int depth) {
+bool PollingDirFile::PollingWildcardConfigPath(PollingTask& task,
+                                               const FileDiscoveryConfig& pConfig,
+                                               const string& dirPath,
+                                               int depth) {
     if (AppConfig::GetInstance()->IsHostPathMatchBlacklist(dirPath)) {
         LOG_INFO(sLogger, ("ignore path matching host path blacklist", dirPath));
         return false;
@@ -553,9 +640,9 @@ bool PollingDirFile::PollingWildcardConfigPath(const FileDiscoveryConfig& pConfi
         // call PollingNormalConfigPath to iterate remaining content.
         // Otherwise, call PollingWildcardConfigPath to deal with remaining parts.
         if (finish) {
-            PollingNormalConfigPath(pConfig, item, string(), baseDirStat, 0);
+            PollingNormalConfigPath(task, pConfig, item, string(), baseDirStat, 0);
         } else {
-            PollingWildcardConfigPath(pConfig, item, depth + 1);
+            PollingWildcardConfigPath(task, pConfig, item, depth + 1);
         }
         return true;
     }
@@ -601,16 +688,17 @@ bool PollingDirFile::PollingWildcardConfigPath(const FileDiscoveryConfig& pConfi
             break;
         }
 
-        if (++mStatCount % INT32_FLAG(dirfile_stat_count) == 0)
+        if (++task.mStatCount % mThrottleStatCount == 0)
             usleep(INT32_FLAG(dirfile_stat_sleep) * 1000);
 
-        if (mStatCount > INT32_FLAG(polling_max_stat_count)) {
+        int32_t statCount = ++mStatCount;
+        if (statCount > INT32_FLAG(polling_max_stat_count)) {
             LOG_WARNING(sLogger,
                         ("total dir's polling stat count is exceeded",
-                         "")(dirPath, mStatCount)(pConfig.second->GetProjectName(), pConfig.second->GetLogstoreName()));
+                         "")(dirPath, statCount)(pConfig.second->GetProjectName(), pConfig.second->GetLogstoreName()));
             AlarmManager::GetInstance()->SendAlarmError(
                 STAT_LIMIT_ALARM,
-                string("total dir's polling stat count is exceeded, total count:" + ToString(mStatCount)
+                string("total dir's polling stat count is exceeded, total count:" + ToString(statCount)
                        + " path: " + dirPath + " project:" + pConfig.second->GetProjectName()
                        + " logstore:" + pConfig.second->GetLogstoreName()),
                 pConfig.second->GetRegion(),
@@ -650,9 +738,9 @@ bool PollingDirFile::PollingWildcardConfigPath(const FileDiscoveryConfig& pConfi
                 == 0) {
                 if (finish) {
                     hasMatchFlag = true;
-                    PollingNormalConfigPath(pConfig, item, string(), buf, 0);
+                    PollingNormalConfigPath(task, pConfig, item, string(), buf, 0);
                 } else {
-                    hasMatchFlag |= PollingWildcardConfigPath(pConfig, item, depth + 1);
+                    hasMatchFlag |= PollingWildcardConfigPath(task, pConfig, item, depth + 1);
                 }
             }
         }
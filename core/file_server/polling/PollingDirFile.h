@@ -15,7 +15,10 @@
  */
 
 #pragma once
+#include <atomic>
 #include <map>
+#include <string>
+#include <vector>
 
 #include "common/Lock.h"
 #include "common/LogRunnable.h"
@@ -54,20 +57,40 @@ public:
     }
 
 private:
+    // PollingTask polls a base path of a config, tasks are run in parallel by polling workers.
+    struct PollingTask {
+        PollingTask(const FileDiscoveryConfig& config, const std::string& basePath, bool isContainer)
+            : mConfig(config), mBasePath(basePath), mIsContainer(isContainer) {}
+
+        FileDiscoveryConfig mConfig;
+        std::string mBasePath;
+        bool mIsContainer;
+        // Stat count of this task, used to check limit per config and to throttle.
+        int32_t mStatCount = 0;
+        // New files found by this task, merged to mNewFileVec after all tasks are done.
+        std::vector<SplitedFilePath> mNewFileVec;
+    };
+
     PollingDirFile();
     ~PollingDirFile();
 
     void Polling();
     void PollingIteration();
 
+    // RunPollingTasks runs @tasks by a few workers in order, the calling thread is one of them.
+    void RunPollingTasks(std::vector<PollingTask>& tasks);
+    void RunPollingTask(PollingTask& task);
+
     // PollingNormalConfigPath polls config with normal base path recursively.
+    // @task: task the polling belongs to.
     // @config: config to poll.
     // @srcPath+@obj: directory path to poll, for base directory, @obj is empty.
     // @statBuf: stat of current object.
     // @depth: the depth of current level, used to detect max depth.
     // @return: it is used only by first call, returns true if poll successfully or
     //   error can be handled, otherwise false is returned.
-    bool PollingNormalConfigPath(const FileDiscoveryConfig& config,
+    bool PollingNormalConfigPath(PollingTask& task,
+                                 const FileDiscoveryConfig& config,
                                  const std::string& srcPath,
                                  const std::string& obj,
                                  const fsutil::PathStat& statBuf,
@@ -76,7 +99,10 @@ private:
     // PollingWildcardConfigPath polls config with wildcard base path recursively.
     // It will use PollingNormalConfigPath to poll if the path becomes normal.
     // @return true if at least one directory was found during polling.
-    bool PollingWildcardConfigPath(const FileDiscoveryConfig& pConfig, const std::string& dirPath, int depth);
+    bool PollingWildcardConfigPath(PollingTask& task,
+                                   const FileDiscoveryConfig& pConfig,
+                                   const std::string& dirPath,
+                                   int depth);
 
     // CheckAndUpdateDirMatchCache updates dir cache (add if not existing).
     // The caller of this method should make sure that there is at least one config matches
@@ -84,12 +110,19 @@ private:
     // @dirPath: absolute path of the directory.
     // @statBuf: stat of the directory.
     // @newFlag: a boolean to indicate caller that it is a new directory, generate event for it.
+    // @entries: the cached entries of the directory if @reusable is true, otherwise an empty list
+    //   to be filled by caller and saved by UpdateDirEntriesCache.
     // @return a boolean to indicate should the directory be continued to poll.
     //   It will returns true always now (might change in future).
     bool CheckAndUpdateDirMatchCache(const std::string& dirPath,
                                      const fsutil::PathStat& statBuf,
                                      bool exceedPreservedDirDepth,
-                                     bool& newFlag);
+                                     bool& newFlag,
+                                     DirEntryList& entries,
+                                     bool& reusable);
+    // UpdateDirEntriesCache saves the entries fully listed from @dirPath, so that following rounds
+    // can skip reading the directory until it is changed.
+    void UpdateDirEntriesCache(const std::string& dirPath, DirEntryList&& entries);
     // CheckAndUpdateFileMatchCache updates file cache (add if not existing).
     // @fileDir+@fileName: absolute path of the file.
     // @needFindBestMatch: false indicates that the file has already found the
@@ -110,10 +143,9 @@ private:
     // By default, it will be called every 600s (flag polling_check_timeout_interval).
     void ClearTimeoutFileAndDir();
 
-    // CheckConfigPollingStatCount checks if the stat count of @config exceeds limit.
+    // CheckConfigPollingStatCount checks if the stat count of @task exceeds limit per config.
     // If true, logs and alarms.
-    void
-    CheckConfigPollingStatCount(const int32_t lastStatCount, const FileDiscoveryConfig& config, bool isDockerConfig);
+    void CheckConfigPollingStatCount(const PollingTask& task);
 
 private:
     PTMutex mPollingThreadLock;
@@ -134,7 +166,10 @@ private:
     FileCheckCacheMap mFileCacheMap;
 
     // Record how much times stat is called, if it exceeds limit, stop polling.
-    int32_t mStatCount;
+    // It is shared by all polling workers.
+    std::atomic<int32_t> mStatCount;
+    // Each worker sleeps dirfile_stat_sleep every this many stats, i.e., dirfile_stat_count divided by the workers.
+    int32_t mThrottleStatCount = 1;
     // Record new files found in current round, will be pushed to PollingModify.
     std::vector<SplitedFilePath> mNewFileVec;
     // The sequence number of current round, uint64_t is used to avoid overflow.
@@ -142,10 +177,13 @@ private:
 
     IntGaugePtr mPollingDirCacheSize;
     IntGaugePtr mPollingFileCacheSize;
+    IntGaugePtr mPollingScanTimeMs;
+    IntGaugePtr mPollingStatCount;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class PollingUnittest;
     friend class PollingPreservedDirDepthUnittest;
+    friend class PollingDirFileUnittest;
 #endif
 };
 
@@ -36,6 +36,7 @@
 
 #include "app_config/AppConfig.h"
 #include "application/Application.h"
+#include "collection_pipeline/limiter/InputFlowController.h"
 #include "collection_pipeline/queue/ExactlyOnceQueueManager.h"
 #include "collection_pipeline/queue/ProcessQueueManager.h"
 #include "collection_pipeline/queue/QueueKeyManager.h"
@@ -52,7 +53,6 @@
 #include "file_server/checkpoint/CheckPointManager.h"
 #include "file_server/checkpoint/CheckpointManagerV2.h"
 #include "file_server/event/BlockEventManager.h"
-#include "file_server/event_handler/LogInput.h"
 #include "file_server/reader/GloablFileDescriptorManager.h"
 #include "file_server/reader/JsonLogFileReader.h"
 #include "logger/Logger.h"
@@ -753,8 +753,8 @@ void LogFileReader::FixLastFilePos(LogFileOperator& op, int64_t endOffset) {
         for (size_t endPs = 0; endPs < readSizeReal - 1; ++endPs) {
             if (readBuf[endPs] == '\n') {
                 LineInfo line = GetLastLine(StringView(readBuf, readSizeReal - 1), endPs, true);
-                if (BoostRegexSearch(
-                        line.data.data(), line.data.size(), *mMultilineConfig.first->GetStartPatternReg(), exception)) {
+                if (mMultilineConfig.first->GetStartPatternReg()->Match(
+                        line.data.data(), line.data.size(), exception)) {
                     mLastFilePos += line.lineBegin;
                     mCache.clear();
                     free(readBuf);
@@ -926,9 +926,6 @@ bool LogFileReader::ReadLog(LogBuffer& logBuffer, const Event* event) {
         }
         return false;
     }
-    if (AppConfig::GetInstance()->IsInputFlowControl()) {
-        LogInput::GetInstance()->FlowControl();
-    }
     if ((event == nullptr || !event->IsReaderFlushTimeout()) && mFirstWatched && (mLastFilePos == 0)) {
         CheckForFirstOpen();
     }
@@ -953,6 +950,10 @@ bool LogFileReader::ReadLog(LogBuffer& logBuffer, const Event* event) {
         }
     }
     bool moreData = GetRawData(logBuffer, mLastFileSize, tryRollback);
+    // the position may also move back on truncation or rollback, so the bytes handed over are charged instead
+    if (AppConfig::GetInstance()->IsInputFlowControl() && !logBuffer.rawBuffer.empty()) {
+        InputFlowController::GetInstance()->ConsumeBytes(GetConfigName(), logBuffer.rawBuffer.size());
+    }
     if (!logBuffer.rawBuffer.empty()) {
         if (mEOOption) {
             // This read was replayed by checkpoint, adjust mLastFilePos to skip hole.
@@ -204,6 +204,9 @@ public:
                   const MultilineConfig& multilineConfig,
                   const FileTagConfig& tagConfig);
 
+    // bytes read are charged to the input flow controller, while waiting for it is left to the callers, i.e.,
+    // ModifyHandler, StaticFileServer and HistoryFileImporter. Reads on flush timeout are never held up, since they
+    // only flush what is cached.
     bool ReadLog(LogBuffer& logBuffer, const Event* event);
     time_t GetLastUpdateTime() const // actually it's the time whenever ReadLogs is called
     {
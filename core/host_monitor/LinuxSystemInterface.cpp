@@ -16,6 +16,7 @@
 
 #include "host_monitor/LinuxSystemInterface.h"
 
+#include <array>
 #include <chrono>
 #include <string>
 
@@ -477,18 +478,20 @@ bool LinuxSystemInterface::GetProcessListInformationOnce(ProcessListInformation&
             }
         }
     }
+    // release files of exited processes
+    mProcFileReader.Retain(processListInfo.pids);
     processListInfo.collectTime = steady_clock::now();
     return true;
 }
 
 bool LinuxSystemInterface::GetProcessInformationOnce(pid_t pid, ProcessInformation& processInfo) {
-    auto processStat = PROCESS_DIR / std::to_string(pid) / PROCESS_STAT;
-    std::string line;
-    if (FileReadResult::kOK != ReadFileContent(processStat.string(), line)) {
-        LOG_ERROR(sLogger, ("read process stat", "fail")("file", processStat));
+    if (!mProcFileReader.Read(pid, ProcFileType::STAT, [&](StringView content) {
+            mProcParser.ParseProcessStat(pid, content, processInfo.stat);
+            return true;
+        })) {
+        LOG_ERROR(sLogger, ("read process stat", "fail")("pid", pid));
         return false;
     }
-    mProcParser.ParseProcessStat(pid, line, processInfo.stat);
     processInfo.collectTime = steady_clock::now();
     return true;
 }
@@ -947,97 +950,101 @@ bool LinuxSystemInterface::GetNetInterfaceInformationOnce(NetInterfaceInformatio
 }
 
 bool LinuxSystemInterface::GetProcessCmdlineStringOnce(pid_t pid, ProcessCmdlineString& cmdline) {
-    auto processCMDline = PROCESS_DIR / std::to_string(pid) / PROCESS_CMDLINE;
     cmdline.cmdline.clear();
-
-    std::ifstream file(static_cast<std::string>(processCMDline));
-
-    if (!file.is_open()) {
-        LOG_ERROR(sLogger, ("open process cmdline file", "fail")("file", processCMDline));
+    if (!mProcFileReader.Read(pid, ProcFileType::CMDLINE, [&](StringView content) {
+            // one entry per line like std::getline, arguments stay separated by '\0'
+            size_t pos = 0;
+            while (pos < content.size()) {
+                auto end = content.find('\n', pos);
+                if (end == StringView::npos) {
+                    end = content.size();
+                }
+                cmdline.cmdline.emplace_back(content.data() + pos, end - pos);
+                pos = end + 1;
+            }
+            return true;
+        })) {
+        LOG_ERROR(sLogger, ("read process cmdline file", "fail")("pid", pid));
         return false;
     }
-
-    std::string line;
-    while (std::getline(file, line)) {
-        cmdline.cmdline.push_back(line);
-    }
-
     return true;
 }
 
+// 数据样例: /proc/1/statm, 单位为页
+// 416988 46661 13498 12061 0 160061 0
 bool LinuxSystemInterface::GetProcessStatmOnce(pid_t pid, ProcessMemoryInformation& processMemory) {
-    auto processStatm = PROCESS_DIR / std::to_string(pid) / PROCESS_STATM;
-    std::vector<std::string> processStatmString;
-
-    std::ifstream file(static_cast<std::string>(processStatm));
-
-    if (!file.is_open()) {
-        LOG_ERROR(sLogger, ("open process statm file", "fail")("file", processStatm));
-        return false;
-    }
-
-    std::string line;
-    while (std::getline(file, line)) {
-        processStatmString.push_back(line);
-    }
-    file.close();
-
-    std::vector<std::string> processMemoryMetric;
-    if (!processStatmString.empty()) {
-        const std::string& input = processStatmString.front();
-        boost::algorithm::split(processMemoryMetric, input, boost::is_any_of(" "), boost::algorithm::token_compress_on);
-    }
-
-    if (processMemoryMetric.size() < 3) {
-        return false;
+    bool readSuccess = false;
+    bool parsed = mProcFileReader.Read(pid, ProcFileType::STATM, [&](StringView content) {
+        readSuccess = true;
+        if (!content.empty() && content.back() == '\n') {
+            content.remove_suffix(1);
+        }
+        // size resident shared
+        std::array<uint64_t, 3> values{};
+        size_t count = 0;
+        for (auto field : StringViewSplitter(content, " ")) {
+            if (field.empty()) {
+                continue;
+            }
+            StringTo(field, values[count]);
+            if (++count == values.size()) {
+                break;
+            }
+        }
+        if (count < values.size()) {
+            return false;
+        }
+        processMemory.size = values[0] * PAGE_SIZE;
+        processMemory.resident = values[1] * PAGE_SIZE;
+        processMemory.share = values[2] * PAGE_SIZE;
+        return true;
+    });
+    if (!readSuccess) {
+        LOG_ERROR(sLogger, ("read process statm file", "fail")("pid", pid));
     }
-
-    int index = 0;
-    StringTo(processMemoryMetric[index++], processMemory.size);
-    processMemory.size = processMemory.size * PAGE_SIZE;
-    StringTo(processMemoryMetric[index++], processMemory.resident);
-    processMemory.resident = processMemory.resident * PAGE_SIZE;
-    StringTo(processMemoryMetric[index++], processMemory.share);
-    processMemory.share = processMemory.share * PAGE_SIZE;
-
-    return true;
+    return parsed;
 }
 
 bool LinuxSystemInterface::GetProcessCredNameOnce(pid_t pid, ProcessCredName& processCredName) {
-    auto processStatus = PROCESS_DIR / std::to_string(pid) / PROCESS_STATUS;
-
-    std::vector<std::string> metric;
-
-    std::ifstream file(static_cast<std::string>(processStatus));
-
-    if (!file.is_open()) {
-        LOG_ERROR(sLogger, ("open process status file", "fail")("file", processStatus));
-        return false;
-    }
-
-    std::string line;
     ProcessCred cred{};
     bool getUID = false;
     bool getGID = false;
     bool getName = false;
-    while (std::getline(file, line) && !(getUID && getGID && getName)) {
-        boost::algorithm::split(metric, line, boost::algorithm::is_any_of("\t"), boost::algorithm::token_compress_on);
-
-        if (metric.front() == "Name:") {
-            processCredName.name = metric[1];
-            getName = true;
-        }
-        if (metric.size() >= 3 && metric.front() == "Uid:") {
-            int index = 1;
-            cred.uid = static_cast<uint64_t>(std::stoull(metric[index++]));
-            cred.euid = static_cast<uint64_t>(std::stoull(metric[index]));
-            getUID = true;
-        } else if (metric.size() >= 3 && metric.front() == "Gid:") {
-            int index = 1;
-            cred.gid = static_cast<uint64_t>(std::stoull(metric[index++]));
-            cred.egid = static_cast<uint64_t>(std::stoull(metric[index]));
-            getGID = true;
-        }
+    if (!mProcFileReader.Read(pid, ProcFileType::STATUS, [&](StringView content) {
+            // key and values are separated by tabs, e.g. "Uid:\t0\t0\t0\t0"
+            std::array<StringView, 3> fields{};
+            for (auto line : StringViewSplitter(content, "\n")) {
+                if (getUID && getGID && getName) {
+                    break;
+                }
+                size_t count = 0;
+                for (auto field : StringViewSplitter(line, "\t")) {
+                    if (field.empty()) {
+                        continue;
+                    }
+                    fields[count] = field;
+                    if (++count == fields.size()) {
+                        break;
+                    }
+                }
+                if (count >= 2 && fields[0] == "Name:") {
+                    processCredName.name.assign(fields[1].data(), fields[1].size());
+                    getName = true;
+                }
+                if (count >= 3 && fields[0] == "Uid:") {
+                    StringTo(fields[1], cred.uid);
+                    StringTo(fields[2], cred.euid);
+                    getUID = true;
+                } else if (count >= 3 && fields[0] == "Gid:") {
+                    StringTo(fields[1], cred.gid);
+                    StringTo(fields[2], cred.egid);
+                    getGID = true;
+                }
+            }
+            return true;
+        })) {
+        LOG_ERROR(sLogger, ("read process status file", "fail")("pid", pid));
+        return false;
     }
 
     passwd* pw = nullptr;
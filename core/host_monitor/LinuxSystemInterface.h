@@ -17,6 +17,7 @@
 #pragma once
 
 #include "common/ProcParser.h"
+#include "host_monitor/ProcFileReader.h"
 #include "host_monitor/SystemInterface.h"
 
 namespace logtail {
@@ -66,5 +67,7 @@ private:
     bool GetInterfaceConfig(InterfaceConfig& interfaceConfig, const std::string& name);
 
     ProcParser mProcParser;
+    // per pid files are read through cached fds, see ProcFileReader
+    ProcFileReader mProcFileReader;
 };
 } // namespace logtail
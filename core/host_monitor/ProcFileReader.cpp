@@ -0,0 +1,207 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "host_monitor/ProcFileReader.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+
+#include "common/Flags.h"
+#include "common/StringTools.h"
+#include "host_monitor/Constants.h"
+
+DEFINE_FLAG_INT32(host_monitor_proc_max_open_fds,
+                  "max /proc/<pid> files kept open by host monitor, 0 means reopening files on every read",
+                  4096);
+
+namespace logtail {
+
+static constexpr const char* kProcFileNames[] = {"stat", "statm", "status", "cmdline"};
+static constexpr size_t kInitialBufferSize = 4096;
+// fields after "(comm) ", starttime is the 22nd field of /proc/<pid>/stat
+static constexpr size_t kStartTimeFieldIndex = 19;
+
+ProcFileReader::ProcFileReader() : ProcFileReader(std::max(INT32_FLAG(host_monitor_proc_max_open_fds), 0)) {
+}
+
+ProcFileReader::ProcFileReader(size_t maxOpenFds) : mMaxOpenFds(maxOpenFds), mBuffer(kInitialBufferSize) {
+}
+
+ProcFileReader::~ProcFileReader() {
+    Clear();
+}
+
+void ProcFileReader::Retain(const std::vector<pid_t>& alivePids) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    ++mGeneration;
+    for (auto pid : alivePids) {
+        auto it = mPidFiles.find(pid);
+        if (it != mPidFiles.end()) {
+            it->second.mGeneration = mGeneration;
+        }
+    }
+    for (auto it = mPidFiles.begin(); it != mPidFiles.end();) {
+        if (it->second.mGeneration != mGeneration) {
+            closeFiles(it->second);
+            it = mPidFiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ProcFileReader::Clear() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto& item : mPidFiles) {
+        closeFiles(item.second);
+    }
+    mPidFiles.clear();
+}
+
+size_t ProcFileReader::OpenFdCount() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mOpenFds;
+}
+
+size_t ProcFileReader::CachedPidCount() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mPidFiles.size();
+}
+
+uint64_t ProcFileReader::PidReusedCount() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mPidReusedCount;
+}
+
+bool ProcFileReader::read(pid_t pid, ProcFileType type, StringView& content) {
+    if (mRoot != PROCESS_DIR.native()) {
+        for (auto& item : mPidFiles) {
+            closeFiles(item.second);
+        }
+        mPidFiles.clear();
+        mRoot = PROCESS_DIR.native();
+    }
+
+    auto [it, inserted] = mPidFiles.try_emplace(pid);
+    auto& files = it->second;
+    if (inserted) {
+        files.mGeneration = mGeneration;
+    }
+    auto idx = static_cast<size_t>(type);
+    if (files.mFds[idx] >= 0) {
+        if (readFd(files.mFds[idx], content)) {
+            return true;
+        }
+        // the process has exited, the pid may have been taken by another process since
+        closeFiles(files);
+    }
+
+    int fd = open(pid, type);
+    if (fd < 0) {
+        if (std::all_of(files.mFds.begin(), files.mFds.end(), [](int value) { return value < 0; })) {
+            mPidFiles.erase(it);
+        }
+        return false;
+    }
+    if (!readFd(fd, content)) {
+        ::close(fd);
+        return false;
+    }
+    if (type == ProcFileType::STAT) {
+        checkStartTicks(files, content);
+    }
+    if (mOpenFds < mMaxOpenFds) {
+        files.mFds[idx] = fd;
+        ++mOpenFds;
+    } else {
+        ::close(fd);
+    }
+    return true;
+}
+
+int ProcFileReader::open(pid_t pid, ProcFileType type) {
+    mPath.assign(mRoot);
+    mPath.push_back('/');
+    mPath.append(std::to_string(pid));
+    mPath.push_back('/');
+    mPath.append(kProcFileNames[static_cast<size_t>(type)]);
+    return ::open(mPath.c_str(), O_RDONLY | O_CLOEXEC);
+}
+
+bool ProcFileReader::readFd(int fd, StringView& content) {
+    size_t size = 0;
+    while (true) {
+        if (size == mBuffer.size()) {
+            mBuffer.resize(mBuffer.size() * 2);
+        }
+        ssize_t n = pread(fd, mBuffer.data() + size, mBuffer.size() - size, size);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        size += n;
+        // these files are generated in one piece, so a short read means the end of file and saves a pread returning 0
+        if (static_cast<size_t>(n) == 0 || size < mBuffer.size()) {
+            break;
+        }
+    }
+    content = StringView(mBuffer.data(), size);
+    return true;
+}
+
+void ProcFileReader::checkStartTicks(PidFiles& files, StringView stat) {
+    auto startTicks = parseStartTicks(stat);
+    if (files.mStartTicks != 0 && startTicks != files.mStartTicks) {
+        // files still open belong to the previous owner of the pid
+        ++mPidReusedCount;
+        closeFiles(files);
+    }
+    files.mStartTicks = startTicks;
+}
+
+void ProcFileReader::closeFiles(PidFiles& files) {
+    for (auto& fd : files.mFds) {
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+            --mOpenFds;
+        }
+    }
+}
+
+uint64_t ProcFileReader::parseStartTicks(StringView stat) {
+    auto pos = stat.rfind(')');
+    if (pos == StringView::npos || pos + 2 > stat.size()) {
+        return 0;
+    }
+    stat.remove_prefix(pos + 2);
+    size_t index = 0;
+    for (auto field : StringViewSplitter(stat, " ")) {
+        if (index++ == kStartTimeFieldIndex) {
+            uint64_t startTicks = 0;
+            StringTo(field, startTicks);
+            return startTicks;
+        }
+    }
+    return 0;
+}
+
+} // namespace logtail
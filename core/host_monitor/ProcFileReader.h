@@ -0,0 +1,107 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/StringView.h"
+
+namespace logtail {
+
+enum class ProcFileType : uint8_t {
+    STAT = 0,
+    STATM,
+    STATUS,
+    CMDLINE,
+    COUNT,
+};
+
+// ProcFileReader keeps /proc/<pid>/{stat,statm,status,cmdline} open across collects and preads them into a reused
+// buffer, so refreshing a process costs one or two syscalls per file instead of open, read, close and the stream and
+// string allocations around them.
+// An fd of a /proc/<pid> file stays bound to the process it was opened for and reading it fails once that process
+// exits. The reader then reopens the file, and compares the start time in stat to tell a reused pid from the
+// original process.
+class ProcFileReader {
+public:
+    ProcFileReader();
+    explicit ProcFileReader(size_t maxOpenFds);
+    ~ProcFileReader();
+
+    ProcFileReader(const ProcFileReader&) = delete;
+    ProcFileReader& operator=(const ProcFileReader&) = delete;
+
+    // call parser with the whole file content, the content is only valid inside parser
+    // return false if the file cannot be read, otherwise the result of parser
+    template <typename Parser>
+    bool Read(pid_t pid, ProcFileType type, Parser&& parser) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        StringView content;
+        if (!read(pid, type, content)) {
+            return false;
+        }
+        return parser(content);
+    }
+
+    // close files of pids not in alivePids
+    void Retain(const std::vector<pid_t>& alivePids);
+    void Clear();
+
+    size_t OpenFdCount() const;
+    size_t CachedPidCount() const;
+    uint64_t PidReusedCount() const;
+
+private:
+    struct PidFiles {
+        PidFiles() { mFds.fill(-1); }
+        std::array<int, static_cast<size_t>(ProcFileType::COUNT)> mFds;
+        uint64_t mStartTicks = 0;
+        uint64_t mGeneration = 0;
+    };
+
+    bool read(pid_t pid, ProcFileType type, StringView& content);
+    int open(pid_t pid, ProcFileType type);
+    bool readFd(int fd, StringView& content);
+    void checkStartTicks(PidFiles& files, StringView stat);
+    void closeFiles(PidFiles& files);
+
+    static uint64_t parseStartTicks(StringView stat);
+
+    size_t mMaxOpenFds = 0;
+    size_t mOpenFds = 0;
+    uint64_t mGeneration = 0;
+    uint64_t mPidReusedCount = 0;
+    // files opened under another root are dropped when PROCESS_DIR changes
+    std::string mRoot;
+    std::unordered_map<pid_t, PidFiles> mPidFiles;
+    std::vector<char> mBuffer;
+    std::string mPath;
+    mutable std::mutex mMutex;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ProcFileReaderUnittest;
+#endif
+};
+
+} // namespace logtail
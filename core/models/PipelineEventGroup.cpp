@@ -111,18 +111,51 @@ PipelineEventGroup& PipelineEventGroup::operator=(PipelineEventGroup&& rhs) noex
 }
 
 PipelineEventGroup PipelineEventGroup::Copy() const {
+    PipelineEventGroup res = CopyWithoutEvents();
+    res.mEvents.reserve(mEvents.size());
+    for (auto& event : mEvents) {
+        res.mEvents.emplace_back(event.Copy());
+        res.mEvents.back()->ResetPipelineEventGroup(&res);
+    }
+    return res;
+}
+
+PipelineEventGroup PipelineEventGroup::CopyWithoutEvents() const {
     PipelineEventGroup res(mSourceBuffer);
     res.mMetadata = mMetadata;
     res.mTags = mTags;
     res.mExactlyOnceCheckpoint = mExactlyOnceCheckpoint;
     res.mExtraSourceBuffers = mExtraSourceBuffers;
-    for (auto& event : mEvents) {
-        res.mEvents.emplace_back(event.Copy());
+    return res;
+}
+
+PipelineEventGroup PipelineEventGroup::CreateSlice(size_t begin, size_t end) {
+    PipelineEventGroup res(make_shared<SourceBuffer>());
+    res.mMetadata = mMetadata;
+    res.mTags = mTags;
+    res.mExtraSourceBuffers = mExtraSourceBuffers;
+    res.mExtraSourceBuffers.insert(mSourceBuffer);
+    res.mEvents.reserve(end - begin);
+    for (size_t i = begin; i < end; ++i) {
+        res.mEvents.emplace_back(std::move(mEvents[i]));
         res.mEvents.back()->ResetPipelineEventGroup(&res);
     }
     return res;
 }
 
+void PipelineEventGroup::MergeSlice(PipelineEventGroup&& slice) {
+    mEvents.reserve(mEvents.size() + slice.mEvents.size());
+    for (auto& event : slice.mEvents) {
+        event->ResetPipelineEventGroup(this);
+        mEvents.emplace_back(std::move(event));
+    }
+    slice.mEvents.clear();
+    AddSourceBuffer(slice.mSourceBuffer);
+    for (const auto& sourceBuffer : slice.mExtraSourceBuffers) {
+        AddSourceBuffer(sourceBuffer);
+    }
+}
+
 unique_ptr<LogEvent> PipelineEventGroup::CreateLogEvent(bool fromPool, EventPool* pool) {
     LogEvent* e = nullptr;
     if (fromPool) {
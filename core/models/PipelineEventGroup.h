@@ -87,6 +87,12 @@ public:
     PipelineEventGroup& operator=(PipelineEventGroup&&) noexcept;
 
     PipelineEventGroup Copy() const;
+    // copy everything but events, source buffers are shared
+    PipelineEventGroup CopyWithoutEvents() const;
+    // Moves the events in [begin, end) to a new group sharing the metadata and tags, which allocates from a source
+    // buffer of its own so that it can be processed on another thread. The slice should be merged back in order.
+    PipelineEventGroup CreateSlice(size_t begin, size_t end);
+    void MergeSlice(PipelineEventGroup&& slice);
 
     std::unique_ptr<LogEvent> CreateLogEvent(bool fromPool = false, EventPool* pool = nullptr);
     std::unique_ptr<MetricEvent> CreateMetricEvent(bool fromPool = false, EventPool* pool = nullptr);
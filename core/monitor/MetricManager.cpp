@@ -45,84 +45,73 @@ void WriteMetrics::CreateMetricsRecordRef(MetricsRecordRef& ref,
 }
 
 void WriteMetrics::CommitMetricsRecordRef(MetricsRecordRef& ref) {
-    std::lock_guard<std::mutex> lock(mMutex);
-    ref.mMetrics->SetNext(mHead);
-    mHead = ref.mMetrics;
     ref.mMetrics->MarkCommitted();
+    MetricsRecord* head = mHead.load(std::memory_order_relaxed);
+    do {
+        ref.mMetrics->SetNext(head);
+    } while (!mHead.compare_exchange_weak(head, ref.mMetrics, std::memory_order_release, std::memory_order_relaxed));
 }
 
 MetricsRecord* WriteMetrics::GetHead() {
-    std::lock_guard<std::mutex> lock(mMutex);
-    return mHead;
+    return mHead.load(std::memory_order_acquire);
 }
 
 void WriteMetrics::Clear() {
-    std::lock_guard<std::mutex> lock(mMutex);
-    while (mHead) {
-        MetricsRecord* toDeleted = mHead;
-        mHead = mHead->GetNext();
+    std::lock_guard<std::mutex> lock(mSnapshotMux);
+    MetricsRecord* head = mHead.exchange(nullptr, std::memory_order_acquire);
+    while (head) {
+        MetricsRecord* toDeleted = head;
+        head = head->GetNext();
+        delete toDeleted;
+    }
+    while (mRetiredHead) {
+        MetricsRecord* toDeleted = mRetiredHead;
+        mRetiredHead = mRetiredHead->GetNext();
         delete toDeleted;
     }
 }
 
 MetricsRecord* WriteMetrics::DoSnapshot() {
+    std::lock_guard<std::mutex> lock(mSnapshotMux);
     // new read head
     MetricsRecord* snapshot = nullptr;
-    MetricsRecord* toDeleteHead = nullptr;
-    MetricsRecord* tmp = nullptr;
-
-    MetricsRecord emptyHead;
-    MetricsRecord* preTmp = nullptr;
+    MetricsRecord* toDeleteHead = mRetiredHead;
+    mRetiredHead = nullptr;
 
     int writeMetricsTotal = 0;
     int writeMetricsDeleteTotal = 0;
     int metricsSnapshotTotal = 0;
 
-    // find the first undeleted node and set as new mHead
-    {
-        std::lock_guard<std::mutex> lock(mMutex);
-        emptyHead.SetNext(mHead);
-        preTmp = &emptyHead;
-        tmp = preTmp->GetNext();
-        bool findHead = false;
-        while (tmp) {
-            if (tmp->IsDeleted()) {
-                preTmp->SetNext(tmp->GetNext());
-                tmp->SetNext(toDeleteHead);
-                toDeleteHead = tmp;
-                tmp = preTmp->GetNext();
-                writeMetricsTotal++;
-            } else {
-                // find head
-                mHead = tmp;
-                preTmp = mHead;
-                tmp = tmp->GetNext();
-                findHead = true;
-                break;
-            }
-        }
-        // if no undeleted node, set null to mHead
-        if (!findHead) {
-            mHead = nullptr;
-            preTmp = mHead;
+    // deleted nodes at the head are unlinked by cas, since new nodes may be committed concurrently
+    MetricsRecord* head = mHead.load(std::memory_order_acquire);
+    while (head && head->IsDeleted()) {
+        MetricsRecord* next = head->GetNext();
+        if (mHead.compare_exchange_weak(head, next, std::memory_order_acquire)) {
+            head->SetNext(mRetiredHead);
+            mRetiredHead = head;
+            head = next;
+            writeMetricsTotal++;
         }
     }
 
-    // copy head
+    // nodes after the head are only touched by the snapshot thread
+    MetricsRecord* preTmp = head;
+    MetricsRecord* tmp = nullptr;
     if (preTmp) {
         MetricsRecord* newMetrics = preTmp->Collect();
         newMetrics->SetNext(snapshot);
         snapshot = newMetrics;
         metricsSnapshotTotal++;
         writeMetricsTotal++;
+        tmp = preTmp->GetNext();
     }
 
     while (tmp) {
         writeMetricsTotal++;
         if (tmp->IsDeleted()) {
             preTmp->SetNext(tmp->GetNext());
-            tmp->SetNext(toDeleteHead);
-            toDeleteHead = tmp;
+            tmp->SetNext(mRetiredHead);
+            mRetiredHead = tmp;
             tmp = preTmp->GetNext();
         } else {
             MetricsRecord* newMetrics = tmp->Collect();
@@ -134,6 +123,7 @@ MetricsRecord* WriteMetrics::DoSnapshot() {
         }
     }
 
+    // records retired by the last snapshot are no longer referenced by the read side
     while (toDeleteHead) {
         MetricsRecord* toDelete = toDeleteHead;
         toDeleteHead = toDeleteHead->GetNext();
@@ -180,20 +170,9 @@ void ReadMetrics::UpdateMetrics() {
         }
     }
     // 获取c++指标
-    MetricsRecord* snapshot = WriteMetrics::GetInstance()->DoSnapshot();
-    MetricsRecord* toDelete;
-    {
-        // Only lock when change head
-        WriteLock lock(mReadWriteLock);
-        toDelete = mHead;
-        mHead = snapshot;
-    }
-    // delete old linklist
-    while (toDelete) {
-        MetricsRecord* obj = toDelete;
-        toDelete = toDelete->GetNext();
-        delete obj;
-    }
+    // snapshots are reused across collections, so readers are blocked until the new one is in place
+    WriteLock lock(mReadWriteLock);
+    mHead = WriteMetrics::GetInstance()->DoSnapshot();
 }
 
 MetricsRecord* ReadMetrics::GetHead() {
@@ -202,12 +181,9 @@ MetricsRecord* ReadMetrics::GetHead() {
 }
 
 void ReadMetrics::Clear() {
+    // snapshots are owned by the write records
     WriteLock lock(mReadWriteLock);
-    while (mHead) {
-        MetricsRecord* toDelete = mHead;
-        mHead = mHead->GetNext();
-        delete toDelete;
-    }
+    mHead = nullptr;
 }
 
 // metrics from Go that are provided by cpp
@@ -30,11 +30,16 @@
 
 namespace logtail {
 
+// Records are committed from any thread onto a lock-free list, while unlinking deleted records and collecting
+// values are only done by the snapshot thread.
 class WriteMetrics {
 private:
     WriteMetrics() = default;
-    std::mutex mMutex;
-    MetricsRecord* mHead = nullptr;
+    std::atomic<MetricsRecord*> mHead = nullptr;
+    // serializes snapshots and clear
+    std::mutex mSnapshotMux;
+    // records unlinked by the last snapshot, whose snapshots may still be read until the next one
+    MetricsRecord* mRetiredHead = nullptr;
 
     void Clear();
     MetricsRecord* GetHead();
@@ -54,6 +59,7 @@ public:
                                 MetricLabels&& labels,
                                 DynamicMetricLabels&& dynamicLabels = {});
     void CommitMetricsRecordRef(MetricsRecordRef& ref);
+    // the returned list is owned by the write records and remains valid until the next snapshot
     MetricsRecord* DoSnapshot();
 
 
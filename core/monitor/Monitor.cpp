@@ -29,6 +29,7 @@
 #include "app_config/AppConfig.h"
 #include "application/Application.h"
 #include "collection_pipeline/CollectionPipelineManager.h"
+#include "collection_pipeline/limiter/InputFlowController.h"
 #include "common/DevInode.h"
 #include "common/ExceptionBase.h"
 #include "common/LogtailCommonFlags.h"
@@ -36,6 +37,7 @@
 #include "common/RuntimeUtil.h"
 #include "common/StringTools.h"
 #include "common/TimeUtil.h"
+#include "common/memory/MemoryAccountant.h"
 #include "common/version.h"
 #include "constants/Constants.h"
 #include "file_server/event_handler/LogInput.h"
@@ -156,9 +158,10 @@ void LogtailMonitor::Monitor() {
             }
             GetCpuStat(curCpuStat);
 
-            // Update mRealtimeCpuStat for InputFlowControl.
+            // Update mRealtimeCpuStat and input rates for InputFlowControl.
             if (AppConfig::GetInstance()->IsInputFlowControl()) {
                 CalCpuStat(curCpuStat, mRealtimeCpuStat);
+                InputFlowController::GetInstance()->UpdateRate();
             }
 
             int32_t monitorTime = time(NULL);
@@ -185,6 +188,8 @@ void LogtailMonitor::Monitor() {
 
                 GetMemStat();
                 LoongCollectorMonitor::GetInstance()->SetAgentMemory(mMemStat.mRss);
+                UpdateMemoryPressure();
+                LoongCollectorMonitor::GetInstance()->UpdateAgentMemoryBreakdown();
                 CalCpuStat(curCpuStat, mCpuStat);
                 LoongCollectorMonitor::GetInstance()->SetAgentCpu(mCpuStat.mCpuUsage);
                 if (CheckHardMemLimit()) {
@@ -215,7 +220,7 @@ void LogtailMonitor::Monitor() {
                 // flag(cpu_limit_num) and flag(mem_limit_num)).
                 // Returning true means too much violations, so we have to prepare to restart
                 // logtail to release resource.
-                // Mainly for controlling memory because we have no idea to descrease memory usage.
+                // For memory, this only happens after all load shedding measures fail to bring the usage down.
                 if (CheckSoftCpuLimit() || CheckSoftMemLimit()) {
                     LOG_ERROR(sLogger,
                               ("Resource used by program exceeds upper limit for some time",
@@ -371,7 +376,9 @@ bool LogtailMonitor::CheckSoftCpuLimit() {
 
 bool LogtailMonitor::CheckSoftMemLimit() {
     if (mMemStat.mRss > AppConfig::GetInstance()->GetMemUsageUpLimit()) {
-        if (++mMemStat.mViolateNum > INT32_FLAG(mem_limit_num))
+        // restart is the last resort, when load shedding has already gone through all the levels
+        if (++mMemStat.mViolateNum > INT32_FLAG(mem_limit_num)
+            && MemoryAccountant::GetInstance()->IsUnderPressure(MemoryPressureLevel::TRIM_POOL))
             return true;
     } else
         mMemStat.mViolateNum = 0;
@@ -382,6 +389,29 @@ bool LogtailMonitor::CheckHardMemLimit() {
     return mMemStat.mRss > 5 * AppConfig::GetInstance()->GetMemUsageUpLimit();
 }
 
+void LogtailMonitor::UpdateMemoryPressure() {
+    auto* accountant = MemoryAccountant::GetInstance();
+    auto lastLevel = accountant->GetPressureLevel();
+    auto level = accountant->UpdatePressureLevel(mMemStat.mRss, AppConfig::GetInstance()->GetMemUsageUpLimit());
+    if (level == lastLevel) {
+        return;
+    }
+    LOG_WARNING(sLogger,
+                ("memory pressure level changed", static_cast<int>(level))("last level", static_cast<int>(lastLevel))(
+                    "mem_rss", mMemStat.mRss)("source buffer bytes",
+                                              accountant->GetBytes(MemoryCategory::SOURCE_BUFFER))(
+                    "process queue bytes", accountant->GetBytes(MemoryCategory::PROCESS_QUEUE))(
+                    "sender queue bytes", accountant->GetBytes(MemoryCategory::SENDER_QUEUE))(
+                    "batcher bytes", accountant->GetBytes(MemoryCategory::BATCHER)));
+    if (level == MemoryPressureLevel::TRIM_POOL) {
+        // drop cached readers and give the free memory held by the allocator back to the system
+        LogInput::GetInstance()->SetForceClearFlag(true);
+#ifndef LOGTAIL_NO_TC_MALLOC
+        gLastTcmallocReleaseMemTime = 0;
+#endif
+    }
+}
+
 bool LogtailMonitor::DumpMonitorInfo(time_t monitorTime) {
     string path = GetAgentLogDir() + GetMonitorInfoFileName();
     ofstream outfile(path.c_str(), ofstream::app);
@@ -633,12 +663,28 @@ void LoongCollectorMonitor::Init() {
     mAgentCpu = mMetricsRecordRef.CreateDoubleGauge(METRIC_AGENT_CPU);
     mAgentMemory = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_MEMORY);
     mAgentGoMemory = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_MEMORY_GO);
+    mAgentMemorySourceBufferSizeBytes
+        = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_MEMORY_SOURCE_BUFFER_SIZE_BYTES);
+    mAgentMemoryProcessQueueSizeBytes
+        = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_MEMORY_PROCESS_QUEUE_SIZE_BYTES);
+    mAgentMemorySenderQueueSizeBytes = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_MEMORY_SENDER_QUEUE_SIZE_BYTES);
+    mAgentMemoryBatcherSizeBytes = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_MEMORY_BATCHER_SIZE_BYTES);
+    mAgentMemoryPressureLevel = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_MEMORY_PRESSURE_LEVEL);
     mAgentGoRoutinesTotal = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_GO_ROUTINES_TOTAL);
     mAgentOpenFdTotal = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_OPEN_FD_TOTAL);
     mAgentConfigTotal = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_PIPELINE_CONFIG_TOTAL);
     WriteMetrics::GetInstance()->CommitMetricsRecordRef(mMetricsRecordRef);
 }
 
+void LoongCollectorMonitor::UpdateAgentMemoryBreakdown() {
+    auto* accountant = MemoryAccountant::GetInstance();
+    SET_GAUGE(mAgentMemorySourceBufferSizeBytes, accountant->GetBytes(MemoryCategory::SOURCE_BUFFER));
+    SET_GAUGE(mAgentMemoryProcessQueueSizeBytes, accountant->GetBytes(MemoryCategory::PROCESS_QUEUE));
+    SET_GAUGE(mAgentMemorySenderQueueSizeBytes, accountant->GetBytes(MemoryCategory::SENDER_QUEUE));
+    SET_GAUGE(mAgentMemoryBatcherSizeBytes, accountant->GetBytes(MemoryCategory::BATCHER));
+    SET_GAUGE(mAgentMemoryPressureLevel, static_cast<uint64_t>(accountant->GetPressureLevel()));
+}
+
 void LoongCollectorMonitor::Stop() {
     SelfMonitorServer::GetInstance()->Stop();
     LOG_INFO(sLogger, ("LoongCollector monitor", "stopped successfully"));
@@ -120,6 +120,8 @@ private:
     bool CheckSoftMemLimit();
 
     bool CheckHardMemLimit();
+    // UpdateMemoryPressure escalates or relaxes load shedding according to the memory usage.
+    void UpdateMemoryPressure();
 
     // SendStatusProfile collects status profile and send them to server.
     // @suicide indicates if the target LogStore is logtail_suicide_profile.
@@ -201,6 +203,8 @@ public:
     void SetAgentCpu(double cpu) { SET_GAUGE(mAgentCpu, cpu); }
     void SetAgentMemory(uint64_t mem) { SET_GAUGE(mAgentMemory, mem); }
     void SetAgentGoMemory(uint64_t mem) { SET_GAUGE(mAgentGoMemory, mem); }
+    // bytes held by each kind of data holder, along with the current memory pressure level
+    void UpdateAgentMemoryBreakdown();
     void SetAgentGoRoutinesTotal(uint64_t total) { SET_GAUGE(mAgentGoRoutinesTotal, total); }
     void SetAgentOpenFdTotal(uint64_t total) {
 #ifndef APSARA_UNIT_TEST_MAIN
@@ -240,6 +244,11 @@ private:
     DoubleGaugePtr mAgentCpu;
     IntGaugePtr mAgentMemory;
     IntGaugePtr mAgentGoMemory;
+    IntGaugePtr mAgentMemorySourceBufferSizeBytes;
+    IntGaugePtr mAgentMemoryProcessQueueSizeBytes;
+    IntGaugePtr mAgentMemorySenderQueueSizeBytes;
+    IntGaugePtr mAgentMemoryBatcherSizeBytes;
+    IntGaugePtr mAgentMemoryPressureLevel;
     IntGaugePtr mAgentGoRoutinesTotal;
     IntGaugePtr mAgentOpenFdTotal;
     IntGaugePtr mAgentConfigTotal;
@@ -36,6 +36,11 @@ const string METRIC_AGENT_GO_ROUTINES_TOTAL = "go_routines_total";
 const string METRIC_AGENT_INSTANCE_CONFIG_TOTAL = "instance_config_total"; // Not Implemented
 const string METRIC_AGENT_MEMORY = "memory_used_mb";
 const string METRIC_AGENT_MEMORY_GO = "go_memory_used_mb";
+const string METRIC_AGENT_MEMORY_BATCHER_SIZE_BYTES = "memory_batcher_size_bytes";
+const string METRIC_AGENT_MEMORY_PRESSURE_LEVEL = "memory_pressure_level";
+const string METRIC_AGENT_MEMORY_PROCESS_QUEUE_SIZE_BYTES = "memory_process_queue_size_bytes";
+const string METRIC_AGENT_MEMORY_SENDER_QUEUE_SIZE_BYTES = "memory_sender_queue_size_bytes";
+const string METRIC_AGENT_MEMORY_SOURCE_BUFFER_SIZE_BYTES = "memory_source_buffer_size_bytes";
 const string METRIC_AGENT_OPEN_FD_TOTAL = "open_fd_total";
 const string METRIC_AGENT_PIPELINE_CONFIG_TOTAL = "pipeline_config_total";
 
@@ -51,6 +51,7 @@ const string& METRIC_COMPONENT_OUT_ITEMS_TOTAL = METRIC_OUT_ITEMS_TOTAL;
 const string& METRIC_COMPONENT_OUT_SIZE_BYTES = METRIC_OUT_SIZE_BYTES;
 const string& METRIC_COMPONENT_TOTAL_DELAY_MS = METRIC_TOTAL_DELAY_MS;
 const string& METRIC_COMPONENT_TOTAL_PROCESS_TIME_MS = METRIC_TOTAL_PROCESS_TIME_MS;
+const string& METRIC_COMPONENT_LATENCY_MS = METRIC_LATENCY_MS;
 const string& METRIC_COMPONENT_DISCARDED_ITEMS_TOTAL = METRIC_DISCARDED_ITEMS_TOTAL;
 const string& METRIC_COMPONENT_DISCARDED_SIZE_BYTES = METRIC_DISCARDED_SIZE_BYTES;
 
@@ -71,6 +72,8 @@ const string METRIC_COMPONENT_QUEUE_SIZE_BYTES = "queue_size_bytes";
 const string METRIC_COMPONENT_QUEUE_VALID_TO_PUSH_FLAG = "valid_to_push_status";
 const string METRIC_COMPONENT_QUEUE_EXTRA_BUFFER_SIZE = "extra_buffer_size";
 const string METRIC_COMPONENT_QUEUE_EXTRA_BUFFER_SIZE_BYTES = "extra_buffer_size_bytes";
+const string METRIC_COMPONENT_QUEUE_SPILL_BUFFER_SIZE = "spill_buffer_size";
+const string METRIC_COMPONENT_QUEUE_SPILL_BUFFER_SIZE_BYTES = "spill_buffer_size_bytes";
 const string& METRIC_COMPONENT_QUEUE_DISCARDED_EVENTS_TOTAL = METRIC_DISCARDED_EVENTS_TOTAL;
 
 const string METRIC_COMPONENT_QUEUE_FETCHED_ITEMS_TOTAL = "fetched_items_total";
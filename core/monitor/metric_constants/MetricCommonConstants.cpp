@@ -29,6 +29,8 @@ const string METRIC_OUT_EVENTS_TOTAL = "out_events_total";
 const string METRIC_OUT_EVENT_GROUPS_TOTAL = "out_event_groups_total";
 const string METRIC_OUT_ITEMS_TOTAL = "out_items_total";
 const string METRIC_OUT_SIZE_BYTES = "out_size_bytes";
+const string METRIC_LATENCY_MS = "latency_ms";
+const string METRIC_TOTAL_CPU_TIME_MS = "total_cpu_time_ms";
 const string METRIC_TOTAL_DELAY_MS = "total_delay_ms";
 const string METRIC_TOTAL_PROCESS_TIME_MS = "total_process_time_ms";
 
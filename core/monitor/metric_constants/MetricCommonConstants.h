@@ -30,6 +30,8 @@ extern const std::string METRIC_OUT_EVENTS_TOTAL;
 extern const std::string METRIC_OUT_EVENT_GROUPS_TOTAL;
 extern const std::string METRIC_OUT_ITEMS_TOTAL;
 extern const std::string METRIC_OUT_SIZE_BYTES;
+extern const std::string METRIC_LATENCY_MS;
+extern const std::string METRIC_TOTAL_CPU_TIME_MS;
 extern const std::string METRIC_TOTAL_DELAY_MS;
 extern const std::string METRIC_TOTAL_PROCESS_TIME_MS;
 
@@ -40,6 +40,11 @@ extern const std::string METRIC_AGENT_GO_ROUTINES_TOTAL;
 extern const std::string METRIC_AGENT_INSTANCE_CONFIG_TOTAL;
 extern const std::string METRIC_AGENT_MEMORY;
 extern const std::string METRIC_AGENT_MEMORY_GO;
+extern const std::string METRIC_AGENT_MEMORY_BATCHER_SIZE_BYTES;
+extern const std::string METRIC_AGENT_MEMORY_PRESSURE_LEVEL;
+extern const std::string METRIC_AGENT_MEMORY_PROCESS_QUEUE_SIZE_BYTES;
+extern const std::string METRIC_AGENT_MEMORY_SENDER_QUEUE_SIZE_BYTES;
+extern const std::string METRIC_AGENT_MEMORY_SOURCE_BUFFER_SIZE_BYTES;
 extern const std::string METRIC_AGENT_OPEN_FD_TOTAL;
 extern const std::string METRIC_AGENT_PIPELINE_CONFIG_TOTAL;
 
@@ -57,10 +62,13 @@ extern const std::string METRIC_PIPELINE_PROCESSORS_IN_EVENTS_TOTAL;
 extern const std::string METRIC_PIPELINE_PROCESSORS_IN_EVENT_GROUPS_TOTAL;
 extern const std::string METRIC_PIPELINE_PROCESSORS_IN_SIZE_BYTES;
 extern const std::string METRIC_PIPELINE_PROCESSORS_TOTAL_PROCESS_TIME_MS;
+extern const std::string METRIC_PIPELINE_PROCESSORS_TOTAL_CPU_TIME_MS;
+extern const std::string METRIC_PIPELINE_PROCESSORS_LATENCY_MS;
 extern const std::string METRIC_PIPELINE_FLUSHERS_IN_EVENTS_TOTAL;
 extern const std::string METRIC_PIPELINE_FLUSHERS_IN_EVENT_GROUPS_TOTAL;
 extern const std::string METRIC_PIPELINE_FLUSHERS_IN_SIZE_BYTES;
 extern const std::string METRIC_PIPELINE_FLUSHERS_TOTAL_PACKAGE_TIME_MS;
+extern const std::string METRIC_PIPELINE_FLUSHERS_TOTAL_CPU_TIME_MS;
 extern const std::string METRIC_PIPELINE_START_TIME;
 
 //////////////////////////////////////////////////////////////////////////
@@ -80,6 +88,7 @@ extern const std::string& METRIC_PLUGIN_OUT_EVENT_GROUPS_TOTAL;
 extern const std::string& METRIC_PLUGIN_OUT_SIZE_BYTES;
 extern const std::string& METRIC_PLUGIN_TOTAL_DELAY_MS;
 extern const std::string& METRIC_PLUGIN_TOTAL_PROCESS_TIME_MS;
+extern const std::string& METRIC_PLUGIN_TOTAL_CPU_TIME_MS;
 
 /**********************************************************
  *   input_file
@@ -190,6 +199,11 @@ extern const std::string METRIC_PLUGIN_FLUSHER_OTHER_ERROR_TOTAL;
  **********************************************************/
 extern const std::string METRIC_PLUGIN_HISTORY_FAILURE_TOTAL;
 
+/**********************************************************
+ *   processor_filter_regex_native
+ **********************************************************/
+extern const std::string METRIC_PLUGIN_DISCARDED_BEFORE_PARSE_EVENTS_TOTAL;
+
 /**********************************************************
  *   processor_split_multiline_log_string_native
  **********************************************************/
@@ -245,6 +259,7 @@ extern const std::string& METRIC_COMPONENT_OUT_ITEMS_TOTAL;
 extern const std::string& METRIC_COMPONENT_OUT_SIZE_BYTES;
 extern const std::string& METRIC_COMPONENT_TOTAL_DELAY_MS;
 extern const std::string& METRIC_COMPONENT_TOTAL_PROCESS_TIME_MS;
+extern const std::string& METRIC_COMPONENT_LATENCY_MS;
 extern const std::string& METRIC_COMPONENT_DISCARDED_ITEMS_TOTAL;
 extern const std::string& METRIC_COMPONENT_DISCARDED_SIZE_BYTES;
 
@@ -265,6 +280,8 @@ extern const std::string METRIC_COMPONENT_QUEUE_SIZE_BYTES;
 extern const std::string METRIC_COMPONENT_QUEUE_VALID_TO_PUSH_FLAG;
 extern const std::string METRIC_COMPONENT_QUEUE_EXTRA_BUFFER_SIZE;
 extern const std::string METRIC_COMPONENT_QUEUE_EXTRA_BUFFER_SIZE_BYTES;
+extern const std::string METRIC_COMPONENT_QUEUE_SPILL_BUFFER_SIZE;
+extern const std::string METRIC_COMPONENT_QUEUE_SPILL_BUFFER_SIZE_BYTES;
 extern const std::string& METRIC_COMPONENT_QUEUE_DISCARDED_EVENTS_TOTAL;
 
 extern const std::string METRIC_COMPONENT_QUEUE_FETCHED_ITEMS_TOTAL;
@@ -300,6 +317,7 @@ extern const std::string& METRIC_RUNNER_IN_ITEMS_TOTAL;
 extern const std::string METRIC_RUNNER_LAST_RUN_TIME;
 extern const std::string& METRIC_RUNNER_OUT_ITEMS_TOTAL;
 extern const std::string& METRIC_RUNNER_TOTAL_DELAY_MS;
+extern const std::string& METRIC_RUNNER_TOTAL_CPU_TIME_MS;
 extern const std::string METRIC_RUNNER_CLIENT_REGISTER_STATE;
 extern const std::string METRIC_RUNNER_CLIENT_REGISTER_RETRY_TOTAL;
 extern const std::string METRIC_RUNNER_JOBS_TOTAL;
@@ -329,6 +347,8 @@ extern const std::string METRIC_RUNNER_FILE_ENABLE_FILE_INCLUDED_BY_MULTI_CONFIG
 extern const std::string METRIC_RUNNER_FILE_POLLING_MODIFY_CACHE_SIZE;
 extern const std::string METRIC_RUNNER_FILE_POLLING_DIR_CACHE_SIZE;
 extern const std::string METRIC_RUNNER_FILE_POLLING_FILE_CACHE_SIZE;
+extern const std::string METRIC_RUNNER_FILE_POLLING_SCAN_TIME_MS;
+extern const std::string METRIC_RUNNER_FILE_POLLING_STAT_COUNT;
 
 /**********************************************************
  *   ebpf server
@@ -343,6 +363,8 @@ extern const std::string METRIC_RUNNER_EBPF_POLL_KERNEL_EVENTS_TOTAL;
 extern const std::string METRIC_RUNNER_EBPF_LOST_KERNEL_EVENTS_TOTAL;
 extern const std::string METRIC_RUNNER_EBPF_CONNECTION_CACHE_SIZE;
 extern const std::string METRIC_RUNNER_EBPF_LOST_LOG_EVENTS_TOTAL;
+extern const std::string METRIC_RUNNER_EBPF_PROTOCOL_PARSE_QUEUE_SIZE;
+extern const std::string METRIC_RUNNER_EBPF_PROTOCOL_PARSE_BACKPRESSURE_TOTAL;
 
 /**********************************************************
  *   k8s metadata
@@ -28,10 +28,13 @@ const string METRIC_PIPELINE_PROCESSORS_IN_EVENTS_TOTAL = "processor_in_events_t
 const string METRIC_PIPELINE_PROCESSORS_IN_EVENT_GROUPS_TOTAL = "processor_in_event_groups_total";
 const string METRIC_PIPELINE_PROCESSORS_IN_SIZE_BYTES = "processor_in_size_bytes";
 const string METRIC_PIPELINE_PROCESSORS_TOTAL_PROCESS_TIME_MS = "processor_total_process_time_ms";
+const string METRIC_PIPELINE_PROCESSORS_TOTAL_CPU_TIME_MS = "processor_total_cpu_time_ms";
+const string METRIC_PIPELINE_PROCESSORS_LATENCY_MS = "processor_latency_ms";
 const string METRIC_PIPELINE_FLUSHERS_IN_EVENTS_TOTAL = "flusher_in_events_total";
 const string METRIC_PIPELINE_FLUSHERS_IN_EVENT_GROUPS_TOTAL = "flusher_in_event_groups_total";
 const string METRIC_PIPELINE_FLUSHERS_IN_SIZE_BYTES = "flusher_in_size_bytes";
 const string METRIC_PIPELINE_FLUSHERS_TOTAL_PACKAGE_TIME_MS = "flusher_total_package_time_ms";
+const string METRIC_PIPELINE_FLUSHERS_TOTAL_CPU_TIME_MS = "flusher_total_cpu_time_ms";
 const string METRIC_PIPELINE_START_TIME = "start_time";
 
 } // namespace logtail
@@ -32,6 +32,7 @@ const string& METRIC_PLUGIN_OUT_EVENT_GROUPS_TOTAL = METRIC_OUT_EVENT_GROUPS_TOT
 const string& METRIC_PLUGIN_OUT_SIZE_BYTES = METRIC_OUT_SIZE_BYTES;
 const string& METRIC_PLUGIN_TOTAL_DELAY_MS = METRIC_TOTAL_DELAY_MS;
 const string& METRIC_PLUGIN_TOTAL_PROCESS_TIME_MS = METRIC_TOTAL_PROCESS_TIME_MS;
+const string& METRIC_PLUGIN_TOTAL_CPU_TIME_MS = METRIC_TOTAL_CPU_TIME_MS;
 
 /**********************************************************
  *   input_file
@@ -128,6 +129,11 @@ const string METRIC_PLUGIN_OUT_SUCCESSFUL_EVENT_GROUPS_TOTAL = "out_successful_e
  **********************************************************/
 const string METRIC_PLUGIN_HISTORY_FAILURE_TOTAL = "history_failure_total";
 
+/**********************************************************
+ *   processor_filter_regex_native
+ **********************************************************/
+const string METRIC_PLUGIN_DISCARDED_BEFORE_PARSE_EVENTS_TOTAL = "discarded_before_parse_events_total";
+
 /**********************************************************
  *   processor_split_multiline_log_string_native
  **********************************************************/
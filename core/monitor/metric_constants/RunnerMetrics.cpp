@@ -40,6 +40,7 @@ const string& METRIC_RUNNER_IN_ITEMS_TOTAL = METRIC_IN_ITEMS_TOTAL;
 const string METRIC_RUNNER_LAST_RUN_TIME = "last_run_time";
 const string& METRIC_RUNNER_OUT_ITEMS_TOTAL = METRIC_OUT_ITEMS_TOTAL;
 const string& METRIC_RUNNER_TOTAL_DELAY_MS = METRIC_TOTAL_DELAY_MS;
+const string& METRIC_RUNNER_TOTAL_CPU_TIME_MS = METRIC_TOTAL_CPU_TIME_MS;
 const string METRIC_RUNNER_CLIENT_REGISTER_STATE = "client_register_state";
 const string METRIC_RUNNER_CLIENT_REGISTER_RETRY_TOTAL = "client_register_retry_total";
 const string METRIC_RUNNER_JOBS_TOTAL = "jobs_total";
@@ -69,6 +70,8 @@ const string METRIC_RUNNER_FILE_ENABLE_FILE_INCLUDED_BY_MULTI_CONFIGS_FLAG = "en
 const string METRIC_RUNNER_FILE_POLLING_MODIFY_CACHE_SIZE = "polling_modify_cache_size";
 const string METRIC_RUNNER_FILE_POLLING_DIR_CACHE_SIZE = "polling_dir_cache_size";
 const string METRIC_RUNNER_FILE_POLLING_FILE_CACHE_SIZE = "polling_file_cache_size";
+const string METRIC_RUNNER_FILE_POLLING_SCAN_TIME_MS = "polling_scan_time_ms";
+const string METRIC_RUNNER_FILE_POLLING_STAT_COUNT = "polling_stat_count";
 
 /**********************************************************
  *   ebpf server
@@ -83,6 +86,8 @@ const string METRIC_RUNNER_EBPF_POLL_KERNEL_EVENTS_TOTAL = "poll_kernel_event_to
 const string METRIC_RUNNER_EBPF_LOST_KERNEL_EVENTS_TOTAL = "lost_kernel_event_total";
 const string METRIC_RUNNER_EBPF_CONNECTION_CACHE_SIZE = "connection_cache_size";
 const string METRIC_RUNNER_EBPF_LOST_LOG_EVENTS_TOTAL = "lost_log_event_total";
+const string METRIC_RUNNER_EBPF_PROTOCOL_PARSE_QUEUE_SIZE = "protocol_parse_queue_size";
+const string METRIC_RUNNER_EBPF_PROTOCOL_PARSE_BACKPRESSURE_TOTAL = "protocol_parse_backpressure_total";
 
 /**********************************************************
  *   k8s metadata
@@ -72,6 +72,17 @@ DoubleGaugePtr MetricsRecord::CreateDoubleGauge(const std::string& name) {
     return gaugePtr;
 }
 
+LatencyHistogramPtr MetricsRecord::CreateLatencyHistogram(const std::string& name) {
+    if (mCommitted) {
+        return nullptr;
+    }
+    std::vector<CounterPtr> buckets;
+    for (size_t i = 0; i <= LatencyHistogram::kBucketBoundsMs.size(); ++i) {
+        buckets.emplace_back(CreateCounter(LatencyHistogram::GetBucketName(name, i)));
+    }
+    return std::make_shared<LatencyHistogram>(std::move(buckets));
+}
+
 void MetricsRecord::AddLabels(MetricLabels&& labels) {
     if (mCommitted) {
         return;
@@ -124,24 +135,35 @@ const std::vector<DoubleGaugePtr>& MetricsRecord::GetDoubleGauges() const {
 }
 
 MetricsRecord* MetricsRecord::Collect() {
-    auto* metrics = new MetricsRecord(mCategory, mLabels, mDynamicLabels);
-    for (auto& item : mCounters) {
-        CounterPtr newPtr(item->Collect());
-        metrics->mCounters.emplace_back(newPtr);
+    if (!mSnapshot) {
+        // metrics cannot be added once the record is committed, so the snapshot can be preallocated
+        mSnapshot = std::make_unique<MetricsRecord>(mCategory, mLabels, mDynamicLabels);
+        for (auto& item : mCounters) {
+            mSnapshot->mCounters.emplace_back(std::make_shared<Counter>(item->GetName(), 0, 1));
+        }
+        for (auto& item : mTimeCounters) {
+            mSnapshot->mTimeCounters.emplace_back(std::make_shared<TimeCounter>(item->GetName(), 0, 1));
+        }
+        for (auto& item : mIntGauges) {
+            mSnapshot->mIntGauges.emplace_back(std::make_shared<IntGauge>(item->GetName()));
+        }
+        for (auto& item : mDoubleGauges) {
+            mSnapshot->mDoubleGauges.emplace_back(std::make_shared<Gauge<double>>(item->GetName()));
+        }
     }
-    for (auto& item : mTimeCounters) {
-        TimeCounterPtr newPtr(item->Collect());
-        metrics->mTimeCounters.emplace_back(newPtr);
+    for (size_t i = 0; i < mCounters.size(); ++i) {
+        mCounters[i]->Collect(*mSnapshot->mCounters[i]);
     }
-    for (auto& item : mIntGauges) {
-        IntGaugePtr newPtr(item->Collect());
-        metrics->mIntGauges.emplace_back(newPtr);
+    for (size_t i = 0; i < mTimeCounters.size(); ++i) {
+        mTimeCounters[i]->Collect(*mSnapshot->mTimeCounters[i]);
     }
-    for (auto& item : mDoubleGauges) {
-        DoubleGaugePtr newPtr(item->Collect());
-        metrics->mDoubleGauges.emplace_back(newPtr);
+    for (size_t i = 0; i < mIntGauges.size(); ++i) {
+        mIntGauges[i]->Collect(*mSnapshot->mIntGauges[i]);
     }
-    return metrics;
+    for (size_t i = 0; i < mDoubleGauges.size(); ++i) {
+        mDoubleGauges[i]->Collect(*mSnapshot->mDoubleGauges[i]);
+    }
+    return mSnapshot.get();
 }
 
 MetricsRecord* MetricsRecord::GetNext() const {
@@ -196,6 +218,10 @@ DoubleGaugePtr MetricsRecordRef::CreateDoubleGauge(const std::string& name) {
     return mMetrics->CreateDoubleGauge(name);
 }
 
+LatencyHistogramPtr MetricsRecordRef::CreateLatencyHistogram(const std::string& name) {
+    return mMetrics->CreateLatencyHistogram(name);
+}
+
 void MetricsRecordRef::AddLabels(MetricLabels&& labels) {
     mMetrics->AddLabels(std::move(labels));
 }
@@ -43,6 +43,8 @@ private:
     std::atomic_bool mCommitted;
     std::atomic_bool mDeleted;
     MetricsRecord* mNext = nullptr;
+    // allocated on first collection and reused afterwards
+    std::unique_ptr<MetricsRecord> mSnapshot;
 
 public:
     MetricsRecord(const std::string& category, MetricLabelsPtr labels, DynamicMetricLabelsPtr dynamicLabels = nullptr);
@@ -62,7 +64,9 @@ public:
     TimeCounterPtr CreateTimeCounter(const std::string& name);
     IntGaugePtr CreateIntGauge(const std::string& name);
     DoubleGaugePtr CreateDoubleGauge(const std::string& name);
+    LatencyHistogramPtr CreateLatencyHistogram(const std::string& name);
     void AddLabels(MetricLabels&& labels);
+    // collects the values into the snapshot owned by the record, which lives as long as the record
     MetricsRecord* Collect();
     void SetNext(MetricsRecord* next);
     MetricsRecord* GetNext() const;
@@ -91,6 +95,7 @@ public:
     TimeCounterPtr CreateTimeCounter(const std::string& name);
     IntGaugePtr CreateIntGauge(const std::string& name);
     DoubleGaugePtr CreateDoubleGauge(const std::string& name);
+    LatencyHistogramPtr CreateLatencyHistogram(const std::string& name);
     void AddLabels(MetricLabels&& labels);
     const MetricsRecord* operator->() const;
 #ifdef APSARA_UNIT_TEST_MAIN
@@ -16,8 +16,10 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <functional>
@@ -34,26 +36,69 @@ enum class MetricType {
     METRIC_TYPE_DOUBLE_GAUGE,
 };
 
+// number of shards of a counter, should be a power of 2
+constexpr size_t kMetricShardCnt = 4;
+
+// threads are spread over the shards in the order they first update a counter
+inline size_t GetMetricShardIdx() {
+    static std::atomic_size_t sNextIdx = 0;
+    thread_local size_t sIdx = sNextIdx.fetch_add(1, std::memory_order_relaxed);
+    return sIdx;
+}
+
+// Counters are updated by many threads on hot paths, so the value is split into cache line sized shards, each
+// updated by a subset of the threads, and summed on read. Snapshots taken by Collect have only one shard.
 class Counter {
 protected:
+    struct alignas(64) Shard {
+        std::atomic_uint64_t mVal = 0;
+    };
+
     std::string mName;
-    std::atomic_uint64_t mVal;
+    std::unique_ptr<Shard[]> mShards;
+    size_t mShardMask;
+
+    void Reset(uint64_t val) {
+        for (size_t i = 0; i <= mShardMask; ++i) {
+            mShards[i].mVal.store(0, std::memory_order_relaxed);
+        }
+        mShards[0].mVal.store(val, std::memory_order_relaxed);
+    }
+    uint64_t Sum() const {
+        uint64_t sum = 0;
+        for (size_t i = 0; i <= mShardMask; ++i) {
+            sum += mShards[i].mVal.load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
 
 public:
-    Counter(const std::string& name, uint64_t val = 0) : mName(name), mVal(val) {}
-    uint64_t GetValue() const { return mVal.load(); }
+    Counter(const std::string& name, uint64_t val = 0, size_t shardCnt = kMetricShardCnt)
+        : mName(name), mShards(new Shard[shardCnt]), mShardMask(shardCnt - 1) {
+        mShards[0].mVal.store(val, std::memory_order_relaxed);
+    }
+    uint64_t GetValue() const { return Sum(); }
     const std::string& GetName() const { return mName; }
-    void Add(uint64_t val) { mVal.fetch_add(val); }
-    Counter* Collect() { return new Counter(mName, mVal.exchange(0)); }
+    void Add(uint64_t val) {
+        mShards[GetMetricShardIdx() & mShardMask].mVal.fetch_add(val, std::memory_order_relaxed);
+    }
+    // moves the value accumulated since last collection into the snapshot
+    void Collect(Counter& snapshot) {
+        uint64_t sum = 0;
+        for (size_t i = 0; i <= mShardMask; ++i) {
+            sum += mShards[i].mVal.exchange(0, std::memory_order_relaxed);
+        }
+        snapshot.Reset(sum);
+    }
 };
 
 // input: nanosecond, output: milisecond
 class TimeCounter : public Counter {
 public:
-    TimeCounter(const std::string& name, uint64_t val = 0) : Counter(name, val) {}
-    uint64_t GetValue() const { return mVal.load() / 1000000; }
-    void Add(std::chrono::nanoseconds val) { mVal.fetch_add(val.count()); }
-    TimeCounter* Collect() { return new TimeCounter(mName, mVal.exchange(0)); }
+    TimeCounter(const std::string& name, uint64_t val = 0, size_t shardCnt = kMetricShardCnt)
+        : Counter(name, val, shardCnt) {}
+    uint64_t GetValue() const { return Sum() / 1000000; }
+    void Add(std::chrono::nanoseconds val) { Counter::Add(val.count()); }
 };
 
 template <typename T>
@@ -65,7 +110,7 @@ public:
     T GetValue() const { return mVal.load(); }
     const std::string& GetName() const { return mName; }
     void Set(T val) { mVal.store(val); }
-    Gauge* Collect() { return new Gauge<T>(mName, mVal.load()); }
+    void Collect(Gauge& snapshot) const { snapshot.Set(mVal.load()); }
 
 protected:
     std::string mName;
@@ -77,15 +122,43 @@ public:
     IntGauge(const std::string& name, uint64_t val = 0) : Gauge<uint64_t>(name, val) {}
     ~IntGauge() = default;
 
-    IntGauge* Collect() { return new IntGauge(mName, mVal.load()); }
     void Add(uint64_t val) { mVal.fetch_add(val); }
     void Sub(uint64_t val) { mVal.fetch_sub(val); }
 };
 
 using CounterPtr = std::shared_ptr<Counter>;
+
+// input: nanosecond
+// each bucket is exported as a counter named {name}_le_{upper bound in ms}, the last one being {name}_le_inf.
+// buckets are not cumulative.
+class LatencyHistogram {
+public:
+    static constexpr std::array<uint64_t, 10> kBucketBoundsMs = {1, 5, 10, 50, 100, 500, 1000, 5000, 10000, 60000};
+
+    static std::string GetBucketName(const std::string& name, size_t idx) {
+        return name + "_le_" + (idx < kBucketBoundsMs.size() ? std::to_string(kBucketBoundsMs[idx]) : "inf");
+    }
+
+    explicit LatencyHistogram(std::vector<CounterPtr>&& buckets) : mBuckets(std::move(buckets)) {}
+    void Observe(std::chrono::nanoseconds val) {
+        auto ms = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(val).count());
+        size_t idx = 0;
+        while (idx < kBucketBoundsMs.size() && ms > kBucketBoundsMs[idx]) {
+            ++idx;
+        }
+        if (idx < mBuckets.size() && mBuckets[idx]) {
+            mBuckets[idx]->Add(1);
+        }
+    }
+
+private:
+    std::vector<CounterPtr> mBuckets;
+};
+
 using TimeCounterPtr = std::shared_ptr<TimeCounter>;
 using IntGaugePtr = std::shared_ptr<IntGauge>;
 using DoubleGaugePtr = std::shared_ptr<Gauge<double>>;
+using LatencyHistogramPtr = std::shared_ptr<LatencyHistogram>;
 
 using MetricLabels = std::vector<std::pair<std::string, std::string>>;
 using MetricLabelsPtr = std::shared_ptr<MetricLabels>;
@@ -108,5 +181,9 @@ using DynamicMetricLabelsPtr = std::shared_ptr<DynamicMetricLabels>;
     if (gaugePtr) { \
         (gaugePtr)->Sub(value); \
     }
+#define OBSERVE_HISTOGRAM(histogramPtr, value) \
+    if (histogramPtr) { \
+        (histogramPtr)->Observe(value); \
+    }
 
 } // namespace logtail
@@ -0,0 +1,157 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "parser/DelimiterModeBitmaskParser.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+
+namespace logtail {
+
+// bit i is set if block[i] == c
+static inline uint64_t CharMask(const char* block, char c) {
+#if defined(__SSE2__)
+    __m128i target = _mm_set1_epi8(c);
+    uint64_t mask = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i * 16));
+        mask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, target))))
+            << (i * 16);
+    }
+    return mask;
+#else
+    uint64_t mask = 0;
+    for (size_t i = 0; i < 64; ++i) {
+        mask |= static_cast<uint64_t>(block[i] == c) << i;
+    }
+    return mask;
+#endif
+}
+
+// bit i is the xor of bits [0, i], i.e. set between an opening quote (included) and its closing quote (excluded)
+static inline uint64_t PrefixXor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+static inline size_t CountTrailingZeros(uint64_t x) {
+#if defined(_MSC_VER)
+    unsigned long idx = 0;
+    _BitScanForward64(&idx, x);
+    return idx;
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+static inline size_t PopCount(uint64_t x) {
+    return std::bitset<64>(x).count();
+}
+
+bool DelimiterModeBitmaskParser::ParseDelimiterLine(
+    StringView buffer, int begin, int end, std::vector<StringView>& columnValues, LogEvent& event) {
+    const char* data = buffer.data();
+    // the last partial block is copied, so that no byte beyond end is read
+    char tail[kBlockSize];
+    size_t columnBegin = begin;
+    size_t quoteCnt = 0;
+    uint64_t inQuoteCarry = 0;
+    for (size_t blockBegin = begin; blockBegin < static_cast<size_t>(end); blockBegin += kBlockSize) {
+        size_t len = std::min(kBlockSize, end - blockBegin);
+        const char* block = data + blockBegin;
+        uint64_t valid = ~0ULL;
+        if (len < kBlockSize) {
+            memcpy(tail, block, len);
+            block = tail;
+            valid = (1ULL << len) - 1;
+        }
+        uint64_t quotes = CharMask(block, mQuote) & valid;
+        uint64_t inQuote = PrefixXor(quotes) ^ inQuoteCarry;
+        inQuoteCarry = static_cast<uint64_t>(static_cast<int64_t>(inQuote) >> 63);
+        uint64_t separators = CharMask(block, mSeparator) & valid & ~inQuote;
+
+        uint64_t consumed = 0;
+        while (separators != 0) {
+            uint64_t bit = separators & (~separators + 1);
+            uint64_t before = bit - 1;
+            quoteCnt += PopCount(quotes & before & ~consumed);
+            size_t columnEnd = blockBegin + CountTrailingZeros(separators);
+            if (!AddColumn(data, columnBegin, columnEnd, quoteCnt, columnValues, event)) {
+                columnValues.clear();
+                return false;
+            }
+            columnBegin = columnEnd + 1;
+            quoteCnt = 0;
+            consumed = before | bit;
+            separators &= separators - 1;
+        }
+        quoteCnt += PopCount(quotes & ~consumed);
+    }
+    if (!AddColumn(data, columnBegin, end, quoteCnt, columnValues, event)) {
+        columnValues.clear();
+        return false;
+    }
+    return true;
+}
+
+bool DelimiterModeBitmaskParser::AddColumn(const char* buffer,
+                                           size_t begin,
+                                           size_t end,
+                                           size_t quoteCnt,
+                                           std::vector<StringView>& columnValues,
+                                           LogEvent& event) const {
+    if (quoteCnt == 0) {
+        columnValues.emplace_back(buffer + begin, end - begin);
+        return true;
+    }
+    // a quote is only allowed at both ends, or doubled in between
+    if (end - begin < 2 || buffer[begin] != mQuote || buffer[end - 1] != mQuote || quoteCnt % 2 != 0) {
+        return false;
+    }
+    ++begin;
+    --end;
+    size_t doubledCnt = (quoteCnt - 2) / 2;
+    if (doubledCnt == 0) {
+        columnValues.emplace_back(buffer + begin, end - begin);
+        return true;
+    }
+    StringBuffer sb = event.GetSourceBuffer()->AllocateStringBuffer(end - begin - doubledCnt);
+    size_t j = 0;
+    for (size_t i = begin; i < end; ++i) {
+        if (buffer[i] == mQuote) {
+            if (i + 1 == end || buffer[i + 1] != mQuote) {
+                return false;
+            }
+            ++i;
+        }
+        sb.data[j++] = buffer[i];
+    }
+    columnValues.emplace_back(sb.data, j);
+    return true;
+}
+
+} // namespace logtail
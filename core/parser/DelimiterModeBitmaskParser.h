@@ -0,0 +1,55 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <vector>
+
+#include "common/StringView.h"
+#include "models/LogEvent.h"
+
+namespace logtail {
+
+// DelimiterModeBitmaskParser accepts the same lines as DelimiterModeFsmParser with the same columns, but handles 64
+// bytes at a time instead of one: the separators and quotes of a block are turned into bitmasks, the quoted regions
+// are the prefix xor of the quote mask, and the separators out of them are the column boundaries. Each column is then
+// checked to be either unquoted or enclosed in quotes with the inner quotes doubled.
+class DelimiterModeBitmaskParser {
+public:
+    DelimiterModeBitmaskParser(char quote, char separator) : mQuote(quote), mSeparator(separator) {}
+
+    // the columns are views of buffer unless they have doubled quotes, which are unescaped into the source buffer
+    bool
+    ParseDelimiterLine(StringView buffer, int begin, int end, std::vector<StringView>& columnValues, LogEvent& event);
+
+private:
+    static constexpr size_t kBlockSize = 64;
+
+    // @param quoteCnt number of quotes in [begin, end)
+    bool AddColumn(const char* buffer,
+                   size_t begin,
+                   size_t end,
+                   size_t quoteCnt,
+                   std::vector<StringView>& columnValues,
+                   LogEvent& event) const;
+
+    const char mQuote;
+    const char mSeparator;
+};
+
+} // namespace logtail
@@ -33,4 +33,8 @@ bool FlusherBlackHole::Send(PipelineEventGroup&& g) {
     return PushToQueue(make_unique<SenderQueueItem>("", 0, this, mQueueKey));
 }
 
+bool FlusherBlackHole::SendShared(shared_ptr<PipelineEventGroup> g) {
+    return PushToQueue(make_unique<SenderQueueItem>("", 0, this, mQueueKey));
+}
+
 } // namespace logtail
@@ -27,6 +27,8 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config, Json::Value& optionalGoPipeline) override;
     bool Send(PipelineEventGroup&& g) override;
+    bool SendShared(std::shared_ptr<PipelineEventGroup> g) override;
+    bool IsSharedGroupReadOnly() const override { return true; }
     bool Flush(size_t key) override { return true; }
     bool FlushAll() override { return true; }
 };
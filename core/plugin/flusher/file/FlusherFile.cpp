@@ -71,6 +71,15 @@ bool FlusherFile::Send(PipelineEventGroup&& g) {
     return SerializeAndPush(std::move(g));
 }
 
+bool FlusherFile::SendShared(shared_ptr<PipelineEventGroup> g) {
+    // serialized straight from the shared group, so no copy is made even if other flushers still hold it
+    string serializedData;
+    string errorMsg;
+    mGroupSerializer->DoSerialize(*g, serializedData, errorMsg);
+    Write(serializedData, errorMsg);
+    return true;
+}
+
 bool FlusherFile::Flush([[maybe_unused]] size_t key) {
     return true;
 }
@@ -91,6 +100,11 @@ bool FlusherFile::SerializeAndPush(PipelineEventGroup&& group) {
         g.mSourceBuffers.emplace_back(extraSourceBuffer);
     }
     mGroupSerializer->DoSerialize(std::move(g), serializedData, errorMsg);
+    Write(serializedData, errorMsg);
+    return true;
+}
+
+void FlusherFile::Write(string& serializedData, const string& errorMsg) {
     if (errorMsg.empty()) {
         if (!serializedData.empty() && serializedData.back() == '\n') {
             serializedData.pop_back();
@@ -100,7 +114,6 @@ bool FlusherFile::SerializeAndPush(PipelineEventGroup&& group) {
     } else {
         LOG_ERROR(sLogger, ("serialize pipeline event group error", errorMsg));
     }
-    return true;
 }
 
 } // namespace logtail
@@ -35,11 +35,14 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config, Json::Value& optionalGoPipeline) override;
     bool Send(PipelineEventGroup&& g) override;
+    bool SendShared(std::shared_ptr<PipelineEventGroup> g) override;
+    bool IsSharedGroupReadOnly() const override { return true; }
     bool Flush(size_t key) override;
     bool FlushAll() override;
 
 private:
     bool SerializeAndPush(PipelineEventGroup&& group);
+    void Write(std::string& serializedData, const std::string& errorMsg);
 
     std::shared_ptr<spdlog::details::thread_pool> mThreadPool;
     std::shared_ptr<spdlog::sinks::rotating_file_sink<std::mutex>> mFileSink;
@@ -47,7 +50,7 @@ private:
     std::string mFilePath;
     uint32_t mMaxFileSize = 1024 * 1024 * 10;
     uint32_t mMaxFiles = 10;
-    std::unique_ptr<EventGroupSerializer> mGroupSerializer;
+    std::unique_ptr<JsonEventGroupSerializer> mGroupSerializer;
 
     CounterPtr mSendCnt;
 };
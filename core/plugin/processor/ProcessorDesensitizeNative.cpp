@@ -156,6 +156,13 @@ void ProcessorDesensitizeNative::Process(PipelineEventGroup& logGroup) {
     }
 }
 
+bool ProcessorDesensitizeNative::ProcessFusedEvent(PipelineEventGroup& logGroup,
+                                                   PipelineEventPtr& e,
+                                                   FusedEventCache& cache) {
+    ProcessEvent(e);
+    return true;
+}
+
 void ProcessorDesensitizeNative::ProcessEvent(PipelineEventPtr& e) {
     if (!IsSupportedEvent(e)) {
         ADD_COUNTER(mOutFailedEventsTotal, 1);
@@ -31,6 +31,8 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config) override;
     void Process(PipelineEventGroup& logGroup) override;
+    bool IsFusable() const override { return true; }
+    bool ProcessFusedEvent(PipelineEventGroup& logGroup, PipelineEventPtr& e, FusedEventCache& cache) override;
 
     // Source field name.
     std::string mSourceKey;
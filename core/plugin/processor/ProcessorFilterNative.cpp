@@ -153,6 +153,9 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                               mContext->GetRegion());
     }
 
+    mDiscardedBeforeParseEventsTotal
+        = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_DISCARDED_BEFORE_PARSE_EVENTS_TOTAL);
+
     return true;
 }
 
@@ -175,6 +178,68 @@ void ProcessorFilterNative::Process(PipelineEventGroup& logGroup) {
     events.resize(wIdx);
 }
 
+bool ProcessorFilterNative::ProcessFusedEvent(PipelineEventGroup& logGroup,
+                                              PipelineEventPtr& e,
+                                              FusedEventCache& cache) {
+    return ProcessEvent(e);
+}
+
+bool ProcessorFilterNative::InitPushdownFilter(const std::string& unescapedChars) {
+    std::vector<std::string> regexes;
+    if (mFilterMode == Mode::EXPRESSION_MODE) {
+        mConditionExp->GetRequiredRegexes(regexes);
+    } else if (mFilterMode == Mode::RULE_MODE) {
+        for (const auto& reg : mFilterRule->FilterRegs) {
+            regexes.emplace_back(reg.str());
+        }
+    }
+    mPushdownLiterals.clear();
+    for (const auto& regex : regexes) {
+        std::vector<std::string> literals;
+        GetRegexRequiredLiterals(regex, literals);
+        // the longest piece without unescaped chars is the most selective one
+        std::string longest;
+        for (const auto& literal : literals) {
+            size_t begin = 0;
+            while (begin < literal.size()) {
+                size_t end = literal.find_first_of(unescapedChars, begin);
+                if (end == std::string::npos) {
+                    end = literal.size();
+                }
+                if (end - begin > longest.size()) {
+                    longest = literal.substr(begin, end - begin);
+                }
+                begin = end + 1;
+            }
+        }
+        if (!longest.empty()) {
+            mPushdownLiterals.emplace_back(std::move(longest));
+        }
+    }
+    return !mPushdownLiterals.empty();
+}
+
+bool ProcessorFilterNative::PushdownFilterEvent(const PipelineEventPtr& e) {
+    if (!IsSupportedEvent(e)) {
+        return true;
+    }
+    const auto& sourceEvent = e.Cast<LogEvent>();
+    for (const auto& literal : mPushdownLiterals) {
+        bool found = false;
+        for (const auto& content : sourceEvent) {
+            if (content.second.find(literal) != StringView::npos) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            ADD_COUNTER(mDiscardedBeforeParseEventsTotal, 1);
+            return false;
+        }
+    }
+    return true;
+}
+
 bool ProcessorFilterNative::ProcessEvent(PipelineEventPtr& e) {
     if (!IsSupportedEvent(e)) {
         return true;
@@ -456,6 +521,13 @@ bool BinaryFilterOperatorNode::Match(const LogEvent& contents, const CollectionP
     return false;
 }
 
+void BinaryFilterOperatorNode::GetRequiredRegexes(std::vector<std::string>& regexes) const {
+    if (op == AND_OPERATOR && left && right) {
+        left->GetRequiredRegexes(regexes);
+        right->GetRequiredRegexes(regexes);
+    }
+}
+
 bool RegexFilterValueNode::Match(const LogEvent& contents, const CollectionPipelineContext& mContext) {
     const auto& content = contents.FindContent(key);
     if (content == contents.end()) {
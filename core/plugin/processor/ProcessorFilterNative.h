@@ -38,6 +38,8 @@ public:
 
 public:
     virtual bool Match(const LogEvent& contents, const CollectionPipelineContext& mContext) { return true; }
+    // collects the regexes that must all be matched for the node to be matched
+    virtual void GetRequiredRegexes(std::vector<std::string>& regexes) const {}
 
 public:
     FilterNodeType GetNodeType() const { return nodeType; }
@@ -57,6 +59,7 @@ public:
 
 public:
     virtual bool Match(const LogEvent& contents, const CollectionPipelineContext& mContext);
+    virtual void GetRequiredRegexes(std::vector<std::string>& regexes) const;
 
 private:
     FilterOperator op;
@@ -74,6 +77,7 @@ public:
 
 public:
     virtual bool Match(const LogEvent& contents, const CollectionPipelineContext& mContext);
+    virtual void GetRequiredRegexes(std::vector<std::string>& regexes) const { regexes.emplace_back(reg.str()); }
 
 private:
     std::string key;
@@ -105,6 +109,10 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config) override;
     void Process(PipelineEventGroup& logGroup) override;
+    bool IsFusable() const override { return true; }
+    bool ProcessFusedEvent(PipelineEventGroup& logGroup, PipelineEventPtr& e, FusedEventCache& cache) override;
+    bool InitPushdownFilter(const std::string& unescapedChars) override;
+    bool PushdownFilterEvent(const PipelineEventPtr& e) override;
 
     // Log field whitelist. The relationship between multiple conditions is "and". Only when all conditions are met, the
     // log will be collected.
@@ -139,6 +147,10 @@ private:
     Mode mFilterMode = Mode::BYPASS_MODE;
 
     std::shared_ptr<LogFilterRule> mFilterRule;
+    // literals required by the predicates, which can be searched in the raw contents before parsing
+    std::vector<std::string> mPushdownLiterals;
+
+    CounterPtr mDiscardedBeforeParseEventsTotal;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ProcessorFilterNativeUnittest;
@@ -105,6 +105,12 @@ void ProcessorParseApsaraNative::Process(PipelineEventGroup& logGroup) {
     return;
 }
 
+bool ProcessorParseApsaraNative::ProcessFusedEvent(PipelineEventGroup& logGroup,
+                                                   PipelineEventPtr& e,
+                                                   FusedEventCache& cache) {
+    return ProcessEvent(cache.mLogPath, e, cache.mLogTime, cache.mTimeStr, logGroup.GetAllMetadata());
+}
+
 /*
  * 处理单个日志事件。
  * @param logPath - 日志文件的路径。
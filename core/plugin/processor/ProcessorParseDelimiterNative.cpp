@@ -106,7 +106,7 @@ bool ProcessorParseDelimiterNative::Init(const Json::Value& config) {
                              mContext->GetRegion());
     }
 
-    mDelimiterModeFsmParserPtr.reset(new DelimiterModeFsmParser(mQuote, mSeparatorChar));
+    mDelimiterModeParserPtr.reset(new DelimiterModeBitmaskParser(mQuote, mSeparatorChar));
 
     // Keys
     if (!GetMandatoryListParam(config, "Keys", mKeys, errorMsg)) {
@@ -203,6 +203,18 @@ void ProcessorParseDelimiterNative::Process(PipelineEventGroup& logGroup) {
     return;
 }
 
+bool ProcessorParseDelimiterNative::ProcessFusedEvent(PipelineEventGroup& logGroup,
+                                                      PipelineEventPtr& e,
+                                                      FusedEventCache& cache) {
+    return ProcessEvent(cache.mLogPath, e, logGroup.GetAllMetadata());
+}
+
+bool ProcessorParseDelimiterNative::KeepsContentSubstrings(std::string& unescapedChars) const {
+    // doubled quotes in a quoted field are unescaped
+    unescapedChars.push_back(mQuote);
+    return true;
+}
+
 bool ProcessorParseDelimiterNative::ProcessEvent(const StringView& logPath,
                                                  PipelineEventPtr& e,
                                                  const GroupMetadata& metadata) {
@@ -253,7 +265,7 @@ bool ProcessorParseDelimiterNative::ProcessEvent(const StringView& logPath,
         if (useQuote) {
             columnValues.reserve(reserveSize);
             parseSuccess
-                = mDelimiterModeFsmParserPtr->ParseDelimiterLine(buffer, begIdx, endIdx, columnValues, sourceEvent);
+                = mDelimiterModeParserPtr->ParseDelimiterLine(buffer, begIdx, endIdx, columnValues, sourceEvent);
             // handle auto extend
             if (!(mOverflowedFieldsTreatment == OverflowedFieldsTreatment::EXTEND)
                 && columnValues.size() > mKeys.size()) {
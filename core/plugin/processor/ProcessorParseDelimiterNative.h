@@ -20,7 +20,7 @@
 
 #include "collection_pipeline/plugin/interface/Processor.h"
 #include "models/LogEvent.h"
-#include "parser/DelimiterModeFsmParser.h"
+#include "parser/DelimiterModeBitmaskParser.h"
 #include "plugin/processor/CommonParserOptions.h"
 
 namespace logtail {
@@ -34,6 +34,9 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config) override;
     void Process(PipelineEventGroup& logGroup) override;
+    bool IsFusable() const override { return true; }
+    bool ProcessFusedEvent(PipelineEventGroup& logGroup, PipelineEventPtr& e, FusedEventCache& cache) override;
+    bool KeepsContentSubstrings(std::string& unescapedChars) const override;
 
     // Required: source field name.
     std::string mSourceKey;
@@ -72,7 +75,7 @@ private:
 
     char mSeparatorChar;
     bool mSourceKeyOverwritten = false;
-    std::unique_ptr<DelimiterModeFsmParser> mDelimiterModeFsmParserPtr;
+    std::unique_ptr<DelimiterModeBitmaskParser> mDelimiterModeParserPtr;
 
     CounterPtr mDiscardedEventsTotal;
     CounterPtr mOutFailedEventsTotal;
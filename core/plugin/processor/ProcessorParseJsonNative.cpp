@@ -102,6 +102,12 @@ void ProcessorParseJsonNative::Process(PipelineEventGroup& logGroup) {
     events.resize(wIdx);
 }
 
+bool ProcessorParseJsonNative::ProcessFusedEvent(PipelineEventGroup& logGroup,
+                                                 PipelineEventPtr& e,
+                                                 FusedEventCache& cache) {
+    return ProcessEvent(cache.mLogPath, e, logGroup.GetAllMetadata());
+}
+
 bool ProcessorParseJsonNative::ProcessEvent(const StringView& logPath,
                                             PipelineEventPtr& e,
                                             const GroupMetadata& metadata) {
@@ -125,6 +125,12 @@ void ProcessorParseRegexNative::Process(PipelineEventGroup& logGroup) {
     return;
 }
 
+bool ProcessorParseRegexNative::ProcessFusedEvent(PipelineEventGroup& logGroup,
+                                                  PipelineEventPtr& e,
+                                                  FusedEventCache& cache) {
+    return ProcessEvent(cache.mLogPath, e, logGroup.GetAllMetadata());
+}
+
 bool ProcessorParseRegexNative::IsSupportedEvent(const PipelineEventPtr& e) const {
     return e.Is<LogEvent>();
 }
@@ -87,6 +87,11 @@ bool ProcessorParseTimestampNative::Init(const Json::Value& config) {
                               mContext->GetRegion());
     }
 
+    mTimeFormat = TimeFormat(mSourceFormat);
+    const char* nanosecondPos = strstr(mSourceFormat.c_str(), "%f");
+    mHaveNanosecond = nanosecondPos != nullptr;
+    mEndWithNanosecond = nanosecondPos == mSourceFormat.c_str() + mSourceFormat.size() - 2;
+
     mDiscardedEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_DISCARDED_EVENTS_TOTAL);
     mOutFailedEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_FAILED_EVENTS_TOTAL);
     mOutKeyNotFoundEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_KEY_NOT_FOUND_EVENTS_TOTAL);
@@ -118,6 +123,15 @@ void ProcessorParseTimestampNative::Process(PipelineEventGroup& logGroup) {
     return;
 }
 
+bool ProcessorParseTimestampNative::ProcessFusedEvent(PipelineEventGroup& logGroup,
+                                                      PipelineEventPtr& e,
+                                                      FusedEventCache& cache) {
+    if (mSourceFormat.empty() || mSourceKey.empty()) {
+        return true;
+    }
+    return ProcessEvent(cache.mLogPath, e, cache.mLogTime, cache.mTimeStr);
+}
+
 bool ProcessorParseTimestampNative::IsSupportedEvent(const PipelineEventPtr& e) const {
     return e.Is<LogEvent>();
 }
@@ -176,6 +190,11 @@ bool ProcessorParseTimestampNative::ProcessEvent(StringView logPath,
     return true;
 }
 
+bool ProcessorParseTimestampNative::KeepsContentSubstrings(std::string& unescapedChars) const {
+    // only the timestamp of the event is set, since the precise timestamp key is not supported any more
+    return true;
+}
+
 bool ProcessorParseTimestampNative::ParseLogTime(const StringView& curTimeStr, // str to parse
                                                  const StringView& logPath,
                                                  LogtailTime& logTime,
@@ -185,21 +204,19 @@ bool ProcessorParseTimestampNative::ParseLogTime(const StringView& curTimeStr, /
     // Second-level cache only work when:
     // 1. No %f in the time format
     // 2. The %f is at the end of the time format
-    const char* compareResult = strstr(mSourceFormat.c_str(), "%f");
-    bool haveNanosecond = compareResult != nullptr;
-    bool endWithNanosecond = compareResult == (mSourceFormat.c_str() + mSourceFormat.size() - 2);
     int nanosecondLength = -1;
     const char* strptimeResult = NULL;
-    if ((!haveNanosecond || endWithNanosecond) && IsPrefixString(curTimeStr, timeStrCache)) {
+    if ((!mHaveNanosecond || mEndWithNanosecond) && IsPrefixString(curTimeStr, timeStrCache)) {
         bool isTimestampNanosecond = (mSourceFormat == "%s") && (curTimeStr.length() > timeStrCache.length());
-        if (endWithNanosecond || isTimestampNanosecond) {
+        if (mEndWithNanosecond || isTimestampNanosecond) {
             strptimeResult = Strptime(curTimeStr.data() + timeStrCache.length(), "%f", &logTime, nanosecondLength);
         } else {
             strptimeResult = curTimeStr.data() + timeStrCache.length();
             logTime.tv_nsec = 0;
         }
     } else {
-        strptimeResult = Strptime(curTimeStr.data(), mSourceFormat.c_str(), &logTime, nanosecondLength, mSourceYear);
+        strptimeResult
+            = mTimeFormat.Parse(curTimeStr.data(), curTimeStr.size(), &logTime, nanosecondLength, mSourceYear);
         if (NULL != strptimeResult) {
             timeStrCache = curTimeStr.substr(0, curTimeStr.length() - nanosecondLength);
             logTime.tv_sec = logTime.tv_sec - mLogTimeZoneOffsetSecond;
@@ -27,6 +27,9 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config) override;
     void Process(PipelineEventGroup& logGroup) override;
+    bool IsFusable() const override { return true; }
+    bool ProcessFusedEvent(PipelineEventGroup& logGroup, PipelineEventPtr& e, FusedEventCache& cache) override;
+    bool KeepsContentSubstrings(std::string& unescapedChars) const override;
 
     // Source field name.
     std::string mSourceKey;
@@ -52,6 +55,10 @@ private:
     bool IsPrefixString(const StringView& all, const StringView& prefix);
 
     int32_t mLogTimeZoneOffsetSecond = 0;
+    // compiled from mSourceFormat at Init
+    TimeFormat mTimeFormat;
+    bool mHaveNanosecond = false;
+    bool mEndWithNanosecond = false;
 
     CounterPtr mDiscardedEventsTotal;
     CounterPtr mOutFailedEventsTotal;
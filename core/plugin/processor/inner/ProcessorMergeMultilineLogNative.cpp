@@ -217,20 +217,16 @@ void ProcessorMergeMultilineLogNative::MergeLogsByRegex(PipelineEventGroup& logG
         StringView sourceVal = sourceEvent->GetContent(mSourceKey);
         if (!isPartialLog) {
             // it is impossible to enter this state if only end pattern is given
-            boost::regex regex;
-            if (mMultiline.GetStartPatternReg() != nullptr) {
-                regex = *mMultiline.GetStartPatternReg();
-            } else {
-                regex = *mMultiline.GetContinuePatternReg();
-            }
-            if (BoostRegexSearch(sourceVal.data(), sourceVal.size(), regex, exception)) {
+            const MultilinePattern& pattern = mMultiline.GetStartPatternReg() != nullptr
+                ? *mMultiline.GetStartPatternReg()
+                : *mMultiline.GetContinuePatternReg();
+            if (pattern.Match(sourceVal.data(), sourceVal.size(), exception)) {
                 events.emplace_back(sourceEvent);
                 begin = cur;
                 isPartialLog = true;
             } else if (mMultiline.GetEndPatternReg() != nullptr && mMultiline.GetStartPatternReg() == nullptr
                        && mMultiline.GetContinuePatternReg() != nullptr
-                       && BoostRegexSearch(
-                           sourceVal.data(), sourceVal.size(), *mMultiline.GetEndPatternReg(), exception)) {
+                       && mMultiline.GetEndPatternReg()->Match(sourceVal.data(), sourceVal.size(), exception)) {
                 // case: continue + end
                 // current line is matched against the end pattern rather than the continue pattern
                 begin = cur;
@@ -242,8 +238,7 @@ void ProcessorMergeMultilineLogNative::MergeLogsByRegex(PipelineEventGroup& logG
         } else {
             // case: start + continue or continue + end
             if (mMultiline.GetContinuePatternReg() != nullptr
-                && BoostRegexSearch(
-                    sourceVal.data(), sourceVal.size(), *mMultiline.GetContinuePatternReg(), exception)) {
+                && mMultiline.GetContinuePatternReg()->Match(sourceVal.data(), sourceVal.size(), exception)) {
                 events.emplace_back(sourceEvent);
                 continue;
             }
@@ -253,8 +248,7 @@ void ProcessorMergeMultilineLogNative::MergeLogsByRegex(PipelineEventGroup& logG
                 if (mMultiline.GetContinuePatternReg() != nullptr) {
                     // current line is not matched against the continue pattern, so the end pattern will decide if
                     // the current log is a match or not
-                    if (BoostRegexSearch(
-                            sourceVal.data(), sourceVal.size(), *mMultiline.GetEndPatternReg(), exception)) {
+                    if (mMultiline.GetEndPatternReg()->Match(sourceVal.data(), sourceVal.size(), exception)) {
                         MergeEvents(events, true);
                         sourceEvents[newSize++] = std::move(sourceEvents[begin]);
                     } else {
@@ -264,8 +258,7 @@ void ProcessorMergeMultilineLogNative::MergeLogsByRegex(PipelineEventGroup& logG
                     isPartialLog = false;
                 } else {
                     // case: start + end or end
-                    if (BoostRegexSearch(
-                            sourceVal.data(), sourceVal.size(), *mMultiline.GetEndPatternReg(), exception)) {
+                    if (mMultiline.GetEndPatternReg()->Match(sourceVal.data(), sourceVal.size(), exception)) {
                         MergeEvents(events, true);
                         sourceEvents[newSize++] = std::move(sourceEvents[begin]);
                         if (mMultiline.GetStartPatternReg() != nullptr) {
@@ -281,8 +274,7 @@ void ProcessorMergeMultilineLogNative::MergeLogsByRegex(PipelineEventGroup& logG
             } else {
                 if (mMultiline.GetContinuePatternReg() == nullptr) {
                     // case: start
-                    if (!BoostRegexSearch(
-                            sourceVal.data(), sourceVal.size(), *mMultiline.GetStartPatternReg(), exception)) {
+                    if (!mMultiline.GetStartPatternReg()->Match(sourceVal.data(), sourceVal.size(), exception)) {
                         events.emplace_back(sourceEvent);
                     } else {
                         MergeEvents(events, true);
@@ -295,8 +287,7 @@ void ProcessorMergeMultilineLogNative::MergeLogsByRegex(PipelineEventGroup& logG
                     // continue pattern is given, but current line is not matched against the continue pattern
                     MergeEvents(events, true);
                     sourceEvents[newSize++] = std::move(sourceEvents[begin]);
-                    if (!BoostRegexSearch(
-                            sourceVal.data(), sourceVal.size(), *mMultiline.GetStartPatternReg(), exception)) {
+                    if (!mMultiline.GetStartPatternReg()->Match(sourceVal.data(), sourceVal.size(), exception)) {
                         // when no end pattern is given, the only chance to enter unmatched state is when both start
                         // and continue pattern are given, and the current line is not matched against the start
                         // pattern
@@ -82,6 +82,13 @@ void ProcessorSplitLogStringNative::Process(PipelineEventGroup& logGroup) {
     logGroup.SwapEvents(newEvents);
 }
 
+void ProcessorSplitLogStringNative::SplitFusedEvent(PipelineEventGroup& logGroup,
+                                                    PipelineEventPtr&& e,
+                                                    EventsContainer& newEvents,
+                                                    FusedEventCache& cache) {
+    ProcessEvent(logGroup, std::move(e), newEvents);
+}
+
 bool ProcessorSplitLogStringNative::IsSupportedEvent(const PipelineEventPtr& e) const {
     if (e.Is<LogEvent>()) {
         return true;
@@ -36,6 +36,11 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config) override;
     void Process(PipelineEventGroup& logGroup) override;
+    bool IsFusableSplitter() const override { return true; }
+    void SplitFusedEvent(PipelineEventGroup& logGroup,
+                         PipelineEventPtr&& e,
+                         EventsContainer& newEvents,
+                         FusedEventCache& cache) override;
 
 protected:
     bool IsSupportedEvent(const PipelineEventPtr& e) const override;
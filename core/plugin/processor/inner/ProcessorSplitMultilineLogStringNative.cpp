@@ -108,6 +108,17 @@ void ProcessorSplitMultilineLogStringNative::Process(PipelineEventGroup& logGrou
     logGroup.SwapEvents(newEvents);
 }
 
+void ProcessorSplitMultilineLogStringNative::SplitFusedEvent(PipelineEventGroup& logGroup,
+                                                             PipelineEventPtr&& e,
+                                                             EventsContainer& newEvents,
+                                                             FusedEventCache& cache) {
+    int inputLines = 0;
+    int unmatchLines = 0;
+    ProcessEvent(logGroup, cache.mLogPath, std::move(e), newEvents, &inputLines, &unmatchLines);
+    ADD_COUNTER(mMatchedLinesTotal, inputLines - unmatchLines);
+    ADD_COUNTER(mUnmatchedLinesTotal, unmatchLines);
+}
+
 bool ProcessorSplitMultilineLogStringNative::IsSupportedEvent(const PipelineEventPtr& e) const {
     if (e.Is<LogEvent>()) {
         return true;
@@ -175,17 +186,12 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
         ++(*inputLines);
         if (!isPartialLog) {
             // it is impossible to enter this state if only end pattern is given
-            boost::regex regex;
-            if (HasStartPattern()) {
-                regex = GetStartPatternReg();
-            } else {
-                regex = GetContinuePatternReg();
-            }
-            if (BoostRegexSearch(content.data(), content.size(), regex, exception)) {
+            const MultilinePattern& pattern = HasStartPattern() ? GetStartPatternReg() : GetContinuePatternReg();
+            if (pattern.Match(content.data(), content.size(), exception)) {
                 multiStartIndex = content.data();
                 isPartialLog = true;
             } else if (HasEndPattern() && !HasStartPattern() && HasContinuePattern()
-                       && BoostRegexSearch(content.data(), content.size(), GetEndPatternReg(), exception)) {
+                       && GetEndPatternReg().Match(content.data(), content.size(), exception)) {
                 // case: continue + end
                 CreateNewEvent(content, isLastLog, sourceKey, sourceEvent, logGroup, newEvents);
                 multiStartIndex = content.data() + content.size() + 1;
@@ -197,7 +203,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
         } else {
             // case: start + continue or continue + end
             if (HasContinuePattern()
-                && BoostRegexSearch(content.data(), content.size(), GetContinuePatternReg(), exception)) {
+                && GetContinuePatternReg().Match(content.data(), content.size(), exception)) {
                 begin += content.size() + 1;
                 continue;
             }
@@ -206,7 +212,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                 if (HasContinuePattern()) {
                     // current line is not matched against the continue pattern, so the end pattern will decide
                     // if the current log is a match or not
-                    if (BoostRegexSearch(content.data(), content.size(), GetEndPatternReg(), exception)) {
+                    if (GetEndPatternReg().Match(content.data(), content.size(), exception)) {
                         CreateNewEvent(StringView(multiStartIndex, content.data() + content.size() - multiStartIndex),
                                        isLastLog,
                                        sourceKey,
@@ -228,7 +234,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                     isPartialLog = false;
                 } else {
                     // case: start + end or end
-                    if (BoostRegexSearch(content.data(), content.size(), GetEndPatternReg(), exception)) {
+                    if (GetEndPatternReg().Match(content.data(), content.size(), exception)) {
                         CreateNewEvent(StringView(multiStartIndex, content.data() + content.size() - multiStartIndex),
                                        isLastLog,
                                        sourceKey,
@@ -249,7 +255,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
             } else {
                 if (!HasContinuePattern()) {
                     // case: start
-                    if (BoostRegexSearch(content.data(), content.size(), GetStartPatternReg(), exception)) {
+                    if (GetStartPatternReg().Match(content.data(), content.size(), exception)) {
                         CreateNewEvent(StringView(multiStartIndex, content.data() - 1 - multiStartIndex),
                                        isLastLog,
                                        sourceKey,
@@ -269,7 +275,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                                    logGroup,
                                    newEvents);
                     ADD_COUNTER(mMatchedEventsTotal, 1);
-                    if (!BoostRegexSearch(content.data(), content.size(), GetStartPatternReg(), exception)) {
+                    if (!GetStartPatternReg().Match(content.data(), content.size(), exception)) {
                         // when no end pattern is given, the only chance to enter unmatched state is when both
                         // start and continue pattern are given, and the current line is not matched against the
                         // start pattern
@@ -392,15 +398,15 @@ StringView ProcessorSplitMultilineLogStringNative::GetNextLine(StringView log, s
     return StringView(log.data() + begin, log.size() - begin);
 }
 
-const boost::regex& ProcessorSplitMultilineLogStringNative::GetStartPatternReg() const {
+const MultilinePattern& ProcessorSplitMultilineLogStringNative::GetStartPatternReg() const {
     return mStartPatternReg[ProcessorRunner::GetThreadNo()];
 }
 
-const boost::regex& ProcessorSplitMultilineLogStringNative::GetContinuePatternReg() const {
+const MultilinePattern& ProcessorSplitMultilineLogStringNative::GetContinuePatternReg() const {
     return mContinuePatternReg[ProcessorRunner::GetThreadNo()];
 }
 
-const boost::regex& ProcessorSplitMultilineLogStringNative::GetEndPatternReg() const {
+const MultilinePattern& ProcessorSplitMultilineLogStringNative::GetEndPatternReg() const {
     return mEndPatternReg[ProcessorRunner::GetThreadNo()];
 }
 
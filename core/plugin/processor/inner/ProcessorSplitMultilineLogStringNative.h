@@ -38,6 +38,11 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config) override;
     void Process(PipelineEventGroup& logGroup) override;
+    bool IsFusableSplitter() const override { return true; }
+    void SplitFusedEvent(PipelineEventGroup& logGroup,
+                         PipelineEventPtr&& e,
+                         EventsContainer& newEvents,
+                         FusedEventCache& cache) override;
 
 protected:
     bool IsSupportedEvent(const PipelineEventPtr& e) const override;
@@ -68,15 +73,15 @@ private:
     bool HasStartPattern() const { return !mStartPatternReg.empty(); }
     bool HasContinuePattern() const { return !mContinuePatternReg.empty(); }
     bool HasEndPattern() const { return !mEndPatternReg.empty(); }
-    const boost::regex& GetStartPatternReg() const;
-    const boost::regex& GetContinuePatternReg() const;
-    const boost::regex& GetEndPatternReg() const;
+    const MultilinePattern& GetStartPatternReg() const;
+    const MultilinePattern& GetContinuePatternReg() const;
+    const MultilinePattern& GetEndPatternReg() const;
 
     // boost::regex object shared by multi-thread leads to performance degradation. Therefore, each thread should be
     // allocated a different copy.
-    std::vector<boost::regex> mStartPatternReg;
-    std::vector<boost::regex> mContinuePatternReg;
-    std::vector<boost::regex> mEndPatternReg;
+    std::vector<MultilinePattern> mStartPatternReg;
+    std::vector<MultilinePattern> mContinuePatternReg;
+    std::vector<MultilinePattern> mEndPatternReg;
 
     CounterPtr mMatchedEventsTotal;
     CounterPtr mMatchedLinesTotal;
@@ -23,8 +23,11 @@
 #include <string>
 #include <utility>
 
+#include "app_config/AppConfig.h"
+#include "collection_pipeline/limiter/InputFlowController.h"
 #include "collection_pipeline/queue/ProcessQueueManager.h"
 #include "collection_pipeline/queue/QueueKey.h"
+#include "collection_pipeline/queue/QueueKeyManager.h"
 #include "common/StringTools.h"
 #include "common/TimeUtil.h"
 #include "common/http/Constant.h"
@@ -105,6 +108,10 @@ void ScrapeScheduler::OnMetricResult(HttpResponse& response, uint64_t) {
     streamScraper->SetAutoMetricMeta(scrapeDurationSeconds, upState, scrapeState);
     streamScraper->SendMetrics();
     mScrapeResponseSizeBytes = streamScraper->mRawSize;
+    if (AppConfig::GetInstance()->IsInputFlowControl()) {
+        InputFlowController::GetInstance()->ConsumeBytes(QueueKeyManager::GetInstance()->GetName(mQueueKey),
+                                                         streamScraper->mRawSize);
+    }
     streamScraper->Reset();
 
     ADD_COUNTER(mPluginTotalDelayMs, scrapeDurationMilliSeconds);
@@ -142,7 +149,12 @@ void ScrapeScheduler::ScheduleNext() {
         return true;
     });
     isContextValidFuture->AddDoneCallback([this]() -> bool {
-        if (ProcessQueueManager::GetInstance()->IsValidToPush(mQueueKey)) {
+        if (ProcessQueueManager::GetInstance()->IsValidToPush(mQueueKey)
+            && (!AppConfig::GetInstance()->IsInputFlowControl()
+                || InputFlowController::GetInstance()
+                        ->GetWaitTime(QueueKeyManager::GetInstance()->GetName(mQueueKey))
+                        .count()
+                    <= 0)) {
             return true;
         }
         this->DelayExecTime(1);
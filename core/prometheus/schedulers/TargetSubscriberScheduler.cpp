@@ -16,11 +16,18 @@
 
 #include "prometheus/schedulers/TargetSubscriberScheduler.h"
 
+#include <xxhash/xxhash.h>
+
 #include <cstdlib>
 
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
+
+#include "rapidjson/reader.h"
 
 #include "AppConfig.h"
 #include "SelfMonitorMetricEvent.h"
@@ -42,6 +49,183 @@ using namespace std;
 
 namespace logtail {
 
+namespace {
+
+struct RawTargetGroup {
+    std::vector<std::string> mTargets;
+    std::vector<std::pair<std::string, std::string>> mLabels;
+};
+
+// TargetGroupReader consumes the target document through rapidjson's SAX interface, so the whole list is never
+// materialized as a DOM. Each target group is handed to the callback as soon as its object is closed.
+class TargetGroupReader : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, TargetGroupReader> {
+public:
+    explicit TargetGroupReader(std::function<void(const RawTargetGroup&)> onGroup) : mOnGroup(std::move(onGroup)) {}
+
+    bool Null() { return Scalar(string(), false); }
+    bool Bool(bool b) { return Scalar(b ? "true" : "false", false); }
+    bool RawNumber(const char* str, rapidjson::SizeType len, bool) { return Scalar(string(str, len), false); }
+    bool String(const char* str, rapidjson::SizeType len, bool) { return Scalar(string(str, len), true); }
+
+    bool Key(const char* str, rapidjson::SizeType len, bool) {
+        if (mState == State::GROUP || mState == State::LABELS) {
+            mKey.assign(str, len);
+        }
+        return true;
+    }
+
+    bool StartObject() {
+        switch (mState) {
+            case State::GROUPS:
+                mGroup.mTargets.clear();
+                mGroup.mLabels.clear();
+                mState = State::GROUP;
+                return true;
+            case State::GROUP:
+                if (mKey == prometheus::LABELS) {
+                    mGroup.mLabels.clear();
+                    mState = State::LABELS;
+                } else {
+                    StartSkip();
+                }
+                return true;
+            case State::SKIP:
+                ++mSkipDepth;
+                return true;
+            default:
+                return Fail();
+        }
+    }
+
+    bool EndObject(rapidjson::SizeType) {
+        switch (mState) {
+            case State::GROUP:
+                mOnGroup(mGroup);
+                mState = State::GROUPS;
+                return true;
+            case State::LABELS:
+                mState = State::GROUP;
+                return true;
+            case State::SKIP:
+                EndSkip();
+                return true;
+            default:
+                return Fail();
+        }
+    }
+
+    bool StartArray() {
+        switch (mState) {
+            case State::ROOT:
+                mState = State::GROUPS;
+                return true;
+            case State::GROUP:
+                if (mKey == prometheus::TARGETS) {
+                    mGroup.mTargets.clear();
+                    mState = State::TARGETS;
+                } else {
+                    StartSkip();
+                }
+                return true;
+            case State::SKIP:
+                ++mSkipDepth;
+                return true;
+            default:
+                return Fail();
+        }
+    }
+
+    bool EndArray(rapidjson::SizeType) {
+        switch (mState) {
+            case State::GROUPS:
+                mState = State::DONE;
+                return true;
+            case State::TARGETS:
+                mState = State::GROUP;
+                return true;
+            case State::SKIP:
+                EndSkip();
+                return true;
+            default:
+                return Fail();
+        }
+    }
+
+    bool IsDone() const { return mState == State::DONE; }
+    const string& GetErrorMsg() const { return mErrorMsg; }
+
+private:
+    enum class State { ROOT, GROUPS, GROUP, TARGETS, LABELS, SKIP, DONE };
+
+    bool Scalar(string&& value, bool isString) {
+        switch (mState) {
+            case State::GROUP:
+                // same as a non-array targets or non-object labels member: ignored
+                if (mKey == prometheus::TARGETS) {
+                    mGroup.mTargets.clear();
+                } else if (mKey == prometheus::LABELS) {
+                    mGroup.mLabels.clear();
+                }
+                return true;
+            case State::TARGETS:
+                if (!isString) {
+                    mErrorMsg = "Invalid target item found";
+                    return false;
+                }
+                mGroup.mTargets.push_back(std::move(value));
+                return true;
+            case State::LABELS:
+                mGroup.mLabels.emplace_back(mKey, std::move(value));
+                return true;
+            case State::SKIP:
+                return true;
+            default:
+                return Fail();
+        }
+    }
+
+    void StartSkip() {
+        mState = State::SKIP;
+        mSkipDepth = 1;
+    }
+
+    void EndSkip() {
+        if (--mSkipDepth == 0) {
+            mState = State::GROUP;
+        }
+    }
+
+    bool Fail() {
+        switch (mState) {
+            case State::ROOT:
+                mErrorMsg = "Failed to parse JSON: root is not an array";
+                break;
+            case State::GROUPS:
+                mErrorMsg = "Invalid target group item found";
+                break;
+            case State::TARGETS:
+                mErrorMsg = "Invalid target item found";
+                break;
+            case State::LABELS:
+                mErrorMsg = "Invalid label value found";
+                break;
+            default:
+                mErrorMsg = "Unexpected JSON token";
+                break;
+        }
+        return false;
+    }
+
+    std::function<void(const RawTargetGroup&)> mOnGroup;
+    State mState = State::ROOT;
+    RawTargetGroup mGroup;
+    string mKey;
+    size_t mSkipDepth = 0;
+    string mErrorMsg;
+};
+
+} // namespace
+
 std::chrono::steady_clock::time_point TargetSubscriberScheduler::mLastUpdateTime = std::chrono::steady_clock::now();
 uint64_t TargetSubscriberScheduler::sDelaySeconds = 0;
 TargetSubscriberScheduler::TargetSubscriberScheduler()
@@ -79,6 +263,11 @@ void TargetSubscriberScheduler::OnSubscription(HttpResponse& response, uint64_t
         mETag = response.GetHeader().at(prometheus::ETAG);
     }
     const string& content = *response.GetBody<string>();
+    // the operator may not honour If-None-Match, so an unchanged document is detected by its content hash as well
+    auto contentHash = XXH64(content.data(), content.size(), 0);
+    if (contentHash == mTargetsContentHash) {
+        return;
+    }
     vector<PromTargetInfo> targetGroup;
     if (!ParseScrapeSchedulerGroup(content, targetGroup)) {
         return;
@@ -86,6 +275,7 @@ void TargetSubscriberScheduler::OnSubscription(HttpResponse& response, uint64_t
     std::unordered_map<std::string, std::shared_ptr<ScrapeScheduler>> newScrapeSchedulerSet
         = BuildScrapeSchedulerSet(targetGroup);
     UpdateScrapeScheduler(newScrapeSchedulerSet);
+    mTargetsContentHash = contentHash;
     SET_GAUGE(mPromSubscriberTargets, mScrapeSchedulerMap.size());
     ADD_COUNTER(mTotalDelayMs, GetCurrentTimeInMilliSeconds() - timestampMilliSec);
 }
@@ -144,51 +334,21 @@ void TargetSubscriberScheduler::UpdateScrapeScheduler(
 
 bool TargetSubscriberScheduler::ParseScrapeSchedulerGroup(const std::string& content,
                                                           std::vector<PromTargetInfo>& scrapeSchedulerGroup) {
-    string errs;
-    Json::Value root;
-    if (!ParseJsonTable(content, root, errs) || !root.isArray()) {
-        LOG_ERROR(sLogger,
-                  ("http service discovery from operator failed", "Failed to parse JSON: " + errs)("job", mJobName));
-        return false;
-    }
-    for (const auto& element : root) {
-        if (!element.isObject()) {
-            LOG_ERROR(
-                sLogger,
-                ("http service discovery from operator failed", "Invalid target group item found")("job", mJobName));
-            return false;
-        }
-
-        // Parse targets
-        vector<string> targets;
-        if (element.isMember(prometheus::TARGETS) && element[prometheus::TARGETS].isArray()) {
-            for (const auto& target : element[prometheus::TARGETS]) {
-                if (target.isString()) {
-                    targets.push_back(target.asString());
-                } else {
-                    LOG_ERROR(
-                        sLogger,
-                        ("http service discovery from operator failed", "Invalid target item found")("job", mJobName));
-                    return false;
-                }
-            }
-        }
-        if (targets.empty()) {
-            continue;
+    auto onGroup = [this, &scrapeSchedulerGroup](const RawTargetGroup& group) {
+        if (group.mTargets.empty()) {
+            return;
         }
         PromTargetInfo targetInfo;
         // Parse labels https://www.robustperception.io/life-of-a-label/
         Labels labels;
-        if (element.isMember(prometheus::LABELS) && element[prometheus::LABELS].isObject()) {
-            for (const string& labelKey : element[prometheus::LABELS].getMemberNames()) {
-                labels.Set(labelKey, element[prometheus::LABELS][labelKey].asString());
-            }
+        for (const auto& [k, v] : group.mLabels) {
+            labels.Set(k, v);
         }
         std::ostringstream rawHashStream;
         rawHashStream << std::setw(16) << std::setfill('0') << std::hex << labels.Hash();
         string rawAddress = labels.Get(prometheus::ADDRESS_LABEL_NAME);
         targetInfo.mHash = mScrapeConfigPtr->mJobName + rawAddress + rawHashStream.str();
-        targetInfo.mInstance = targets[0];
+        targetInfo.mInstance = group.mTargets[0];
 
         for (const auto& pair : mScrapeConfigPtr->mParams) {
             if (!pair.second.empty()) {
@@ -196,10 +356,8 @@ bool TargetSubscriberScheduler::ParseScrapeSchedulerGroup(const std::string& con
             }
         }
 
-        if (element.isMember(prometheus::LABELS) && element[prometheus::LABELS].isObject()) {
-            for (const string& labelKey : element[prometheus::LABELS].getMemberNames()) {
-                labels.Set(labelKey, element[prometheus::LABELS][labelKey].asString());
-            }
+        for (const auto& [k, v] : group.mLabels) {
+            labels.Set(k, v);
         }
         if (labels.Get(prometheus::JOB).empty()) {
             labels.Set(prometheus::JOB, mJobName);
@@ -211,11 +369,35 @@ bool TargetSubscriberScheduler::ParseScrapeSchedulerGroup(const std::string& con
             labels.Set(prometheus::METRICS_PATH_LABEL_NAME, mScrapeConfigPtr->mMetricsPath);
         }
         if (labels.Get(prometheus::ADDRESS_LABEL_NAME).empty()) {
-            continue;
+            return;
         }
 
-        targetInfo.mLabels = labels;
-        scrapeSchedulerGroup.push_back(targetInfo);
+        targetInfo.mLabels = std::move(labels);
+        scrapeSchedulerGroup.push_back(std::move(targetInfo));
+    };
+
+    TargetGroupReader handler(onGroup);
+    rapidjson::Reader reader;
+    rapidjson::StringStream stream(content.c_str());
+    reader.Parse<rapidjson::kParseNumbersAsStringsFlag | rapidjson::kParseTrailingCommasFlag
+                 | rapidjson::kParseCommentsFlag>(stream, handler);
+    if (reader.HasParseError()) {
+        if (!handler.GetErrorMsg().empty()) {
+            LOG_ERROR(sLogger,
+                      ("http service discovery from operator failed", handler.GetErrorMsg())("job", mJobName));
+        } else {
+            LOG_ERROR(sLogger,
+                      ("http service discovery from operator failed",
+                       "Failed to parse JSON")("rapidjson error", reader.GetParseErrorCode())(
+                          "rapidjson offset", reader.GetErrorOffset())("job", mJobName));
+        }
+        return false;
+    }
+    if (!handler.IsDone()) {
+        LOG_ERROR(sLogger,
+                  ("http service discovery from operator failed", "Failed to parse JSON: root is not an array")(
+                      "job", mJobName));
+        return false;
     }
     return true;
 }
@@ -224,6 +406,16 @@ std::unordered_map<std::string, std::shared_ptr<ScrapeScheduler>>
 TargetSubscriberScheduler::BuildScrapeSchedulerSet(std::vector<PromTargetInfo>& targetGroups) {
     std::unordered_map<std::string, std::shared_ptr<ScrapeScheduler>> scrapeSchedulerMap;
     for (auto& targetInfo : targetGroups) {
+        // the target id is derived from the raw labels and relabel configs never change for a job, so a known target
+        // keeps its running scheduler (and its scrape caches) without being rebuilt
+        {
+            ReadLock lock(mRWLock);
+            auto iter = mScrapeSchedulerMap.find(targetInfo.mHash);
+            if (iter != mScrapeSchedulerMap.end()) {
+                scrapeSchedulerMap[targetInfo.mHash] = iter->second;
+                continue;
+            }
+        }
         // Relabel Config
         auto& resultLabel = targetInfo.mLabels;
         if (!mScrapeConfigPtr->mRelabelConfigs.Process(resultLabel)) {
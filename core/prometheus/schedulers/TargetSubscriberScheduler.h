@@ -83,6 +83,7 @@ private:
     std::string mJobName;
 
     std::string mETag;
+    uint64_t mTargetsContentHash = 0;
 
     // self monitor
     std::shared_ptr<PromSelfMonitorUnsafe> mSelfMonitor;
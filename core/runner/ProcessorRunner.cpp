@@ -14,10 +14,14 @@
 
 #include "runner/ProcessorRunner.h"
 
+#include <algorithm>
+
 #include "app_config/AppConfig.h"
 #include "batch/TimeoutFlushManager.h"
 #include "collection_pipeline/CollectionPipelineManager.h"
+#include "collection_pipeline/limiter/InputFlowController.h"
 #include "common/Flags.h"
+#include "common/TimeUtil.h"
 #include "go_pipeline/LogtailPlugin.h"
 #include "models/EventPool.h"
 #include "monitor/AlarmManager.h"
@@ -39,6 +43,7 @@ thread_local MetricsRecordRef ProcessorRunner::sMetricsRecordRef;
 thread_local CounterPtr ProcessorRunner::sInGroupsCnt;
 thread_local CounterPtr ProcessorRunner::sInEventsCnt;
 thread_local CounterPtr ProcessorRunner::sInGroupDataSizeBytes;
+thread_local TimeCounterPtr ProcessorRunner::sTotalCpuTimeMs;
 thread_local IntGaugePtr ProcessorRunner::sLastRunTime;
 
 ProcessorRunner::ProcessorRunner()
@@ -86,6 +91,67 @@ bool ProcessorRunner::PushQueue(QueueKey key, size_t inputIndex, PipelineEventGr
     return false;
 }
 
+void ProcessorRunner::RunTasks(vector<function<void()>>&& tasks) {
+    auto batch = make_shared<TaskBatch>(std::move(tasks));
+    {
+        lock_guard<mutex> lock(mTaskBatchMux);
+        mTaskBatches.push_back(batch);
+    }
+    // wake up an idle thread, which wakes up the next one if tasks are still left, see StealTask
+    ProcessQueueManager::GetInstance()->Trigger();
+    while (batch->RunNext()) {
+    }
+    {
+        lock_guard<mutex> lock(mTaskBatchMux);
+        mTaskBatches.erase(find(mTaskBatches.begin(), mTaskBatches.end(), batch));
+    }
+    batch->WaitAllDone();
+}
+
+bool ProcessorRunner::StealTask() {
+    shared_ptr<TaskBatch> batch;
+    {
+        lock_guard<mutex> lock(mTaskBatchMux);
+        auto it = find_if(mTaskBatches.begin(), mTaskBatches.end(), [](const shared_ptr<TaskBatch>& item) {
+            return item->HasPendingTask();
+        });
+        if (it == mTaskBatches.end()) {
+            return false;
+        }
+        batch = *it;
+    }
+    if (batch->HasPendingTask()) {
+        ProcessQueueManager::GetInstance()->Trigger();
+    }
+    auto cpuTimeNs = GetThreadCpuTimeNs();
+    bool res = batch->RunNext();
+    // the pipeline metrics are charged by the caller of RunTasks, which knows the pipeline
+    chrono::nanoseconds cpuTime(GetThreadCpuTimeNs() - cpuTimeNs);
+    ADD_COUNTER(sTotalCpuTimeMs, cpuTime);
+    if (AppConfig::GetInstance()->IsInputFlowControl()) {
+        InputFlowController::GetInstance()->AddProcessorCpuTime(cpuTime);
+    }
+    return res;
+}
+
+bool ProcessorRunner::TaskBatch::RunNext() {
+    size_t idx = mNext.fetch_add(1, memory_order_relaxed);
+    if (idx >= mTasks.size()) {
+        return false;
+    }
+    mTasks[idx]();
+    lock_guard<mutex> lock(mMux);
+    if (++mDoneCnt == mTasks.size()) {
+        mCond.notify_all();
+    }
+    return true;
+}
+
+void ProcessorRunner::TaskBatch::WaitAllDone() {
+    unique_lock<mutex> lock(mMux);
+    mCond.wait(lock, [this]() { return mDoneCnt == mTasks.size(); });
+}
+
 void ProcessorRunner::Run(uint32_t threadNo) {
     LOG_INFO(sLogger, ("processor runner", "started")("thread no", threadNo));
 
@@ -99,6 +165,7 @@ void ProcessorRunner::Run(uint32_t threadNo) {
     sInGroupsCnt = sMetricsRecordRef.CreateCounter(METRIC_RUNNER_IN_EVENT_GROUPS_TOTAL);
     sInEventsCnt = sMetricsRecordRef.CreateCounter(METRIC_RUNNER_IN_EVENTS_TOTAL);
     sInGroupDataSizeBytes = sMetricsRecordRef.CreateCounter(METRIC_RUNNER_IN_SIZE_BYTES);
+    sTotalCpuTimeMs = sMetricsRecordRef.CreateTimeCounter(METRIC_RUNNER_TOTAL_CPU_TIME_MS);
     sLastRunTime = sMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_LAST_RUN_TIME);
     WriteMetrics::GetInstance()->CommitMetricsRecordRef(sMetricsRecordRef);
 
@@ -114,6 +181,9 @@ void ProcessorRunner::Run(uint32_t threadNo) {
         unique_ptr<ProcessQueueItem> item;
         string configName;
         if (!ProcessQueueManager::GetInstance()->PopItem(threadNo, item, configName)) {
+            if (StealTask()) {
+                continue;
+            }
             if (mIsFlush && ProcessQueueManager::GetInstance()->IsAllQueueEmpty()) {
                 break;
             }
@@ -135,6 +205,11 @@ void ProcessorRunner::Run(uint32_t threadNo) {
         }
 
         bool isLog = !item->mEventGroup.GetEvents().empty() && item->mEventGroup.GetEvents()[0].Is<LogEvent>();
+        bool isFlowControl = AppConfig::GetInstance()->IsInputFlowControl();
+        if (isFlowControl) {
+            InputFlowController::GetInstance()->ConsumeEvents(configName, item->mEventGroup.GetEvents().size());
+        }
+        auto cpuTimeNs = GetThreadCpuTimeNs();
 
         vector<PipelineEventGroup> eventGroupList;
         eventGroupList.emplace_back(std::move(item->mEventGroup));
@@ -177,6 +252,11 @@ void ProcessorRunner::Run(uint32_t threadNo) {
             pipeline->Send(std::move(eventGroupList));
         }
         pipeline->SubInProcessCnt();
+        chrono::nanoseconds cpuTime(GetThreadCpuTimeNs() - cpuTimeNs);
+        ADD_COUNTER(sTotalCpuTimeMs, cpuTime);
+        if (isFlowControl) {
+            InputFlowController::GetInstance()->AddProcessorCpuTime(cpuTime);
+        }
 
         gThreadedEventPool.CheckGC();
     }
@@ -19,7 +19,12 @@
 #include <cstdint>
 
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <future>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -45,11 +50,35 @@ public:
 
     bool PushQueue(QueueKey key, size_t inputIndex, PipelineEventGroup&& group, uint32_t retryTimes = 1);
 
+    // Runs the tasks on the calling thread, while the idle processor threads steal the ones not started yet, and
+    // returns when all of them are done. Tasks must not run tasks themselves.
+    void RunTasks(std::vector<std::function<void()>>&& tasks);
+    uint32_t GetThreadCount() const { return mThreadCount; }
+
 private:
+    class TaskBatch {
+    public:
+        explicit TaskBatch(std::vector<std::function<void()>>&& tasks) : mTasks(std::move(tasks)) {}
+
+        /// @return false if all the tasks have been taken
+        bool RunNext();
+        bool HasPendingTask() const { return mNext.load(std::memory_order_relaxed) < mTasks.size(); }
+        void WaitAllDone();
+
+    private:
+        std::vector<std::function<void()>> mTasks;
+        std::atomic_size_t mNext = 0;
+        size_t mDoneCnt = 0;
+        std::mutex mMux;
+        std::condition_variable mCond;
+    };
+
     ProcessorRunner();
     ~ProcessorRunner() = default;
 
     void Run(uint32_t threadNo);
+    /// @return true if a task of another thread has been run
+    bool StealTask();
 
     bool Serialize(const PipelineEventGroup& group,
                    bool enableNanosecond,
@@ -61,13 +90,21 @@ private:
     std::vector<std::future<void>> mThreadRes;
     std::atomic_bool mIsFlush = false;
 
+    std::mutex mTaskBatchMux;
+    std::deque<std::shared_ptr<TaskBatch>> mTaskBatches;
+
     thread_local static uint32_t sThreadNo;
 
     thread_local static MetricsRecordRef sMetricsRecordRef;
     thread_local static CounterPtr sInGroupsCnt;
     thread_local static CounterPtr sInEventsCnt;
     thread_local static CounterPtr sInGroupDataSizeBytes;
+    thread_local static TimeCounterPtr sTotalCpuTimeMs;
     thread_local static IntGaugePtr sLastRunTime;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class FusedProcessorChainUnittest;
+#endif
 };
 
 } // namespace logtail
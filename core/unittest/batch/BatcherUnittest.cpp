@@ -655,6 +655,32 @@ void BatcherUnittest::TestMetric() {
         APSARA_TEST_EQUAL(1U, batch.mBufferedEventsTotal->GetValue());
         APSARA_TEST_EQUAL(batchSize, batch.mBufferedDataSizeByte->GetValue());
     }
+    {
+        DefaultFlushStrategyOptions strategy;
+        strategy.mMinCnt = 2;
+        strategy.mMinSizeBytes = 1000;
+        strategy.mTimeoutSecs = 3;
+
+        Batcher<> batch;
+        batch.Init(Json::Value(), sFlusher.get(), strategy, false);
+
+        vector<BatchedEventsList> res;
+        batch.Add(CreateEventGroup(1), res);
+        this_thread::sleep_for(chrono::milliseconds(20));
+        batch.FlushAll(res);
+        map<string, uint64_t> buckets;
+        for (const auto& counter : batch.mMetricsRecordRef->GetCounters()) {
+            buckets[counter->GetName()] = counter->GetValue();
+        }
+        uint64_t total = 0;
+        for (size_t i = 0; i <= LatencyHistogram::kBucketBoundsMs.size(); ++i) {
+            total += buckets[LatencyHistogram::GetBucketName(METRIC_COMPONENT_LATENCY_MS, i)];
+        }
+        APSARA_TEST_EQUAL(1U, total);
+        // 20ms must not be rounded down to zero
+        APSARA_TEST_EQUAL(0U, buckets[LatencyHistogram::GetBucketName(METRIC_COMPONENT_LATENCY_MS, 0)]);
+        APSARA_TEST_EQUAL(0U, buckets[LatencyHistogram::GetBucketName(METRIC_COMPONENT_LATENCY_MS, 1)]);
+    }
 }
 
 PipelineEventGroup BatcherUnittest::CreateEventGroup(size_t cnt) {
@@ -26,6 +26,7 @@ namespace logtail {
 class EventFlushStrategyUnittest : public ::testing::Test {
 public:
     void TestNeedFlush();
+    void TestNeedFlushUnderMemoryPressure();
 
 protected:
     void SetUp() override {
@@ -34,6 +35,7 @@ protected:
         mStrategy.SetMinSizeBytes(100);
         mStrategy.SetTimeoutSecs(3);
     }
+    void TearDown() override { MemoryAccountant::GetInstance()->SetPressureLevel(MemoryPressureLevel::NORMAL); }
 
 private:
     EventFlushStrategy<EventBatchStatus> mStrategy;
@@ -72,7 +74,26 @@ void EventFlushStrategyUnittest::TestNeedFlush() {
     APSARA_TEST_TRUE(mStrategy.SizeReachingUpperLimit(status));
 }
 
+void EventFlushStrategyUnittest::TestNeedFlushUnderMemoryPressure() {
+    mStrategy.SetMinCnt(100);
+    mStrategy.SetMinSizeBytes(1000);
+    EventBatchStatus status;
+    status.mCnt = 30;
+    status.mSizeBytes = 300;
+    APSARA_TEST_FALSE(mStrategy.NeedFlushByCnt(status));
+    APSARA_TEST_FALSE(mStrategy.NeedFlushBySize(status));
+
+    MemoryAccountant::GetInstance()->SetPressureLevel(MemoryPressureLevel::SHRINK_BATCH);
+    APSARA_TEST_TRUE(mStrategy.NeedFlushByCnt(status));
+    APSARA_TEST_TRUE(mStrategy.NeedFlushBySize(status));
+
+    // no count limit is never turned into one
+    mStrategy.SetMinCnt(0);
+    APSARA_TEST_FALSE(mStrategy.NeedFlushByCnt(status));
+}
+
 UNIT_TEST_CASE(EventFlushStrategyUnittest, TestNeedFlush)
+UNIT_TEST_CASE(EventFlushStrategyUnittest, TestNeedFlushUnderMemoryPressure)
 
 class GroupFlushStrategyUnittest : public ::testing::Test {
 public:
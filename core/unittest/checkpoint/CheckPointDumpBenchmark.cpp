@@ -0,0 +1,119 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "app_config/AppConfig.h"
+#include "common/FileSystemUtil.h"
+#include "common/Flags.h"
+#include "file_server/checkpoint/CheckPointManager.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_BOOL(enable_checkpoint_journal);
+
+using namespace std;
+
+namespace logtail {
+
+class CheckPointDumpBenchmark : public testing::Test {
+public:
+    void TestDumpAndLoad_100000();
+
+protected:
+    void SetUp() override {
+        mRootDir = (bfs::path(GetProcessExecutionDir()) / "CheckPointDumpBenchmark").string();
+        bfs::remove_all(mRootDir);
+        bfs::create_directories(mRootDir);
+        AppConfig::GetInstance()->mCheckPointFilePath = (bfs::path(mRootDir) / "checkpoint").string();
+    }
+
+    void TearDown() override {
+        CheckPointManager::Instance()->RemoveAllCheckPoint();
+        CheckPointManager::Instance()->RemoveLocalCheckPoint();
+        BOOL_FLAG(enable_checkpoint_journal) = true;
+        bfs::remove_all(mRootDir);
+    }
+
+private:
+    // every 1 out of movedEvery checkpoints has moved on since the last dump
+    static void addCheckPoints(size_t cnt, size_t movedEvery, int64_t movedOffset) {
+        auto* manager = CheckPointManager::Instance();
+        for (size_t i = 0; i < cnt; ++i) {
+            string fileName = "/var/log/app_" + to_string(i / 100) + "/access_" + to_string(i) + ".log";
+            int64_t offset = movedEvery > 0 && i % movedEvery == 0 ? movedOffset : 1024;
+            manager->AddCheckPoint(new CheckPoint(fileName,
+                                                  offset,
+                                                  1024,
+                                                  i,
+                                                  DevInode(1, i + 1),
+                                                  "config_" + to_string(i % 10),
+                                                  fileName,
+                                                  false,
+                                                  false,
+                                                  "",
+                                                  false));
+        }
+    }
+
+    static double elapsedMs(chrono::steady_clock::time_point start) {
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    }
+
+    string mRootDir;
+};
+
+void CheckPointDumpBenchmark::TestDumpAndLoad_100000() {
+    const size_t kCheckPointCnt = 100000;
+    auto* manager = CheckPointManager::Instance();
+    for (bool journal : {false, true}) {
+        BOOL_FLAG(enable_checkpoint_journal) = journal;
+        const string& checkPointFile = AppConfig::GetInstance()->GetCheckPointFilePath();
+        const string dumpFile = journal ? checkPointFile + ".journal" : checkPointFile;
+
+        addCheckPoints(kCheckPointCnt, 0, 0);
+        auto start = chrono::steady_clock::now();
+        APSARA_TEST_TRUE(manager->DumpCheckPointToLocal());
+        auto fullDumpMs = elapsedMs(start);
+        manager->RemoveAllCheckPoint();
+
+        // 1% of the files are still being read
+        addCheckPoints(kCheckPointCnt, 100, 2048);
+        auto size = bfs::file_size(dumpFile);
+        start = chrono::steady_clock::now();
+        APSARA_TEST_TRUE(manager->DumpCheckPointToLocal());
+        auto dumpMs = elapsedMs(start);
+        auto writtenSize = journal ? bfs::file_size(dumpFile) - size : bfs::file_size(dumpFile);
+        manager->RemoveAllCheckPoint();
+
+        start = chrono::steady_clock::now();
+        manager->LoadCheckPoint();
+        auto loadMs = elapsedMs(start);
+        APSARA_TEST_EQUAL(kCheckPointCnt, manager->GetAllFileCheckPoint().size());
+        manager->RemoveAllCheckPoint();
+
+        cout << (journal ? "journal" : "json") << " full dump: " << fullDumpMs << "ms, dump with 1% changed: " << dumpMs
+             << "ms, " << writtenSize << " bytes written, load: " << loadMs << "ms" << endl;
+        manager->RemoveLocalCheckPoint();
+    }
+    // json full dump: 1.9s, dump with 1% changed: 3.0s, 45MB written, load: 1.8s in release mode
+    // journal full dump: 0.2s, dump with 1% changed: 0.15s, 137KB written, load: 0.13s in release mode
+}
+
+UNIT_TEST_CASE(CheckPointDumpBenchmark, TestDumpAndLoad_100000)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,200 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+#include "xxhash/xxhash.h"
+
+#include "common/Flags.h"
+#include "file_server/checkpoint/CheckPointJournal.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(checkpoint_journal_compact_ratio);
+
+using namespace std;
+
+namespace logtail {
+
+static const filesystem::path kJournalDir = "./checkpoint_journal_test";
+
+class CheckPointJournalUnittest : public testing::Test {
+public:
+    void TestDumpAndLoad();
+    void TestIncrementalDump();
+    void TestTornTail();
+    void TestCompact();
+
+protected:
+    void SetUp() override {
+        filesystem::remove_all(kJournalDir);
+        filesystem::create_directories(kJournalDir);
+    }
+    void TearDown() override { filesystem::remove_all(kJournalDir); }
+
+private:
+    static string journalPath() { return (kJournalDir / "checkpoint.journal").string(); }
+
+    static unordered_map<string, string> load(uint32_t* version = nullptr) {
+        CheckPointJournal journal(journalPath());
+        unordered_map<string, string> records;
+        uint32_t loadVersion = 0;
+        APSARA_TEST_TRUE(journal.Load(records, loadVersion));
+        if (version != nullptr) {
+            *version = loadVersion;
+        }
+        return records;
+    }
+};
+
+void CheckPointJournalUnittest::TestDumpAndLoad() {
+    unordered_map<string, string> records;
+    uint32_t version = 0;
+    {
+        CheckPointJournal journal(journalPath());
+        APSARA_TEST_FALSE(journal.Load(records, version));
+        records = {{"a", "1"}, {"b", string("2\0x", 3)}, {"c", ""}};
+        APSARA_TEST_TRUE(journal.Dump(records, 200));
+    }
+    APSARA_TEST_TRUE(records == load(&version));
+    APSARA_TEST_EQUAL(200U, version);
+
+    // not a journal
+    ofstream(journalPath(), ios::trunc) << "{\"check_point\": {}}";
+    CheckPointJournal journal(journalPath());
+    APSARA_TEST_FALSE(journal.Load(records, version));
+}
+
+void CheckPointJournalUnittest::TestIncrementalDump() {
+    unordered_map<string, string> records = {{"a", "1"}, {"b", "2"}, {"c", "3"}};
+    CheckPointJournal journal(journalPath());
+    APSARA_TEST_TRUE(journal.Dump(records, 200));
+    auto size = journal.GetFileSize();
+    APSARA_TEST_EQUAL(size, filesystem::file_size(journalPath()));
+
+    // nothing is written if nothing changes
+    APSARA_TEST_TRUE(journal.Dump(records, 200));
+    APSARA_TEST_EQUAL(size, journal.GetFileSize());
+
+    // only the changed one is appended
+    records["b"] = "22";
+    APSARA_TEST_TRUE(journal.Dump(records, 200));
+    auto deltaSize = journal.GetFileSize() - size;
+    APSARA_TEST_TRUE(deltaSize < 32U);
+    APSARA_TEST_TRUE(records == load());
+
+    records.erase("a");
+    records["d"] = "4";
+    APSARA_TEST_TRUE(journal.Dump(records, 200));
+    APSARA_TEST_EQUAL(journal.GetFileSize(), filesystem::file_size(journalPath()));
+    APSARA_TEST_TRUE(records == load());
+
+    // deltas go on after reload
+    CheckPointJournal reloaded(journalPath());
+    unordered_map<string, string> loaded;
+    uint32_t version = 0;
+    APSARA_TEST_TRUE(reloaded.Load(loaded, version));
+    size = reloaded.GetFileSize();
+    APSARA_TEST_TRUE(reloaded.Dump(records, 200));
+    APSARA_TEST_EQUAL(size, reloaded.GetFileSize());
+    records.clear();
+    APSARA_TEST_TRUE(reloaded.Dump(records, 200));
+    APSARA_TEST_TRUE(reloaded.GetFileSize() > size);
+    APSARA_TEST_TRUE(load().empty());
+
+    // a new version starts over with a new file
+    records["e"] = "5";
+    APSARA_TEST_TRUE(reloaded.Dump(records, 300));
+    APSARA_TEST_TRUE(reloaded.GetFileSize() < size);
+    APSARA_TEST_TRUE(records == load(&version));
+    APSARA_TEST_EQUAL(300U, version);
+}
+
+void CheckPointJournalUnittest::TestTornTail() {
+    unordered_map<string, string> records = {{"a", "1"}, {"b", "2"}};
+    CheckPointJournal journal(journalPath());
+    APSARA_TEST_TRUE(journal.Dump(records, 200));
+    auto validSize = journal.GetFileSize();
+    auto expected = records;
+    records["a"] = "11";
+    records["c"] = "3";
+    APSARA_TEST_TRUE(journal.Dump(records, 200));
+
+    // the batch torn by a crash is dropped as a whole
+    filesystem::resize_file(journalPath(), journal.GetFileSize() - 1);
+    CheckPointJournal reloaded(journalPath());
+    unordered_map<string, string> loaded;
+    uint32_t version = 0;
+    APSARA_TEST_TRUE(reloaded.Load(loaded, version));
+    APSARA_TEST_TRUE(expected == loaded);
+    APSARA_TEST_EQUAL(validSize, reloaded.GetFileSize());
+    APSARA_TEST_EQUAL(validSize, filesystem::file_size(journalPath()));
+
+    // and is written again on next dump
+    APSARA_TEST_TRUE(reloaded.Dump(records, 200));
+    APSARA_TEST_TRUE(records == load());
+
+    // corrupted
+    {
+        fstream fout(journalPath(), ios::in | ios::out | ios::binary);
+        fout.seekp(validSize + 20);
+        fout.put('x');
+    }
+    APSARA_TEST_TRUE(expected == load());
+
+    // a batch of unknown type, though intact
+    {
+        const char payload[] = {2};
+        uint32_t header[3] = {0x434b5054, sizeof(payload), XXH32(payload, sizeof(payload), 0)};
+        fstream fout(journalPath(), ios::in | ios::out | ios::binary | ios::app);
+        fout.write(reinterpret_cast<const char*>(header), sizeof(header));
+        fout.write(payload, sizeof(payload));
+    }
+    APSARA_TEST_TRUE(expected == load());
+    APSARA_TEST_EQUAL(validSize, filesystem::file_size(journalPath()));
+}
+
+void CheckPointJournalUnittest::TestCompact() {
+    INT32_FLAG(checkpoint_journal_compact_ratio) = 2;
+    unordered_map<string, string> records = {{"a", string(512 * 1024, 'a')}, {"b", "2"}};
+    CheckPointJournal journal(journalPath());
+    APSARA_TEST_TRUE(journal.Dump(records, 200));
+    auto size = journal.GetFileSize();
+    records["a"] = string(512 * 1024, 'b');
+    APSARA_TEST_TRUE(journal.Dump(records, 200));
+    records["a"] = string(512 * 1024, 'c');
+    APSARA_TEST_TRUE(journal.Dump(records, 200));
+    APSARA_TEST_TRUE(journal.GetFileSize() > 2 * size);
+    APSARA_TEST_TRUE(records == load());
+
+    // the file would be bigger than twice of the compaction threshold, i.e., 1MB
+    records["a"] = string(512 * 1024, 'd');
+    APSARA_TEST_TRUE(journal.Dump(records, 200));
+    APSARA_TEST_EQUAL(size, journal.GetFileSize());
+    APSARA_TEST_EQUAL(size, filesystem::file_size(journalPath()));
+    APSARA_TEST_FALSE(filesystem::exists(journalPath() + ".tmp"));
+    APSARA_TEST_TRUE(records == load());
+    INT32_FLAG(checkpoint_journal_compact_ratio) = 4;
+}
+
+UNIT_TEST_CASE(CheckPointJournalUnittest, TestDumpAndLoad)
+UNIT_TEST_CASE(CheckPointJournalUnittest, TestIncrementalDump)
+UNIT_TEST_CASE(CheckPointJournalUnittest, TestTornTail)
+UNIT_TEST_CASE(CheckPointJournalUnittest, TestCompact)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -18,6 +18,8 @@
 #include "unittest/Unittest.h"
 
 DECLARE_FLAG_INT32(checkpoint_find_max_file_count);
+DECLARE_FLAG_INT32(check_point_version);
+DECLARE_FLAG_BOOL(enable_checkpoint_journal);
 
 namespace logtail {
 
@@ -35,9 +37,19 @@ public:
     static void TearDownTestCase() { bfs::remove_all(kTestRootDir); }
 
     void TestSearchFilePathByDevInodeInDirectory();
+    void TestDumpAndLoadJournal();
+
+private:
+    static CheckPoint* createCheckPoint(const std::string& fileName, uint64_t inode, int64_t offset) {
+        return new CheckPoint(
+            fileName, offset, 1024, 12345, DevInode(1, inode), "config", fileName + ".real", true, false, "id", false);
+    }
 };
 
 UNIT_TEST_CASE(CheckpointManagerUnittest, TestSearchFilePathByDevInodeInDirectory);
+#if defined(__linux__)
+UNIT_TEST_CASE(CheckpointManagerUnittest, TestDumpAndLoadJournal);
+#endif
 
 void CheckpointManagerUnittest::TestSearchFilePathByDevInodeInDirectory() {
     const std::string kRotateFileName = "test.log.5";
@@ -96,6 +108,74 @@ void CheckpointManagerUnittest::TestSearchFilePathByDevInodeInDirectory() {
     }
 }
 
+void CheckpointManagerUnittest::TestDumpAndLoadJournal() {
+    auto* manager = CheckPointManager::Instance();
+    const auto checkPointFile = (bfs::path(kTestRootDir) / "checkpoint").string();
+    const auto journalFile = checkPointFile + ".journal";
+    AppConfig::GetInstance()->mCheckPointFilePath = checkPointFile;
+
+    // migrate from the json file
+    BOOL_FLAG(enable_checkpoint_journal) = false;
+    manager->AddCheckPoint(createCheckPoint("/var/log/a.log", 2, 100));
+    manager->AddDirCheckPoint("/var/log/app");
+    EXPECT_TRUE(manager->DumpCheckPointToLocal());
+    EXPECT_TRUE(bfs::exists(checkPointFile));
+    EXPECT_FALSE(bfs::exists(journalFile));
+    manager->RemoveAllCheckPoint();
+
+    BOOL_FLAG(enable_checkpoint_journal) = true;
+    manager->LoadCheckPoint();
+    EXPECT_EQ(1U, manager->GetAllFileCheckPoint().size());
+    EXPECT_TRUE(manager->DumpCheckPointToLocal());
+    EXPECT_FALSE(bfs::exists(checkPointFile));
+    EXPECT_TRUE(bfs::exists(journalFile));
+    manager->RemoveAllCheckPoint();
+
+    manager->LoadCheckPoint();
+    EXPECT_EQ(INT32_FLAG(check_point_version), manager->mLoadVersion);
+    EXPECT_EQ(1, manager->GetReaderCount());
+    CheckPointPtr ptr;
+    EXPECT_TRUE(manager->GetCheckPoint(DevInode(1, 2), "config", ptr));
+    EXPECT_EQ("/var/log/a.log", ptr->mFileName);
+    EXPECT_EQ("/var/log/a.log.real", ptr->mRealFileName);
+    EXPECT_EQ(100, ptr->mOffset);
+    EXPECT_EQ(1024U, ptr->mSignatureSize);
+    EXPECT_EQ(12345U, ptr->mSignatureHash);
+    EXPECT_TRUE(ptr->mFileOpenFlag);
+    EXPECT_FALSE(ptr->mContainerStopped);
+    EXPECT_EQ("id", ptr->mContainerID);
+    DirCheckPointPtr dirPtr;
+    EXPECT_TRUE(manager->GetDirCheckPoint("/var/log", dirPtr));
+    EXPECT_EQ(1U, dirPtr->mSubDir.count("/var/log/app"));
+
+    // the readers add their checkpoints again before each dump, and only the changed ones are appended
+    auto size = bfs::file_size(journalFile);
+    manager->RemoveAllCheckPoint();
+    manager->AddCheckPoint(createCheckPoint("/var/log/a.log", 2, 200));
+    manager->AddCheckPoint(createCheckPoint("/var/log/b.log", 3, 0));
+    EXPECT_TRUE(manager->DumpCheckPointToLocal());
+    EXPECT_GT(bfs::file_size(journalFile), size);
+    manager->RemoveAllCheckPoint();
+    manager->LoadCheckPoint();
+    EXPECT_EQ(2U, manager->GetAllFileCheckPoint().size());
+    EXPECT_TRUE(manager->GetCheckPoint(DevInode(1, 2), "config", ptr));
+    EXPECT_EQ(200, ptr->mOffset);
+    EXPECT_FALSE(manager->GetDirCheckPoint("/var/log", dirPtr));
+
+    // back to the json file
+    BOOL_FLAG(enable_checkpoint_journal) = false;
+    EXPECT_TRUE(manager->DumpCheckPointToLocal());
+    EXPECT_TRUE(bfs::exists(checkPointFile));
+    EXPECT_FALSE(bfs::exists(journalFile));
+    manager->RemoveAllCheckPoint();
+    manager->LoadCheckPoint();
+    EXPECT_EQ(2U, manager->GetAllFileCheckPoint().size());
+
+    BOOL_FLAG(enable_checkpoint_journal) = true;
+    manager->RemoveAllCheckPoint();
+    manager->RemoveLocalCheckPoint();
+}
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
@@ -0,0 +1,231 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "common/DNSCache.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class DnsCacheUnittest : public ::testing::Test {
+public:
+    void TestResolveAsync();
+    void TestNegativeCache();
+    void TestTtl();
+    void TestCollectRefreshHosts();
+    void TestStop();
+
+protected:
+    // a stub resolver, which maps each host to the address set, or fails if it is empty
+    void SetStubResolver(DnsCache& cache) {
+        cache.mResolver = [this](const string& host, string& ip, int32_t& ttlSec) {
+            ++mResolveCnt;
+            if (mBlocker.valid()) {
+                mBlocker.wait();
+            }
+            if (mAddress.empty()) {
+                return false;
+            }
+            ip = mAddress;
+            if (mTtl > 0) {
+                ttlSec = mTtl;
+            }
+            return true;
+        };
+    }
+
+    // a stub clock, which can be moved forward by mTimeOffset
+    void SetStubClock(DnsCache& cache) {
+        cache.mClock = [this]() { return static_cast<int32_t>(time(NULL)) + mTimeOffset.load(); };
+    }
+
+    bool WaitForResolved(DnsCache& cache, const string& host, string& address) {
+        for (size_t i = 0; i < 200; ++i) {
+            bool resolved = false;
+            {
+                lock_guard<mutex> lock(cache.mMux);
+                resolved = cache.mPendingHosts.empty() && atomic_load(&cache.mSnapshot)->count(host) > 0;
+            }
+            if (resolved) {
+                return cache.GetIPFromDnsCache(host, address);
+            }
+            this_thread::sleep_for(chrono::milliseconds(10));
+        }
+        return false;
+    }
+
+    atomic_int mResolveCnt = 0;
+    shared_future<void> mBlocker;
+    string mAddress = "10.0.0.1";
+    int32_t mTtl = 0;
+    atomic_int32_t mTimeOffset = 0;
+};
+
+void DnsCacheUnittest::TestResolveAsync() {
+    DnsCache cache;
+    SetStubResolver(cache);
+    string address;
+    APSARA_TEST_TRUE(cache.GetIPFromDnsCache("127.0.0.1", address));
+    APSARA_TEST_EQUAL("127.0.0.1", address);
+    APSARA_TEST_EQUAL(0, mResolveCnt.load());
+
+    // the resolver is stuck, which does not block the callers
+    promise<void> blocker;
+    mBlocker = blocker.get_future().share();
+    for (size_t i = 0; i < 10; ++i) {
+        APSARA_TEST_FALSE(cache.GetIPFromDnsCache("example.com", address));
+    }
+    blocker.set_value();
+    APSARA_TEST_TRUE(WaitForResolved(cache, "example.com", address));
+    APSARA_TEST_EQUAL("10.0.0.1", address);
+    APSARA_TEST_EQUAL(1, mResolveCnt.load());
+
+    APSARA_TEST_TRUE(cache.GetIPFromDnsCache("example.com", address));
+    APSARA_TEST_EQUAL(1, mResolveCnt.load());
+    cache.Stop();
+}
+
+void DnsCacheUnittest::TestNegativeCache() {
+    DnsCache cache;
+    SetStubResolver(cache);
+    SetStubClock(cache);
+    string address;
+    mAddress.clear();
+    APSARA_TEST_FALSE(cache.GetIPFromDnsCache("example.com", address));
+    APSARA_TEST_FALSE(WaitForResolved(cache, "example.com", address));
+    APSARA_TEST_FALSE(cache.GetIPFromDnsCache("example.com", address));
+    APSARA_TEST_EQUAL(1, mResolveCnt.load());
+    auto entry = atomic_load(&cache.mSnapshot)->at("example.com");
+    APSARA_TEST_EQUAL(INT32_FLAG(dns_cache_negative_ttl_sec), entry->mExpireTime - entry->mUpdateTime);
+
+    // retried once expired
+    mAddress = "10.0.0.1";
+    mTimeOffset += INT32_FLAG(dns_cache_negative_ttl_sec);
+    APSARA_TEST_FALSE(cache.GetIPFromDnsCache("example.com", address));
+    APSARA_TEST_TRUE(WaitForResolved(cache, "example.com", address));
+    APSARA_TEST_EQUAL("10.0.0.1", address);
+    APSARA_TEST_EQUAL(2, mResolveCnt.load());
+
+    // the last known address is kept after a failure
+    mAddress.clear();
+    mTimeOffset += INT32_FLAG(dns_cache_ttl_sec);
+    APSARA_TEST_TRUE(cache.GetIPFromDnsCache("example.com", address));
+    APSARA_TEST_TRUE(WaitForResolved(cache, "example.com", address));
+    APSARA_TEST_EQUAL("10.0.0.1", address);
+    APSARA_TEST_EQUAL(3, mResolveCnt.load());
+    cache.Stop();
+}
+
+void DnsCacheUnittest::TestTtl() {
+    DnsCache cache;
+    SetStubResolver(cache);
+    string address;
+    mTtl = 100;
+    APSARA_TEST_FALSE(cache.GetIPFromDnsCache("example.com", address));
+    APSARA_TEST_TRUE(WaitForResolved(cache, "example.com", address));
+    auto entry = atomic_load(&cache.mSnapshot)->at("example.com");
+    APSARA_TEST_EQUAL(100, entry->mExpireTime - entry->mUpdateTime);
+
+    mTtl = 0;
+    APSARA_TEST_FALSE(cache.GetIPFromDnsCache("example.org", address));
+    APSARA_TEST_TRUE(WaitForResolved(cache, "example.org", address));
+    entry = atomic_load(&cache.mSnapshot)->at("example.org");
+    APSARA_TEST_EQUAL(INT32_FLAG(dns_cache_ttl_sec), entry->mExpireTime - entry->mUpdateTime);
+    cache.Stop();
+}
+
+void DnsCacheUnittest::TestCollectRefreshHosts() {
+    DnsCache cache;
+    DnsCache::Snapshot snapshot;
+    // used and in the last tenth of the ttl
+    snapshot["a"] = make_shared<DnsCache::Entry>("10.0.0.1", 1000, 1100);
+    snapshot["a"]->mLastAccessTime = 1050;
+    // used but not to be refreshed yet
+    snapshot["b"] = make_shared<DnsCache::Entry>("10.0.0.2", 1000, 1200);
+    snapshot["b"]->mLastAccessTime = 1050;
+    // used and expired, but already being refreshed
+    snapshot["c"] = make_shared<DnsCache::Entry>("10.0.0.3", 1000, 1050);
+    snapshot["c"]->mLastAccessTime = 1010;
+    snapshot["c"]->mRefreshRequested = true;
+    // not used and expired
+    snapshot["d"] = make_shared<DnsCache::Entry>("10.0.0.4", 1000, 1050);
+    // not used but not expired yet
+    snapshot["e"] = make_shared<DnsCache::Entry>("10.0.0.5", 1000, 1200);
+
+    auto hosts = cache.CollectRefreshHosts(snapshot, 1095);
+    APSARA_TEST_EQUAL(1U, hosts.size());
+    APSARA_TEST_EQUAL("a", hosts[0]);
+    APSARA_TEST_TRUE(snapshot["a"]->mRefreshRequested.load());
+    APSARA_TEST_EQUAL(4U, snapshot.size());
+    APSARA_TEST_EQUAL(0U, snapshot.count("d"));
+
+    // requested only once
+    APSARA_TEST_TRUE(cache.CollectRefreshHosts(snapshot, 1096).empty());
+}
+
+void DnsCacheUnittest::TestStop() {
+    DnsCache cache;
+    SetStubResolver(cache);
+    string address;
+    APSARA_TEST_FALSE(cache.GetIPFromDnsCache("example.com", address));
+    APSARA_TEST_TRUE(WaitForResolved(cache, "example.com", address));
+
+    // stopped while resolving
+    promise<void> blocker;
+    mBlocker = blocker.get_future().share();
+    APSARA_TEST_FALSE(cache.GetIPFromDnsCache("example.org", address));
+    while (mResolveCnt.load() < 2) {
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    thread stopper([&cache]() { cache.Stop(); });
+    while (true) {
+        lock_guard<mutex> lock(cache.mMux);
+        if (cache.mIsStopped) {
+            break;
+        }
+    }
+
+    // the resolving thread is not restarted, and the callers are not blocked
+    APSARA_TEST_FALSE(cache.GetIPFromDnsCache("example.net", address));
+    APSARA_TEST_TRUE(cache.GetIPFromDnsCache("example.com", address));
+    APSARA_TEST_EQUAL("10.0.0.1", address);
+    blocker.set_value();
+    stopper.join();
+    APSARA_TEST_FALSE(cache.GetIPFromDnsCache("example.net", address));
+    APSARA_TEST_EQUAL(2, mResolveCnt.load());
+    {
+        lock_guard<mutex> lock(cache.mMux);
+        APSARA_TEST_FALSE(cache.mIsRunning);
+        APSARA_TEST_TRUE(cache.mPendingHosts.count("example.net") == 0);
+    }
+}
+
+UNIT_TEST_CASE(DnsCacheUnittest, TestResolveAsync)
+UNIT_TEST_CASE(DnsCacheUnittest, TestNegativeCache)
+UNIT_TEST_CASE(DnsCacheUnittest, TestTtl)
+UNIT_TEST_CASE(DnsCacheUnittest, TestCollectRefreshHosts)
+UNIT_TEST_CASE(DnsCacheUnittest, TestStop)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
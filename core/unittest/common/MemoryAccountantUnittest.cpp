@@ -0,0 +1,93 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+
+#include "common/memory/MemoryAccountant.h"
+#include "common/memory/SourceBuffer.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class MemoryAccountantUnittest : public ::testing::Test {
+public:
+    void TestSourceBufferAccounting();
+    void TestUpdatePressureLevel();
+
+protected:
+    void TearDown() override { MemoryAccountant::GetInstance()->SetPressureLevel(MemoryPressureLevel::NORMAL); }
+};
+
+void MemoryAccountantUnittest::TestSourceBufferAccounting() {
+    auto* accountant = MemoryAccountant::GetInstance();
+    auto base = accountant->GetBytes(MemoryCategory::SOURCE_BUFFER);
+    {
+        BufferAllocator allocator(1024, 4096);
+        APSARA_TEST_EQUAL(base + 1024, accountant->GetBytes(MemoryCategory::SOURCE_BUFFER));
+        // a new chunk of twice the size is allocated
+        allocator.Allocate(1000);
+        allocator.Allocate(200);
+        APSARA_TEST_EQUAL(base + 1024 + 2048, accountant->GetBytes(MemoryCategory::SOURCE_BUFFER));
+
+        // moving keeps the chunks accounted once
+        BufferAllocator moved(std::move(allocator));
+        APSARA_TEST_EQUAL(base + 1024 + 2048, accountant->GetBytes(MemoryCategory::SOURCE_BUFFER));
+        BufferAllocator assigned(256);
+        assigned = std::move(moved);
+        APSARA_TEST_EQUAL(base + 1024 + 2048, accountant->GetBytes(MemoryCategory::SOURCE_BUFFER));
+
+        assigned.Reset();
+        APSARA_TEST_EQUAL(base + 1024, accountant->GetBytes(MemoryCategory::SOURCE_BUFFER));
+    }
+    APSARA_TEST_EQUAL(base, accountant->GetBytes(MemoryCategory::SOURCE_BUFFER));
+
+    {
+        auto sourceBuffer = make_shared<SourceBuffer>();
+        sourceBuffer->CopyString(string(10000, 'a'));
+        APSARA_TEST_TRUE(accountant->GetBytes(MemoryCategory::SOURCE_BUFFER) >= base + 10000);
+    }
+    APSARA_TEST_EQUAL(base, accountant->GetBytes(MemoryCategory::SOURCE_BUFFER));
+}
+
+void MemoryAccountantUnittest::TestUpdatePressureLevel() {
+    auto* accountant = MemoryAccountant::GetInstance();
+    APSARA_TEST_EQUAL(MemoryPressureLevel::NORMAL, accountant->UpdatePressureLevel(50, 100));
+
+    // one level up per update while above the high watermark
+    APSARA_TEST_EQUAL(MemoryPressureLevel::SHRINK_BATCH, accountant->UpdatePressureLevel(90, 100));
+    APSARA_TEST_EQUAL(MemoryPressureLevel::SPILL_SENDER_QUEUE, accountant->UpdatePressureLevel(90, 100));
+    APSARA_TEST_EQUAL(MemoryPressureLevel::PAUSE_INPUT, accountant->UpdatePressureLevel(120, 100));
+    APSARA_TEST_EQUAL(MemoryPressureLevel::TRIM_POOL, accountant->UpdatePressureLevel(120, 100));
+    APSARA_TEST_EQUAL(MemoryPressureLevel::TRIM_POOL, accountant->UpdatePressureLevel(120, 100));
+    APSARA_TEST_TRUE(accountant->IsUnderPressure(MemoryPressureLevel::PAUSE_INPUT));
+
+    // kept between the watermarks
+    APSARA_TEST_EQUAL(MemoryPressureLevel::TRIM_POOL, accountant->UpdatePressureLevel(70, 100));
+
+    // one level down per update while below the low watermark
+    APSARA_TEST_EQUAL(MemoryPressureLevel::PAUSE_INPUT, accountant->UpdatePressureLevel(50, 100));
+    APSARA_TEST_EQUAL(MemoryPressureLevel::SPILL_SENDER_QUEUE, accountant->UpdatePressureLevel(50, 100));
+    APSARA_TEST_FALSE(accountant->IsUnderPressure(MemoryPressureLevel::PAUSE_INPUT));
+
+    APSARA_TEST_EQUAL(MemoryPressureLevel::NORMAL, accountant->UpdatePressureLevel(50, 0));
+}
+
+UNIT_TEST_CASE(MemoryAccountantUnittest, TestSourceBufferAccounting)
+UNIT_TEST_CASE(MemoryAccountantUnittest, TestUpdatePressureLevel)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -432,4 +432,31 @@ TEST_F(StringToolsUnittest, TestStringTo) {
     APSARA_TEST_FALSE(StringTo(nullptr, nullptr, s));
 }
 
+TEST_F(StringToolsUnittest, TestGetRegexRequiredLiterals) {
+    auto literals = [](const std::string& exp) {
+        std::vector<std::string> res;
+        GetRegexRequiredLiterals(exp, res);
+        return res;
+    };
+    APSARA_TEST_EQUAL(std::vector<std::string>({"ERROR", "code="}), literals("ERROR.*code=\\d+"));
+    APSARA_TEST_EQUAL(std::vector<std::string>({"a", "b"}), literals("a\\sb"));
+    APSARA_TEST_EQUAL(std::vector<std::string>({"[", "]"}), literals("\\[\\w+\\]"));
+    APSARA_TEST_EQUAL(std::vector<std::string>({"a", "bc"}), literals("a(x|y)bc"));
+    APSARA_TEST_TRUE(literals("a|b").empty());
+
+    // escapes whose operand would otherwise be taken as literal chars
+    APSARA_TEST_TRUE(literals("\\x5b\\d+").empty());
+    APSARA_TEST_TRUE(literals("\\x{5b}abc").empty());
+    APSARA_TEST_TRUE(literals("\\u005babc").empty());
+    APSARA_TEST_TRUE(literals("\\cAabc").empty());
+    APSARA_TEST_TRUE(literals("\\N{LEFT SQUARE BRACKET}abc").empty());
+    APSARA_TEST_TRUE(literals("\\pLabc").empty());
+    APSARA_TEST_TRUE(literals("\\PLabc").empty());
+    APSARA_TEST_TRUE(literals("\\0133abc").empty());
+    APSARA_TEST_TRUE(literals("(a)\\1abc").empty());
+    APSARA_TEST_TRUE(literals("(?<n>a)\\k<n>abc").empty());
+    APSARA_TEST_TRUE(literals("\\Q.*\\Eabc").empty());
+    APSARA_TEST_TRUE(literals("(\\Q)\\E)abc").empty());
+}
+
 UNIT_TEST_MAIN
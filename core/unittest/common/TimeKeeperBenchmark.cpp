@@ -14,7 +14,11 @@
  * limitations under the License.
  */
 
+#include <thread>
+#include <vector>
+
 #include "common/TimeKeeper.h"
+#include "common/TimeUtil.h"
 #include "unittest/Unittest.h"
 
 using namespace std;
@@ -24,6 +28,7 @@ class TimeKeeperBenchmark : public testing::Test {
 public:
     void TestGetTimeNs();
     void TestGetTimeMs();
+    void TestParseTime();
 };
 
 /*
@@ -83,7 +88,51 @@ void TimeKeeperBenchmark::TestGetTimeMs() {
     }
 }
 
+/*
+libc strptime + mktime, 1 threads elapsed: 0.358468 seconds
+TimeFormat.Parse, 1 threads elapsed: 0.056597 seconds
+*/
+void TimeKeeperBenchmark::TestParseTime() {
+#ifdef __linux__
+    int iterations = 1000000;
+    const string format = "%Y-%m-%d %H:%M:%S";
+    const string timeStr = "2024-05-01 12:34:56";
+    TimeFormat timeFormat(format);
+    LocalTimeZone::GetInstance();
+    for (size_t threadCnt : {1, 2, 4, 8}) {
+        for (bool compiled : {false, true}) {
+            auto start = std::chrono::high_resolution_clock::now();
+            vector<thread> threads;
+            for (size_t i = 0; i < threadCnt; ++i) {
+                threads.emplace_back([&]() {
+                    for (int j = 0; j < iterations; ++j) {
+                        LogtailTime logTime = {0, 0};
+                        if (compiled) {
+                            int nanosecondLength = -1;
+                            timeFormat.Parse(timeStr.data(), timeStr.size(), &logTime, nanosecondLength);
+                        } else {
+                            struct tm tm = {0};
+                            strptime(timeStr.c_str(), format.c_str(), &tm);
+                            logTime.tv_sec = mktime(&tm);
+                        }
+                        (void)logTime;
+                    }
+                });
+            }
+            for (auto& t : threads) {
+                t.join();
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            std::chrono::duration<double> elapsed = end - start;
+            cout << (compiled ? "TimeFormat.Parse, " : "libc strptime + mktime, ") << threadCnt
+                 << " threads elapsed: " << elapsed.count() << " seconds" << endl;
+        }
+    }
+#endif
+}
+
 UNIT_TEST_CASE(TimeKeeperBenchmark, TestGetTimeNs)
 UNIT_TEST_CASE(TimeKeeperBenchmark, TestGetTimeMs)
+UNIT_TEST_CASE(TimeKeeperBenchmark, TestParseTime)
 
 UNIT_TEST_MAIN
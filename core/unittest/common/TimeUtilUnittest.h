@@ -35,6 +35,8 @@ public:
     void TestGetPreciseTimestampFromLogtailTime();
     void TestBootTimeDiff();
     void TestKernelTimeToUTC();
+    void TestLocalTimeZone();
+    void TestTimeFormat();
 };
 
 APSARA_UNIT_TEST_CASE(TimeUtilUnittest, TestDeduceYear, 0);
@@ -44,6 +46,8 @@ APSARA_UNIT_TEST_CASE(TimeUtilUnittest, TestStrptimeNanosecond, 0);
 APSARA_UNIT_TEST_CASE(TimeUtilUnittest, TestGetPreciseTimestampFromLogtailTime, 0);
 APSARA_UNIT_TEST_CASE(TimeUtilUnittest, TestBootTimeDiff, 0);
 APSARA_UNIT_TEST_CASE(TimeUtilUnittest, TestKernelTimeToUTC, 0);
+APSARA_UNIT_TEST_CASE(TimeUtilUnittest, TestLocalTimeZone, 0);
+APSARA_UNIT_TEST_CASE(TimeUtilUnittest, TestTimeFormat, 0);
 
 void TimeUtilUnittest::TestBootTimeDiff() {
     auto diff = GetTimeDiffFromMonotonic();
@@ -270,4 +274,82 @@ void TimeUtilUnittest::TestGetPreciseTimestampFromLogtailTime() {
     EXPECT_EQ(1640970061123456789UL, GetPreciseTimestampFromLogtailTime(lt, preciseTimestampConfig));
 }
 
+void TimeUtilUnittest::TestLocalTimeZone() {
+#ifdef __linux__
+    const char* tz = getenv("TZ");
+    std::string oldTZ = tz == nullptr ? "" : tz;
+    for (const char* zone : {"UTC", "Asia/Shanghai", "Europe/Berlin", "America/New_York"}) {
+        setenv("TZ", zone, 1);
+        tzset();
+        LocalTimeZone localTimeZone;
+        APSARA_TEST_FALSE(localTimeZone.mPeriods.empty());
+        if (std::string(zone) == "Europe/Berlin") {
+            // two transitions a year
+            APSARA_TEST_TRUE(localTimeZone.mPeriods.size() > 40);
+        }
+        // the noon of each month in the last years, away from any dst transition
+        time_t now = time(nullptr);
+        for (time_t t = now - 10 * 365 * 86400; t < now + 365 * 86400; t += 30 * 86400 + 3600) {
+            struct tm expected = {0};
+            localtime_r(&t, &expected);
+            struct tm local = {0};
+            localTimeZone.ToLocalTime(t, local);
+            EXPECT_EQ(expected.tm_year, local.tm_year) << zone << " " << t;
+            EXPECT_EQ(expected.tm_yday, local.tm_yday) << zone << " " << t;
+            EXPECT_EQ(expected.tm_wday, local.tm_wday) << zone << " " << t;
+            EXPECT_EQ(expected.tm_hour, local.tm_hour) << zone << " " << t;
+            EXPECT_EQ(expected.tm_sec, local.tm_sec) << zone << " " << t;
+            EXPECT_EQ(expected.tm_isdst, local.tm_isdst) << zone << " " << t;
+
+            expected.tm_hour = 12;
+            for (int isdst : {0, 1}) {
+                expected.tm_isdst = isdst;
+                struct tm copy = expected;
+                EXPECT_EQ(mktime(&copy), localTimeZone.ToEpoch(expected)) << zone << " " << t << " " << isdst;
+            }
+        }
+    }
+    if (oldTZ.empty()) {
+        unsetenv("TZ");
+    } else {
+        setenv("TZ", oldTZ.c_str(), 1);
+    }
+    tzset();
+#endif
+}
+
+void TimeUtilUnittest::TestTimeFormat() {
+    APSARA_TEST_TRUE(TimeFormat("%Y-%m-%d %H:%M:%S.%f").IsCompiled());
+    APSARA_TEST_TRUE(TimeFormat("[%F %T]").IsCompiled());
+    APSARA_TEST_FALSE(TimeFormat("%d %b %Y %H:%M").IsCompiled());
+    APSARA_TEST_FALSE(TimeFormat("%s").IsCompiled());
+
+    // strings out of the fixed widths fall back to Strptime with the same result
+    std::vector<std::string> formats = {"%Y-%m-%d %H:%M:%S", "[%Y-%m-%d %H:%M:%S.%f", "%F %T", "%m/%d/%y %H:%M:%S.%f"};
+    std::vector<std::string> strs = {"2017-01-11 15:05:07",
+                                     "2017-1-11 15:05:07",
+                                     "[2017-01-11 15:05:07.0123]",
+                                     "2017-01-11   15:05:07.123456789",
+                                     "01/11/17 15:05:07.5",
+                                     "2017-13-11 15:05:07",
+                                     "2017-01-11 15:05:07.1234567891"};
+    for (const auto& format : formats) {
+        TimeFormat timeFormat(format);
+        for (const auto& str : strs) {
+            for (int32_t year : {-1, 0, 2018}) {
+                LogtailTime expected = {0, 0}, actual = {0, 0};
+                int expectedLength = -1, actualLength = -1;
+                auto expectedRes = Strptime(str.c_str(), format.c_str(), &expected, expectedLength, year);
+                auto actualRes = timeFormat.Parse(str.c_str(), str.size(), &actual, actualLength, year);
+                EXPECT_EQ(expectedRes, actualRes) << format << " " << str;
+                if (expectedRes != nullptr) {
+                    EXPECT_EQ(expected.tv_sec, actual.tv_sec) << format << " " << str;
+                    EXPECT_EQ(expected.tv_nsec, actual.tv_nsec) << format << " " << str;
+                    EXPECT_EQ(expectedLength, actualLength) << format << " " << str;
+                }
+            }
+        }
+    }
+}
+
 } // namespace logtail
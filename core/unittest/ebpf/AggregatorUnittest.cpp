@@ -24,6 +24,7 @@
 #include "ebpf/type/FileEvent.h"
 #include "ebpf/type/NetworkEvent.h"
 #include "ebpf/util/AggregateTree.h"
+#include "ebpf/util/FlatAggregateTree.h"
 #include "logger/Logger.h"
 #include "models/PipelineEventGroup.h"
 #include "unittest/Unittest.h"
@@ -52,6 +53,10 @@ public:
     void TestGetAndReset();
     void TestAggManager();
     void TestAggregator();
+    void TestFlatAgg();
+    void TestFlatAggGetAndReset();
+    void TestFlatAggSourceBuffer();
+    void FlatAggBenchmark();
 
 protected:
     void SetUp() override {
@@ -246,9 +251,138 @@ void AggregatorUnittest::TestGetAndReset() {
     APSARA_TEST_EQUAL(GetSum(newTree), 5);
 }
 
+void AggregatorUnittest::TestFlatAgg() {
+    SIZETFlatAggTree<HT, int, 2> flatAgg(
+        4,
+        [](std::unique_ptr<HT>& base, const int& other) { base->val += other; },
+        [](const int&, std::shared_ptr<SourceBuffer>& sourceBuffer) {
+            APSARA_TEST_TRUE(sourceBuffer == nullptr);
+            return std::make_unique<HT>(0);
+        });
+    APSARA_TEST_TRUE(flatAgg.Aggregate(1, {1UL, 1UL}));
+    APSARA_TEST_TRUE(flatAgg.Aggregate(2, {1UL, 1UL}));
+    APSARA_TEST_TRUE(flatAgg.Aggregate(3, {1UL, 2UL}));
+    APSARA_TEST_TRUE(flatAgg.Aggregate(4, {2UL, 1UL}));
+    APSARA_TEST_EQUAL(flatAgg.NodeCount(), 3UL);
+    APSARA_TEST_EQUAL(flatAgg.GroupCount(), 2UL);
+    APSARA_TEST_EQUAL(flatAgg.EventCount(), 4UL);
+
+    // new keys beyond the limit are dropped, existing keys are still aggregated
+    APSARA_TEST_TRUE(flatAgg.Aggregate(5, {2UL, 2UL}));
+    APSARA_TEST_FALSE(flatAgg.Aggregate(6, {3UL, 1UL}));
+    APSARA_TEST_TRUE(flatAgg.Aggregate(7, {1UL, 1UL}));
+    APSARA_TEST_EQUAL(flatAgg.NodeCount(), 4UL);
+
+    int sum = 0;
+    flatAgg.ForEach([&sum](const HT* ht) { sum += ht->val; });
+    APSARA_TEST_EQUAL(sum, 22);
+
+    auto groups = flatAgg.GetGroups();
+    APSARA_TEST_EQUAL(groups.size(), 2UL);
+    APSARA_TEST_EQUAL(groups[0]->mKey, 1UL);
+    APSARA_TEST_EQUAL(groups[0]->mSize, 2UL);
+    std::vector<int> vals;
+    flatAgg.ForEach(groups[0], [&vals](const HT* ht) { vals.push_back(ht->val); });
+    APSARA_TEST_EQUAL(vals, std::vector<int>({10, 3}));
+
+    flatAgg.Reset();
+    APSARA_TEST_EQUAL(flatAgg.NodeCount(), 0UL);
+    APSARA_TEST_EQUAL(flatAgg.GroupCount(), 0UL);
+    APSARA_TEST_EQUAL(flatAgg.EventCount(), 0UL);
+}
+
+void AggregatorUnittest::TestFlatAggGetAndReset() {
+    SIZETFlatAggTree<HT, int, 3> flatAgg(
+        100000,
+        [](std::unique_ptr<HT>& base, const int& other) { base->val += other; },
+        [](const int&, std::shared_ptr<SourceBuffer>&) { return std::make_unique<HT>(0); });
+    // enough distinct keys to force several rehashes
+    for (size_t i = 0; i < 10000; ++i) {
+        APSARA_TEST_TRUE(flatAgg.Aggregate(1, {i % 10, i % 1000, 0UL}));
+    }
+    APSARA_TEST_EQUAL(flatAgg.NodeCount(), 1000UL);
+    APSARA_TEST_EQUAL(flatAgg.GroupCount(), 10UL);
+
+    auto newTree(flatAgg.GetAndReset());
+    APSARA_TEST_EQUAL(flatAgg.NodeCount(), 0UL);
+    APSARA_TEST_EQUAL(flatAgg.EventCount(), 0UL);
+    APSARA_TEST_TRUE(flatAgg.Aggregate(1, {0UL, 0UL, 0UL}));
+    APSARA_TEST_EQUAL(flatAgg.NodeCount(), 1UL);
+
+    APSARA_TEST_EQUAL(newTree.NodeCount(), 1000UL);
+    APSARA_TEST_EQUAL(newTree.EventCount(), 10000UL);
+    int sum = 0;
+    size_t nodes = 0;
+    for (auto* group : newTree.GetGroups()) {
+        APSARA_TEST_EQUAL(group->mSize, 100UL);
+        newTree.ForEach(group, [&](const HT* ht) {
+            sum += ht->val;
+            nodes++;
+        });
+    }
+    APSARA_TEST_EQUAL(sum, 10000);
+    APSARA_TEST_EQUAL(nodes, 1000UL);
+}
+
+void AggregatorUnittest::TestFlatAggSourceBuffer() {
+    SIZETFlatAggTreeWithSourceBuffer<HT, int, 2> flatAgg(
+        100,
+        [](std::unique_ptr<HT>& base, const int& other) { base->val += other; },
+        [](const int&, std::shared_ptr<SourceBuffer>& sourceBuffer) {
+            APSARA_TEST_TRUE(sourceBuffer != nullptr);
+            return std::make_unique<HT>(0);
+        });
+    APSARA_TEST_TRUE(flatAgg.Aggregate(1, {1UL, 1UL}));
+    APSARA_TEST_TRUE(flatAgg.Aggregate(1, {1UL, 2UL}));
+    APSARA_TEST_TRUE(flatAgg.Aggregate(1, {2UL, 1UL}));
+    auto groups = flatAgg.GetGroups();
+    APSARA_TEST_EQUAL(groups.size(), 2UL);
+    APSARA_TEST_TRUE(groups[0]->mSourceBuffer != nullptr);
+    APSARA_TEST_TRUE(groups[1]->mSourceBuffer != nullptr);
+    APSARA_TEST_TRUE(groups[0]->mSourceBuffer != groups[1]->mSourceBuffer);
+}
+
+void AggregatorUnittest::FlatAggBenchmark() {
+    const size_t apps = 20;
+    const size_t keysPerApp = 500;
+    const size_t rounds = 1000000;
+    std::vector<std::array<size_t, 2>> keys;
+    std::mt19937_64 rng(42);
+    for (size_t i = 0; i < rounds; ++i) {
+        keys.push_back({rng() % apps, rng() % keysPerApp});
+    }
+    auto aggregate = [](std::unique_ptr<HT>& base, const int& other) { base->val += other; };
+    auto build = [](const int&, std::shared_ptr<SourceBuffer>&) { return std::make_unique<HT>(0); };
+
+    SIZETAggTreeWithSourceBuffer<HT, int> tree(apps * keysPerApp * 2, aggregate, build);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const auto& key : keys) {
+        tree.Aggregate(1, key);
+    }
+    auto treeResult = tree.GetAndReset();
+    std::chrono::duration<double> treeElapsed = std::chrono::high_resolution_clock::now() - start;
+
+    SIZETFlatAggTreeWithSourceBuffer<HT, int, 2> flatAgg(apps * keysPerApp * 2, aggregate, build);
+    start = std::chrono::high_resolution_clock::now();
+    for (const auto& key : keys) {
+        flatAgg.Aggregate(1, key);
+    }
+    auto flatResult = flatAgg.GetAndReset();
+    std::chrono::duration<double> flatElapsed = std::chrono::high_resolution_clock::now() - start;
+
+    APSARA_TEST_EQUAL(treeResult.EventCount(), flatResult.EventCount());
+    APSARA_TEST_EQUAL(flatResult.NodeCount(), apps * keysPerApp);
+    std::cout << "[agg tree] elapsed: " << treeElapsed.count() << " seconds" << std::endl;
+    std::cout << "[flat agg tree] elapsed: " << flatElapsed.count() << " seconds" << std::endl;
+}
+
 UNIT_TEST_CASE(AggregatorUnittest, TestBasicAgg);
 UNIT_TEST_CASE(AggregatorUnittest, TestGetAndReset);
 UNIT_TEST_CASE(AggregatorUnittest, TestAggregator);
+UNIT_TEST_CASE(AggregatorUnittest, TestFlatAgg);
+UNIT_TEST_CASE(AggregatorUnittest, TestFlatAggGetAndReset);
+UNIT_TEST_CASE(AggregatorUnittest, TestFlatAggSourceBuffer);
+UNIT_TEST_CASE(AggregatorUnittest, FlatAggBenchmark);
 
 
 } // namespace ebpf
@@ -19,6 +19,7 @@
 
 #include "ebpf/protocol/ProtocolParser.h"
 #include "ebpf/protocol/http/HttpParser.h"
+#include "ebpf/plugin/network_observer/Type.h"
 #include "logger/Logger.h"
 #include "unittest/Unittest.h"
 
@@ -35,6 +36,7 @@ public:
     void TestParseInvalidRequests();
     void TestParsePartialRequests();
     void TestProtocolParserManager();
+    void TestProtocolParserManagerParse();
     void TestHttpParserEdgeCases();
 
     void RequestBenchmark();
@@ -222,6 +224,46 @@ void ProtocolParserUnittest::TestProtocolParserManager() {
     APSARA_TEST_TRUE(manager.RemoveParser(support_proto_e::ProtoHTTP));
 }
 
+void ProtocolParserUnittest::TestProtocolParserManagerParse() {
+    auto& manager = ProtocolParserManager::GetInstance();
+    APSARA_TEST_TRUE(manager.AddParser(support_proto_e::ProtoHTTP));
+
+    ObserverNetworkOption options;
+    options.mL7Config.mEnable = true;
+    options.mL7Config.mSampleRate = 1.0;
+    auto appDetail = std::make_shared<AppDetail>(&options, nullptr);
+
+    const std::string req = "GET /index.html HTTP/1.1\r\nHost: www.cmonitor.ai\r\n\r\n";
+    const std::string resp = "HTTP/1.1 200 OK\r\nContent-Length: 13\r\n\r\nHello, World!";
+    std::string msg = req + resp;
+    auto* evt = static_cast<conn_data_event_t*>(malloc(offsetof(conn_data_event_t, msg) + msg.size()));
+    memcpy(evt->msg, msg.data(), msg.size());
+    evt->request_len = req.size();
+    evt->response_len = resp.size();
+    evt->protocol = support_proto_e::ProtoHTTP;
+    evt->start_ts = 1;
+    evt->end_ts = 2;
+
+    // records are appended to the caller's buffer, which is reused across events
+    std::vector<std::shared_ptr<L7Record>> records;
+    APSARA_TEST_EQUAL(1UL, manager.Parse(support_proto_e::ProtoHTTP, nullptr, evt, appDetail, nullptr, records));
+    APSARA_TEST_EQUAL(1UL, manager.Parse(support_proto_e::ProtoHTTP, nullptr, evt, appDetail, nullptr, records));
+    APSARA_TEST_EQUAL(2UL, records.size());
+    auto* record = static_cast<HttpRecord*>(records[0].get());
+    APSARA_TEST_EQUAL(record->GetPath(), "/index.html");
+    APSARA_TEST_EQUAL(record->GetStatusCode(), 200);
+
+    // invalid payload appends nothing
+    evt->response_len = 0;
+    memcpy(evt->msg, "INVALID", 7);
+    APSARA_TEST_EQUAL(0UL, manager.Parse(support_proto_e::ProtoHTTP, nullptr, evt, appDetail, nullptr, records));
+    APSARA_TEST_EQUAL(2UL, records.size());
+
+    APSARA_TEST_TRUE(manager.RemoveParser(support_proto_e::ProtoHTTP));
+    APSARA_TEST_EQUAL(0UL, manager.Parse(support_proto_e::ProtoHTTP, nullptr, evt, appDetail, nullptr, records));
+    free(evt);
+}
+
 void ProtocolParserUnittest::TestHttpParserEdgeCases() {
     // 测试空请求
     const std::string emptyRequest;
@@ -351,6 +393,7 @@ UNIT_TEST_CASE(ProtocolParserUnittest, TestParseChunkedEncoding);
 UNIT_TEST_CASE(ProtocolParserUnittest, TestParseInvalidRequests);
 UNIT_TEST_CASE(ProtocolParserUnittest, TestParsePartialRequests);
 UNIT_TEST_CASE(ProtocolParserUnittest, TestProtocolParserManager);
+UNIT_TEST_CASE(ProtocolParserUnittest, TestProtocolParserManagerParse);
 UNIT_TEST_CASE(ProtocolParserUnittest, TestHttpParserEdgeCases);
 UNIT_TEST_CASE(ProtocolParserUnittest, RequestBenchmark);
 UNIT_TEST_CASE(ProtocolParserUnittest, RequestWithoutBodyBenchmark);
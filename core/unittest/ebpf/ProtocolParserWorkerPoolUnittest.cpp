@@ -0,0 +1,219 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <unordered_map>
+
+#include "ebpf/plugin/network_observer/Connection.h"
+#include "ebpf/protocol/ProtocolParser.h"
+#include "ebpf/protocol/ProtocolParserWorkerPool.h"
+#include "unittest/Unittest.h"
+
+namespace logtail {
+namespace ebpf {
+
+class ProtocolParserWorkerPoolUnittest : public testing::Test {
+public:
+    void TestPerConnectionOrder();
+    void TestBackpressure();
+    void TestStop();
+    void SyntheticTrafficBenchmark();
+
+protected:
+    void SetUp() override {
+        ProtocolParserManager::GetInstance().AddParser(support_proto_e::ProtoHTTP);
+        mOptions.mL7Config.mEnable = true;
+        mOptions.mL7Config.mSampleRate = 1.0;
+        mAppDetail = std::make_shared<AppDetail>(&mOptions, nullptr);
+    }
+    void TearDown() override {}
+
+private:
+    static conn_data_event_t* buildEvent(const std::string& path) {
+        const std::string req = "GET " + path + " HTTP/1.1\r\nHost: www.cmonitor.ai\r\nAccept: */*\r\n\r\n";
+        const std::string resp = "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: 13\r\n\r\n"
+                                 "Hello, World!";
+        std::string msg = req + resp;
+        auto* evt = static_cast<conn_data_event_t*>(malloc(offsetof(conn_data_event_t, msg) + msg.size()));
+        memcpy(evt->msg, msg.data(), msg.size());
+        evt->request_len = req.size();
+        evt->response_len = resp.size();
+        evt->protocol = support_proto_e::ProtoHTTP;
+        evt->start_ts = 1;
+        evt->end_ts = 2;
+        return evt;
+    }
+
+    static size_t drainUntil(ProtocolParserWorkerPool& pool, std::vector<ParsedRecord>& records, size_t expected) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (records.size() < expected && std::chrono::steady_clock::now() < deadline) {
+            if (pool.Drain(records) == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        return records.size();
+    }
+
+    ObserverNetworkOption mOptions;
+    std::shared_ptr<AppDetail> mAppDetail;
+};
+
+void ProtocolParserWorkerPoolUnittest::TestPerConnectionOrder() {
+    const size_t connNum = 16;
+    const size_t eventsPerConn = 200;
+    std::vector<std::shared_ptr<Connection>> conns;
+    for (size_t i = 0; i < connNum; ++i) {
+        conns.emplace_back(std::make_shared<Connection>(ConnId(i, 100, i)));
+    }
+
+    ProtocolParserWorkerPool pool(4, connNum * eventsPerConn);
+    pool.Start();
+    for (size_t seq = 0; seq < eventsPerConn; ++seq) {
+        for (size_t i = 0; i < connNum; ++i) {
+            auto* evt = buildEvent("/" + std::to_string(seq));
+            APSARA_TEST_TRUE(pool.Submit(support_proto_e::ProtoHTTP, conns[i], mAppDetail, evt));
+            // the pool owns a copy, the perf buffer memory may be reused right away
+            memset(evt->msg, 0, evt->request_len + evt->response_len);
+            free(evt);
+        }
+    }
+
+    std::vector<ParsedRecord> records;
+    APSARA_TEST_EQUAL(connNum * eventsPerConn, drainUntil(pool, records, connNum * eventsPerConn));
+    APSARA_TEST_EQUAL(0UL, pool.PendingCount());
+
+    std::unordered_map<Connection*, size_t> nextSeq;
+    for (auto& parsed : records) {
+        APSARA_TEST_EQUAL(support_proto_e::ProtoHTTP, parsed.mProtocol);
+        auto* record = static_cast<HttpRecord*>(parsed.mRecord.get());
+        APSARA_TEST_EQUAL(200, record->GetStatusCode());
+        auto& expected = nextSeq[record->GetConnection().get()];
+        APSARA_TEST_EQUAL("/" + std::to_string(expected), record->GetPath());
+        ++expected;
+    }
+    APSARA_TEST_EQUAL(connNum, nextSeq.size());
+    pool.Stop();
+}
+
+void ProtocolParserWorkerPoolUnittest::TestBackpressure() {
+    auto conn = std::make_shared<Connection>(ConnId(1, 100, 1));
+    auto* evt = buildEvent("/index.html");
+
+    // workers are not started, so the shard fills up
+    ProtocolParserWorkerPool pool(2, 3);
+    for (int i = 0; i < 3; ++i) {
+        APSARA_TEST_TRUE(pool.Submit(support_proto_e::ProtoHTTP, conn, mAppDetail, evt));
+    }
+    APSARA_TEST_FALSE(pool.Submit(support_proto_e::ProtoHTTP, conn, mAppDetail, evt));
+    APSARA_TEST_EQUAL(3UL, pool.PendingCount());
+
+    pool.Start();
+    std::vector<ParsedRecord> records;
+    APSARA_TEST_EQUAL(3UL, drainUntil(pool, records, 3));
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (pool.PendingCount() > 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    APSARA_TEST_EQUAL(0UL, pool.PendingCount());
+    APSARA_TEST_TRUE(pool.Submit(support_proto_e::ProtoHTTP, conn, mAppDetail, evt));
+    APSARA_TEST_EQUAL(4UL, drainUntil(pool, records, 4));
+    free(evt);
+}
+
+void ProtocolParserWorkerPoolUnittest::TestStop() {
+    auto conn = std::make_shared<Connection>(ConnId(1, 100, 1));
+    auto* evt = buildEvent("/index.html");
+
+    ProtocolParserWorkerPool pool(1, 16);
+    APSARA_TEST_TRUE(pool.Submit(support_proto_e::ProtoHTTP, conn, mAppDetail, evt));
+    pool.Start();
+    APSARA_TEST_TRUE(pool.IsRunning());
+    pool.Stop();
+    APSARA_TEST_FALSE(pool.IsRunning());
+    APSARA_TEST_EQUAL(0UL, pool.PendingCount());
+    std::vector<ParsedRecord> records;
+    APSARA_TEST_EQUAL(0UL, pool.Drain(records));
+    // stop is idempotent
+    pool.Stop();
+    free(evt);
+}
+
+void ProtocolParserWorkerPoolUnittest::SyntheticTrafficBenchmark() {
+    const size_t connNum = 256;
+    const size_t eventNum = 200000;
+    std::vector<std::shared_ptr<Connection>> conns;
+    std::vector<conn_data_event_t*> events;
+    for (size_t i = 0; i < connNum; ++i) {
+        conns.emplace_back(std::make_shared<Connection>(ConnId(i, 100, i)));
+        events.push_back(buildEvent("/api/v1/users/" + std::to_string(i) + "?page=1&size=20"));
+    }
+
+    {
+        std::vector<std::shared_ptr<L7Record>> records;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < eventNum; ++i) {
+            records.clear();
+            ProtocolParserManager::GetInstance().Parse(
+                support_proto_e::ProtoHTTP, conns[i % connNum], events[i % connNum], mAppDetail, nullptr, records);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        std::cout << "[synthetic traffic] inline parse " << eventNum << " events: " << duration.count() << "us"
+                  << std::endl;
+    }
+
+    for (size_t workerNum : {1, 2, 4}) {
+        ProtocolParserWorkerPool pool(workerNum, 4096);
+        pool.Start();
+        std::vector<ParsedRecord> records;
+        size_t drained = 0;
+        size_t backpressure = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < eventNum; ++i) {
+            while (!pool.Submit(support_proto_e::ProtoHTTP, conns[i % connNum], mAppDetail, events[i % connNum])) {
+                ++backpressure;
+                records.clear();
+                drained += pool.Drain(records);
+                std::this_thread::yield();
+            }
+        }
+        while (drained < eventNum) {
+            records.clear();
+            drained += pool.Drain(records);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        std::cout << "[synthetic traffic] " << workerNum << " parse workers, " << eventNum
+                  << " events: " << duration.count() << "us, backpressure: " << backpressure << std::endl;
+        pool.Stop();
+    }
+
+    for (auto* evt : events) {
+        free(evt);
+    }
+}
+
+UNIT_TEST_CASE(ProtocolParserWorkerPoolUnittest, TestPerConnectionOrder);
+UNIT_TEST_CASE(ProtocolParserWorkerPoolUnittest, TestBackpressure);
+UNIT_TEST_CASE(ProtocolParserWorkerPoolUnittest, TestStop);
+UNIT_TEST_CASE(ProtocolParserWorkerPoolUnittest, SyntheticTrafficBenchmark);
+
+} // namespace ebpf
+} // namespace logtail
+
+UNIT_TEST_MAIN
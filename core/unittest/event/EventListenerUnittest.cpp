@@ -0,0 +1,293 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "file_server/EventDispatcher.h"
+#include "file_server/event/Event.h"
+#include "file_server/event_listener/EventListener.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_BOOL(fs_events_fanotify_enable);
+
+using namespace std;
+
+namespace logtail {
+
+class EventListenerUnittest : public ::testing::Test {
+public:
+    void TestParseEvents();
+    void TestParseHalfEvent();
+    void TestEventPool();
+    void TestFanotify();
+    void TestFanotifyFallback();
+
+protected:
+    void SetUp() override {
+        auto* dispatcher = EventDispatcher::GetInstance();
+        dispatcher->mWdDirInfoMap[1] = new DirInfo("/var/log", 0, false, nullptr);
+        dispatcher->mWdDirInfoMap[2] = new DirInfo("/home/admin/logs", 0, false, nullptr);
+    }
+
+    void TearDown() override {
+        auto* dispatcher = EventDispatcher::GetInstance();
+        for (auto& item : dispatcher->mWdDirInfoMap) {
+            delete item.second;
+        }
+        dispatcher->mWdDirInfoMap.clear();
+        mBuffer.clear();
+    }
+
+    void AppendEvent(int wd, uint32_t mask, const string& name, uint32_t cookie = 0) {
+        // the name is padded like the kernel does
+        size_t nameLen = name.empty() ? 0 : (name.size() / 16 + 1) * 16;
+        vector<char> buf(sizeof(struct inotify_event) + nameLen, '\0');
+        auto* event = reinterpret_cast<struct inotify_event*>(buf.data());
+        event->wd = wd;
+        event->mask = mask;
+        event->cookie = cookie;
+        event->len = nameLen;
+        memcpy(buf.data() + sizeof(struct inotify_event), name.data(), name.size());
+        mBuffer.insert(mBuffer.end(), buf.begin(), buf.end());
+    }
+
+    string ToString(const vector<Event*>& events) {
+        string res;
+        for (const auto* event : events) {
+            res.append(event->GetSource()).append("/").append(event->GetEventObject());
+            res.append(":").append(event->GetTypeString()).append(";");
+        }
+        return res;
+    }
+
+    void FreeEvents(vector<Event*>& events) {
+        for (auto* event : events) {
+            delete event;
+        }
+        events.clear();
+    }
+
+    string ReadAllEvents(EventListener* listener) {
+        vector<Event*> events;
+        string res;
+        for (size_t i = 0; i < 20; ++i) {
+            this_thread::sleep_for(chrono::milliseconds(50));
+            listener->ReadEvents(events);
+            res += ToString(events);
+            FreeEvents(events);
+        }
+        return res;
+    }
+
+    vector<char> mBuffer;
+};
+
+void EventListenerUnittest::TestParseEvents() {
+    AppendEvent(1, IN_MODIFY, "a.log");
+    AppendEvent(1, IN_MODIFY, "b.log");
+    AppendEvent(1, IN_MODIFY, "a.log");
+    AppendEvent(2, IN_MODIFY, "a.log");
+    // not registered
+    AppendEvent(3, IN_MODIFY, "a.log");
+    AppendEvent(1, IN_MODIFY, "a.log");
+    // a.log is rotated, the modifications after must not be merged into the ones before
+    AppendEvent(1, IN_MOVED_FROM, "a.log", 1);
+    AppendEvent(1, IN_MOVED_TO, "a.log.1", 1);
+    AppendEvent(1, IN_CREATE, "a.log");
+    AppendEvent(1, IN_MODIFY, "a.log");
+    AppendEvent(1, IN_MODIFY, "a.log.1");
+    AppendEvent(1, IN_MODIFY, "a.log");
+    AppendEvent(1, IN_CREATE | IN_ISDIR, "sub");
+    AppendEvent(1, IN_MODIFY, "b.log");
+    AppendEvent(2, IN_DELETE_SELF, "");
+
+    vector<Event*> events;
+    APSARA_TEST_EQUAL(static_cast<int32_t>(mBuffer.size()),
+                      EventListener::GetInstance()->ParseEvents(mBuffer.data(), mBuffer.size(), events));
+    APSARA_TEST_EQUAL(string("/var/log/a.log:MODIFY;/var/log/b.log:MODIFY;/home/admin/logs/a.log:MODIFY;"
+                             "/var/log/a.log:MOVED_FROM;/var/log/a.log.1:MOVED_TO;/var/log/a.log:CREATE;"
+                             "/var/log/a.log:MODIFY;/var/log/a.log.1:MODIFY;/var/log/sub:ISDIR | CREATE;"
+                             "/home/admin/logs/:DELETE_SELF;"),
+                      ToString(events));
+    APSARA_TEST_EQUAL(1U, events[3]->GetCookie());
+    FreeEvents(events);
+}
+
+void EventListenerUnittest::TestParseHalfEvent() {
+    AppendEvent(1, IN_MODIFY, "a.log");
+    size_t firstSize = mBuffer.size();
+    AppendEvent(1, IN_CREATE, "b.log");
+
+    vector<Event*> events;
+    auto* listener = EventListener::GetInstance();
+    APSARA_TEST_EQUAL(static_cast<int32_t>(firstSize), listener->ParseEvents(mBuffer.data(), firstSize + 8, events));
+    APSARA_TEST_EQUAL(1U, events.size());
+    FreeEvents(events);
+    APSARA_TEST_EQUAL(static_cast<int32_t>(firstSize),
+                      listener->ParseEvents(mBuffer.data(), mBuffer.size() - 1, events));
+    FreeEvents(events);
+    APSARA_TEST_EQUAL(static_cast<int32_t>(mBuffer.size() - firstSize),
+                      listener->ParseEvents(mBuffer.data() + firstSize, mBuffer.size() - firstSize, events));
+    APSARA_TEST_EQUAL(string("/var/log/b.log:CREATE;"), ToString(events));
+    FreeEvents(events);
+}
+
+void EventListenerUnittest::TestEventPool() {
+    auto* event = new Event("/var/log", "a.log", EVENT_MODIFY, 1);
+    void* ptr = event;
+    delete event;
+    // the freed memory is reused
+    event = new Event("/var/log", "b.log", EVENT_CREATE, 1);
+    APSARA_TEST_EQUAL(ptr, static_cast<void*>(event));
+    APSARA_TEST_EQUAL(string("b.log"), event->GetEventObject());
+    APSARA_TEST_TRUE(event->IsCreate());
+    delete event;
+
+    auto owned = make_unique<Event>("/var/log", "c.log", EVENT_MODIFY, 1);
+    APSARA_TEST_EQUAL(ptr, static_cast<void*>(owned.get()));
+}
+
+void EventListenerUnittest::TestFanotify() {
+    auto* listener = EventListener::GetInstance();
+    listener->Destroy();
+    BOOL_FLAG(fs_events_fanotify_enable) = true;
+    APSARA_TEST_TRUE(listener->Init());
+    BOOL_FLAG(fs_events_fanotify_enable) = false;
+    if (!listener->IsFanotifyEnabled()) {
+        // not permitted, which falls back to inotify
+        listener->Destroy();
+        APSARA_TEST_TRUE(listener->Init());
+        return;
+    }
+
+    auto dir = filesystem::temp_directory_path() / ("EventListenerUnittest_" + to_string(getpid()));
+    filesystem::remove_all(dir);
+    filesystem::create_directories(dir / "sub");
+    int wd = listener->AddWatch(dir.c_str());
+    APSARA_TEST_TRUE(EventListener::IsValidID(wd));
+    APSARA_TEST_FALSE(listener->IsInotifyWatch(wd));
+    APSARA_TEST_EQUAL(wd, listener->AddWatch((dir / "." / "").c_str()));
+    int subWd = listener->AddWatch((dir / "sub").c_str());
+    APSARA_TEST_TRUE(EventListener::IsValidID(subWd));
+    APSARA_TEST_NOT_EQUAL(wd, subWd);
+    auto* dispatcher = EventDispatcher::GetInstance();
+    TearDown();
+    dispatcher->mWdDirInfoMap[wd] = new DirInfo(dir.string(), 0, false, nullptr);
+    dispatcher->mWdDirInfoMap[subWd] = new DirInfo((dir / "sub").string(), 0, false, nullptr);
+
+    {
+        ofstream fout(dir / "a.log");
+        fout << "1" << endl;
+        fout << "2" << endl;
+    }
+    filesystem::rename(dir / "a.log", dir / "b.log");
+    {
+        ofstream fout(dir / "sub" / "c.log");
+        fout << "1" << endl;
+    }
+    // not registered
+    filesystem::create_directories(dir / "other");
+    {
+        ofstream fout(dir / "other" / "d.log");
+        fout << "1" << endl;
+    }
+    APSARA_TEST_EQUAL(dir.string() + "/a.log:CREATE;" + dir.string() + "/a.log:MODIFY;" + dir.string()
+                          + "/a.log:MOVED_FROM;" + dir.string() + "/b.log:MOVED_TO;" + dir.string()
+                          + "/sub/c.log:CREATE;" + dir.string() + "/sub/c.log:MODIFY;" + dir.string()
+                          + "/other:ISDIR | CREATE;",
+                      ReadAllEvents(listener));
+
+    filesystem::remove_all(dir / "sub");
+    string events = ReadAllEvents(listener);
+    EXPECT_NE(string::npos, events.find(dir.string() + "/sub/c.log:DELETE;")) << events;
+    EXPECT_NE(string::npos, events.find(dir.string() + "/sub:ISDIR | DELETE;")) << events;
+    EXPECT_NE(string::npos, events.find(dir.string() + "/sub/:DELETE_SELF;")) << events;
+
+    // the events are dropped once the dir is removed
+    APSARA_TEST_TRUE(listener->RemoveWatch(wd));
+    APSARA_TEST_FALSE(listener->RemoveWatch(wd));
+    {
+        ofstream fout(dir / "b.log");
+        fout << "1" << endl;
+    }
+    APSARA_TEST_EQUAL(string(), ReadAllEvents(listener));
+
+    filesystem::remove_all(dir);
+    listener->Destroy();
+    APSARA_TEST_TRUE(listener->Init());
+    APSARA_TEST_FALSE(listener->IsFanotifyEnabled());
+}
+
+void EventListenerUnittest::TestFanotifyFallback() {
+    auto* listener = EventListener::GetInstance();
+    listener->Destroy();
+    // a fd which can not be marked, as if the filesystem of the dir were not supported by fanotify
+    int fds[2];
+    APSARA_TEST_EQUAL(0, pipe(fds));
+    listener->mFanotifyFd = fds[0];
+    APSARA_TEST_TRUE(listener->IsFanotifyEnabled());
+
+    auto dir = filesystem::temp_directory_path() / ("EventListenerUnittest_" + to_string(getpid()));
+    filesystem::remove_all(dir);
+    filesystem::create_directories(dir);
+    // the inotify watchers reach the limit
+    APSARA_TEST_EQUAL(-1, listener->AddWatch(dir.c_str(), false));
+    APSARA_TEST_EQUAL(ENOSPC, errno);
+    int wd = listener->AddWatch(dir.c_str());
+    APSARA_TEST_TRUE(EventListener::IsValidID(wd));
+    APSARA_TEST_TRUE(listener->IsInotifyWatch(wd));
+    APSARA_TEST_NOT_EQUAL(-1, listener->mInotifyFd);
+    APSARA_TEST_TRUE(listener->mWdHandleMap.empty());
+    auto* dispatcher = EventDispatcher::GetInstance();
+    TearDown();
+    dispatcher->mWdDirInfoMap[wd] = new DirInfo(dir.string(), 0, false, nullptr);
+
+    // the events of the dir are read from inotify
+    {
+        ofstream fout(dir / "a.log");
+        fout << "1" << endl;
+    }
+    APSARA_TEST_EQUAL(dir.string() + "/a.log:CREATE;" + dir.string() + "/a.log:MODIFY;", ReadAllEvents(listener));
+    APSARA_TEST_TRUE(listener->RemoveWatch(wd));
+    {
+        ofstream fout(dir / "a.log");
+        fout << "2" << endl;
+    }
+    APSARA_TEST_EQUAL(string(), ReadAllEvents(listener));
+
+    filesystem::remove_all(dir);
+    listener->Destroy();
+    close(fds[1]);
+    APSARA_TEST_TRUE(listener->Init());
+    APSARA_TEST_FALSE(listener->IsFanotifyEnabled());
+}
+
+UNIT_TEST_CASE(EventListenerUnittest, TestParseEvents)
+UNIT_TEST_CASE(EventListenerUnittest, TestParseHalfEvent)
+UNIT_TEST_CASE(EventListenerUnittest, TestEventPool)
+UNIT_TEST_CASE(EventListenerUnittest, TestFanotify)
+UNIT_TEST_CASE(EventListenerUnittest, TestFanotifyFallback)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,211 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "json/json.h"
+
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "file_server/FileDiscoveryIndex.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class FileDiscoveryIndexUnittest : public testing::Test {
+public:
+    void TestFindCandidates();
+    void TestContainer();
+    void TestRemove();
+
+protected:
+    unique_ptr<FileDiscoveryOptions> CreateOptions(const string& filePath, int32_t maxDepth = 0) {
+        Json::Value configJson;
+        configJson["FilePaths"].append(Json::Value(filePath));
+        configJson["MaxDirSearchDepth"] = maxDepth;
+        auto options = make_unique<FileDiscoveryOptions>();
+        APSARA_TEST_TRUE(options->Init(configJson, mCtx, "test"));
+        return options;
+    }
+
+    set<string> FindMatch(const FileDiscoveryIndex& index,
+                          const vector<pair<string, unique_ptr<FileDiscoveryOptions>>>& options,
+                          const string& path,
+                          const string& name) {
+        set<string> res;
+        vector<FileDiscoveryConfig> candidates;
+        index.FindCandidates(path, name, candidates);
+        for (const auto& candidate : candidates) {
+            if (candidate.first->IsMatch(path, name)) {
+                for (const auto& item : options) {
+                    if (item.second.get() == candidate.first) {
+                        res.insert(item.first);
+                    }
+                }
+            }
+        }
+        return res;
+    }
+
+    set<string> FindMatchBruteForce(const vector<pair<string, unique_ptr<FileDiscoveryOptions>>>& options,
+                                    const string& path,
+                                    const string& name) {
+        set<string> res;
+        for (const auto& item : options) {
+            if (item.second->IsMatch(path, name)) {
+                res.insert(item.first);
+            }
+        }
+        return res;
+    }
+
+    CollectionPipelineContext mCtx;
+};
+
+void FileDiscoveryIndexUnittest::TestFindCandidates() {
+    vector<pair<string, unique_ptr<FileDiscoveryOptions>>> options;
+    options.emplace_back("1", CreateOptions("/var/log/app/*.log", 2));
+    options.emplace_back("2", CreateOptions("/var/log/**/access.log", 1));
+    options.emplace_back("3", CreateOptions("/var/*/app/*.txt"));
+    options.emplace_back("4", CreateOptions("/var/log/a?p/test_*.log", 1));
+    options.emplace_back("5", CreateOptions("/home/admin/logs/*.log"));
+    options.emplace_back("6", CreateOptions("/var/log/app/sub/a*b*c.log", -1));
+    FileDiscoveryIndex index;
+    for (const auto& item : options) {
+        index.Add(item.first, make_pair(item.second.get(), &mCtx));
+    }
+    APSARA_TEST_EQUAL(6U, index.Size());
+
+    vector<FileDiscoveryConfig> candidates;
+    index.FindCandidates("/home/admin/logs", "a.log", candidates);
+    APSARA_TEST_EQUAL(1U, candidates.size());
+    candidates.clear();
+    index.FindCandidates("/tmp", "a.log", candidates);
+    APSARA_TEST_EQUAL(0U, candidates.size());
+    candidates.clear();
+    // configs 3, 4 and 6 are filtered by the file pattern
+    index.FindCandidates("/var/log/app/sub", "access.log", candidates);
+    APSARA_TEST_EQUAL(2U, candidates.size());
+
+    const vector<string> paths = {"/var",
+                                  "/var/log",
+                                  "/var/log/app",
+                                  "/var/log/app/sub",
+                                  "/var/log/app/sub/x",
+                                  "/var/log/app/sub/x/y",
+                                  "/var/log/apq",
+                                  "/var/log/web/access",
+                                  "/var/data/app",
+                                  "/var/data/app/x",
+                                  "/var//log/app",
+                                  "/var/log/application",
+                                  "/home/admin/logs",
+                                  "/home/admin/logs/x",
+                                  "/home/admin",
+                                  "/"};
+    const vector<string> names
+        = {"", "a.log", "access.log", "test_1.log", "abc.log", "axbxc.log", "a.txt", "ac.log", "b.log"};
+    for (const auto& path : paths) {
+        for (const auto& name : names) {
+            EXPECT_EQ(FindMatchBruteForce(options, path, name), FindMatch(index, options, path, name))
+                << path << " " << name;
+        }
+    }
+}
+
+void FileDiscoveryIndexUnittest::TestContainer() {
+    vector<pair<string, unique_ptr<FileDiscoveryOptions>>> options;
+    options.emplace_back("1", CreateOptions("/home/admin/logs/*.log", 1));
+    options.emplace_back("2", CreateOptions("/home/*/logs/*.log"));
+    auto containerInfos = make_shared<vector<ContainerInfo>>();
+    for (size_t i = 0; i < 3; ++i) {
+        ContainerInfo info;
+        info.mID = to_string(i);
+        info.mRealBaseDir = "/logtail_host/containers/" + to_string(i) + "/home/admin/logs";
+        containerInfos->push_back(info);
+    }
+    options[0].second->SetEnableContainerDiscoveryFlag(true);
+    options[0].second->SetContainerInfo(containerInfos);
+    auto wildcardContainerInfos = make_shared<vector<ContainerInfo>>();
+    ContainerInfo info;
+    info.mID = "0";
+    info.mRealBaseDir = "/logtail_host/containers/0/home";
+    wildcardContainerInfos->push_back(info);
+    options[1].second->SetEnableContainerDiscoveryFlag(true);
+    options[1].second->SetContainerInfo(wildcardContainerInfos);
+
+    FileDiscoveryIndex index;
+    for (const auto& item : options) {
+        index.Add(item.first, make_pair(item.second.get(), &mCtx));
+    }
+    const vector<string> paths = {"/logtail_host/containers/0/home/admin/logs",
+                                  "/logtail_host/containers/0/home/admin/logs/x",
+                                  "/logtail_host/containers/0/home/admin/logs/x/y",
+                                  "/logtail_host/containers/0/home/web/logs",
+                                  "/logtail_host/containers/1/home/admin/logs",
+                                  "/logtail_host/containers/3/home/admin/logs",
+                                  "/home/admin/logs"};
+    for (const auto& path : paths) {
+        EXPECT_EQ(FindMatchBruteForce(options, path, "a.log"), FindMatch(index, options, path, "a.log")) << path;
+    }
+
+    // the index must be refreshed once the containers have changed
+    info.mID = "3";
+    info.mRealBaseDir = "/logtail_host/containers/3/home/admin/logs";
+    containerInfos->push_back(info);
+    containerInfos->erase(containerInfos->begin());
+    options[0].second->SetContainerInfo(containerInfos);
+    index.Add("1", make_pair(options[0].second.get(), &mCtx));
+    for (const auto& path : paths) {
+        EXPECT_EQ(FindMatchBruteForce(options, path, "a.log"), FindMatch(index, options, path, "a.log")) << path;
+    }
+    APSARA_TEST_EQUAL(set<string>({"1"}), FindMatch(index, options, "/logtail_host/containers/3/home/admin/logs", ""));
+}
+
+void FileDiscoveryIndexUnittest::TestRemove() {
+    auto options1 = CreateOptions("/var/log/app/*.log");
+    auto options2 = CreateOptions("/var/log/app/sub/*.log");
+    FileDiscoveryIndex index;
+    index.Add("1", make_pair(options1.get(), &mCtx));
+    index.Add("2", make_pair(options2.get(), &mCtx));
+    index.Add("2", make_pair(options2.get(), &mCtx));
+    APSARA_TEST_EQUAL(2U, index.Size());
+
+    index.Remove("2");
+    APSARA_TEST_EQUAL(1U, index.Size());
+    vector<FileDiscoveryConfig> candidates;
+    index.FindCandidates("/var/log/app/sub", "a.log", candidates);
+    APSARA_TEST_EQUAL(1U, candidates.size());
+    APSARA_TEST_EQUAL(options1.get(), candidates[0].first);
+    // the branch of config 2 is pruned
+    const auto* node = index.mRoot.mChildren["var"]->mChildren["log"]->mChildren["app"].get();
+    APSARA_TEST_TRUE(node->mChildren.empty());
+
+    index.Remove("1");
+    index.Remove("1");
+    APSARA_TEST_EQUAL(0U, index.Size());
+    APSARA_TEST_TRUE(index.mRoot.mChildren.empty());
+}
+
+UNIT_TEST_CASE(FileDiscoveryIndexUnittest, TestFindCandidates)
+UNIT_TEST_CASE(FileDiscoveryIndexUnittest, TestContainer)
+UNIT_TEST_CASE(FileDiscoveryIndexUnittest, TestRemove)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
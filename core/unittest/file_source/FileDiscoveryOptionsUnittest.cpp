@@ -15,6 +15,7 @@
 #include <filesystem>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "json/json.h"
 
@@ -33,6 +34,7 @@ public:
     void OnSuccessfulInit() const;
     void OnFailedInit() const;
     void TestFilePaths() const;
+    void TestContainerInfoIndex() const;
 
 private:
     const string pluginType = "test";
@@ -283,9 +285,116 @@ void FileDiscoveryOptionsUnittest::TestFilePaths() const {
     APSARA_TEST_EQUAL("*.log", config->GetFilePattern());
 }
 
+void FileDiscoveryOptionsUnittest::TestContainerInfoIndex() const {
+    Json::Value configJson;
+    configJson["FilePaths"].append(Json::Value("/home/admin/logs/*.log"));
+    FileDiscoveryOptions config;
+    APSARA_TEST_TRUE(config.Init(configJson, ctx, pluginType));
+    config.SetEnableContainerDiscoveryFlag(true);
+    config.SetContainerInfo(make_shared<vector<ContainerInfo>>());
+    config.SetDeduceAndSetContainerBaseDirFunc(
+        [](ContainerInfo& info, const CollectionPipelineContext*, const FileDiscoveryOptions*) {
+            return !info.mRealBaseDir.empty();
+        });
+
+    auto createContainer = [](size_t id, const string& path) {
+        Json::Value container;
+        container["ID"] = to_string(id);
+        container["Path"] = path;
+        return container;
+    };
+    // the latest container whose real base dir contains the path, as found by scanning the list
+    auto findByScan = [&](const string& path) -> const ContainerInfo* {
+        const auto& infos = *config.GetContainerInfo();
+        for (auto it = infos.rbegin(); it != infos.rend(); ++it) {
+            const auto& base = it->mRealBaseDir;
+            if (path.compare(0, base.size(), base) == 0 && (path.size() == base.size() || path[base.size()] == '/')) {
+                return &*it;
+            }
+        }
+        return nullptr;
+    };
+    const vector<string> paths = {"/c/0/home/admin/logs",
+                                  "/c/1/home/admin/logs/sub",
+                                  "/c/2/home",
+                                  "/c/3/home/admin",
+                                  "/c/3/home/admin/logs",
+                                  "/c/4/home/admin/logs1",
+                                  "/c/5",
+                                  "/c/11/home/admin/logs"};
+    auto check = [&]() {
+        APSARA_TEST_TRUE(config.mContainerInfoIndex.IsBuiltFrom(*config.GetContainerInfo()));
+        for (const auto& path : paths) {
+            EXPECT_EQ(findByScan(path), config.GetContainerPathByLogPath(path)) << path;
+        }
+        for (const auto& info : *config.GetContainerInfo()) {
+            EXPECT_EQ(&info, config.GetContainerInfoByID(info.mID)) << info.mID;
+        }
+    };
+
+    // containers with nested base dirs are added, updated and deleted at random
+    uint32_t seed = 1;
+    auto random = [&seed](uint32_t n) {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) % n;
+    };
+    auto randomPath = [&]() {
+        static const vector<string> suffixes = {"", "/home", "/home/admin", "/home/admin/logs", "/home/admin/logs/sub"};
+        return "/c/" + to_string(random(6)) + suffixes[random(suffixes.size())];
+    };
+    for (size_t i = 0; i < 500; ++i) {
+        size_t id = random(50);
+        if (random(4) == 0) {
+            Json::Value container;
+            container["ID"] = to_string(id);
+            APSARA_TEST_TRUE(config.DeleteContainerInfo(container));
+        } else {
+            APSARA_TEST_TRUE(config.UpdateContainerInfo(createContainer(id, randomPath()), &ctx));
+        }
+        check();
+    }
+    APSARA_TEST_EQUAL(nullptr, config.GetContainerInfoByID("50"));
+
+    // full update, the containers kept stay in place
+    vector<string> keptIDs;
+    Json::Value allCmd;
+    for (const auto& info : *config.GetContainerInfo()) {
+        if (random(2) == 0) {
+            keptIDs.push_back(info.mID);
+            allCmd["AllCmd"].append(createContainer(stoul(info.mID), info.mRealBaseDir));
+        }
+    }
+    allCmd["AllCmd"].append(createContainer(100, "/c/3/home"));
+    APSARA_TEST_TRUE(config.UpdateContainerInfo(allCmd, &ctx));
+    APSARA_TEST_EQUAL(keptIDs.size() + 1, config.GetContainerInfo()->size());
+    for (size_t i = 0; i < keptIDs.size(); ++i) {
+        APSARA_TEST_EQUAL(keptIDs[i], (*config.GetContainerInfo())[i].mID);
+    }
+    APSARA_TEST_EQUAL("100", config.GetContainerPathByLogPath("/c/3/home/admin/logs")->mID);
+    check();
+
+    // full update changing the metadata only
+    Json::Value metadataCmd;
+    for (const auto& info : *config.GetContainerInfo()) {
+        auto container = createContainer(stoul(info.mID), info.mRealBaseDir);
+        container["MetaDatas"].append("custom_key");
+        container["MetaDatas"].append("value_" + info.mID);
+        metadataCmd["AllCmd"].append(container);
+    }
+    APSARA_TEST_TRUE(config.UpdateContainerInfo(metadataCmd, &ctx));
+    APSARA_TEST_EQUAL(keptIDs.size() + 1, config.GetContainerInfo()->size());
+    for (const auto& info : *config.GetContainerInfo()) {
+        APSARA_TEST_EQUAL(1U, info.mCustomMetadatas.size());
+        APSARA_TEST_EQUAL("value_" + info.mID, info.mCustomMetadatas[0].second);
+        APSARA_TEST_EQUAL("value_" + info.mID, info.mJson["MetaDatas"][1].asString());
+    }
+    check();
+}
+
 UNIT_TEST_CASE(FileDiscoveryOptionsUnittest, OnSuccessfulInit)
 UNIT_TEST_CASE(FileDiscoveryOptionsUnittest, OnFailedInit)
 UNIT_TEST_CASE(FileDiscoveryOptionsUnittest, TestFilePaths)
+UNIT_TEST_CASE(FileDiscoveryOptionsUnittest, TestContainerInfoIndex)
 
 } // namespace logtail
 
@@ -29,6 +29,7 @@ namespace logtail {
 class MultilineOptionsUnittest : public testing::Test {
 public:
     void OnSuccessfulInit() const;
+    void TestPatternMatch() const;
 
 private:
     const string pluginType = "test";
@@ -212,7 +213,63 @@ void MultilineOptionsUnittest::OnSuccessfulInit() const {
     APSARA_TEST_EQUAL(MultilineOptions::UnmatchedContentTreatment::SINGLE_LINE, config->mUnmatchedContentTreatment);
 }
 
+void MultilineOptionsUnittest::TestPatternMatch() const {
+    string exception;
+    {
+        MultilinePattern pattern(R"(\d{4}-\d{2}-\d{2}.*)");
+        APSARA_TEST_TRUE(pattern.mHasFirstChars);
+        APSARA_TEST_TRUE(pattern.mFirstChars['0']);
+        APSARA_TEST_FALSE(pattern.mFirstChars['\t']);
+        APSARA_TEST_EQUAL("-", pattern.mLiteral);
+        string line = "2024-01-01 12:00:00 start";
+        APSARA_TEST_TRUE(pattern.Match(line.data(), line.size(), exception));
+        line = "\tat com.example.Main";
+        APSARA_TEST_FALSE(pattern.Match(line.data(), line.size(), exception));
+        line = "2024/01/01";
+        APSARA_TEST_FALSE(pattern.Match(line.data(), line.size(), exception));
+        APSARA_TEST_FALSE(pattern.Match(line.data(), 0, exception));
+    }
+    {
+        MultilinePattern pattern(R"(\s+at .*)");
+        APSARA_TEST_FALSE(pattern.mHasFirstChars);
+        APSARA_TEST_EQUAL("at ", pattern.mLiteral);
+        string line = "    at com.example.Main";
+        APSARA_TEST_TRUE(pattern.Match(line.data(), line.size(), exception));
+        line = "Caused by: error";
+        APSARA_TEST_FALSE(pattern.Match(line.data(), line.size(), exception));
+    }
+    {
+        // no prefilter for alternations, matched by the regex only
+        MultilinePattern pattern("ERROR|WARN");
+        APSARA_TEST_FALSE(pattern.mHasFirstChars);
+        APSARA_TEST_TRUE(pattern.mLiteral.empty());
+        string line = "WARN disk full";
+        APSARA_TEST_TRUE(pattern.Match(line.data(), line.size(), exception));
+    }
+    {
+        // the operands of hex and octal escapes are not literal chars
+        MultilinePattern pattern(R"(\x5b\d+)");
+        APSARA_TEST_FALSE(pattern.mHasFirstChars);
+        APSARA_TEST_TRUE(pattern.mLiteral.empty());
+        string line = "[2024-01-01 12:00:00] start";
+        APSARA_TEST_TRUE(pattern.Match(line.data(), line.size(), exception));
+        line = "5b2024";
+        APSARA_TEST_FALSE(pattern.Match(line.data(), line.size(), exception));
+    }
+    {
+        MultilinePattern pattern(R"(\0133\d+\]\s)");
+        APSARA_TEST_FALSE(pattern.mHasFirstChars);
+        APSARA_TEST_TRUE(pattern.mLiteral.empty());
+        string line = "[2024] start";
+        APSARA_TEST_TRUE(pattern.Match(line.data(), line.size(), exception));
+        line = "1332024] start";
+        APSARA_TEST_FALSE(pattern.Match(line.data(), line.size(), exception));
+    }
+    APSARA_TEST_TRUE(exception.empty());
+}
+
 UNIT_TEST_CASE(MultilineOptionsUnittest, OnSuccessfulInit)
+UNIT_TEST_CASE(MultilineOptionsUnittest, TestPatternMatch)
 
 } // namespace logtail
 
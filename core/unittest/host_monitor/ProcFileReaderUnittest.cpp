@@ -0,0 +1,264 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include "common/StringTools.h"
+#include "host_monitor/Constants.h"
+#include "host_monitor/ProcFileReader.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+static const string kTestProcDir = "./proc_file_reader_test";
+
+class ProcFileReaderUnittest : public testing::Test {
+public:
+    void TestRead();
+    void TestMaxOpenFds();
+    void TestRetain();
+    void TestPidReuse();
+    void TestProcessExit();
+    void SyntheticProcfsBenchmark();
+
+protected:
+    void SetUp() override {
+        filesystem::create_directories(kTestProcDir);
+        PROCESS_DIR = kTestProcDir;
+    }
+
+    void TearDown() override {
+        PROCESS_DIR = "/proc";
+        filesystem::remove_all(kTestProcDir);
+    }
+
+private:
+    static string statLine(pid_t pid, uint64_t startTicks) {
+        return to_string(pid) + " (ilogtail) S 1811 1811 1811 0 -1 1077936192 1378102 0 848 0 643169 334268 0 0 20 0 "
+            + "55 0 " + to_string(startTicks)
+            + " 1707982848 46314 18446744073709551615 4227072 53627809 140730946407792 0 0 0 65536 0 4281570 0 0 0 17 "
+              "26 0 0 24 0 0 66246848 67456896 101158912 140730946416312 140730946416341 140730946416341 "
+              "140730946416603 0\n";
+    }
+
+    static void writeFile(pid_t pid, const string& name, const string& content) {
+        auto dir = filesystem::path(kTestProcDir) / to_string(pid);
+        filesystem::create_directories(dir);
+        ofstream ofs(dir / name, std::ios::trunc);
+        ofs << content;
+    }
+
+    static void writeProcess(pid_t pid, uint64_t startTicks) {
+        writeFile(pid, "stat", statLine(pid, startTicks));
+        writeFile(pid, "statm", "416988 46661 13498 12061 0 160061 0\n");
+        writeFile(pid,
+                  "status",
+                  "Name:\tilogtail\nUmask:\t0022\nState:\tS (sleeping)\nUid:\t0\t0\t0\t0\nGid:\t0\t0\t0\t0\n");
+        writeFile(pid, "cmdline", string("./ilogtail\0--flag\0", 18));
+    }
+
+    static bool readAll(ProcFileReader& reader, pid_t pid, ProcFileType type, string& content) {
+        return reader.Read(pid, type, [&](StringView data) {
+            content.assign(data.data(), data.size());
+            return true;
+        });
+    }
+};
+
+void ProcFileReaderUnittest::TestRead() {
+    writeProcess(100, 1304);
+    ProcFileReader reader(16);
+
+    string content;
+    APSARA_TEST_TRUE(readAll(reader, 100, ProcFileType::STAT, content));
+    APSARA_TEST_EQUAL(statLine(100, 1304), content);
+    APSARA_TEST_TRUE(readAll(reader, 100, ProcFileType::STATM, content));
+    APSARA_TEST_EQUAL("416988 46661 13498 12061 0 160061 0\n", content);
+    APSARA_TEST_TRUE(readAll(reader, 100, ProcFileType::CMDLINE, content));
+    APSARA_TEST_EQUAL(string("./ilogtail\0--flag\0", 18), content);
+    APSARA_TEST_EQUAL(3UL, reader.OpenFdCount());
+    APSARA_TEST_EQUAL(1UL, reader.CachedPidCount());
+
+    // files are kept open and read again from the start
+    writeFile(100, "statm", "1 2 3 4 5 6 7\n");
+    APSARA_TEST_TRUE(readAll(reader, 100, ProcFileType::STATM, content));
+    APSARA_TEST_EQUAL("1 2 3 4 5 6 7\n", content);
+    APSARA_TEST_EQUAL(3UL, reader.OpenFdCount());
+
+    // content larger than the initial buffer
+    string longCmdline(10000, 'a');
+    writeFile(100, "cmdline", longCmdline);
+    APSARA_TEST_TRUE(readAll(reader, 100, ProcFileType::CMDLINE, content));
+    APSARA_TEST_EQUAL(longCmdline, content);
+
+    // the result of parser is returned
+    APSARA_TEST_FALSE(reader.Read(100, ProcFileType::STATUS, [](StringView) { return false; }));
+
+    // missing process
+    APSARA_TEST_FALSE(readAll(reader, 200, ProcFileType::STAT, content));
+    APSARA_TEST_EQUAL(1UL, reader.CachedPidCount());
+}
+
+void ProcFileReaderUnittest::TestMaxOpenFds() {
+    writeProcess(100, 1304);
+    ProcFileReader reader(2);
+
+    string content;
+    APSARA_TEST_TRUE(readAll(reader, 100, ProcFileType::STAT, content));
+    APSARA_TEST_TRUE(readAll(reader, 100, ProcFileType::STATM, content));
+    APSARA_TEST_TRUE(readAll(reader, 100, ProcFileType::STATUS, content));
+    APSARA_TEST_TRUE(readAll(reader, 100, ProcFileType::CMDLINE, content));
+    APSARA_TEST_EQUAL(2UL, reader.OpenFdCount());
+    APSARA_TEST_EQUAL(string("./ilogtail\0--flag\0", 18), content);
+}
+
+void ProcFileReaderUnittest::TestRetain() {
+    writeProcess(100, 1304);
+    writeProcess(200, 1305);
+    ProcFileReader reader(16);
+
+    string content;
+    APSARA_TEST_TRUE(readAll(reader, 100, ProcFileType::STAT, content));
+    APSARA_TEST_TRUE(readAll(reader, 200, ProcFileType::STAT, content));
+    APSARA_TEST_TRUE(readAll(reader, 200, ProcFileType::STATM, content));
+    APSARA_TEST_EQUAL(3UL, reader.OpenFdCount());
+
+    reader.Retain({100, 300});
+    APSARA_TEST_EQUAL(1UL, reader.CachedPidCount());
+    APSARA_TEST_EQUAL(1UL, reader.OpenFdCount());
+
+    reader.Clear();
+    APSARA_TEST_EQUAL(0UL, reader.CachedPidCount());
+    APSARA_TEST_EQUAL(0UL, reader.OpenFdCount());
+}
+
+void ProcFileReaderUnittest::TestPidReuse() {
+    writeProcess(100, 1304);
+    ProcFileReader reader(16);
+
+    string content;
+    APSARA_TEST_TRUE(readAll(reader, 100, ProcFileType::STAT, content));
+    APSARA_TEST_TRUE(readAll(reader, 100, ProcFileType::STATM, content));
+    APSARA_TEST_EQUAL(1304UL, reader.mPidFiles[100].mStartTicks);
+
+    // a regular file never fails to read, drop the fds as if the process had exited
+    reader.closeFiles(reader.mPidFiles[100]);
+    writeProcess(100, 2000);
+    APSARA_TEST_TRUE(readAll(reader, 100, ProcFileType::STATM, content));
+    APSARA_TEST_TRUE(readAll(reader, 100, ProcFileType::STAT, content));
+    APSARA_TEST_EQUAL(statLine(100, 2000), content);
+    APSARA_TEST_EQUAL(1UL, reader.PidReusedCount());
+    APSARA_TEST_EQUAL(2000UL, reader.mPidFiles[100].mStartTicks);
+    // fds opened before the start time check are reopened lazily
+    APSARA_TEST_EQUAL(1UL, reader.OpenFdCount());
+}
+
+void ProcFileReaderUnittest::TestProcessExit() {
+    pid_t child = fork();
+    if (child == 0) {
+        pause();
+        _exit(0);
+    }
+    APSARA_TEST_TRUE_FATAL(child > 0);
+    PROCESS_DIR = "/proc";
+    ProcFileReader reader(16);
+
+    string content;
+    APSARA_TEST_TRUE(readAll(reader, child, ProcFileType::STAT, content));
+    APSARA_TEST_TRUE(StartWith(content, to_string(child) + " ("));
+    APSARA_TEST_EQUAL(1UL, reader.OpenFdCount());
+    APSARA_TEST_TRUE(reader.mPidFiles[child].mStartTicks > 0);
+
+    kill(child, SIGKILL);
+    waitpid(child, nullptr, 0);
+    // the cached fd is bound to the exited process
+    APSARA_TEST_FALSE(readAll(reader, child, ProcFileType::STAT, content));
+    APSARA_TEST_EQUAL(0UL, reader.OpenFdCount());
+    APSARA_TEST_EQUAL(0UL, reader.CachedPidCount());
+}
+
+void ProcFileReaderUnittest::SyntheticProcfsBenchmark() {
+    const pid_t pidNum = 2000;
+    const int rounds = 10;
+    for (pid_t pid = 1; pid <= pidNum; ++pid) {
+        writeProcess(pid, 1000 + pid);
+    }
+
+    {
+        // open, getline and split per file, as the system interface used to do
+        uint64_t sum = 0;
+        auto start = chrono::high_resolution_clock::now();
+        for (int round = 0; round < rounds; ++round) {
+            for (pid_t pid = 1; pid <= pidNum; ++pid) {
+                auto dir = filesystem::path(kTestProcDir) / to_string(pid);
+                for (const char* name : {"stat", "statm", "status", "cmdline"}) {
+                    ifstream file((dir / name).string());
+                    string line;
+                    vector<string> fields;
+                    while (getline(file, line)) {
+                        auto parts = SplitString(line, " ");
+                        fields.insert(fields.end(), parts.begin(), parts.end());
+                    }
+                    sum += fields.size();
+                }
+            }
+        }
+        auto end = chrono::high_resolution_clock::now();
+        cout << "[synthetic procfs] ifstream read " << pidNum << " pids x " << rounds << " rounds: "
+             << chrono::duration_cast<chrono::microseconds>(end - start).count() << "us, fields: " << sum << endl;
+    }
+
+    {
+        ProcFileReader reader(pidNum * 4);
+        uint64_t sum = 0;
+        auto start = chrono::high_resolution_clock::now();
+        for (int round = 0; round < rounds; ++round) {
+            for (pid_t pid = 1; pid <= pidNum; ++pid) {
+                for (auto type :
+                     {ProcFileType::STAT, ProcFileType::STATM, ProcFileType::STATUS, ProcFileType::CMDLINE}) {
+                    reader.Read(pid, type, [&](StringView content) {
+                        for (auto field : StringViewSplitter(content, " ")) {
+                            sum += !field.empty();
+                        }
+                        return true;
+                    });
+                }
+            }
+        }
+        auto end = chrono::high_resolution_clock::now();
+        cout << "[synthetic procfs] ProcFileReader read " << pidNum << " pids x " << rounds << " rounds: "
+             << chrono::duration_cast<chrono::microseconds>(end - start).count() << "us, fields: " << sum
+             << ", open fds: " << reader.OpenFdCount() << endl;
+    }
+}
+
+UNIT_TEST_CASE(ProcFileReaderUnittest, TestRead);
+UNIT_TEST_CASE(ProcFileReaderUnittest, TestMaxOpenFds);
+UNIT_TEST_CASE(ProcFileReaderUnittest, TestRetain);
+UNIT_TEST_CASE(ProcFileReaderUnittest, TestPidReuse);
+UNIT_TEST_CASE(ProcFileReaderUnittest, TestProcessExit);
+UNIT_TEST_CASE(ProcFileReaderUnittest, SyntheticProcfsBenchmark);
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -31,6 +31,7 @@ public:
     void TestSwapEvents();
     void TestReserveEvents();
     void TestCopy();
+    void TestSlice();
     void TestDestructor();
     void TestSetMetadata();
     void TestDelMetadata();
@@ -216,6 +217,34 @@ void PipelineEventGroupUnittest::TestCopy() {
     APSARA_TEST_EQUAL(3U, res.GetSourceBuffer().use_count());
 }
 
+void PipelineEventGroupUnittest::TestSlice() {
+    mEventGroup->SetMetadata(EventGroupMetaKey::LOG_FILE_PATH_RESOLVED, std::string("/a/b.log"));
+    for (size_t i = 0; i < 4; ++i) {
+        mEventGroup->AddLogEvent()->SetContent(std::string("key"), std::to_string(i));
+    }
+    auto slice1 = mEventGroup->CreateSlice(0, 1);
+    auto slice2 = mEventGroup->CreateSlice(1, 4);
+    mEventGroup->MutableEvents().clear();
+    APSARA_TEST_EQUAL(1U, slice1.GetEvents().size());
+    APSARA_TEST_EQUAL(3U, slice2.GetEvents().size());
+    APSARA_TEST_EQUAL(&slice2, slice2.MutableEvents()[0]->mPipelineEventGroupPtr);
+    APSARA_TEST_EQUAL("/a/b.log", slice2.GetMetadata(EventGroupMetaKey::LOG_FILE_PATH_RESOLVED).to_string());
+    // each slice allocates from its own source buffer
+    APSARA_TEST_NOT_EQUAL(mEventGroup->GetSourceBuffer(), slice1.GetSourceBuffer());
+    APSARA_TEST_NOT_EQUAL(slice1.GetSourceBuffer(), slice2.GetSourceBuffer());
+    slice2.MutableEvents()[0]->GetSourceBuffer()->CopyString(std::string("value"));
+
+    mEventGroup->MergeSlice(std::move(slice1));
+    mEventGroup->MergeSlice(std::move(slice2));
+    APSARA_TEST_EQUAL(4U, mEventGroup->GetEvents().size());
+    for (size_t i = 0; i < 4; ++i) {
+        auto& e = mEventGroup->MutableEvents()[i];
+        APSARA_TEST_EQUAL(mEventGroup.get(), e->mPipelineEventGroupPtr);
+        APSARA_TEST_EQUAL(std::to_string(i), e.Cast<LogEvent>().GetContent("key").to_string());
+    }
+    APSARA_TEST_EQUAL(2U, mEventGroup->GetExtraSourceBuffers().size());
+}
+
 void PipelineEventGroupUnittest::TestSetMetadata() {
     { // string copy, let kv out of scope
         mEventGroup->SetMetadata(EventGroupMetaKey::LOG_FORMAT, std::string("value1"));
@@ -316,6 +345,7 @@ UNIT_TEST_CASE(PipelineEventGroupUnittest, TestAddEvent)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestSwapEvents)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestReserveEvents)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestCopy)
+UNIT_TEST_CASE(PipelineEventGroupUnittest, TestSlice)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestDestructor)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestSetMetadata)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestDelMetadata)
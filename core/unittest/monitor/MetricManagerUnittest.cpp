@@ -41,11 +41,15 @@ public:
     void TestCreateMetricAutoDelete();
     void TestCreateMetricAutoDeleteMultiThread();
     void TestCreateAndDeleteMetric();
+    void TestCreateLatencyHistogram();
+    void TestCollectShardedCounter();
 };
 
 APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestCreateMetricAutoDelete, 0);
 APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestCreateMetricAutoDeleteMultiThread, 1);
 APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestCreateAndDeleteMetric, 2);
+APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestCreateLatencyHistogram, 3);
+APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestCollectShardedCounter, 4);
 
 
 void MetricManagerUnittest::TestCreateMetricAutoDelete() {
@@ -335,6 +339,64 @@ void MetricManagerUnittest::TestCreateAndDeleteMetric() {
     delete fileMetric1;
 }
 
+void MetricManagerUnittest::TestCreateLatencyHistogram() {
+    MetricsRecordRef record;
+    WriteMetrics::GetInstance()->CreateMetricsRecordRef(record, MetricCategory::METRIC_CATEGORY_UNKNOWN, {});
+    LatencyHistogramPtr histogram = record.CreateLatencyHistogram("latency_ms");
+    WriteMetrics::GetInstance()->CommitMetricsRecordRef(record);
+    const auto& buckets = record->GetCounters();
+    APSARA_TEST_EQUAL(LatencyHistogram::kBucketBoundsMs.size() + 1, buckets.size());
+    APSARA_TEST_EQUAL("latency_ms_le_1", buckets[0]->GetName());
+    APSARA_TEST_EQUAL("latency_ms_le_inf", buckets.back()->GetName());
+
+    OBSERVE_HISTOGRAM(histogram, std::chrono::microseconds(500));
+    OBSERVE_HISTOGRAM(histogram, std::chrono::milliseconds(1));
+    OBSERVE_HISTOGRAM(histogram, std::chrono::milliseconds(30));
+    OBSERVE_HISTOGRAM(histogram, std::chrono::minutes(2));
+    APSARA_TEST_EQUAL(2U, buckets[0]->GetValue());
+    APSARA_TEST_EQUAL(0U, buckets[2]->GetValue());
+    APSARA_TEST_EQUAL(1U, buckets[3]->GetValue());
+    APSARA_TEST_EQUAL(1U, buckets.back()->GetValue());
+
+    // no metric can be added after commit
+    APSARA_TEST_EQUAL(nullptr, record.CreateLatencyHistogram("other_latency_ms"));
+}
+
+void MetricManagerUnittest::TestCollectShardedCounter() {
+    MetricsRecordRef record;
+    WriteMetrics::GetInstance()->CreateMetricsRecordRef(record, MetricCategory::METRIC_CATEGORY_UNKNOWN, {});
+    CounterPtr counter = record.CreateCounter("counter");
+    TimeCounterPtr timeCounter = record.CreateTimeCounter("time_counter");
+    WriteMetrics::GetInstance()->CommitMetricsRecordRef(record);
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < kMetricShardCnt * 2; ++i) {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < 1000; ++j) {
+                ADD_COUNTER(counter, 1UL);
+                ADD_COUNTER(timeCounter, std::chrono::milliseconds(1));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    APSARA_TEST_EQUAL(kMetricShardCnt * 2000, counter->GetValue());
+    APSARA_TEST_EQUAL(kMetricShardCnt * 2000, timeCounter->GetValue());
+
+    ReadMetrics::GetInstance()->UpdateMetrics();
+    MetricsRecord* snapshot = ReadMetrics::GetInstance()->GetHead();
+    APSARA_TEST_EQUAL(kMetricShardCnt * 2000, snapshot->GetCounters()[0]->GetValue());
+    APSARA_TEST_EQUAL(kMetricShardCnt * 2000, snapshot->GetTimeCounters()[0]->GetValue());
+    APSARA_TEST_EQUAL(0U, counter->GetValue());
+
+    // the snapshot is reused by the next collection
+    ADD_COUNTER(counter, 5UL);
+    ReadMetrics::GetInstance()->UpdateMetrics();
+    APSARA_TEST_EQUAL(snapshot, ReadMetrics::GetInstance()->GetHead());
+    APSARA_TEST_EQUAL(5U, snapshot->GetCounters()[0]->GetValue());
+}
+
 } // namespace logtail
 
 int main(int argc, char** argv) {
@@ -0,0 +1,116 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "collection_pipeline/limiter/InputFlowController.h"
+#include "collection_pipeline/limiter/TokenBucket.h"
+#include "common/Flags.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT64(input_flow_control_max_bytes_per_sec);
+
+using namespace std;
+
+namespace logtail {
+
+class InputFlowControllerUnittest : public testing::Test {
+public:
+    void TestTokenBucket();
+    void TestWaitTime();
+    void TestUpdateRate();
+
+protected:
+    void TearDown() override { InputFlowController::GetInstance()->Clear(); }
+};
+
+void InputFlowControllerUnittest::TestTokenBucket() {
+    auto now = chrono::steady_clock::now();
+    TokenBucket bucket(100.0, 10.0, now);
+    APSARA_TEST_EQUAL(0, bucket.GetWaitTime(now).count());
+
+    // a read larger than the burst is admitted, and paid back by waiting
+    bucket.Consume(30.0, now);
+    auto waitTime = bucket.GetWaitTime(now);
+    APSARA_TEST_TRUE(waitTime > chrono::milliseconds(199) && waitTime <= chrono::milliseconds(201));
+    APSARA_TEST_TRUE(bucket.GetWaitTime(now + chrono::milliseconds(100)) > chrono::microseconds(0));
+    APSARA_TEST_EQUAL(0, bucket.GetWaitTime(now + chrono::milliseconds(201)).count());
+
+    // tokens never exceed the burst
+    now += chrono::seconds(10);
+    bucket.Consume(11.0, now);
+    APSARA_TEST_TRUE(bucket.GetWaitTime(now) > chrono::microseconds(0));
+
+    bucket.SetRate(1000.0, 100.0, now);
+    APSARA_TEST_TRUE(bucket.GetWaitTime(now + chrono::milliseconds(2)) == chrono::microseconds(0));
+
+    bucket.SetRate(0.0, 0.0, now);
+    bucket.Consume(1.0, now);
+    APSARA_TEST_TRUE(bucket.GetWaitTime(now) == chrono::microseconds::max());
+}
+
+void InputFlowControllerUnittest::TestWaitTime() {
+    auto* controller = InputFlowController::GetInstance();
+    auto rate = INT64_FLAG(input_flow_control_max_bytes_per_sec);
+    APSARA_TEST_EQUAL(0, controller->GetWaitTime("test_config_1").count());
+
+    controller->ConsumeBytes("test_config_1", rate);
+    auto waitTime = controller->GetWaitTime("test_config_1");
+    APSARA_TEST_TRUE(waitTime > chrono::milliseconds(800));
+    APSARA_TEST_TRUE(waitTime <= chrono::milliseconds(901));
+    // buckets are kept per pipeline
+    APSARA_TEST_EQUAL(0, controller->GetWaitTime("test_config_2").count());
+
+    controller->ConsumeEvents("test_config_2", 1000000000);
+    APSARA_TEST_TRUE(controller->GetWaitTime("test_config_2") > chrono::seconds(1));
+}
+
+void InputFlowControllerUnittest::TestUpdateRate() {
+    auto* controller = InputFlowController::GetInstance();
+    auto maxRate = static_cast<double>(INT64_FLAG(input_flow_control_max_bytes_per_sec));
+    auto now = chrono::steady_clock::now();
+    controller->updateRate(0, 1.0, now);
+    controller->ConsumeBytes("test_config", 10 * 1024 * 1024);
+
+    // processors take 2 cores against a budget of 1, rate shrinks from the throughput
+    now += chrono::seconds(1);
+    controller->updateRate(2000000000, 1.0, now);
+    auto& buckets = controller->mBuckets.at("test_config");
+    APSARA_TEST_EQUAL(5.0 * 1024 * 1024, buckets.mBytes.GetRate());
+    APSARA_TEST_EQUAL(0.0, buckets.mConsumedBytes);
+
+    // back under budget, rate grows again
+    now += chrono::seconds(1);
+    controller->updateRate(2500000000, 1.0, now);
+    double expected = 5.0 * 1024 * 1024 * (1.0 + 0.5 * (0.5 + 1.0) + 0.3 * 0.5);
+    APSARA_TEST_TRUE(abs(expected - buckets.mBytes.GetRate()) < 1.0);
+
+    // no further than the configured max
+    for (int i = 0; i < 20; ++i) {
+        now += chrono::seconds(1);
+        controller->updateRate(2500000000, 1.0, now);
+    }
+    APSARA_TEST_EQUAL(maxRate, buckets.mBytes.GetRate());
+
+    // idle pipelines are dropped
+    now += chrono::seconds(600);
+    controller->updateRate(2500000000, 1.0, now);
+    APSARA_TEST_TRUE(controller->mBuckets.empty());
+}
+
+UNIT_TEST_CASE(InputFlowControllerUnittest, TestTokenBucket)
+UNIT_TEST_CASE(InputFlowControllerUnittest, TestWaitTime)
+UNIT_TEST_CASE(InputFlowControllerUnittest, TestUpdateRate)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
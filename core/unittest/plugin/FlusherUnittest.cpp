@@ -24,9 +24,22 @@ using namespace std;
 
 namespace logtail {
 
+class SharedGroupFlusherMock : public FlusherMock {
+public:
+    bool Send(PipelineEventGroup&& g) override {
+        mReceivedEvents.push_back(g.GetEvents()[0].Get<LogEvent>());
+        mReceivedGroups.emplace_back(std::move(g));
+        return true;
+    }
+
+    vector<const LogEvent*> mReceivedEvents;
+    vector<PipelineEventGroup> mReceivedGroups;
+};
+
 class FlusherUnittest : public testing::Test {
 public:
     void TestStop() const;
+    void TestSendShared() const;
 
 protected:
     void TearDown() override { QueueKeyManager::GetInstance()->Clear(); }
@@ -79,7 +92,25 @@ void FlusherUnittest::TestStop() const {
     }
 }
 
+void FlusherUnittest::TestSendShared() const {
+    SharedGroupFlusherMock mock;
+    auto group = make_shared<PipelineEventGroup>(make_shared<SourceBuffer>());
+    group->AddLogEvent()->SetContent(string("key"), string("value"));
+    const auto* origin = group->GetEvents()[0].Get<LogEvent>();
+
+    // still held by others, so the flusher gets a copy
+    APSARA_TEST_TRUE(mock.SendShared(group));
+    APSARA_TEST_NOT_EQUAL(origin, mock.mReceivedEvents[0]);
+    APSARA_TEST_EQUAL("value", mock.mReceivedGroups[0].GetEvents()[0].Cast<LogEvent>().GetContent("key"));
+    APSARA_TEST_EQUAL(1U, group->GetEvents().size());
+
+    // the last holder takes the group over
+    APSARA_TEST_TRUE(mock.SendShared(std::move(group)));
+    APSARA_TEST_EQUAL(origin, mock.mReceivedEvents[1]);
+}
+
 UNIT_TEST_CASE(FlusherUnittest, TestStop)
+UNIT_TEST_CASE(FlusherUnittest, TestSendShared)
 
 } // namespace logtail
 
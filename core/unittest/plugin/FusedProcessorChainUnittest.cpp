@@ -0,0 +1,223 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "collection_pipeline/plugin/instance/FusedProcessorChain.h"
+#include "collection_pipeline/plugin/instance/ProcessorInstance.h"
+#include "plugin/processor/ProcessorFilterNative.h"
+#include "plugin/processor/ProcessorParseRegexNative.h"
+#include "plugin/processor/inner/ProcessorSplitLogStringNative.h"
+#include "runner/ProcessorRunner.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_BOOL(enable_filter_pushdown);
+DECLARE_FLAG_INT32(process_slice_min_size_bytes);
+
+using namespace std;
+
+namespace logtail {
+
+class FusedProcessorChainUnittest : public testing::Test {
+public:
+    void TestProcess();
+    void TestProcessWithoutSplitter();
+    void TestPushdownFilter();
+    void TestProcessSlices();
+
+protected:
+    void SetUp() override {
+        // pushdown changes the metrics of the skipped processors, see TestPushdownFilter
+        BOOL_FLAG(enable_filter_pushdown) = false;
+        mContext.SetConfigName("test_config");
+        mRegexConfig["SourceKey"] = "content";
+        mRegexConfig["Regex"] = "(\\d+) (\\w+)";
+        mRegexConfig["Keys"] = Json::arrayValue;
+        mRegexConfig["Keys"].append("k1");
+        mRegexConfig["Keys"].append("k2");
+        mFilterConfig["Include"]["k2"] = "a";
+    }
+    void TearDown() override { BOOL_FLAG(enable_filter_pushdown) = true; }
+
+    vector<unique_ptr<ProcessorInstance>> CreateProcessors() {
+        vector<unique_ptr<ProcessorInstance>> processors;
+        processors.emplace_back(
+            make_unique<ProcessorInstance>(new ProcessorSplitLogStringNative(), PluginInstance::PluginMeta("1")));
+        processors.emplace_back(
+            make_unique<ProcessorInstance>(new ProcessorParseRegexNative(), PluginInstance::PluginMeta("2")));
+        processors.emplace_back(
+            make_unique<ProcessorInstance>(new ProcessorFilterNative(), PluginInstance::PluginMeta("3")));
+        APSARA_TEST_TRUE(processors[0]->Init(Json::Value(), mContext));
+        APSARA_TEST_TRUE(processors[1]->Init(mRegexConfig, mContext));
+        APSARA_TEST_TRUE(processors[2]->Init(mFilterConfig, mContext));
+        return processors;
+    }
+
+    vector<PipelineEventGroup> CreateGroups() {
+        vector<PipelineEventGroup> groups;
+        groups.emplace_back(make_shared<SourceBuffer>());
+        auto e = groups[0].AddLogEvent();
+        e->SetContent(string("content"), string("1 a\n2 b\nnot matched\n3 a"));
+        e->SetTimestamp(12345678901);
+        e = groups[0].AddLogEvent();
+        e->SetContent(string("content"), string("4 a"));
+        e->SetTimestamp(12345678901);
+        return groups;
+    }
+
+    CollectionPipelineContext mContext;
+    Json::Value mRegexConfig;
+    Json::Value mFilterConfig;
+};
+
+void FusedProcessorChainUnittest::TestProcess() {
+    auto processors = CreateProcessors();
+    APSARA_TEST_TRUE(processors[0]->GetPlugin()->IsFusableSplitter());
+    APSARA_TEST_TRUE(processors[1]->GetPlugin()->IsFusable());
+    APSARA_TEST_TRUE(processors[2]->GetPlugin()->IsFusable());
+
+    auto expected = CreateGroups();
+    for (auto& p : processors) {
+        p->Process(expected);
+    }
+
+    auto fusedProcessors = CreateProcessors();
+    FusedProcessorChain chain(fusedProcessors[0].get(), {fusedProcessors[1].get(), fusedProcessors[2].get()});
+    APSARA_TEST_TRUE(chain.HasSplitter());
+    APSARA_TEST_EQUAL(2U, chain.GetProcessorCnt());
+    auto groups = CreateGroups();
+    chain.Process(groups);
+
+    APSARA_TEST_EQUAL(3U, groups[0].GetEvents().size());
+    APSARA_TEST_EQUAL(expected[0].ToJsonString(), groups[0].ToJsonString());
+
+    for (size_t i = 0; i < processors.size(); ++i) {
+        APSARA_TEST_EQUAL(processors[i]->mInEventsTotal->GetValue(), fusedProcessors[i]->mInEventsTotal->GetValue());
+        APSARA_TEST_EQUAL(processors[i]->mOutEventsTotal->GetValue(),
+                          fusedProcessors[i]->mOutEventsTotal->GetValue());
+    }
+    APSARA_TEST_EQUAL(2U, fusedProcessors[0]->mInEventsTotal->GetValue());
+    APSARA_TEST_EQUAL(5U, fusedProcessors[0]->mOutEventsTotal->GetValue());
+    APSARA_TEST_EQUAL(4U, fusedProcessors[1]->mOutEventsTotal->GetValue());
+    APSARA_TEST_EQUAL(3U, fusedProcessors[2]->mOutEventsTotal->GetValue());
+}
+
+void FusedProcessorChainUnittest::TestProcessWithoutSplitter() {
+    auto processors = CreateProcessors();
+    auto expected = CreateGroups();
+    for (auto& p : processors) {
+        p->Process(expected);
+    }
+
+    auto fusedProcessors = CreateProcessors();
+    auto groups = CreateGroups();
+    fusedProcessors[0]->Process(groups);
+    FusedProcessorChain chain(nullptr, {fusedProcessors[1].get(), fusedProcessors[2].get()});
+    APSARA_TEST_FALSE(chain.HasSplitter());
+    chain.Process(groups);
+
+    APSARA_TEST_EQUAL(expected[0].ToJsonString(), groups[0].ToJsonString());
+    APSARA_TEST_EQUAL(5U, fusedProcessors[1]->mInEventsTotal->GetValue());
+    APSARA_TEST_EQUAL(3U, fusedProcessors[2]->mOutEventsTotal->GetValue());
+}
+
+void FusedProcessorChainUnittest::TestPushdownFilter() {
+    BOOL_FLAG(enable_filter_pushdown) = true;
+    auto processors = CreateProcessors();
+    auto expected = CreateGroups();
+    for (auto& p : processors) {
+        p->Process(expected);
+    }
+
+    auto fusedProcessors = CreateProcessors();
+    FusedProcessorChain chain(fusedProcessors[0].get(), {fusedProcessors[1].get(), fusedProcessors[2].get()});
+    APSARA_TEST_TRUE(chain.HasPushdownFilter());
+    auto groups = CreateGroups();
+    chain.Process(groups);
+
+    APSARA_TEST_EQUAL(expected[0].ToJsonString(), groups[0].ToJsonString());
+    APSARA_TEST_EQUAL(5U, fusedProcessors[0]->mOutEventsTotal->GetValue());
+    // "2 b" is discarded before parsing
+    APSARA_TEST_EQUAL(4U, fusedProcessors[1]->mInEventsTotal->GetValue());
+    APSARA_TEST_EQUAL(3U, fusedProcessors[1]->mOutEventsTotal->GetValue());
+    APSARA_TEST_EQUAL(4U, fusedProcessors[2]->mInEventsTotal->GetValue());
+    APSARA_TEST_EQUAL(3U, fusedProcessors[2]->mOutEventsTotal->GetValue());
+
+    // nothing to skip when the filter comes first
+    FusedProcessorChain filterFirst(nullptr, {fusedProcessors[2].get(), fusedProcessors[1].get()});
+    APSARA_TEST_FALSE(filterFirst.HasPushdownFilter());
+}
+
+void FusedProcessorChainUnittest::TestProcessSlices() {
+    auto processors = CreateProcessors();
+    auto expected = CreateGroups();
+    for (auto& p : processors) {
+        p->Process(expected);
+    }
+
+    auto* runner = ProcessorRunner::GetInstance();
+    auto threadCnt = runner->mThreadCount;
+    auto minSliceSize = INT32_FLAG(process_slice_min_size_bytes);
+    runner->mThreadCount = 4;
+    INT32_FLAG(process_slice_min_size_bytes) = 1;
+
+    // another thread steals the slices while the chain is running
+    atomic_bool stop = false;
+    thread stealer([&]() {
+        while (!stop) {
+            if (!runner->StealTask()) {
+                this_thread::yield();
+            }
+        }
+    });
+
+    auto fusedProcessors = CreateProcessors();
+    FusedProcessorChain chain(fusedProcessors[0].get(), {fusedProcessors[1].get(), fusedProcessors[2].get()});
+    APSARA_TEST_EQUAL(4U, chain.GetSliceCnt(CreateGroups()[0]));
+    for (size_t i = 0; i < 10; ++i) {
+        auto groups = CreateGroups();
+        chain.Process(groups);
+        APSARA_TEST_EQUAL(expected[0].ToJsonString(), groups[0].ToJsonString());
+        for (auto& e : groups[0].MutableEvents()) {
+            APSARA_TEST_EQUAL(&groups[0], e->GetPipelineEventGroupPtr());
+        }
+    }
+    stop = true;
+    stealer.join();
+
+    // the cpu time of the caller is not reported as the one of the other threads
+    auto groups = CreateGroups();
+    APSARA_TEST_EQUAL(0, chain.Process(groups).count());
+    APSARA_TEST_EQUAL(expected[0].ToJsonString(), groups[0].ToJsonString());
+    runner->mThreadCount = threadCnt;
+    INT32_FLAG(process_slice_min_size_bytes) = minSliceSize;
+
+    for (size_t i = 0; i < processors.size(); ++i) {
+        APSARA_TEST_EQUAL(processors[i]->mInEventsTotal->GetValue() * 11,
+                          fusedProcessors[i]->mInEventsTotal->GetValue());
+        APSARA_TEST_EQUAL(processors[i]->mOutEventsTotal->GetValue() * 11,
+                          fusedProcessors[i]->mOutEventsTotal->GetValue());
+    }
+}
+
+UNIT_TEST_CASE(FusedProcessorChainUnittest, TestProcess)
+UNIT_TEST_CASE(FusedProcessorChainUnittest, TestProcessWithoutSplitter)
+UNIT_TEST_CASE(FusedProcessorChainUnittest, TestPushdownFilter)
+UNIT_TEST_CASE(FusedProcessorChainUnittest, TestProcessSlices)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,229 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <unistd.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "json/json.h"
+
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "common/FileSystemUtil.h"
+#include "common/Flags.h"
+#include "file_server/ConfigManager.h"
+#include "file_server/FileServer.h"
+#include "file_server/polling/PollingDirFile.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(polling_dir_file_thread_num);
+DECLARE_FLAG_INT32(dirfile_stat_count);
+DECLARE_FLAG_INT32(polling_dir_entries_cache_timeout);
+
+using namespace std;
+
+namespace logtail {
+
+class PollingDirFileUnittest : public ::testing::Test {
+public:
+    void TestDirEntryList();
+    void TestDirEntriesCache();
+    void TestParallelPolling();
+
+protected:
+    void SetUp() override {
+        mRootDir = filesystem::temp_directory_path() / ("PollingDirFileUnittest_" + to_string(getpid()));
+        filesystem::remove_all(mRootDir);
+        filesystem::create_directories(mRootDir);
+        auto* polling = PollingDirFile::GetInstance();
+        polling->ClearCache();
+        polling->mRuningFlag = true;
+        polling->mHoldOnFlag = false;
+        mThreadNum = INT32_FLAG(polling_dir_file_thread_num);
+    }
+
+    void TearDown() override {
+        for (const auto& item : mOptions) {
+            FileServer::GetInstance()->RemoveFileDiscoveryConfig(item.first);
+        }
+        mOptions.clear();
+        ConfigManager::GetInstance()->ClearFilePipelineMatchCache();
+        auto* polling = PollingDirFile::GetInstance();
+        polling->ClearCache();
+        polling->mRuningFlag = false;
+        filesystem::remove_all(mRootDir);
+        INT32_FLAG(polling_dir_file_thread_num) = mThreadNum;
+    }
+
+    void AddConfig(const string& name, const string& filePath, int32_t maxDepth) {
+        Json::Value configJson;
+        configJson["FilePaths"].append(Json::Value(filePath));
+        configJson["MaxDirSearchDepth"] = maxDepth;
+        auto options = make_unique<FileDiscoveryOptions>();
+        APSARA_TEST_TRUE(options->Init(configJson, mCtx, "test"));
+        FileServer::GetInstance()->AddFileDiscoveryConfig(name, options.get(), &mCtx);
+        mOptions.emplace_back(name, std::move(options));
+    }
+
+    void CreateFile(const filesystem::path& path) {
+        filesystem::create_directories(path.parent_path());
+        ofstream(path) << "0" << endl;
+    }
+
+    // The entries listed right after the directory is modified are not reused, and the files
+    // modified recently are pushed to PollingModify again.
+    void MakeOld(const filesystem::path& path, chrono::seconds duration) {
+        filesystem::last_write_time(path, filesystem::last_write_time(path) - duration);
+    }
+
+    bool CheckDir(const string& dirPath, DirEntryList& entries) {
+        fsutil::PathStat buf;
+        APSARA_TEST_TRUE(fsutil::PathStat::stat(dirPath, buf));
+        bool newFlag = false;
+        bool reusable = false;
+        PollingDirFile::GetInstance()->CheckAndUpdateDirMatchCache(dirPath, buf, false, newFlag, entries, reusable);
+        return reusable;
+    }
+
+    // ToString returns the entries sorted, since the order of directory listing is undefined.
+    string ToString(const DirEntryList& entries) {
+        set<string> items;
+        size_t pos = 0;
+        DirEntryList::Type type;
+        string name;
+        while (entries.Next(pos, type, name)) {
+            items.insert(to_string(static_cast<int>(type)) + ":" + name + ";");
+        }
+        string res;
+        for (const auto& item : items) {
+            res += item;
+        }
+        return res;
+    }
+
+    filesystem::path mRootDir;
+    CollectionPipelineContext mCtx;
+    vector<pair<string, unique_ptr<FileDiscoveryOptions>>> mOptions;
+    int32_t mThreadNum = 0;
+};
+
+void PollingDirFileUnittest::TestDirEntryList() {
+    DirEntryList entries(2000000000000000000LL, 2000000000);
+    APSARA_TEST_EQUAL(string(), ToString(entries));
+    entries.Add(DirEntryList::Type::DIR, "sub");
+    entries.Add(DirEntryList::Type::REG_FILE, "a.log");
+    entries.Add(DirEntryList::Type::SYMBOLIC, "b");
+    APSARA_TEST_EQUAL(string("1:sub;2:a.log;3:b;"), ToString(entries));
+    size_t pos = 0;
+    DirEntryList::Type type;
+    string name;
+    APSARA_TEST_TRUE(entries.Next(pos, type, name));
+    APSARA_TEST_TRUE(DirEntryList::Type::DIR == type);
+    APSARA_TEST_EQUAL(string("sub"), name);
+    APSARA_TEST_EQUAL(15U, entries.GetDataSize());
+
+    int32_t timeout = INT32_FLAG(polling_dir_entries_cache_timeout);
+    APSARA_TEST_TRUE(entries.IsReusable(2000000000000000000LL, 1999999990, 2000000001, timeout));
+    // the directory has been modified
+    APSARA_TEST_FALSE(entries.IsReusable(2000000000000000001LL, 1999999990, 2000000001, timeout));
+    // the modification in the same second might be missed
+    APSARA_TEST_FALSE(entries.IsReusable(2000000000000000000LL, 1999999999, 2000000001, timeout));
+    // expired
+    APSARA_TEST_FALSE(entries.IsReusable(2000000000000000000LL, 1999999990, 2000000000 + timeout, timeout));
+    APSARA_TEST_FALSE(DirEntryList().IsReusable(0, 0, 2000000001, timeout));
+}
+
+void PollingDirFileUnittest::TestDirEntriesCache() {
+    auto* polling = PollingDirFile::GetInstance();
+    polling->mCurrentRound = 1;
+    string dirPath = mRootDir.string();
+    CreateFile(mRootDir / "a.log");
+    MakeOld(mRootDir, chrono::seconds(10));
+
+    DirEntryList entries;
+    APSARA_TEST_FALSE(CheckDir(dirPath, entries));
+    entries.Add(DirEntryList::Type::REG_FILE, "a.log");
+    polling->UpdateDirEntriesCache(dirPath, std::move(entries));
+    // not cached, since the directory is unknown
+    polling->UpdateDirEntriesCache(dirPath + "/sub", DirEntryList(1, 1));
+
+    APSARA_TEST_TRUE(CheckDir(dirPath, entries));
+    APSARA_TEST_EQUAL(string("2:a.log;"), ToString(entries));
+    APSARA_TEST_EQUAL(1U, polling->mDirCacheMap.size());
+
+    // the entries listed earlier are not saved
+    polling->UpdateDirEntriesCache(dirPath, DirEntryList(entries.GetModifyTime(), entries.GetListTime() - 1));
+    APSARA_TEST_TRUE(CheckDir(dirPath, entries));
+    APSARA_TEST_EQUAL(string("2:a.log;"), ToString(entries));
+
+    CreateFile(mRootDir / "b.log");
+    APSARA_TEST_FALSE(CheckDir(dirPath, entries));
+    APSARA_TEST_EQUAL(string(), ToString(entries));
+}
+
+void PollingDirFileUnittest::TestParallelPolling() {
+    INT32_FLAG(polling_dir_file_thread_num) = 2;
+    auto dirA = mRootDir / "a";
+    auto dirB = mRootDir / "b";
+    CreateFile(dirA / "1.log");
+    CreateFile(dirA / "2.txt");
+    CreateFile(dirA / "sub" / "3.log");
+    CreateFile(dirB / "4.log");
+    for (const auto& file : {dirA / "1.log", dirA / "2.txt", dirA / "sub" / "3.log", dirB / "4.log"}) {
+        MakeOld(file, chrono::hours(24));
+    }
+    for (const auto& dir : {dirA, dirA / "sub", dirB}) {
+        MakeOld(dir, chrono::seconds(10));
+    }
+    AddConfig("a", (dirA / "**" / "*.log").string(), 1);
+    AddConfig("b", (dirB / "*.log").string(), 0);
+
+    auto* polling = PollingDirFile::GetInstance();
+    polling->PollingIteration();
+    APSARA_TEST_EQUAL(3U, polling->mDirCacheMap.size());
+    // 2.txt is matched by no config
+    APSARA_TEST_EQUAL(3U, polling->mFileCacheMap.size());
+    APSARA_TEST_EQUAL(5, polling->mStatCount.load());
+    // the throttle is shared by the 2 workers
+    APSARA_TEST_EQUAL(INT32_FLAG(dirfile_stat_count) / 2, polling->mThrottleStatCount);
+    // files found at round 1 are considered as old data
+    APSARA_TEST_TRUE(polling->mNewFileVec.empty());
+    APSARA_TEST_EQUAL(string("1:sub;2:1.log;"), ToString(polling->mDirCacheMap[dirA.string()].GetEntries()));
+
+    // the unchanged directories are not read again
+    polling->PollingIteration();
+    APSARA_TEST_EQUAL(4, polling->mStatCount.load());
+    APSARA_TEST_TRUE(polling->mNewFileVec.empty());
+
+    CreateFile(dirA / "5.log");
+    polling->PollingIteration();
+    APSARA_TEST_EQUAL(6, polling->mStatCount.load());
+    APSARA_TEST_EQUAL(1U, polling->mNewFileVec.size());
+    APSARA_TEST_EQUAL(dirA.string(), polling->mNewFileVec[0].mFileDir);
+    APSARA_TEST_EQUAL(string("5.log"), polling->mNewFileVec[0].mFileName);
+    APSARA_TEST_EQUAL(4U, polling->mFileCacheMap.size());
+}
+
+UNIT_TEST_CASE(PollingDirFileUnittest, TestDirEntryList)
+UNIT_TEST_CASE(PollingDirFileUnittest, TestDirEntriesCache)
+UNIT_TEST_CASE(PollingDirFileUnittest, TestParallelPolling)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
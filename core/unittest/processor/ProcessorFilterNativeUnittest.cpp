@@ -31,6 +31,7 @@ public:
     void TestLogFilterRule();
     void TestBaseFilter();
     void TestFilterNoneUtf8();
+    void TestPushdownFilter();
 
     CollectionPipelineContext mContext;
 };
@@ -40,6 +41,7 @@ UNIT_TEST_CASE(ProcessorFilterNativeUnittest, OnFailedInit)
 UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestLogFilterRule)
 UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestBaseFilter)
 UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestFilterNoneUtf8)
+UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestPushdownFilter)
 
 PluginInstance::PluginMeta getPluginMeta() {
     PluginInstance::PluginMeta pluginMeta{"1"};
@@ -1111,6 +1113,71 @@ void ProcessorFilterNativeUnittest::TestFilterNoneUtf8() {
     }
 } // end of case
 
+void ProcessorFilterNativeUnittest::TestPushdownFilter() {
+    {
+        Json::Value config;
+        config["FilterKey"] = Json::arrayValue;
+        config["FilterRegex"] = Json::arrayValue;
+        vector<pair<string, string>> cases = {{"k1", "GET /api.*"},
+                                              {"k2", "\\d+ms(ec)?"},
+                                              {"k3", "ab?cdef"},
+                                              {"k4", "[a-z]+\\.log"},
+                                              {"k5", "error|warn"},
+                                              {"k6", "(?i)error"},
+                                              {"k7", "x\"y\"zw"},
+                                              {"k8", "\\x5b\\d+"},
+                                              {"k9", "(\\Q)\\E)abc"}};
+        for (const auto& item : cases) {
+            config["FilterKey"].append(item.first);
+            config["FilterRegex"].append(item.second);
+        }
+        ProcessorFilterNative& processor = *(new ProcessorFilterNative);
+        ProcessorInstance processorInstance(&processor, getPluginMeta());
+        APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, mContext));
+        APSARA_TEST_TRUE(processor.InitPushdownFilter("\""));
+        vector<string> expected = {"GET /api", "ms", "cdef", ".log", "zw"};
+        APSARA_TEST_EQUAL(expected, processor.mPushdownLiterals);
+    }
+    {
+        Json::Value root;
+        root["operator"] = "and";
+        Json::Value operands1;
+        operands1["key"] = "key1";
+        operands1["exp"] = ".*value1";
+        operands1["type"] = "regex";
+        Json::Value operands2;
+        operands2["operator"] = "not";
+        operands2["operands"].append(operands1);
+        root["operands"].append(operands1);
+        root["operands"].append(operands2);
+        Json::Value config;
+        config["ConditionExp"] = root;
+        ProcessorFilterNative& processor = *(new ProcessorFilterNative);
+        ProcessorInstance processorInstance(&processor, getPluginMeta());
+        APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, mContext));
+        // predicates under not are not required
+        APSARA_TEST_TRUE(processor.InitPushdownFilter(""));
+        APSARA_TEST_EQUAL(vector<string>{"value1"}, processor.mPushdownLiterals);
+
+        PipelineEventGroup eventGroup(make_shared<SourceBuffer>());
+        auto e1 = eventGroup.AddLogEvent();
+        e1->SetContent(string("content"), string("key1=avalue1 key2=b"));
+        auto e2 = eventGroup.AddLogEvent();
+        e2->SetContent(string("content"), string("key1=avalue2 key2=b"));
+        APSARA_TEST_TRUE(processor.PushdownFilterEvent(eventGroup.GetEvents()[0]));
+        APSARA_TEST_FALSE(processor.PushdownFilterEvent(eventGroup.GetEvents()[1]));
+        APSARA_TEST_EQUAL(1U, processor.mDiscardedBeforeParseEventsTotal->GetValue());
+    }
+    {
+        Json::Value config;
+        config["Include"]["key1"] = ".*";
+        ProcessorFilterNative& processor = *(new ProcessorFilterNative);
+        ProcessorInstance processorInstance(&processor, getPluginMeta());
+        APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, mContext));
+        APSARA_TEST_FALSE(processor.InitPushdownFilter(""));
+    }
+}
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
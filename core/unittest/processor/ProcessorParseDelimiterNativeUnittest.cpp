@@ -18,6 +18,7 @@
 #include "common/JsonUtil.h"
 #include "config/CollectionConfig.h"
 #include "models/LogEvent.h"
+#include "parser/DelimiterModeFsmParser.h"
 #include "plugin/processor/ProcessorParseDelimiterNative.h"
 #include "plugin/processor/inner/ProcessorMergeMultilineLogNative.h"
 #include "plugin/processor/inner/ProcessorSplitLogStringNative.h"
@@ -47,6 +48,7 @@ public:
     void TestAllowingShortenedFields();
     void TestExtend();
     void TestEmpty();
+    void TestBitmaskParser();
     CollectionPipelineContext mContext;
 };
 
@@ -64,6 +66,7 @@ UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestProcessEventDiscardUnm
 UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestAllowingShortenedFields);
 UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestExtend);
 UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestEmpty);
+UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestBitmaskParser);
 
 PluginInstance::PluginMeta getPluginMeta() {
     PluginInstance::PluginMeta pluginMeta{"1"};
@@ -2574,6 +2577,38 @@ void ProcessorParseDelimiterNativeUnittest::TestEmpty() {
     }
 }
 
+void ProcessorParseDelimiterNativeUnittest::TestBitmaskParser() {
+    // same columns as the fsm parser, including quotes across the 64 bytes blocks
+    std::string longField(100, 'x');
+    std::vector<std::string> lines = {"a,b,c",
+                                      ",,",
+                                      "\"a,b\",c",
+                                      "\"a\"\"b\",\"\"",
+                                      "\"\"\"\"",
+                                      "\"" + longField + "," + longField + "\"," + longField,
+                                      longField + ",\"" + longField + "\"\"" + longField + "\",c",
+                                      // invalid
+                                      "a\"b,c",
+                                      "\"a\"b,c",
+                                      "\"a,b",
+                                      "\"a\"\",b",
+                                      "\"" + longField + ",b"};
+    DelimiterModeFsmParser fsmParser('"', ',');
+    DelimiterModeBitmaskParser bitmaskParser('"', ',');
+    for (const auto& line : lines) {
+        PipelineEventGroup group(std::make_shared<SourceBuffer>());
+        auto* event = group.AddLogEvent();
+        std::vector<StringView> expected, actual;
+        bool expectedRes = fsmParser.ParseDelimiterLine(line, 0, line.size(), expected, *event);
+        bool actualRes = bitmaskParser.ParseDelimiterLine(line, 0, line.size(), actual, *event);
+        EXPECT_EQ(expectedRes, actualRes) << line;
+        EXPECT_EQ(expected.size(), actual.size()) << line;
+        for (size_t i = 0; i < expected.size() && i < actual.size(); ++i) {
+            EXPECT_EQ(expected[i], actual[i]) << line;
+        }
+    }
+}
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
@@ -39,6 +39,8 @@ public:
     void TestBuildScrapeSchedulerSet();
     void TestTargetLabels();
     void TestTargetsInfoToString();
+    void TestParseInvalidTargetGroups();
+    void TestIncrementalSubscription();
 
 protected:
     void SetUp() override {
@@ -596,12 +598,101 @@ void TargetSubscriberSchedulerUnittest::TestTargetsInfoToString() {
     APSARA_TEST_EQUAL((uint64_t)3, data[prometheus::TARGETS_INFO].size());
 }
 
+void TargetSubscriberSchedulerUnittest::TestParseInvalidTargetGroups() {
+    std::shared_ptr<TargetSubscriberScheduler> targetSubscriber = std::make_shared<TargetSubscriberScheduler>();
+    APSARA_TEST_TRUE(targetSubscriber->Init(mConfig["ScrapeConfig"]));
+
+    std::vector<PromTargetInfo> targetGroup;
+    APSARA_TEST_FALSE(targetSubscriber->ParseScrapeSchedulerGroup(R"JSON({"targets": []})JSON", targetGroup));
+    APSARA_TEST_FALSE(targetSubscriber->ParseScrapeSchedulerGroup(R"JSON([1])JSON", targetGroup));
+    APSARA_TEST_FALSE(
+        targetSubscriber->ParseScrapeSchedulerGroup(R"JSON([{"targets": [1], "labels": {}}])JSON", targetGroup));
+    APSARA_TEST_FALSE(targetSubscriber->ParseScrapeSchedulerGroup(R"JSON([{"targets": [)JSON", targetGroup));
+    APSARA_TEST_TRUE(targetGroup.empty());
+
+    // unknown members are skipped and non-string label values are kept as text
+    string content = R"JSON([
+        {
+            "targets": ["192.168.22.7:8080"],
+            "extra": {"nested": [1, {"a": "b"}]},
+            "labels": {
+                "__address__": "192.168.22.7:8080",
+                "port": 8080,
+                "ready": true
+            },
+            "Load": 425
+        },
+        {
+            "targets": [],
+            "labels": {
+                "__address__": "192.168.22.8:8080"
+            }
+        }
+    ])JSON";
+    APSARA_TEST_TRUE(targetSubscriber->ParseScrapeSchedulerGroup(content, targetGroup));
+    APSARA_TEST_EQUAL(1UL, targetGroup.size());
+    APSARA_TEST_EQUAL("192.168.22.7:8080", targetGroup[0].mInstance);
+    APSARA_TEST_EQUAL("8080", targetGroup[0].mLabels.Get("port"));
+    APSARA_TEST_EQUAL("true", targetGroup[0].mLabels.Get("ready"));
+}
+
+void TargetSubscriberSchedulerUnittest::TestIncrementalSubscription() {
+    std::shared_ptr<TargetSubscriberScheduler> targetSubscriber = std::make_shared<TargetSubscriberScheduler>();
+    auto metricLabels = MetricLabels();
+    APSARA_TEST_TRUE(targetSubscriber->Init(mConfig["ScrapeConfig"]));
+    targetSubscriber->InitSelfMonitor(metricLabels);
+
+    string targetA = R"JSON({"targets": ["192.168.22.31:6443"], "labels": {"__address__": "192.168.22.31:6443"}})JSON";
+    string targetB = R"JSON({"targets": ["192.168.22.33:6443"], "labels": {"__address__": "192.168.22.33:6443"}})JSON";
+    string targetC = R"JSON({"targets": ["192.168.22.35:6443"], "labels": {"__address__": "192.168.22.35:6443"}})JSON";
+
+    HttpResponse response;
+    response.SetStatusCode(200);
+    *response.GetBody<string>() = "[" + targetA + "," + targetB + "]";
+    targetSubscriber->OnSubscription(response, 0);
+    APSARA_TEST_EQUAL(2UL, targetSubscriber->mScrapeSchedulerMap.size());
+    auto snapshot = targetSubscriber->mScrapeSchedulerMap;
+
+    // unchanged document, even without a matching ETag, leaves every scheduler untouched
+    targetSubscriber->OnSubscription(response, 0);
+    APSARA_TEST_EQUAL(2UL, targetSubscriber->mScrapeSchedulerMap.size());
+    for (const auto& [k, v] : snapshot) {
+        APSARA_TEST_EQUAL(v.get(), targetSubscriber->mScrapeSchedulerMap[k].get());
+    }
+
+    // surviving targets reuse their schedulers, only the new one is built
+    *response.GetBody<string>() = "[" + targetB + "," + targetC + "]";
+    auto built = [&]() {
+        std::vector<PromTargetInfo> targetGroup;
+        targetSubscriber->ParseScrapeSchedulerGroup(*response.GetBody<string>(), targetGroup);
+        return targetSubscriber->BuildScrapeSchedulerSet(targetGroup);
+    }();
+    APSARA_TEST_EQUAL(2UL, built.size());
+    size_t reused = 0;
+    for (const auto& [k, v] : built) {
+        auto iter = snapshot.find(k);
+        if (iter != snapshot.end()) {
+            APSARA_TEST_EQUAL(iter->second.get(), v.get());
+            ++reused;
+        }
+    }
+    APSARA_TEST_EQUAL(1UL, reused);
+
+    targetSubscriber->OnSubscription(response, 0);
+    APSARA_TEST_EQUAL(2UL, targetSubscriber->mScrapeSchedulerMap.size());
+    for (const auto& [k, v] : built) {
+        APSARA_TEST_EQUAL(1UL, targetSubscriber->mScrapeSchedulerMap.count(k));
+    }
+}
+
 UNIT_TEST_CASE(TargetSubscriberSchedulerUnittest, OnInitScrapeJobEvent)
 UNIT_TEST_CASE(TargetSubscriberSchedulerUnittest, TestProcess)
 UNIT_TEST_CASE(TargetSubscriberSchedulerUnittest, TestParseTargetGroups)
 UNIT_TEST_CASE(TargetSubscriberSchedulerUnittest, TestBuildScrapeSchedulerSet)
 UNIT_TEST_CASE(TargetSubscriberSchedulerUnittest, TestTargetLabels)
 UNIT_TEST_CASE(TargetSubscriberSchedulerUnittest, TestTargetsInfoToString)
+UNIT_TEST_CASE(TargetSubscriberSchedulerUnittest, TestParseInvalidTargetGroups)
+UNIT_TEST_CASE(TargetSubscriberSchedulerUnittest, TestIncrementalSubscription)
 
 } // namespace logtail
 
@@ -19,6 +19,7 @@
 #include "collection_pipeline/queue/ProcessQueueManager.h"
 #include "collection_pipeline/queue/QueueKeyManager.h"
 #include "collection_pipeline/queue/QueueParam.h"
+#include "common/memory/MemoryAccountant.h"
 #include "models/PipelineEventGroup.h"
 #include "unittest/Unittest.h"
 
@@ -35,6 +36,7 @@ public:
     void TestPushQueue();
     void TestPopItem();
     void TestIsAllQueueEmpty();
+    void TestIsValidToPushUnderMemoryPressure();
     void OnPipelineUpdate();
 
 protected:
@@ -442,6 +444,36 @@ void ProcessQueueManagerUnittest::OnPipelineUpdate() {
     }
 }
 
+void ProcessQueueManagerUnittest::TestIsValidToPushUnderMemoryPressure() {
+    auto* accountant = MemoryAccountant::GetInstance();
+    accountant->SetPressureLevel(MemoryPressureLevel::PAUSE_INPUT);
+    CollectionPipelineContext ctx;
+
+    // all pipelines share the same priority, none is paused
+    QueueKey key1 = QueueKeyManager::GetInstance()->GetKey("test_config_1");
+    QueueKey key2 = QueueKeyManager::GetInstance()->GetKey("test_config_2");
+    sProcessQueueManager->CreateOrUpdateBoundedQueue(key1, 1, ctx);
+    sProcessQueueManager->CreateOrUpdateBoundedQueue(key2, 1, ctx);
+    APSARA_TEST_TRUE(sProcessQueueManager->IsValidToPush(key1));
+    APSARA_TEST_TRUE(sProcessQueueManager->IsValidToPush(key2));
+
+    // only the lowest priority in use is paused
+    QueueKey key3 = QueueKeyManager::GetInstance()->GetKey("test_config_3");
+    sProcessQueueManager->CreateOrUpdateBoundedQueue(key3, 0, ctx);
+    APSARA_TEST_FALSE(sProcessQueueManager->IsValidToPush(key1));
+    APSARA_TEST_FALSE(sProcessQueueManager->IsValidToPush(key2));
+    APSARA_TEST_TRUE(sProcessQueueManager->IsValidToPush(key3));
+
+    QueueKey key4 = QueueKeyManager::GetInstance()->GetKey("test_config_4");
+    sProcessQueueManager->CreateOrUpdateBoundedQueue(key4, 2, ctx);
+    APSARA_TEST_TRUE(sProcessQueueManager->IsValidToPush(key1));
+    APSARA_TEST_TRUE(sProcessQueueManager->IsValidToPush(key3));
+    APSARA_TEST_FALSE(sProcessQueueManager->IsValidToPush(key4));
+
+    accountant->SetPressureLevel(MemoryPressureLevel::NORMAL);
+    APSARA_TEST_TRUE(sProcessQueueManager->IsValidToPush(key4));
+}
+
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestUpdateSameTypeQueue)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestUpdateDifferentTypeQueue)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestDeleteQueue)
@@ -449,6 +481,7 @@ UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestSetQueueUpstreamAndDownStream)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestPushQueue)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestPopItem)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestIsAllQueueEmpty)
+UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestIsValidToPushUnderMemoryPressure)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, OnPipelineUpdate)
 
 } // namespace logtail
@@ -0,0 +1,349 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <filesystem>
+#include <fstream>
+
+#include "collection_pipeline/CollectionPipeline.h"
+#include "collection_pipeline/queue/SLSSenderQueueItem.h"
+#include "collection_pipeline/queue/SenderQueue.h"
+#include "collection_pipeline/queue/SenderQueueSpillStore.h"
+#include "common/Flags.h"
+#include "unittest/Unittest.h"
+#include "unittest/queue/FeedbackInterfaceMock.h"
+
+DECLARE_FLAG_INT64(sender_queue_spill_threshold_bytes);
+
+using namespace std;
+
+namespace logtail {
+
+static const filesystem::path kSpillDir = "./sender_queue_spill_test";
+
+class SenderQueueSpillStoreUnittest : public testing::Test {
+public:
+    void TestAppendAndPop();
+    void TestRotate();
+    void TestRecovery();
+    void TestSpillInSenderQueue();
+    void TestReplayAfterRestart();
+    void TestUnspillableItem();
+
+protected:
+    static void SetUpTestCase() { BoundedSenderQueueInterface::SetFeedback(&sFeedback); }
+
+    void SetUp() override { filesystem::remove_all(kSpillDir); }
+    void TearDown() override { filesystem::remove_all(kSpillDir); }
+
+private:
+    static unique_ptr<SenderQueueItem> generateItem(const string& data) {
+        return make_unique<SenderQueueItem>(string(data), data.size() * 2, nullptr, 0);
+    }
+
+    static vector<string> popAll(SenderQueue& queue) {
+        vector<string> sent;
+        for (int round = 0; round < 10; ++round) {
+            vector<SenderQueueItem*> items;
+            queue.GetAvailableItems(items, -1);
+            for (auto* item : items) {
+                sent.push_back(item->mData);
+                queue.Remove(item);
+            }
+        }
+        return sent;
+    }
+
+    static FeedbackInterfaceMock sFeedback;
+
+    static size_t segmentCnt() {
+        size_t cnt = 0;
+        for (const auto& entry : filesystem::directory_iterator(kSpillDir)) {
+            cnt += entry.path().extension() == ".log";
+        }
+        return cnt;
+    }
+};
+
+FeedbackInterfaceMock SenderQueueSpillStoreUnittest::sFeedback;
+
+void SenderQueueSpillStoreUnittest::TestAppendAndPop() {
+    SenderQueueSpillStore store(kSpillDir, 1024 * 1024);
+    APSARA_TEST_TRUE(store.Open());
+    APSARA_TEST_TRUE(store.Empty());
+
+    store.Append(*generateItem("first"));
+    SLSSenderQueueItem slsItem(
+        "second", 100, nullptr, 0, "logstore", RawDataType::EVENT_GROUP_LIST, "hash_key", nullptr, false);
+    store.Append(slsItem);
+    APSARA_TEST_EQUAL(2U, store.Size());
+    APSARA_TEST_EQUAL(11U, store.DataSizeBytes());
+    APSARA_TEST_TRUE(store.PendingSizeBytes() > 0);
+    APSARA_TEST_TRUE(store.Commit());
+    APSARA_TEST_EQUAL(0U, store.PendingSizeBytes());
+
+    // uncommitted items are committed before being read
+    store.Append(*generateItem("third"));
+
+    auto item = store.Pop(nullptr, 1);
+    APSARA_TEST_TRUE(item != nullptr);
+    APSARA_TEST_EQUAL("first", item->mData);
+    APSARA_TEST_EQUAL(10U, item->mRawSize);
+    APSARA_TEST_EQUAL(RawDataType::EVENT_GROUP, item->mType);
+    APSARA_TEST_TRUE(item->mBufferOrNot);
+    APSARA_TEST_EQUAL(1U, item->mQueueKey);
+
+    item = store.Pop(nullptr, 1);
+    auto sls = dynamic_cast<SLSSenderQueueItem*>(item.get());
+    APSARA_TEST_TRUE(sls != nullptr);
+    APSARA_TEST_EQUAL("second", sls->mData);
+    APSARA_TEST_EQUAL(100U, sls->mRawSize);
+    APSARA_TEST_EQUAL(RawDataType::EVENT_GROUP_LIST, sls->mType);
+    APSARA_TEST_FALSE(sls->mBufferOrNot);
+    APSARA_TEST_EQUAL("logstore", sls->mLogstore);
+    APSARA_TEST_EQUAL("hash_key", sls->mShardHashKey);
+
+    item = store.Pop(nullptr, 1);
+    APSARA_TEST_EQUAL("third", item->mData);
+    APSARA_TEST_TRUE(store.Empty());
+    APSARA_TEST_EQUAL(0U, store.DataSizeBytes());
+    APSARA_TEST_TRUE(store.Pop(nullptr, 1) == nullptr);
+}
+
+void SenderQueueSpillStoreUnittest::TestRotate() {
+    SenderQueueSpillStore store(kSpillDir, 64);
+    APSARA_TEST_TRUE(store.Open());
+    for (int i = 0; i < 5; ++i) {
+        store.Append(*generateItem(string(30, 'a' + i)));
+        APSARA_TEST_TRUE(store.Commit());
+    }
+    APSARA_TEST_EQUAL(5U, store.mSegments.size());
+    APSARA_TEST_EQUAL(5U, segmentCnt());
+
+    for (int i = 0; i < 3; ++i) {
+        auto item = store.Pop(nullptr, 0);
+        APSARA_TEST_EQUAL(string(30, 'a' + i), item->mData);
+    }
+    // replayed segments are removed
+    APSARA_TEST_EQUAL(3U, segmentCnt());
+    APSARA_TEST_EQUAL(2U, store.Size());
+
+    store.Pop(nullptr, 0);
+    store.Pop(nullptr, 0);
+    APSARA_TEST_TRUE(store.Empty());
+    APSARA_TEST_EQUAL(1U, segmentCnt());
+}
+
+void SenderQueueSpillStoreUnittest::TestRecovery() {
+    {
+        SenderQueueSpillStore store(kSpillDir, 1024 * 1024);
+        APSARA_TEST_TRUE(store.Open());
+        for (int i = 0; i < 4; ++i) {
+            store.Append(*generateItem(to_string(i)));
+        }
+        APSARA_TEST_TRUE(store.Commit());
+        APSARA_TEST_EQUAL("0", store.Pop(nullptr, 0)->mData);
+    }
+    {
+        // a record torn by a crash during write
+        auto path = kSpillDir / "segment_0.log";
+        auto size = filesystem::file_size(path);
+        ofstream fout(path, ios::app | ios::binary);
+        fout << string("\x54\x53\x51\x53\x20\x00\x00\x00", 8);
+        fout.close();
+        APSARA_TEST_EQUAL(size + 8, filesystem::file_size(path));
+
+        SenderQueueSpillStore store(kSpillDir, 1024 * 1024);
+        APSARA_TEST_TRUE(store.Open());
+        APSARA_TEST_EQUAL(size, filesystem::file_size(path));
+        // the item taken back before is not replayed
+        APSARA_TEST_EQUAL(3U, store.Size());
+        APSARA_TEST_EQUAL("1", store.Pop(nullptr, 0)->mData);
+
+        // new items are appended after the valid ones
+        store.Append(*generateItem("4"));
+        APSARA_TEST_TRUE(store.Commit());
+    }
+    {
+        // corrupted record, items left in the segment are dropped
+        SenderQueueSpillStore store(kSpillDir, 1024 * 1024);
+        APSARA_TEST_TRUE(store.Open());
+        APSARA_TEST_EQUAL(3U, store.Size());
+        APSARA_TEST_EQUAL("2", store.Pop(nullptr, 0)->mData);
+        {
+            fstream fout(kSpillDir / "segment_0.log", ios::in | ios::out | ios::binary);
+            fout.seekp(store.mReadOffset + 12);
+            fout << 'x';
+        }
+        APSARA_TEST_TRUE(store.Pop(nullptr, 0) == nullptr);
+        APSARA_TEST_TRUE(store.Empty());
+        APSARA_TEST_EQUAL(0U, store.DataSizeBytes());
+    }
+}
+
+void SenderQueueSpillStoreUnittest::TestSpillInSenderQueue() {
+    auto threshold = INT64_FLAG(sender_queue_spill_threshold_bytes);
+    INT64_FLAG(sender_queue_spill_threshold_bytes) = 10;
+
+    CollectionPipelineContext ctx;
+    ctx.SetConfigName("test_config");
+    SenderQueue queue(2, 1, 2, 0, "1", ctx);
+    APSARA_TEST_TRUE(queue.EnableSpill(kSpillDir));
+
+    auto* flusher = reinterpret_cast<Flusher*>(0x1);
+    for (int i = 0; i < 6; ++i) {
+        auto item = make_unique<SenderQueueItem>(string(5, 'a' + i), 5, flusher, 0);
+        APSARA_TEST_TRUE(queue.Push(std::move(item)));
+    }
+    APSARA_TEST_EQUAL(2U, queue.Size());
+    // extra buffer takes items until the threshold is reached
+    APSARA_TEST_EQUAL(2U, queue.mExtraBuffer.size());
+    APSARA_TEST_EQUAL(2U, queue.mSpillStore->Size());
+
+    // items not to be buffered never go to disk
+    APSARA_TEST_TRUE(queue.Push(make_unique<SenderQueueItem>("g", 1, flusher, 0, RawDataType::EVENT_GROUP, false)));
+    APSARA_TEST_EQUAL(3U, queue.mExtraBuffer.size());
+    APSARA_TEST_EQUAL(2U, queue.mSpillStore->Size());
+
+    vector<string> sent;
+    for (int round = 0; round < 10 && sent.size() < 7; ++round) {
+        vector<SenderQueueItem*> items;
+        queue.GetAvailableItems(items, -1);
+        for (auto* item : items) {
+            APSARA_TEST_EQUAL(flusher, item->mFlusher);
+            sent.push_back(item->mData);
+            APSARA_TEST_TRUE(queue.Remove(item));
+        }
+    }
+    vector<string> expected = {"aaaaa", "bbbbb", "ccccc", "ddddd", "g", "eeeee", "fffff"};
+    APSARA_TEST_EQUAL(expected, sent);
+    APSARA_TEST_TRUE(queue.Empty());
+    APSARA_TEST_TRUE(queue.mSpillStore->Empty());
+
+    // replay waits for the next flusher once the current one is stopped
+    queue.Push(make_unique<SenderQueueItem>("h", 1, flusher, 0));
+    queue.Push(make_unique<SenderQueueItem>("i", 1, flusher, 0));
+    queue.mExtraBufferDataSize = 100;
+    queue.Push(make_unique<SenderQueueItem>("j", 1, flusher, 0));
+    queue.mExtraBufferDataSize = 0;
+    queue.CommitSpill();
+    queue.StopSpillReplay();
+    vector<SenderQueueItem*> items;
+    queue.GetAvailableItems(items, -1);
+    APSARA_TEST_EQUAL(2U, items.size());
+    for (auto* item : items) {
+        queue.Remove(item);
+    }
+    APSARA_TEST_TRUE(queue.Empty());
+    APSARA_TEST_EQUAL(1U, queue.mSpillStore->Size());
+
+    INT64_FLAG(sender_queue_spill_threshold_bytes) = threshold;
+}
+
+void SenderQueueSpillStoreUnittest::TestReplayAfterRestart() {
+    auto threshold = INT64_FLAG(sender_queue_spill_threshold_bytes);
+    INT64_FLAG(sender_queue_spill_threshold_bytes) = 0;
+
+    CollectionPipelineContext ctx;
+    ctx.SetConfigName("test_config");
+    auto* flusher = reinterpret_cast<Flusher*>(0x1);
+    {
+        SenderQueue queue(2, 1, 2, 0, "1", ctx);
+        APSARA_TEST_TRUE(queue.EnableSpill(kSpillDir));
+        for (int i = 0; i < 5; ++i) {
+            queue.Push(make_unique<SenderQueueItem>(to_string(i), 1, flusher, 0));
+        }
+        APSARA_TEST_EQUAL(2U, queue.Size());
+        APSARA_TEST_EQUAL(3U, queue.mSpillStore->Size());
+    }
+    {
+        // recovered items are replayed once the flusher starts, even if nothing new comes
+        SenderQueue queue(2, 1, 2, 0, "1", ctx);
+        APSARA_TEST_TRUE(queue.EnableSpill(kSpillDir));
+        APSARA_TEST_EQUAL(3U, queue.mSpillStore->Size());
+        APSARA_TEST_TRUE(popAll(queue).empty());
+        queue.StartSpillReplay(flusher);
+        vector<SenderQueueItem*> items;
+        queue.GetAvailableItems(items, -1);
+        APSARA_TEST_EQUAL(2U, items.size());
+        APSARA_TEST_EQUAL(flusher, items[0]->mFlusher);
+        APSARA_TEST_EQUAL("2", items[0]->mData);
+        APSARA_TEST_EQUAL("3", items[1]->mData);
+        queue.Remove(items[0]);
+        queue.Remove(items[1]);
+        APSARA_TEST_EQUAL(1U, queue.Size());
+        APSARA_TEST_TRUE(queue.mSpillStore->Empty());
+    }
+    {
+        SenderQueue queue(2, 1, 2, 0, "1", ctx);
+        APSARA_TEST_TRUE(queue.EnableSpill(kSpillDir));
+        for (int i = 5; i < 9; ++i) {
+            queue.Push(make_unique<SenderQueueItem>(to_string(i), 1, flusher, 0));
+        }
+        queue.StopSpillReplay();
+    }
+    {
+        // a new item waits for all spilled ones, though the queue is not full
+        SenderQueue queue(4, 1, 4, 0, "1", ctx);
+        APSARA_TEST_TRUE(queue.EnableSpill(kSpillDir));
+        APSARA_TEST_EQUAL(2U, queue.mSpillStore->Size());
+        APSARA_TEST_TRUE(queue.Push(make_unique<SenderQueueItem>("9", 1, flusher, 0)));
+        APSARA_TEST_TRUE(queue.mSpillStore->Empty());
+        vector<string> expected = {"7", "8", "9"};
+        APSARA_TEST_EQUAL(expected, popAll(queue));
+    }
+
+    INT64_FLAG(sender_queue_spill_threshold_bytes) = threshold;
+}
+
+void SenderQueueSpillStoreUnittest::TestUnspillableItem() {
+    auto threshold = INT64_FLAG(sender_queue_spill_threshold_bytes);
+    INT64_FLAG(sender_queue_spill_threshold_bytes) = 0;
+
+    CollectionPipelineContext ctx;
+    ctx.SetConfigName("test_config");
+    SenderQueue queue(1, 0, 1, 0, "1", ctx);
+    APSARA_TEST_TRUE(queue.EnableSpill(kSpillDir));
+    auto* flusher = reinterpret_cast<Flusher*>(0x1);
+    queue.Push(make_unique<SenderQueueItem>("a", 1, flusher, 0));
+    queue.Push(make_unique<SenderQueueItem>("b", 1, flusher, 0));
+    APSARA_TEST_EQUAL(1U, queue.mSpillStore->Size());
+
+    // the checkpoint and the pipeline only live in memory, so such items stay there
+    auto item = make_unique<SenderQueueItem>("c", 1, flusher, 0);
+    item->mPipeline = make_shared<CollectionPipeline>();
+    APSARA_TEST_FALSE(SenderQueueSpillStore::CanSpill(*item));
+    queue.Push(std::move(item));
+    auto slsItem = make_unique<SLSSenderQueueItem>(
+        "d", 1, flusher, 0, "logstore", RawDataType::EVENT_GROUP, "", RangeCheckpointPtr(new RangeCheckpoint));
+    APSARA_TEST_FALSE(SenderQueueSpillStore::CanSpill(*slsItem));
+    queue.Push(std::move(slsItem));
+    APSARA_TEST_EQUAL(2U, queue.mExtraBuffer.size());
+    APSARA_TEST_EQUAL(1U, queue.mSpillStore->Size());
+
+    APSARA_TEST_TRUE(SenderQueueSpillStore::CanSpill(
+        SLSSenderQueueItem("e", 1, flusher, 0, "logstore", RawDataType::EVENT_GROUP, "", nullptr)));
+
+    INT64_FLAG(sender_queue_spill_threshold_bytes) = threshold;
+}
+
+UNIT_TEST_CASE(SenderQueueSpillStoreUnittest, TestAppendAndPop)
+UNIT_TEST_CASE(SenderQueueSpillStoreUnittest, TestRotate)
+UNIT_TEST_CASE(SenderQueueSpillStoreUnittest, TestRecovery)
+UNIT_TEST_CASE(SenderQueueSpillStoreUnittest, TestSpillInSenderQueue)
+UNIT_TEST_CASE(SenderQueueSpillStoreUnittest, TestReplayAfterRestart)
+UNIT_TEST_CASE(SenderQueueSpillStoreUnittest, TestUnspillableItem)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -440,6 +440,132 @@ UNIT_TEST_CASE(TagConditionUnittest, TestInit)
 UNIT_TEST_CASE(TagConditionUnittest, TestCheck)
 UNIT_TEST_CASE(TagConditionUnittest, TestDiscardTag)
 
+class ContentConditionUnittest : public testing::Test {
+public:
+    void TestInit();
+    void TestCheck();
+
+private:
+    CollectionPipelineContext ctx;
+};
+
+void ContentConditionUnittest::TestInit() {
+    Json::Value configJson;
+    string configStr, errorMsg;
+    {
+        configStr = R"(
+            {
+                "Key": "level",
+                "Value": "INFO"
+            }
+        )";
+        APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+        ContentCondition cond;
+        APSARA_TEST_TRUE(cond.Init(configJson, ctx));
+        APSARA_TEST_EQUAL("level", cond.mKey);
+        APSARA_TEST_TRUE(ContentCondition::Operator::EQUALS == cond.mOperator);
+        APSARA_TEST_EQUAL(vector<string>({"INFO"}), cond.mValues);
+    }
+    {
+        configStr = R"(
+            {
+                "Key": "level",
+                "Operator": "in",
+                "Value": ["WARNING", "ERROR"]
+            }
+        )";
+        APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+        ContentCondition cond;
+        APSARA_TEST_TRUE(cond.Init(configJson, ctx));
+        APSARA_TEST_TRUE(ContentCondition::Operator::IN == cond.mOperator);
+        APSARA_TEST_EQUAL(vector<string>({"WARNING", "ERROR"}), cond.mValues);
+    }
+    {
+        configStr = R"(
+            {
+                "Key": "level",
+                "Operator": "in",
+                "Value": "ERROR"
+            }
+        )";
+        APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+        ContentCondition cond;
+        APSARA_TEST_FALSE(cond.Init(configJson, ctx));
+    }
+    {
+        configStr = R"(
+            {
+                "Key": "path",
+                "Operator": "regex",
+                "Value": "/api/(v1"
+            }
+        )";
+        APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+        ContentCondition cond;
+        APSARA_TEST_FALSE(cond.Init(configJson, ctx));
+    }
+    {
+        configStr = R"(
+            {
+                "Key": "level",
+                "Operator": "unknown",
+                "Value": "INFO"
+            }
+        )";
+        APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+        ContentCondition cond;
+        APSARA_TEST_FALSE(cond.Init(configJson, ctx));
+    }
+    {
+        configStr = R"(
+            {
+                "Key": "",
+                "Value": "INFO"
+            }
+        )";
+        APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+        ContentCondition cond;
+        APSARA_TEST_FALSE(cond.Init(configJson, ctx));
+    }
+}
+
+void ContentConditionUnittest::TestCheck() {
+    auto check = [&](const string& configStr, const string& value) {
+        Json::Value configJson;
+        string errorMsg;
+        APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+        ContentCondition cond;
+        APSARA_TEST_TRUE(cond.Init(configJson, ctx));
+        PipelineEventGroup g(make_shared<SourceBuffer>());
+        g.AddLogEvent()->SetContent(string("key"), value);
+        return cond.Check(g.GetEvents()[0]);
+    };
+    APSARA_TEST_TRUE(check(R"({"Key": "key", "Value": "abc"})", "abc"));
+    APSARA_TEST_FALSE(check(R"({"Key": "key", "Value": "abc"})", "abcd"));
+    APSARA_TEST_FALSE(check(R"({"Key": "other", "Value": "abc"})", "abc"));
+    APSARA_TEST_TRUE(check(R"({"Key": "key", "Operator": "prefix", "Value": "ab"})", "abc"));
+    APSARA_TEST_FALSE(check(R"({"Key": "key", "Operator": "prefix", "Value": "bc"})", "abc"));
+    APSARA_TEST_TRUE(check(R"({"Key": "key", "Operator": "in", "Value": ["x", "abc"]})", "abc"));
+    APSARA_TEST_FALSE(check(R"({"Key": "key", "Operator": "in", "Value": ["x", "y"]})", "abc"));
+    APSARA_TEST_TRUE(check(R"({"Key": "key", "Operator": "regex", "Value": "a.c"})", "abc"));
+    APSARA_TEST_FALSE(check(R"({"Key": "key", "Operator": "regex", "Value": "b"})", "abc"));
+
+    {
+        // only log events have contents
+        Json::Value configJson;
+        string errorMsg;
+        APSARA_TEST_TRUE(ParseJsonTable(R"({"Key": "key", "Value": "abc"})", configJson, errorMsg));
+        ContentCondition cond;
+        APSARA_TEST_TRUE(cond.Init(configJson, ctx));
+        PipelineEventGroup g(make_shared<SourceBuffer>());
+        g.AddMetricEvent();
+        APSARA_TEST_FALSE(cond.Check(g.GetEvents()[0]));
+    }
+}
+
+UNIT_TEST_CASE(ContentConditionUnittest, TestInit)
+UNIT_TEST_CASE(ContentConditionUnittest, TestCheck)
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
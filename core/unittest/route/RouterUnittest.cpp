@@ -26,6 +26,8 @@ class RouterUnittest : public testing::Test {
 public:
     void TestInit();
     void TestRoute();
+    void TestSharedRoute();
+    void TestEventRoute();
     void TestMetric();
 
 protected:
@@ -124,9 +126,9 @@ void RouterUnittest::TestRoute() {
         auto res = router.Route(g);
         APSARA_TEST_EQUAL(2U, res.size());
         APSARA_TEST_EQUAL(2U, res[0].first);
-        APSARA_TEST_EQUAL(1U, res[0].second.GetEvents().size());
+        APSARA_TEST_EQUAL(1U, res[0].second->GetEvents().size());
         APSARA_TEST_EQUAL(0U, res[1].first);
-        APSARA_TEST_EQUAL(1U, res[0].second.GetEvents().size());
+        APSARA_TEST_EQUAL(1U, res[0].second->GetEvents().size());
     }
     {
         PipelineEventGroup g(make_shared<SourceBuffer>());
@@ -134,9 +136,9 @@ void RouterUnittest::TestRoute() {
         auto res = router.Route(g);
         APSARA_TEST_EQUAL(2U, res.size());
         APSARA_TEST_EQUAL(2U, res[0].first);
-        APSARA_TEST_TRUE(res[0].second.HasTag("level"));
+        APSARA_TEST_TRUE(res[0].second->HasTag("level"));
         APSARA_TEST_EQUAL(1U, res[1].first);
-        APSARA_TEST_FALSE(res[1].second.HasTag("level"));
+        APSARA_TEST_FALSE(res[1].second->HasTag("level"));
     }
     {
         PipelineEventGroup g(make_shared<SourceBuffer>());
@@ -144,7 +146,191 @@ void RouterUnittest::TestRoute() {
         auto res = router.Route(g);
         APSARA_TEST_EQUAL(1U, res.size());
         APSARA_TEST_EQUAL(2U, res[0].first);
-        APSARA_TEST_EQUAL(1U, res[0].second.GetEvents().size());
+        APSARA_TEST_EQUAL(1U, res[0].second->GetEvents().size());
+    }
+}
+
+void RouterUnittest::TestSharedRoute() {
+    Json::Value configJson;
+    string errorMsg;
+    string configStr = R"(
+        [
+            {
+                "Type": "event_type",
+                "Value": "log"
+            },
+            {
+                "Type": "tag",
+                "Key": "level",
+                "Value": "INFO",
+                "DiscardingTag": true
+            },
+            {
+                "Type": "tag",
+                "Key": "level",
+                "Value": "INFO",
+                "DiscardingTag": true
+            }
+        ]
+    )";
+    APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+    vector<pair<size_t, const Json::Value*>> configs;
+    for (Json::Value::ArrayIndex i = 0; i < configJson.size(); ++i) {
+        configs.emplace_back(i, &configJson[i]);
+    }
+    configs.emplace_back(configJson.size(), nullptr);
+
+    Router router;
+    router.Init(configs, ctx);
+    {
+        // destinations not modifying the group share the same one
+        PipelineEventGroup g(make_shared<SourceBuffer>());
+        g.AddLogEvent();
+        const auto* event = g.GetEvents()[0].Get<LogEvent>();
+        auto res = router.Route(g);
+        APSARA_TEST_EQUAL(2U, res.size());
+        APSARA_TEST_EQUAL(res[0].second.get(), res[1].second.get());
+        APSARA_TEST_EQUAL(event, res[0].second->GetEvents()[0].Get<LogEvent>());
+        APSARA_TEST_EQUAL(2, res[0].second.use_count());
+    }
+    {
+        // destinations discarding the tag get a copy each
+        PipelineEventGroup g(make_shared<SourceBuffer>());
+        g.AddLogEvent();
+        g.SetTag(string("level"), string("INFO"));
+        const auto* event = g.GetEvents()[0].Get<LogEvent>();
+        auto res = router.Route(g);
+        APSARA_TEST_EQUAL(4U, res.size());
+        APSARA_TEST_EQUAL(3U, res[0].first);
+        APSARA_TEST_EQUAL(0U, res[1].first);
+        APSARA_TEST_EQUAL(res[0].second.get(), res[1].second.get());
+        APSARA_TEST_EQUAL(event, res[0].second->GetEvents()[0].Get<LogEvent>());
+        APSARA_TEST_TRUE(res[0].second->HasTag("level"));
+        for (size_t i = 2; i < 4; ++i) {
+            APSARA_TEST_EQUAL(i - 1, res[i].first);
+            APSARA_TEST_NOT_EQUAL(res[0].second.get(), res[i].second.get());
+            APSARA_TEST_NOT_EQUAL(event, res[i].second->GetEvents()[0].Get<LogEvent>());
+            APSARA_TEST_FALSE(res[i].second->HasTag("level"));
+            APSARA_TEST_EQUAL(1, res[i].second.use_count());
+        }
+    }
+    {
+        // the last destination modifying the group takes the original one over when no one else shares it
+        Router tagRouter;
+        tagRouter.Init({{0, &configJson[1]}, {1, &configJson[2]}}, ctx);
+        PipelineEventGroup g(make_shared<SourceBuffer>());
+        g.AddLogEvent();
+        g.SetTag(string("level"), string("INFO"));
+        const auto* event = g.GetEvents()[0].Get<LogEvent>();
+        auto res = tagRouter.Route(g);
+        APSARA_TEST_EQUAL(2U, res.size());
+        APSARA_TEST_NOT_EQUAL(event, res[0].second->GetEvents()[0].Get<LogEvent>());
+        APSARA_TEST_EQUAL(event, res[1].second->GetEvents()[0].Get<LogEvent>());
+        APSARA_TEST_FALSE(res[0].second->HasTag("level"));
+        APSARA_TEST_FALSE(res[1].second->HasTag("level"));
+    }
+}
+
+void RouterUnittest::TestEventRoute() {
+    Json::Value configJson;
+    string errorMsg;
+    string configStr = R"(
+        [
+            {
+                "Type": "content",
+                "Key": "level",
+                "Value": "ERROR"
+            },
+            {
+                "Type": "content",
+                "Key": "level",
+                "Operator": "in",
+                "Value": ["WARNING", "ERROR"]
+            },
+            {
+                "Type": "content",
+                "Key": "path",
+                "Operator": "prefix",
+                "Value": "/api/"
+            },
+            {
+                "Type": "content",
+                "Key": "path",
+                "Operator": "regex",
+                "Value": ".*\\.html"
+            }
+        ]
+    )";
+    APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+    vector<pair<size_t, const Json::Value*>> configs;
+    for (Json::Value::ArrayIndex i = 0; i < configJson.size(); ++i) {
+        configs.emplace_back(i, &configJson[i]);
+    }
+
+    auto addEvent = [](PipelineEventGroup& g, const string& level, const string& path) {
+        auto* e = g.AddLogEvent();
+        e->SetContent(string("level"), level);
+        e->SetContent(string("path"), path);
+        return e;
+    };
+    auto levels = [](const PipelineEventGroup& g) {
+        vector<string> res;
+        for (const auto& e : g.GetEvents()) {
+            res.emplace_back(e.Cast<LogEvent>().GetContent("level").to_string());
+        }
+        return res;
+    };
+    {
+        Router router;
+        APSARA_TEST_TRUE(router.Init(configs, ctx));
+        APSARA_TEST_TRUE(router.mConditions.empty());
+        APSARA_TEST_EQUAL(4U, router.mEventIndex.mFlusherIdx.size());
+        APSARA_TEST_EQUAL(2U, router.mEventIndex.mKeys.size());
+
+        auto sourceBuffer = make_shared<SourceBuffer>();
+        PipelineEventGroup g(sourceBuffer);
+        g.SetTag(string("host"), string("a"));
+        addEvent(g, "ERROR", "/api/user");
+        const auto* info = addEvent(g, "INFO", "/index.html");
+        addEvent(g, "WARNING", "/static/a.js");
+        addEvent(g, "DEBUG", "/static/b.js");
+        auto res = router.Route(g);
+        APSARA_TEST_EQUAL(4U, res.size());
+        APSARA_TEST_EQUAL(0U, res[0].first);
+        APSARA_TEST_EQUAL(vector<string>({"ERROR"}), levels(*res[0].second));
+        APSARA_TEST_EQUAL(1U, res[1].first);
+        APSARA_TEST_EQUAL(vector<string>({"ERROR", "WARNING"}), levels(*res[1].second));
+        APSARA_TEST_EQUAL(2U, res[2].first);
+        APSARA_TEST_EQUAL(vector<string>({"ERROR"}), levels(*res[2].second));
+        APSARA_TEST_EQUAL(3U, res[3].first);
+        APSARA_TEST_EQUAL(vector<string>({"INFO"}), levels(*res[3].second));
+        for (const auto& item : res) {
+            APSARA_TEST_EQUAL(sourceBuffer.get(), item.second->GetSourceBuffer().get());
+            APSARA_TEST_EQUAL("a", item.second->GetTag("host"));
+            for (auto& e : item.second->MutableEvents()) {
+                APSARA_TEST_EQUAL(item.second.get(), e->GetPipelineEventGroupPtr());
+            }
+        }
+        // events matching only one flusher are moved rather than copied
+        APSARA_TEST_EQUAL(info, res[3].second->GetEvents()[0].Get<LogEvent>());
+        // unmatched events stay in the original group
+        APSARA_TEST_EQUAL(vector<string>({"DEBUG"}), levels(g));
+    }
+    {
+        // events are copied if the whole group is also routed elsewhere
+        configs.emplace_back(configJson.size(), nullptr);
+        Router router;
+        APSARA_TEST_TRUE(router.Init(configs, ctx));
+
+        PipelineEventGroup g(make_shared<SourceBuffer>());
+        const auto* info = addEvent(g, "INFO", "/index.html");
+        auto res = router.Route(g);
+        APSARA_TEST_EQUAL(2U, res.size());
+        APSARA_TEST_EQUAL(4U, res[0].first);
+        APSARA_TEST_EQUAL(info, res[0].second->GetEvents()[0].Get<LogEvent>());
+        APSARA_TEST_EQUAL(3U, res[1].first);
+        APSARA_TEST_NOT_EQUAL(info, res[1].second->GetEvents()[0].Get<LogEvent>());
+        APSARA_TEST_EQUAL(vector<string>({"INFO"}), levels(*res[1].second));
     }
 }
 
@@ -186,6 +372,8 @@ void RouterUnittest::TestMetric() {
 
 UNIT_TEST_CASE(RouterUnittest, TestInit)
 UNIT_TEST_CASE(RouterUnittest, TestRoute)
+UNIT_TEST_CASE(RouterUnittest, TestSharedRoute)
+UNIT_TEST_CASE(RouterUnittest, TestEventRoute)
 UNIT_TEST_CASE(RouterUnittest, TestMetric)
 
 } // namespace logtail
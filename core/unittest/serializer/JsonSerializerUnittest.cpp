@@ -26,6 +26,7 @@ namespace logtail {
 class JsonSerializerUnittest : public ::testing::Test {
 public:
     void TestSerializeEventGroup();
+    void TestSerializeSharedEventGroup();
 
 protected:
     static void SetUpTestCase() { sFlusher = make_unique<FlusherMock>(); }
@@ -262,6 +263,31 @@ void JsonSerializerUnittest::TestSerializeEventGroup() {
     }
 }
 
+void JsonSerializerUnittest::TestSerializeSharedEventGroup() {
+    JsonEventGroupSerializer serializer(sFlusher.get());
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    group.SetTag(LOG_RESERVED_KEY_TOPIC, "topic");
+    LogEvent* e = group.AddLogEvent();
+    e->SetContent(string("key"), string("value"));
+    e->SetTimestamp(1234567890);
+    const auto* origin = group.GetEvents()[0].Get<LogEvent>();
+
+    string res;
+    string errorMsg;
+    APSARA_TEST_TRUE(serializer.DoSerialize(static_cast<const PipelineEventGroup&>(group), res, errorMsg));
+    APSARA_TEST_EQUAL("{\"__topic__\":\"topic\",\"__time__\":1234567890,\"key\":\"value\"}\n", res);
+    APSARA_TEST_EQUAL("", errorMsg);
+    // the group is left untouched for other flushers
+    APSARA_TEST_EQUAL(1U, group.GetEvents().size());
+    APSARA_TEST_EQUAL(origin, group.GetEvents()[0].Get<LogEvent>());
+    APSARA_TEST_EQUAL("value", group.GetEvents()[0].Cast<LogEvent>().GetContent("key"));
+    APSARA_TEST_EQUAL("topic", group.GetTag(LOG_RESERVED_KEY_TOPIC));
+
+    PipelineEventGroup emptyGroup(make_shared<SourceBuffer>());
+    res.clear();
+    APSARA_TEST_FALSE(serializer.DoSerialize(static_cast<const PipelineEventGroup&>(emptyGroup), res, errorMsg));
+    APSARA_TEST_EQUAL("empty event group", errorMsg);
+}
 
 BatchedEvents
 JsonSerializerUnittest::createBatchedLogEvents(bool enableNanosecond, bool withEmptyContent, bool withNonEmptyContent) {
@@ -426,6 +452,7 @@ BatchedEvents JsonSerializerUnittest::createBatchedSpanEvents() {
 }
 
 UNIT_TEST_CASE(JsonSerializerUnittest, TestSerializeEventGroup)
+UNIT_TEST_CASE(JsonSerializerUnittest, TestSerializeSharedEventGroup)
 
 } // namespace logtail
 